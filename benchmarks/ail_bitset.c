@@ -0,0 +1,77 @@
+#define AIL_BENCH_IMPL
+#define AIL_BENCH_PROFILE
+#include "../src/base/ail_alloc.h"
+#include "../src/base/ail_bitset.h"
+#include "../src/bench/ail_bench.h"
+#include "../src/math/ail_rand.h"
+#include <stdio.h>
+
+#define BITS    (AIL_MIL(64ULL))
+#define QUERIES AIL_MIL(1)
+
+static u64 checksum;
+
+static void fill_random(AIL_Bitset bs, u32 one_in)
+{
+    ail_bitset_clear_all(bs);
+    for (u64 i = 0; i < bs.len/one_in; i++) ail_bitset_set(bs, ail_rand_u64() % bs.len);
+}
+
+int main(void)
+{
+    ail_default_allocator = ail_alloc_std;
+    AIL_Bitset a = ail_bitset_new(BITS, ail_default_allocator);
+    AIL_Bitset b = ail_bitset_new(BITS, ail_default_allocator);
+    u64 bytes = ail_bitset_word_count(BITS)*sizeof(u64);
+    fill_random(a, 2);
+    fill_random(b, 2);
+
+    ail_bench_init();
+    ail_bench_begin_profile();
+
+    AIL_BENCH_PROFILE_MEM_START(Popcount, bytes);
+    checksum += ail_bitset_popcount(a);
+    AIL_BENCH_PROFILE_END(Popcount);
+
+    AIL_BENCH_PROFILE_MEM_START(And, 3*bytes);
+    ail_bitset_and(a, a, b);
+    AIL_BENCH_PROFILE_END(And);
+
+    AIL_BENCH_PROFILE_MEM_START(Xor, 3*bytes);
+    ail_bitset_xor(a, a, b);
+    AIL_BENCH_PROFILE_END(Xor);
+
+    AIL_BENCH_PROFILE_MEM_START(Andnot, 3*bytes);
+    ail_bitset_andnot(a, a, b);
+    AIL_BENCH_PROFILE_END(Andnot);
+
+    fill_random(a, 4096);
+    AIL_BENCH_PROFILE_MEM_START(Find_Next_Set_Sparse, bytes);
+    ail_bitset_for_each_set(a, i) checksum += i;
+    AIL_BENCH_PROFILE_END(Find_Next_Set_Sparse);
+
+    fill_random(a, 2);
+    AIL_BENCH_PROFILE_MEM_START(Find_Next_Set_Dense, bytes);
+    ail_bitset_for_each_set(a, i) checksum += i;
+    AIL_BENCH_PROFILE_END(Find_Next_Set_Dense);
+
+    AIL_BENCH_PROFILE_MEM_START(Rank_Build, bytes);
+    AIL_Bitset_Rank rank = ail_bitset_rank_new(a, ail_default_allocator);
+    AIL_BENCH_PROFILE_END(Rank_Build);
+
+    AIL_BENCH_PROFILE_START(Rank_1M);
+    for (u32 i = 0; i < QUERIES; i++) checksum += ail_bitset_rank(a, rank, ail_rand_u64() % BITS);
+    AIL_BENCH_PROFILE_END(Rank_1M);
+
+    AIL_BENCH_PROFILE_START(Select_1M);
+    for (u32 i = 0; i < QUERIES; i++) checksum += ail_bitset_select(a, rank, ail_rand_u64() % rank.ones);
+    AIL_BENCH_PROFILE_END(Select_1M);
+
+    ail_bench_end_and_print_profile(16, false);
+    printf("Checksum: %llu\n", (unsigned long long)checksum);
+
+    ail_bitset_rank_free(&rank, ail_default_allocator);
+    ail_bitset_free(&a, ail_default_allocator);
+    ail_bitset_free(&b, ail_default_allocator);
+    return 0;
+}
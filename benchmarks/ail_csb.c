@@ -0,0 +1,87 @@
+#define AIL_BENCH_IMPL
+#define AIL_BENCH_PROFILE
+#include "../src/base/ail_alloc.h"
+#include "../src/base/ail_csb.h"
+#include "../src/bench/ail_bench.h"
+#include "../src/math/ail_rand.h"
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#define RESPONSES 64
+#define LINES     AIL_KB(16)
+
+static u64 checksum;
+
+// A static file, that is embedded into every response (i.e. a stylesheet)
+static u8 asset[AIL_KB(16)];
+static const char *words[] = { "GET", "POST", "/index.html", "/api/v1/users", "200", "404", "OK", "Not Found", "text/html" };
+
+// Both builders are filled with the same lines of text, which mimics a large HTTP response or log
+#define FILL(push_cstr, push_num, push_asset) do {                      \
+        for (u32 i = 0; i < LINES; i++) {                               \
+            u64 r = ail_rand_u64();                                     \
+            push_cstr(words[r % ail_arrlen(words)]);                    \
+            push_cstr(" | ");                                           \
+            push_num(r >> (r % 64));                                    \
+            push_cstr(" bytes\n");                                      \
+            if (i % 64 == 0) push_asset;                               \
+        }                                                               \
+    } while(0)
+
+int main(void)
+{
+    ail_default_allocator = ail_alloc_std;
+    for (u64 i = 0; i < sizeof(asset); i++) asset[i] = 'a' + ail_rand_u64() % 26;
+    int fd = open("/dev/null", O_WRONLY);
+    if (fd < 0) return 1;
+
+    ail_bench_init();
+    ail_bench_begin_profile();
+
+    u64 seed = ail_rand_state;
+    AIL_BENCH_PROFILE_START(SB_Build);
+    for (u32 k = 0; k < RESPONSES; k++) {
+        AIL_SB sb = ail_da_new(u8);
+#define SB_CSTR(s) ail_da_pushn(&sb, (char *)s, ail_cstr_len((char *)s))
+#define SB_NUM(n)  ail_sb_push_unsigned(&sb, n)
+        FILL(SB_CSTR, SB_NUM, ail_da_pushn(&sb, asset, sizeof(asset)));
+        checksum += (u64)write(fd, sb.data, sb.len);
+        ail_da_free(&sb);
+    }
+    AIL_BENCH_PROFILE_END(SB_Build);
+
+    ail_rand_state = seed;
+    AIL_BENCH_PROFILE_START(CSB_Build);
+    for (u32 k = 0; k < RESPONSES; k++) {
+        AIL_CSB csb = ail_csb_new();
+#define CSB_CSTR(s) ail_csb_push_cstr(&csb, (char *)s)
+#define CSB_NUM(n)  ail_csb_push_unsigned(&csb, n)
+        FILL(CSB_CSTR, CSB_NUM, ail_csb_push_ref(&csb, ail_str_from_parts(asset, sizeof(asset))));
+        checksum += ail_csb_write_fd(csb, fd) + csb.len;
+        ail_csb_free(&csb);
+    }
+    AIL_BENCH_PROFILE_END(CSB_Build);
+
+    // Reusing the builder for every response avoids almost all allocations
+    ail_rand_state = seed;
+    AIL_CSB csb = ail_csb_new();
+    AIL_BENCH_PROFILE_START(CSB_Build_Reused);
+    for (u32 k = 0; k < RESPONSES; k++) {
+        ail_csb_clear(&csb);
+        FILL(CSB_CSTR, CSB_NUM, ail_csb_push_ref(&csb, ail_str_from_parts(asset, sizeof(asset))));
+        checksum += ail_csb_write_fd(csb, fd) + csb.len;
+    }
+    AIL_BENCH_PROFILE_END(CSB_Build_Reused);
+
+    AIL_BENCH_PROFILE_START(CSB_Collapse);
+    checksum += ail_csb_collapse(&csb).len;
+    AIL_BENCH_PROFILE_END(CSB_Collapse);
+    ail_csb_free(&csb);
+
+    ail_bench_end_and_print_profile(16, false);
+    printf("Checksum: %llu\n", (unsigned long long)checksum);
+    close(fd);
+    return 0;
+}
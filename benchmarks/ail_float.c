@@ -0,0 +1,76 @@
+#define AIL_BENCH_IMPL
+#define AIL_BENCH_PROFILE
+#include "../src/base/ail_alloc.h"
+#include "../src/base/ail_str.h"
+#include "../src/bench/ail_bench.h"
+#include "../src/math/ail_rand.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define N AIL_MIL(2)
+
+static u64 checksum;
+
+// Random values with full precision (as produced by computations) and short values (as typed by people, i.e. prices in a CSV file)
+static f64 random_full(void)
+{
+    return (f64)(ail_rand_u64() >> 11) / (f64)(1ULL << 53) * 1e6;
+}
+
+static f64 random_short(void)
+{
+    return (f64)(ail_rand_u64() % 1000000) / 100;
+}
+
+// Writes all numbers separated by newlines into `text` and returns the amount of bytes written
+static u64 fill_text(f64 *nums, u8 *text)
+{
+    u64 len = 0;
+    for (u32 i = 0; i < N; i++) {
+        len += ail_str_float_to_buf(nums[i], text + len);
+        text[len++] = '\n';
+    }
+    text[len] = 0;
+    return len;
+}
+
+#define BENCH_FLOATS(name, random_func) do {                                                                           \
+        for (u32 i = 0; i < N; i++) nums[i] = random_func();                                                           \
+        u64 len = fill_text(nums, text);                                                                               \
+        AIL_BENCH_PROFILE_MEM_START(Parse_##name, len);                                                                \
+        for (u64 i = 0; i < len;) {                                                                                    \
+            AIL_Str_Parse_F_Res res = ail_str_parse_float(ail_str_from_parts(text + i, len - i));                      \
+            checksum += (u64)res.val;                                                                                  \
+            i += res.len + 1;                                                                                          \
+        }                                                                                                              \
+        AIL_BENCH_PROFILE_END(Parse_##name);                                                                           \
+        AIL_BENCH_PROFILE_MEM_START(Strtod_##name, len);                                                               \
+        for (char *p = (char *)text; *p; p++) checksum += (u64)strtod(p, &p);                                          \
+        AIL_BENCH_PROFILE_END(Strtod_##name);                                                                          \
+        AIL_BENCH_PROFILE_MEM_START(Print_##name, len);                                                                \
+        for (u32 i = 0, out = 0; i < N; i++) out += ail_str_float_to_buf(nums[i], text + out % (len - 64));            \
+        AIL_BENCH_PROFILE_END(Print_##name);                                                                           \
+        AIL_BENCH_PROFILE_MEM_START(Snprintf_##name, len);                                                             \
+        for (u32 i = 0, out = 0; i < N; i++) out += snprintf((char *)text + out % (len - 64), 64, "%.17g", nums[i]);   \
+        AIL_BENCH_PROFILE_END(Snprintf_##name);                                                                        \
+    } while(0)
+
+int main(void)
+{
+    ail_default_allocator = ail_alloc_std;
+    f64 *nums = ail_call_alloc(ail_default_allocator, N*sizeof(f64));
+    u8  *text = ail_call_alloc(ail_default_allocator, N*(AIL_STR_FLOAT_MAX_LEN + 1) + 1);
+
+    ail_bench_init();
+    ail_bench_begin_profile();
+
+    BENCH_FLOATS(Full,  random_full);
+    BENCH_FLOATS(Short, random_short);
+
+    ail_bench_end_and_print_profile(16, false);
+    printf("Checksum: %llu\n", (unsigned long long)checksum);
+    ail_call_free(ail_default_allocator, nums);
+    ail_call_free(ail_default_allocator, text);
+    return 0;
+}
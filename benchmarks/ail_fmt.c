@@ -0,0 +1,91 @@
+#define AIL_BENCH_IMPL
+#define AIL_BENCH_PROFILE
+#include "../src/base/ail_alloc.h"
+#include "../src/base/ail_fmt.h"
+#include "../src/bench/ail_bench.h"
+#include "../src/math/ail_rand.h"
+#include <stdio.h>
+#include <string.h>
+
+#define N AIL_MIL(2)
+#define LOG_FMT "[%s] %08.3f | thread %-4d | %s: %llu bytes in %.2f ms (%x)\n"
+
+static u64 checksum;
+
+static const char *levels[]  = { "INFO", "WARN", "ERROR", "DEBUG" };
+static const char *actions[] = { "read", "write", "flush", "compress" };
+
+// Arguments for one log-like line
+typedef struct Log_Args {
+    f64 time;
+    f64 ms;
+    u64 bytes;
+    i32 thread;
+    u32 id;
+    u8  level;
+    u8  action;
+} Log_Args;
+
+int main(void)
+{
+    ail_default_allocator = ail_alloc_std;
+    Log_Args *args = ail_call_alloc(ail_default_allocator, N*sizeof(Log_Args));
+    for (u32 i = 0; i < N; i++) {
+        args[i] = (Log_Args) {
+            .time   = (f64)(ail_rand_u64() % 100000000) / 1000,
+            .ms     = (f64)(ail_rand_u64() % 1000000) / 997,
+            .bytes  = ail_rand_u64() >> (ail_rand_u64() % 64),
+            .thread = (i32)(ail_rand_u64() % 64),
+            .id     = (u32)ail_rand_u64(),
+            .level  = ail_rand_u64() % ail_arrlen(levels),
+            .action = ail_rand_u64() % ail_arrlen(actions),
+        };
+    }
+    AIL_SB sb = ail_da_new(u8);
+    ail_da_maybe_grow(&sb, 256);
+    char buf[256];
+
+    ail_bench_init();
+    ail_bench_begin_profile();
+
+#define LOG_ARGS(a) levels[(a).level], (a).time, (a).thread, actions[(a).action], (unsigned long long)(a).bytes, (a).ms, (a).id
+
+    AIL_BENCH_PROFILE_START(Snprintf);
+    for (u32 i = 0; i < N; i++) checksum += (u64)snprintf(buf, sizeof(buf), LOG_FMT, LOG_ARGS(args[i]));
+    AIL_BENCH_PROFILE_END(Snprintf);
+
+    AIL_BENCH_PROFILE_START(SB_Print);
+    for (u32 i = 0; i < N; i++) {
+        sb.len = 0;
+        ail_sb_print(&sb, LOG_FMT, LOG_ARGS(args[i]));
+        checksum += sb.len;
+    }
+    AIL_BENCH_PROFILE_END(SB_Print);
+
+    AIL_Fmt fmt = ail_fmt_compile(LOG_FMT);
+    AIL_BENCH_PROFILE_START(SB_Print_Compiled);
+    for (u32 i = 0; i < N; i++) {
+        sb.len = 0;
+        ail_sb_print_fmt(&sb, &fmt, LOG_ARGS(args[i]));
+        checksum += sb.len;
+    }
+    AIL_BENCH_PROFILE_END(SB_Print_Compiled);
+
+    AIL_BENCH_PROFILE_START(Snprintf_Ints);
+    for (u32 i = 0; i < N; i++) checksum += (u64)snprintf(buf, sizeof(buf), "%d,%u,%llu\n", args[i].thread, args[i].id, (unsigned long long)args[i].bytes);
+    AIL_BENCH_PROFILE_END(Snprintf_Ints);
+
+    AIL_BENCH_PROFILE_START(SB_Print_Ints);
+    for (u32 i = 0; i < N; i++) {
+        sb.len = 0;
+        ail_sb_print(&sb, "%d,%u,%llu\n", args[i].thread, args[i].id, (unsigned long long)args[i].bytes);
+        checksum += sb.len;
+    }
+    AIL_BENCH_PROFILE_END(SB_Print_Ints);
+
+    ail_bench_end_and_print_profile(16, false);
+    printf("Checksum: %llu\n", (unsigned long long)checksum);
+    ail_da_free(&sb);
+    ail_call_free(ail_default_allocator, args);
+    return 0;
+}
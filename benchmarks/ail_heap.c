@@ -0,0 +1,102 @@
+#define AIL_BENCH_IMPL
+#define AIL_BENCH_PROFILE
+#include "../src/base/ail_alloc.h"
+#include "../src/base/ail_heap.h"
+#include "../src/bench/ail_bench.h"
+#include "../src/math/ail_rand.h"
+#include <stdio.h>
+
+#define OPS AIL_MIL(1)
+
+AIL_IHEAP_INIT(u64);
+
+static u64 *keys;
+static u64  checksum;
+
+static void bench_binary(void)
+{
+    AIL_DA(u64) heap = ail_da_empty(u64);
+    AIL_BENCH_PROFILE_START(Binary_Push);
+    for (u32 i = 0; i < OPS; i++) ail_heap_push(&heap, keys[i], ail_heap_lt);
+    AIL_BENCH_PROFILE_END(Binary_Push);
+    AIL_BENCH_PROFILE_START(Binary_Pop);
+    for (u32 i = 0; i < OPS; i++) {
+        u64 x;
+        ail_heap_pop(&heap, x, ail_heap_lt);
+        checksum += x;
+    }
+    AIL_BENCH_PROFILE_END(Binary_Pop);
+    ail_da_free(&heap);
+}
+
+static void bench_quaternary(void)
+{
+    AIL_DA(u64) heap = ail_da_empty(u64);
+    AIL_BENCH_PROFILE_START(Quaternary_Push);
+    for (u32 i = 0; i < OPS; i++) ail_heap4_push(&heap, keys[i], ail_heap_lt);
+    AIL_BENCH_PROFILE_END(Quaternary_Push);
+    AIL_BENCH_PROFILE_START(Quaternary_Pop);
+    for (u32 i = 0; i < OPS; i++) {
+        u64 x;
+        ail_heap4_pop(&heap, x, ail_heap_lt);
+        checksum += x;
+    }
+    AIL_BENCH_PROFILE_END(Quaternary_Pop);
+    ail_da_free(&heap);
+}
+
+static void bench_heapify(void)
+{
+    AIL_DA(u64) binary     = ail_da_new_with_cap(u64, OPS);
+    AIL_DA(u64) quaternary = ail_da_new_with_cap(u64, OPS);
+    ail_da_pushn(&binary,     keys, OPS);
+    ail_da_pushn(&quaternary, keys, OPS);
+    AIL_BENCH_PROFILE_START(Binary_Heapify);
+    ail_heap_heapify(&binary, ail_heap_lt);
+    AIL_BENCH_PROFILE_END(Binary_Heapify);
+    AIL_BENCH_PROFILE_START(Quaternary_Heapify);
+    ail_heap4_heapify(&quaternary, ail_heap_lt);
+    AIL_BENCH_PROFILE_END(Quaternary_Heapify);
+    checksum += ail_heap_peek(&binary) + ail_heap4_peek(&quaternary);
+    ail_da_free(&binary);
+    ail_da_free(&quaternary);
+}
+
+static void bench_indexed(void)
+{
+    AIL_IHEAP(u64) heap = ail_iheap_new(u64, OPS);
+    AIL_BENCH_PROFILE_START(Indexed_Push);
+    for (u32 i = 0; i < OPS; i++) ail_iheap_push(&heap, i, keys[i], ail_heap_lt);
+    AIL_BENCH_PROFILE_END(Indexed_Push);
+    AIL_BENCH_PROFILE_START(Indexed_Decrease_Key);
+    for (u32 i = 0; i < OPS; i++) {
+        u32 id = (u32)(ail_rand_u64() % OPS);
+        ail_iheap_decrease_key(&heap, id, ail_iheap_key(&heap, id)/2, ail_heap_lt);
+    }
+    AIL_BENCH_PROFILE_END(Indexed_Decrease_Key);
+    AIL_BENCH_PROFILE_START(Indexed_Pop);
+    for (u32 i = 0; i < OPS; i++) {
+        u32 id;
+        ail_iheap_pop(&heap, id, ail_heap_lt);
+        checksum += id;
+    }
+    AIL_BENCH_PROFILE_END(Indexed_Pop);
+    ail_iheap_free(&heap);
+}
+
+int main(void)
+{
+    ail_default_allocator = ail_alloc_std;
+    keys = ail_call_alloc(ail_default_allocator, sizeof(u64)*OPS);
+    for (u32 i = 0; i < OPS; i++) keys[i] = ail_rand_u64();
+
+    ail_bench_init();
+    ail_bench_begin_profile();
+    bench_binary();
+    bench_quaternary();
+    bench_heapify();
+    bench_indexed();
+    ail_bench_end_and_print_profile(16, false);
+    printf("Checksum: %llu\n", (unsigned long long)checksum);
+    return 0;
+}
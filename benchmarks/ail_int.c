@@ -0,0 +1,83 @@
+#define AIL_BENCH_IMPL
+#define AIL_BENCH_PROFILE
+#include "../src/base/ail_alloc.h"
+#include "../src/base/ail_str.h"
+#include "../src/bench/ail_bench.h"
+#include "../src/math/ail_rand.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define N AIL_MIL(4)
+
+static u64 checksum;
+
+// Numbers of any size (i.e. ids or hashes) and small numbers (i.e. counts or columns in a CSV file)
+static u64 random_full(void)
+{
+    return ail_rand_u64() >> (ail_rand_u64() % 64);
+}
+
+static u64 random_short(void)
+{
+    return ail_rand_u64() % 10000;
+}
+
+// Writes all numbers separated by commas into `text` and returns the amount of bytes written
+static u64 fill_text(u64 *nums, u8 *text)
+{
+    u64 len = 0;
+    for (u32 i = 0; i < N; i++) {
+        len += ail_str_unsigned_to_buf(nums[i], text + len);
+        text[len++] = ',';
+    }
+    text[len] = 0;
+    return len;
+}
+
+#define BENCH_INTS(name, random_func) do {                                                                             \
+        for (u32 i = 0; i < N; i++) nums[i] = random_func();                                                           \
+        u64 len = fill_text(nums, text);                                                                               \
+        AIL_BENCH_PROFILE_MEM_START(Parse_##name, len);                                                                \
+        for (u64 i = 0; i < len;) {                                                                                    \
+            AIL_Str_Parse_U_Res res = ail_str_parse_unsigned(ail_str_from_parts(text + i, len - i));                   \
+            checksum += res.val;                                                                                       \
+            i += res.len + 1;                                                                                          \
+        }                                                                                                              \
+        AIL_BENCH_PROFILE_END(Parse_##name);                                                                           \
+        AIL_BENCH_PROFILE_MEM_START(Strtoull_##name, len);                                                             \
+        for (char *p = (char *)text; *p; p++) checksum += strtoull(p, &p, 10);                                         \
+        AIL_BENCH_PROFILE_END(Strtoull_##name);                                                                        \
+        AIL_BENCH_PROFILE_MEM_START(Print_##name, len);                                                                \
+        for (u32 i = 0, out = 0; i < N; i++) out += ail_str_unsigned_to_buf(nums[i], text + out % (len - 64));         \
+        AIL_BENCH_PROFILE_END(Print_##name);                                                                           \
+        AIL_BENCH_PROFILE_MEM_START(Snprintf_##name, len);                                                             \
+        for (u32 i = 0, out = 0; i < N; i++) out += snprintf((char *)text + out % (len - 64), 64, "%llu", (unsigned long long)nums[i]); \
+        AIL_BENCH_PROFILE_END(Snprintf_##name);                                                                        \
+        AIL_BENCH_PROFILE_MEM_START(SB_Push_##name, len);                                                              \
+        sb.len = 0;                                                                                                    \
+        for (u32 i = 0; i < N; i++) ail_sb_push_unsigned(&sb, nums[i]);                                                \
+        checksum += sb.len;                                                                                            \
+        AIL_BENCH_PROFILE_END(SB_Push_##name);                                                                         \
+    } while(0)
+
+int main(void)
+{
+    ail_default_allocator = ail_alloc_std;
+    u64 *nums = ail_call_alloc(ail_default_allocator, N*sizeof(u64));
+    u8  *text = ail_call_alloc(ail_default_allocator, N*(AIL_STR_INT_MAX_LEN + 1) + 1);
+    AIL_SB sb = ail_da_new_with_cap(u8, N*AIL_STR_INT_MAX_LEN);
+
+    ail_bench_init();
+    ail_bench_begin_profile();
+
+    BENCH_INTS(Full,  random_full);
+    BENCH_INTS(Short, random_short);
+
+    ail_bench_end_and_print_profile(16, false);
+    printf("Checksum: %llu\n", (unsigned long long)checksum);
+    ail_call_free(ail_default_allocator, nums);
+    ail_call_free(ail_default_allocator, text);
+    ail_da_free(&sb);
+    return 0;
+}
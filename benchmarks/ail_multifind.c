@@ -0,0 +1,69 @@
+#define AIL_BENCH_IMPL
+#define AIL_BENCH_PROFILE
+#include "../src/base/ail_alloc.h"
+#include "../src/base/ail_multifind.h"
+#include "../src/bench/ail_bench.h"
+#include "../src/math/ail_rand.h"
+#include <stdio.h>
+
+#define HAY_LEN  AIL_MIL(8ULL)
+#define KEYWORDS 300
+
+static u64 checksum;
+
+// Every keyword is matched against every line, as when filtering a log file
+#define BENCH_LINES(name, needles, count, find) do {                           \
+        AIL_Str rest = hay;                                                    \
+        AIL_BENCH_PROFILE_MEM_START(name, hay.len);                            \
+        while (rest.len) {                                                     \
+            AIL_Str line = ail_str_split_next_char(&rest, '\n', false);       \
+            AIL_Str_Find_Of_Res res = find;                                    \
+            checksum += (u64)(res.str_idx + res.needle_idx);                   \
+        }                                                                      \
+        AIL_BENCH_PROFILE_END(name);                                           \
+    } while(0)
+
+int main(void)
+{
+    ail_default_allocator = ail_alloc_std;
+    u8 *data = ail_call_alloc(ail_default_allocator, HAY_LEN);
+    for (u64 i = 0; i < HAY_LEN; i++) {
+        u64 r = ail_rand_u64() % 80;
+        data[i] = r < 68 ? 'a' + r % 26 : r < 79 ? ' ' : '\n';
+    }
+    AIL_Str hay = ail_str_from_parts(data, HAY_LEN);
+
+    static u8 bytes[KEYWORDS*12];
+    AIL_Str needles[KEYWORDS];
+    for (u32 i = 0; i < KEYWORDS; i++) {
+        u64 len = 5 + ail_rand_u64() % 8;
+        for (u64 j = 0; j < len; j++) bytes[12*i + j] = 'a' + ail_rand_u64() % 26;
+        needles[i] = ail_str_from_parts(bytes + 12*i, len);
+    }
+
+    ail_bench_init();
+    ail_bench_begin_profile();
+
+    AIL_BENCH_PROFILE_START(Compile_300);
+    AIL_MultiFind many = ail_multifind_new(needles, KEYWORDS);
+    AIL_BENCH_PROFILE_END(Compile_300);
+    AIL_MultiFind few = ail_multifind_new(needles, 5);
+
+    BENCH_LINES(Multifind_300, needles, KEYWORDS, ail_multifind_first(&many, line));
+    BENCH_LINES(Find_Of_300,   needles, KEYWORDS, ail_str_find_of(line, needles, KEYWORDS));
+    BENCH_LINES(Multifind_5,   needles, 5,        ail_multifind_first(&few, line));
+    BENCH_LINES(Find_Of_5,     needles, 5,        ail_str_find_of(line, needles, 5));
+
+    AIL_BENCH_PROFILE_MEM_START(Multifind_All_300, hay.len);
+    AIL_DA(AIL_Str_Find_Of_Res) all = ail_multifind_all(&many, hay);
+    checksum += all.len;
+    AIL_BENCH_PROFILE_END(Multifind_All_300);
+
+    ail_bench_end_and_print_profile(16, false);
+    printf("Checksum: %llu\n", (unsigned long long)checksum);
+    ail_da_free(&all);
+    ail_multifind_free(&many);
+    ail_multifind_free(&few);
+    ail_call_free(ail_default_allocator, data);
+    return 0;
+}
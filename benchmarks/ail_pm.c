@@ -0,0 +1,271 @@
+#define AIL_FS_IMPL
+#define AIL_BENCH_IMPL
+#define AIL_BENCH_PROFILE
+#include "../src/base/ail_alloc.h"
+#include "../src/pm/ail_pm.h"
+#include "../src/fs/ail_file.h"
+#include "../src/bench/ail_bench.h"
+#include "../src/math/ail_rand.h"
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h> // For exit
+
+#define CORPUS_LEN      AIL_MB(256)
+#define SUBJECTS_LEN    AIL_MB(32)
+#define PATHS_COUNT     AIL_MIL(1)
+#define WORST_CASE_LEN  AIL_MB(16)
+
+static u64 checksum;
+
+// Scales lorem.txt up to `len` bytes, by writing its sentences in random order with one sentence per line
+// Every few thousand lines, a log-like line is inserted, so that the rarer patterns still find some matches
+static void fill_corpus(u8 *corpus, u64 len, AIL_Str lorem)
+{
+    AIL_DA(AIL_Str) sentences = ail_da_new(AIL_Str);
+    for (AIL_Str rest = lorem; rest.len;) {
+        i64 end = ail_str_find(rest, ail_str_from_cstr(". "));
+        u64 n   = end < 0 ? rest.len : (u64)end + 1;
+        ail_da_push(&sentences, ail_str_trim(ail_str_from_parts(rest.data, n)));
+        rest = ail_str_from_parts(rest.data + n, rest.len - n);
+    }
+    const char *error = "ERROR 2024-03-14 12:34:56 connection refused by 10.0.0.1";
+    u64 pos = 0;
+    while (pos < len) {
+        AIL_Str line = ail_rand_u64() % 4096 ? sentences.data[ail_rand_u64() % sentences.len] : ail_str_from_cstr((char *)error);
+        u64 n = ail_min(line.len, len - pos);
+        memcpy(corpus + pos, line.data, n);
+        pos += n;
+        if (pos < len) corpus[pos++] = '\n';
+    }
+    ail_da_free(&sentences);
+}
+
+// Fills `paths` with file paths like "src/dir12/file345.c"
+static void fill_paths(AIL_DA(AIL_Str) *paths, u8 *buf, u64 count)
+{
+    const char *exts[] = { "c", "h", "txt", "log", "gz", "md" };
+    for (u64 i = 0; i < count; i++) {
+        u32 n = (u32)sprintf((char *)buf, "%s/dir%u/file%u.%s", i % 3 ? "src" : "logs", (u32)(ail_rand_u64() % 100), (u32)(ail_rand_u64() % 10000), exts[ail_rand_u64() % ail_arrlen(exts)]);
+        ail_da_push(paths, ail_str_from_parts(buf, n));
+        buf += n;
+    }
+}
+
+static AIL_PM_Pattern compile(const char *pattern, AIL_PM_Exp_Type type)
+{
+    AIL_PM_Comp_Res cr = ail_pm_compile_str(ail_str_from_cstr((char *)pattern), type);
+    if (cr.failed) {
+        printf("Failed to compile '%s'\n", pattern);
+        exit(1);
+    }
+    return cr.pattern;
+}
+
+// Compares the sequential iterator to ail_pm_find_all with a single thread, with 4 threads and with one thread per core
+// The fixed amount of threads makes sure, that the threaded path is measured even on machines with few cores
+#define BENCH_FIND_ALL(name, pattern, corpus) do {                                          \
+        AIL_PM_Pattern p = compile(pattern, AIL_PM_EXP_REGEX);                              \
+        AIL_PM_DFA dfa   = ail_pm_dfa_new(p);                                               \
+        AIL_PM_Match64 m;                                                                   \
+        u64 count = 0;                                                                      \
+        AIL_BENCH_PROFILE_MEM_START(Iter_##name, (corpus).len);                             \
+        AIL_PM_Match_Iter it = ail_pm_match_iter_str(&dfa, corpus);                         \
+        while (ail_pm_match_iter_next(&it, &m)) { checksum += m.idx; count++; }             \
+        AIL_BENCH_PROFILE_END(Iter_##name);                                                 \
+        AIL_BENCH_PROFILE_MEM_START(Find_All_1_##name, (corpus).len);                       \
+        AIL_DA(AIL_PM_Match64) single = ail_pm_find_all_str(p, corpus, 1);                  \
+        AIL_BENCH_PROFILE_END(Find_All_1_##name);                                           \
+        AIL_BENCH_PROFILE_MEM_START(Find_All_4_##name, (corpus).len);                       \
+        AIL_DA(AIL_PM_Match64) four = ail_pm_find_all_str(p, corpus, 4);                    \
+        AIL_BENCH_PROFILE_END(Find_All_4_##name);                                           \
+        AIL_BENCH_PROFILE_MEM_START(Find_All_N_##name, (corpus).len);                       \
+        AIL_DA(AIL_PM_Match64) all = ail_pm_find_all_str(p, corpus, 0);                     \
+        AIL_BENCH_PROFILE_END(Find_All_N_##name);                                           \
+        if (single.len != count || four.len != count || all.len != count) {                 \
+            printf("Different matches for '%s' with ail_pm_find_all\n", pattern);           \
+        }                                                                                   \
+        checksum += single.len + four.len + all.len;                                        \
+        ail_da_free(&single);                                                               \
+        ail_da_free(&four);                                                                 \
+        ail_da_free(&all);                                                                  \
+        ail_pm_dfa_free(&dfa);                                                              \
+        ail_pm_free(p);                                                                     \
+    } while(0)
+
+// Compares interpreting the DFA of a pattern to running its compiled code
+#define BENCH_JIT(name, pattern, corpus) do {                                               \
+        AIL_PM_Pattern p = compile(pattern, AIL_PM_EXP_REGEX);                              \
+        AIL_PM_DFA dfa   = ail_pm_dfa_new(p);                                               \
+        AIL_PM_DFA jit   = ail_pm_dfa_new(p);                                               \
+        AIL_PM_Match64 m;                                                                   \
+        AIL_BENCH_PROFILE_START(Jit_Compile_##name);                                        \
+        b32 compiled = ail_pm_dfa_jit(&jit);                                                \
+        AIL_BENCH_PROFILE_END(Jit_Compile_##name);                                          \
+        if (!compiled) printf("Couldn't compile the DFA for '%s'\n", pattern);              \
+        AIL_BENCH_PROFILE_MEM_START(Interpreted_##name, (corpus).len);                      \
+        AIL_PM_Match_Iter it = ail_pm_match_iter_str(&dfa, corpus);                         \
+        while (ail_pm_match_iter_next(&it, &m)) checksum += m.idx;                          \
+        AIL_BENCH_PROFILE_END(Interpreted_##name);                                          \
+        AIL_BENCH_PROFILE_MEM_START(Jit_##name, (corpus).len);                              \
+        it = ail_pm_match_iter_str(&jit, corpus);                                           \
+        while (ail_pm_match_iter_next(&it, &m)) checksum += m.idx;                          \
+        AIL_BENCH_PROFILE_END(Jit_##name);                                                  \
+        ail_pm_dfa_free(&jit);                                                              \
+        ail_pm_dfa_free(&dfa);                                                              \
+        ail_pm_free(p);                                                                     \
+    } while(0)
+
+#define COMPILE_ITERS 100000
+
+// Compiles the pattern many times directly and through a cache, in which the pattern is found every time after the first one
+#define BENCH_COMPILE(name, pat, type) do {                                                 \
+        u32 n_ = (u32)strlen(pat);                                                          \
+        AIL_BENCH_PROFILE_START(Compile_##name);                                            \
+        for (u32 i = 0; i < COMPILE_ITERS; i++) {                                           \
+            AIL_PM_Comp_Res r = ail_pm_compile(pat, n_, type);                              \
+            checksum += r.pattern.len;                                                      \
+            if (!r.failed) ail_pm_free(r.pattern);                                          \
+        }                                                                                   \
+        AIL_BENCH_PROFILE_END(Compile_##name);                                              \
+        AIL_BENCH_PROFILE_START(Compile_Cached_##name);                                     \
+        for (u32 i = 0; i < COMPILE_ITERS; i++) {                                           \
+            AIL_PM_Comp_Res r = ail_pm_cache_compile(&cache, pat, n_, type);                \
+            checksum += r.pattern.len;                                                      \
+            if (!r.failed) ail_pm_free(r.pattern);                                          \
+        }                                                                                   \
+        AIL_BENCH_PROFILE_END(Compile_Cached_##name);                                       \
+        AIL_PM_Pattern p_ = compile(pat, type);                                             \
+        AIL_BENCH_PROFILE_START(Dfa_Jit_##name);                                            \
+        for (u32 i = 0; i < COMPILE_ITERS/100; i++) {                                       \
+            AIL_PM_DFA dfa = ail_pm_dfa_new(p_);                                            \
+            checksum += ail_pm_dfa_jit(&dfa);                                               \
+            ail_pm_dfa_free(&dfa);                                                          \
+        }                                                                                   \
+        AIL_BENCH_PROFILE_END(Dfa_Jit_##name);                                              \
+        ail_pm_free(p_);                                                                    \
+    } while(0)
+
+// Matches the pattern against each subject with the backtracking matcher, the DFA and the DFA compiled to machine code
+#define BENCH_SUBJECTS(name, pattern, type, subjects, bytes) do {                           \
+        AIL_PM_Pattern p = compile(pattern, type);                                          \
+        AIL_PM_DFA dfa   = ail_pm_dfa_new(p);                                               \
+        AIL_PM_DFA jit   = ail_pm_dfa_new(p);                                               \
+        ail_pm_dfa_jit(&jit);                                                               \
+        AIL_BENCH_PROFILE_MEM_START(Backtrack_##name, bytes);                               \
+        for (u64 i = 0; i < (subjects).len; i++)                                            \
+            checksum += ail_pm_match_str(p, (subjects).data[i]).len;                        \
+        AIL_BENCH_PROFILE_END(Backtrack_##name);                                            \
+        AIL_BENCH_PROFILE_MEM_START(Dfa_##name, bytes);                                     \
+        for (u64 i = 0; i < (subjects).len; i++)                                            \
+            checksum += ail_pm_dfa_match_str(&dfa, (subjects).data[i]).len;                 \
+        AIL_BENCH_PROFILE_END(Dfa_##name);                                                  \
+        AIL_BENCH_PROFILE_MEM_START(Jit_##name, bytes);                                     \
+        for (u64 i = 0; i < (subjects).len; i++)                                            \
+            checksum += ail_pm_dfa_match_str(&jit, (subjects).data[i]).len;                 \
+        AIL_BENCH_PROFILE_END(Jit_##name);                                                  \
+        ail_pm_dfa_free(&jit);                                                              \
+        ail_pm_dfa_free(&dfa);                                                              \
+        ail_pm_free(p);                                                                     \
+    } while(0)
+
+// Inputs, on which backtracking takes super-linear time, because every way to split the input between the repeated elements is tried
+// The backtracking matcher only gets a short prefix of the subject, while the DFAs get all of it
+#define BENCH_WORST_CASE(name, pattern, type, subject, short_len) do {                      \
+        AIL_PM_Pattern p = compile(pattern, type);                                          \
+        AIL_PM_DFA dfa   = ail_pm_dfa_new(p);                                               \
+        AIL_PM_DFA jit   = ail_pm_dfa_new(p);                                               \
+        ail_pm_dfa_jit(&jit);                                                               \
+        AIL_BENCH_PROFILE_MEM_START(Worst_Backtrack_##name, short_len);                     \
+        checksum += ail_pm_match(p, (char *)(subject).data, short_len).len;                 \
+        AIL_BENCH_PROFILE_END(Worst_Backtrack_##name);                                      \
+        AIL_BENCH_PROFILE_MEM_START(Worst_Dfa_##name, (subject).len);                       \
+        checksum += ail_pm_dfa_match_str(&dfa, subject).len;                                \
+        AIL_BENCH_PROFILE_END(Worst_Dfa_##name);                                            \
+        AIL_BENCH_PROFILE_MEM_START(Worst_Jit_##name, (subject).len);                       \
+        checksum += ail_pm_dfa_match_str(&jit, subject).len;                                \
+        AIL_BENCH_PROFILE_END(Worst_Jit_##name);                                            \
+        ail_pm_dfa_free(&jit);                                                              \
+        ail_pm_dfa_free(&dfa);                                                              \
+        ail_pm_free(p);                                                                     \
+    } while(0)
+
+int main(void)
+{
+    ail_default_allocator = ail_alloc_std;
+    ail_pm_init(AIL_GB(1));
+    u64 lorem_len;
+    u8 *lorem = ail_fs_read_entire_file("lorem.txt", &lorem_len, ail_default_allocator);
+    if (!lorem) {
+        printf("Failed to read lorem.txt\n");
+        return 1;
+    }
+    // The corpus is mapped directly from the OS like a large file would be
+    u8 *data = ail_call_alloc(ail_alloc_pager, CORPUS_LEN);
+    fill_corpus(data, CORPUS_LEN, ail_str_from_parts(lorem, lorem_len));
+    AIL_Str corpus = ail_str_from_parts(data, CORPUS_LEN);
+
+    // Short subjects are the lines of the start of the corpus, long subjects are large slices of it
+    AIL_DA(AIL_Str) lines = ail_da_new(AIL_Str);
+    AIL_Str_Split_Iter it = ail_str_split_iter_lines(ail_str_from_parts(data, SUBJECTS_LEN), false);
+    ail_str_split_for_each(&it, line) ail_da_push(&lines, line);
+    AIL_DA(AIL_Str) slices = ail_da_new(AIL_Str);
+    for (u64 i = 0; i < SUBJECTS_LEN; i += SUBJECTS_LEN/8) ail_da_push(&slices, ail_str_from_parts(data + i, SUBJECTS_LEN/8));
+    AIL_DA(AIL_Str) paths = ail_da_new(AIL_Str);
+    u8 *paths_buf = ail_call_alloc(ail_default_allocator, PATHS_COUNT*32);
+    fill_paths(&paths, paths_buf, PATHS_COUNT);
+    u64 paths_len = 0;
+    for (u64 i = 0; i < paths.len; i++) paths_len += paths.data[i].len;
+
+    u8 *as_data = ail_call_alloc(ail_default_allocator, WORST_CASE_LEN);
+    memset(as_data, 'a', WORST_CASE_LEN);
+    AIL_Str as = ail_str_from_parts(as_data, WORST_CASE_LEN);
+    AIL_PM_Cache cache = ail_pm_cache_new(16);
+
+    ail_bench_init();
+    ail_bench_begin_profile();
+
+    BENCH_COMPILE(Regex_Short,  "^ab+c$",                                    AIL_PM_EXP_REGEX);
+    BENCH_COMPILE(Regex_Long,   "[A-Z][a-z]+ \\d+\\.\\d+ [^\\s]+ [Ee]rror: .*$", AIL_PM_EXP_REGEX);
+    BENCH_COMPILE(Glob_Short,   "*.c",                                       AIL_PM_EXP_GLOB);
+    BENCH_COMPILE(Glob_Long,    "logs/[a-z]*/file[0-9]*.[lt][ox][gt]",       AIL_PM_EXP_GLOB);
+
+    BENCH_SUBJECTS(Short_Unanchored,   "ipsum [a-z]+",  AIL_PM_EXP_REGEX, lines,  SUBJECTS_LEN);
+    BENCH_SUBJECTS(Short_Start,        "^Lorem [a-z]+", AIL_PM_EXP_REGEX, lines,  SUBJECTS_LEN);
+    BENCH_SUBJECTS(Short_End,          "[a-z]+ est\\.$", AIL_PM_EXP_REGEX, lines,  SUBJECTS_LEN);
+    BENCH_SUBJECTS(Long_Unanchored,    "ipsum [0-9]+",  AIL_PM_EXP_REGEX, slices, SUBJECTS_LEN);
+    BENCH_SUBJECTS(Long_Start,         "^[A-Z][a-z]+",  AIL_PM_EXP_REGEX, slices, SUBJECTS_LEN);
+    BENCH_SUBJECTS(Long_End,           "[0-9]+$",       AIL_PM_EXP_REGEX, slices, SUBJECTS_LEN);
+    BENCH_SUBJECTS(Glob_Ext,           "*.gz",          AIL_PM_EXP_GLOB,  paths,  paths_len);
+    BENCH_SUBJECTS(Glob_Dir,           "logs/dir[1-3]?/*.log", AIL_PM_EXP_GLOB, paths, paths_len);
+
+    BENCH_WORST_CASE(Regex_Stars,  "a*a*a*a*a*[bc]", AIL_PM_EXP_REGEX, as, 64);
+    BENCH_WORST_CASE(Regex_Dots,   ".*.*.*[=:]",     AIL_PM_EXP_REGEX, as, 128);
+    BENCH_WORST_CASE(Glob_Stars,   "*a*a*a*a*[bc]",  AIL_PM_EXP_GLOB,  as, 64);
+
+    BENCH_FIND_ALL(Word,    "amet",                 corpus);
+    BENCH_FIND_ALL(Class,   "[A-Z][a-z]+ ipsum",    corpus);
+    BENCH_FIND_ALL(Rare,    "ERROR.*refused",       corpus);
+    BENCH_FIND_ALL(Words,   "[a-z]+ [a-z]+\\.",      corpus);
+    BENCH_FIND_ALL(Digits,  "\\d+\\.\\d+\\.\\d+",   corpus);
+
+    // A small rule set, like one that would be used to filter logs
+    BENCH_JIT(Word,     "amet",                 corpus);
+    BENCH_JIT(Class,    "[A-Z][a-z]+ ipsum",    corpus);
+    BENCH_JIT(Rare,     "ERROR.*refused",       corpus);
+    BENCH_JIT(Words,    "[a-z]+ [a-z]+\\.",      corpus);
+    BENCH_JIT(Digits,   "\\d+\\.\\d+\\.\\d+",   corpus);
+    BENCH_JIT(Vowels,   "[aeiou][aeiou]+m",     corpus);
+
+    ail_bench_end_and_print_profile(16, false);
+    printf("Checksum: %llu\n", (unsigned long long)checksum);
+    ail_pm_cache_free(&cache);
+    ail_da_free(&lines);
+    ail_da_free(&slices);
+    ail_da_free(&paths);
+    ail_call_free(ail_default_allocator, paths_buf);
+    ail_call_free(ail_default_allocator, as_data);
+    ail_call_free(ail_alloc_pager, data);
+    ail_call_free(ail_default_allocator, lorem);
+    ail_pm_deinit();
+    return 0;
+}
@@ -0,0 +1,92 @@
+#define AIL_BENCH_IMPL
+#define AIL_BENCH_PROFILE
+#include "../src/base/ail_alloc.h"
+#include "../src/base/ail_multifind.h"
+#include "../src/bench/ail_bench.h"
+#include "../src/math/ail_rand.h"
+#include <stdio.h>
+
+#define TEMPLATE_LEN AIL_MIL(32ULL)
+#define KEYS         6
+
+static u64 checksum;
+
+static const char *keys[KEYS]   = { "{{title}}", "{{user}}", "{{date}}", "{{count}}", "{{url}}", "{{footer}}" };
+static const char *values[KEYS] = { "Monthly Report", "Jane Doe", "2024-01-01", "1234567", "https://example.com/a/b", "" };
+
+// Fills `data` with lines of text, that contain a placeholder about every 100 bytes, like a large HTML template
+static u64 fill_template(u8 *data, u64 cap)
+{
+    u64 len = 0;
+    while (len + 128 < cap) {
+        u64 words = 5 + ail_rand_u64() % 20;
+        for (u64 i = 0; i < words; i++) data[len++] = 'a' + ail_rand_u64() % 26;
+        data[len++] = ' ';
+        const char *key = keys[ail_rand_u64() % KEYS];
+        for (const char *p = key; *p; p++) data[len++] = (u8)*p;
+        data[len++] = ail_rand_u64() % 8 ? ' ' : '\n';
+    }
+    return len;
+}
+
+int main(void)
+{
+    ail_default_allocator = ail_alloc_std;
+    u8 *data = ail_call_alloc(ail_default_allocator, TEMPLATE_LEN);
+    AIL_Str tmpl = ail_str_from_parts(data, fill_template(data, TEMPLATE_LEN));
+    AIL_Str from[KEYS], to[KEYS];
+    for (u32 i = 0; i < KEYS; i++) {
+        from[i] = ail_str_from_cstr((char *)keys[i]);
+        to[i]   = ail_str_from_cstr((char *)values[i]);
+    }
+
+    ail_bench_init();
+    ail_bench_begin_profile();
+
+    AIL_BENCH_PROFILE_MEM_START(Replace_1, tmpl.len);
+    AIL_Str res = ail_str_replace(tmpl, from[0], to[0]);
+    checksum += res.len;
+    ail_str_free(res);
+    AIL_BENCH_PROFILE_END(Replace_1);
+
+    // What ail_str_replace used to do
+    AIL_BENCH_PROFILE_MEM_START(Split_Join_1, tmpl.len);
+    AIL_DA(AIL_Str) parts = ail_str_split(tmpl, from[0], false);
+    res = ail_str_join_da(parts, to[0]);
+    checksum += res.len;
+    ail_str_free(res);
+    ail_da_free(&parts);
+    AIL_BENCH_PROFILE_END(Split_Join_1);
+
+    AIL_BENCH_PROFILE_MEM_START(Replace_Chained_6, tmpl.len);
+    AIL_Str cur = tmpl;
+    for (u32 i = 0; i < KEYS; i++) {
+        AIL_Str next = ail_str_replace(cur, from[i], to[i]);
+        if (i) ail_str_free(cur);
+        cur = next;
+    }
+    checksum += cur.len;
+    ail_str_free(cur);
+    AIL_BENCH_PROFILE_END(Replace_Chained_6);
+
+    AIL_MultiFind mf = ail_multifind_new(from, KEYS);
+    AIL_BENCH_PROFILE_MEM_START(Multifind_Replace_6, tmpl.len);
+    res = ail_multifind_replace(&mf, tmpl, to);
+    checksum += res.len;
+    ail_str_free(res);
+    AIL_BENCH_PROFILE_END(Multifind_Replace_6);
+    ail_multifind_free(&mf);
+
+    AIL_DA(AIL_Str) lines = ail_str_split_lines(tmpl, false);
+    AIL_BENCH_PROFILE_MEM_START(Join_Lines, tmpl.len);
+    res = ail_str_join_da(lines, ail_str_from_cstr("\r\n"));
+    checksum += res.len;
+    ail_str_free(res);
+    AIL_BENCH_PROFILE_END(Join_Lines);
+    ail_da_free(&lines);
+
+    ail_bench_end_and_print_profile(16, false);
+    printf("Checksum: %llu\n", (unsigned long long)checksum);
+    ail_call_free(ail_default_allocator, data);
+    return 0;
+}
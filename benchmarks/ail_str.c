@@ -0,0 +1,139 @@
+#define _GNU_SOURCE // For memmem
+#define AIL_BENCH_IMPL
+#define AIL_BENCH_PROFILE
+#include "../src/base/ail_alloc.h"
+#include "../src/base/ail_str.h"
+#include "../src/bench/ail_bench.h"
+#include "../src/math/ail_rand.h"
+#include <stdio.h>
+#include <string.h>
+#include <strings.h> // For strncasecmp
+#include <ctype.h>
+
+#define HAY_LEN AIL_MIL(32ULL)
+
+static u64 checksum;
+
+// Fills `hay` with lines of lowercase words, which looks roughly like a log file to the search
+static void fill_log(u8 *hay, u64 len)
+{
+    for (u64 i = 0; i < len; i++) {
+        u64 r = ail_rand_u64() % 64;
+        hay[i] = r < 52 ? 'a' + r % 26 : r < 63 ? ' ' : '\n';
+    }
+}
+
+// The needle isn't contained in the haystack, so that the whole haystack is searched
+static AIL_Str make_needle(u8 *needle, u32 needle_len)
+{
+    for (u32 i = 0; i < needle_len; i++) needle[i] = 'a' + ail_rand_u64() % 26;
+    needle[needle_len - 1] = '!';
+    return ail_str_from_parts(needle, needle_len);
+}
+
+#define BENCH_NEEDLE(hay, n) do {                                              \
+        u8 needle[n];                                                          \
+        AIL_Str s = make_needle(needle, n);                                    \
+        AIL_BENCH_PROFILE_MEM_START(Find_##n, (hay).len);                      \
+        checksum += ail_str_find(hay, s);                                      \
+        AIL_BENCH_PROFILE_END(Find_##n);                                       \
+        AIL_BENCH_PROFILE_MEM_START(Find_Last_##n, (hay).len);                 \
+        checksum += ail_str_find_last(hay, s);                                 \
+        AIL_BENCH_PROFILE_END(Find_Last_##n);                                  \
+        AIL_BENCH_PROFILE_MEM_START(Memmem_##n, (hay).len);                    \
+        checksum += (u64)memmem((hay).data, (hay).len, needle, n);             \
+        AIL_BENCH_PROFILE_END(Memmem_##n);                                     \
+    } while(0)
+
+int main(void)
+{
+    ail_default_allocator = ail_alloc_std;
+    u8 *data = ail_call_alloc(ail_default_allocator, HAY_LEN);
+    fill_log(data, HAY_LEN);
+    AIL_Str hay = ail_str_from_parts(data, HAY_LEN);
+
+    ail_bench_init();
+    ail_bench_begin_profile();
+
+    AIL_BENCH_PROFILE_MEM_START(Find_Char, HAY_LEN);
+    checksum += ail_str_find_char(hay, '!');
+    AIL_BENCH_PROFILE_END(Find_Char);
+
+    AIL_BENCH_PROFILE_MEM_START(Memchr, HAY_LEN);
+    checksum += (u64)memchr(data, '!', HAY_LEN);
+    AIL_BENCH_PROFILE_END(Memchr);
+
+    BENCH_NEEDLE(hay, 2);
+    BENCH_NEEDLE(hay, 4);
+    BENCH_NEEDLE(hay, 16);
+    BENCH_NEEDLE(hay, 64);
+    BENCH_NEEDLE(hay, 512);
+
+    AIL_BENCH_PROFILE_MEM_START(Split_Iter_Lines, HAY_LEN);
+    AIL_Str_Split_Iter lines = ail_str_split_iter_lines(hay, false);
+    ail_str_split_for_each(&lines, line) checksum += line.len;
+    AIL_BENCH_PROFILE_END(Split_Iter_Lines);
+
+    AIL_BENCH_PROFILE_MEM_START(Split_Iter_Words, HAY_LEN);
+    AIL_Str_Split_Iter words = ail_str_split_iter_whitespace(hay, true);
+    ail_str_split_for_each(&words, word) checksum += word.len;
+    AIL_BENCH_PROFILE_END(Split_Iter_Words);
+
+    AIL_BENCH_PROFILE_MEM_START(Split_Next_Line, HAY_LEN);
+    for (AIL_Str rest = hay; rest.len;) checksum += ail_str_split_next_line(&rest, false).len;
+    AIL_BENCH_PROFILE_END(Split_Next_Line);
+
+    AIL_BENCH_PROFILE_MEM_START(Split_Lines_Greedy, HAY_LEN);
+    AIL_DA(AIL_Str) all_lines = ail_str_split_lines(hay, false);
+    for (u64 i = 0; i < all_lines.len; i++) checksum += all_lines.data[i].len;
+    ail_da_free(&all_lines);
+    AIL_BENCH_PROFILE_END(Split_Lines_Greedy);
+
+    u8 *copy = ail_call_alloc(ail_default_allocator, HAY_LEN);
+    AIL_BENCH_PROFILE_MEM_START(To_Upper, HAY_LEN);
+    checksum += ail_str_to_upper(hay, copy).data[HAY_LEN/2];
+    AIL_BENCH_PROFILE_END(To_Upper);
+
+    AIL_BENCH_PROFILE_MEM_START(To_Upper_Scalar, HAY_LEN);
+    for (u64 i = 0; i < HAY_LEN; i++) copy[i] = (u8)toupper(data[i]);
+    checksum += copy[HAY_LEN/2];
+    AIL_BENCH_PROFILE_END(To_Upper_Scalar);
+
+    AIL_BENCH_PROFILE_MEM_START(Eq_Nocase, HAY_LEN);
+    checksum += ail_str_eq_nocase(hay, ail_str_from_parts(copy, HAY_LEN));
+    AIL_BENCH_PROFILE_END(Eq_Nocase);
+
+    AIL_BENCH_PROFILE_MEM_START(Strncasecmp, HAY_LEN);
+    checksum += (u64)strncasecmp((char *)data, (char *)copy, HAY_LEN);
+    AIL_BENCH_PROFILE_END(Strncasecmp);
+
+    AIL_BENCH_PROFILE_MEM_START(Hash_Nocase, HAY_LEN);
+    checksum += ail_str_hash_nocase(hay);
+    AIL_BENCH_PROFILE_END(Hash_Nocase);
+
+    memset(copy, ' ', HAY_LEN);
+    copy[HAY_LEN/2] = 'x';
+    AIL_BENCH_PROFILE_MEM_START(Trim, HAY_LEN);
+    checksum += ail_str_trim(ail_str_from_parts(copy, HAY_LEN)).len;
+    AIL_BENCH_PROFILE_END(Trim);
+    ail_call_free(ail_default_allocator, copy);
+
+    // Worst case for the SIMD filter, where every position is a candidate
+    u8 needle[64];
+    memset(data, 'a', HAY_LEN);
+    memset(needle, 'a', sizeof(needle));
+    needle[sizeof(needle)/2] = 'b';
+
+    AIL_BENCH_PROFILE_MEM_START(Find_Worst_Case, HAY_LEN);
+    checksum += ail_str_find(hay, ail_str_from_parts(needle, sizeof(needle)));
+    AIL_BENCH_PROFILE_END(Find_Worst_Case);
+
+    AIL_BENCH_PROFILE_MEM_START(Memmem_Worst_Case, HAY_LEN);
+    checksum += (u64)memmem(data, HAY_LEN, needle, sizeof(needle));
+    AIL_BENCH_PROFILE_END(Memmem_Worst_Case);
+
+    ail_bench_end_and_print_profile(16, false);
+    printf("Checksum: %llu\n", (unsigned long long)checksum);
+    ail_call_free(ail_default_allocator, data);
+    return 0;
+}
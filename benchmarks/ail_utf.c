@@ -0,0 +1,109 @@
+#define AIL_BENCH_IMPL
+#define AIL_BENCH_PROFILE
+#include "../src/base/ail_alloc.h"
+#include "../src/base/ail_str.h"
+#include "../src/bench/ail_bench.h"
+#include "../src/math/ail_rand.h"
+#include <stdio.h>
+
+#define TEXT_LEN AIL_MIL(32ULL)
+
+static u64 checksum;
+
+// Fills `buf` with about `len` bytes of UTF-8, where `non_ascii` out of 64 characters are not ASCII
+// The non-ASCII characters are mostly 2- and 3-byte characters with the occasional emoji
+static AIL_Str8 fill_text(u8 *buf, u64 len, u32 non_ascii)
+{
+    u64 i = 0;
+    while (i + 4 <= len) {
+        u64 r  = ail_rand_u64();
+        u32 cp = r % 64 < non_ascii ? ((r >> 8) % 16 == 0 ? 0x1F600 + (r >> 16) % 80 : (r >> 8) % 2 ? 0xC0 + (r >> 16) % 0x100 : 0x4E00 + (r >> 16) % 0x5000) : 'a' + (r >> 8) % 26;
+        if (cp < 0x80) {
+            buf[i++] = (u8)cp;
+        } else if (cp < 0x800) {
+            buf[i++] = (u8)(0xC0 | (cp >> 6));
+            buf[i++] = (u8)(0x80 | (cp & 0x3F));
+        } else if (cp < 0x10000) {
+            buf[i++] = (u8)(0xE0 | (cp >> 12));
+            buf[i++] = (u8)(0x80 | ((cp >> 6) & 0x3F));
+            buf[i++] = (u8)(0x80 | (cp & 0x3F));
+        } else {
+            buf[i++] = (u8)(0xF0 | (cp >> 18));
+            buf[i++] = (u8)(0x80 | ((cp >> 12) & 0x3F));
+            buf[i++] = (u8)(0x80 | ((cp >> 6) & 0x3F));
+            buf[i++] = (u8)(0x80 | (cp & 0x3F));
+        }
+    }
+    return ail_str_from_parts(buf, i);
+}
+
+// The conversions write into preallocated buffers, so that page faults on fresh allocations aren't measured
+#define BENCH_TEXT(name, non_ascii) do {                                                                   \
+        AIL_Str8 s8 = fill_text(text, TEXT_LEN, non_ascii);                                                \
+        AIL_BENCH_PROFILE_MEM_START(Validate_##name, s8.len);                                              \
+        checksum += ail_str8_is_valid_utf8(s8);                                                            \
+        AIL_BENCH_PROFILE_END(Validate_##name);                                                            \
+        u64 i = 0;                                                                                         \
+        AIL_BENCH_PROFILE_MEM_START(Validate_Scalar_##name, s8.len);                                       \
+        checksum += _ail_utf8_validate_scalar_(s8.data, s8.len, &i, s8.len);                               \
+        AIL_BENCH_PROFILE_END(Validate_Scalar_##name);                                                     \
+        AIL_BENCH_PROFILE_MEM_START(Utf16_Len_##name, s8.len);                                             \
+        checksum += ail_str16_len_from_str8(s8);                                                           \
+        AIL_BENCH_PROFILE_END(Utf16_Len_##name);                                                           \
+        AIL_BENCH_PROFILE_MEM_START(Utf8_To_Utf16_##name, s8.len);                                         \
+        AIL_Str16 s16 = ail_str16_from_str8(s8, buf16);                                                    \
+        AIL_BENCH_PROFILE_END(Utf8_To_Utf16_##name);                                                       \
+        AIL_BENCH_PROFILE_MEM_START(Utf8_To_Utf32_##name, s8.len);                                         \
+        AIL_Str32 s32 = ail_str32_from_str8(s8, buf32);                                                    \
+        AIL_BENCH_PROFILE_END(Utf8_To_Utf32_##name);                                                       \
+        AIL_BENCH_PROFILE_MEM_START(Utf16_Validate_##name, 2*s16.len);                                     \
+        checksum += ail_str16_is_valid_utf16(s16);                                                         \
+        AIL_BENCH_PROFILE_END(Utf16_Validate_##name);                                                      \
+        AIL_BENCH_PROFILE_MEM_START(Utf16_To_Utf8_##name, 2*s16.len);                                      \
+        checksum += ail_str8_from_str16(s16, buf8).len;                                                    \
+        AIL_BENCH_PROFILE_END(Utf16_To_Utf8_##name);                                                       \
+        AIL_BENCH_PROFILE_MEM_START(Utf16_To_Utf32_##name, 2*s16.len);                                     \
+        checksum += ail_str32_from_str16(s16, buf32).len;                                                  \
+        AIL_BENCH_PROFILE_END(Utf16_To_Utf32_##name);                                                      \
+        AIL_BENCH_PROFILE_MEM_START(Utf32_To_Utf8_##name, 4*s32.len);                                      \
+        checksum += ail_str8_from_str32(s32, buf8).len;                                                    \
+        AIL_BENCH_PROFILE_END(Utf32_To_Utf8_##name);                                                       \
+        AIL_BENCH_PROFILE_MEM_START(Utf32_To_Utf16_##name, 4*s32.len);                                     \
+        checksum += ail_str16_from_str32(s32, buf16).len;                                                  \
+        AIL_BENCH_PROFILE_END(Utf32_To_Utf16_##name);                                                      \
+        /* Validating, measuring, allocating and converting all at once */                                 \
+        AIL_BENCH_PROFILE_MEM_START(New_Utf16_From_Utf8_##name, s8.len);                                   \
+        AIL_Str16 n16 = ail_str16_new_str8(s8);                                                            \
+        AIL_BENCH_PROFILE_END(New_Utf16_From_Utf8_##name);                                                 \
+        checksum += n16.len;                                                                               \
+        ail_str_free(n16);                                                                                 \
+    } while(0)
+
+int main(void)
+{
+    ail_default_allocator = ail_alloc_std;
+    u8  *text  = ail_call_alloc(ail_default_allocator, TEXT_LEN);
+    u8  *buf8  = ail_call_alloc(ail_default_allocator, TEXT_LEN);
+    u16 *buf16 = ail_call_alloc(ail_default_allocator, TEXT_LEN*sizeof(u16));
+    u32 *buf32 = ail_call_alloc(ail_default_allocator, TEXT_LEN*sizeof(u32));
+    // Touch all buffers once, so that no page faults happen during the benchmark
+    ail_mem_set(buf8,  0, TEXT_LEN);
+    ail_mem_set(buf16, 0, TEXT_LEN*sizeof(u16));
+    ail_mem_set(buf32, 0, TEXT_LEN*sizeof(u32));
+
+    ail_bench_init();
+    ail_bench_begin_profile();
+
+    BENCH_TEXT(Ascii, 0);
+    BENCH_TEXT(Latin, 4);
+    BENCH_TEXT(Mixed, 24);
+    BENCH_TEXT(Cjk,   64);
+
+    ail_bench_end_and_print_profile(16, false);
+    printf("Checksum: %llu\n", (unsigned long long)checksum);
+    ail_call_free(ail_default_allocator, text);
+    ail_call_free(ail_default_allocator, buf8);
+    ail_call_free(ail_default_allocator, buf16);
+    ail_call_free(ail_default_allocator, buf32);
+    return 0;
+}
@@ -209,6 +209,9 @@ AIL_WARN_DISABLE(AIL_WARN_ALL)
 AIL_WARN_POP
 #else
 #include <sys/mman.h> // For mmap, munmap
+#ifndef MAP_ANONYMOUS
+#   define MAP_ANONYMOUS MAP_ANON
+#endif
 #endif
 
 // For tracing memory
@@ -456,7 +459,7 @@ void* _ail_alloc_page_internal_alloc_(void *addr, u64 size)
 #if defined(_WIN32)
     void *ptr = VirtualAlloc(addr, size, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
 #else
-    void *ptr = mmap(addr, size, PROT_READ|PROT_WRITE, MAP_PRIVATE|MAP_ANON, -1, 0);
+    void *ptr = mmap(addr, size, PROT_READ|PROT_WRITE, MAP_PRIVATE|MAP_ANONYMOUS, -1, 0);
 #endif
     ((AIL_Alloc_Page_Header *)ptr)->size = aligned_size - header_size;
     return (u8 *)ptr + header_size;
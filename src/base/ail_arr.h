@@ -11,6 +11,12 @@
   * DA: "Dynamic Array"
     * Contains a pointer, length, capacity and allocator, so it can be dynamically resized
     * Can be used like a Vector in C++
+  * SOA: "Struct of Arrays"
+    * Contains one pointer per field of a struct, as well as a shared length, capacity and allocator
+    * All fields are stored in a single allocation, with each field's array aligned to AIL_SOA_ALIGNMENT bytes
+    * Created via `AIL_SOA_INIT(name, FIELDS)`, where FIELDS is an X-Macro listing all fields, i.e.:
+      `#define PARTICLE_FIELDS(X) X(AIL_Vec2f32, pos) X(AIL_Vec2f32, vel) X(f32, life)`
+      `AIL_SOA_INIT(Particle, PARTICLE_FIELDS);`
 *
 */
 
@@ -20,6 +26,7 @@
 #include "./ail_base.h"
 #include "./ail_base_math.h"
 #include "./ail_mem.h"
+#include <stddef.h> // For offsetof
 
 AIL_WARN_PUSH
 AIL_WARN_DISABLE(AIL_WARN_UNUSED_FUNCTION)
@@ -28,6 +35,22 @@ AIL_WARN_DISABLE(AIL_WARN_UNUSED_FUNCTION)
 #   define AIL_ARR_INIT_CAP 256
 #endif
 
+#ifndef AIL_SOA_ALIGNMENT
+#   define AIL_SOA_ALIGNMENT 64
+#endif
+ail_static_assert(ail_is_2power_pos(AIL_SOA_ALIGNMENT), "AIL_SOA_ALIGNMENT must be a power of 2");
+
+// Growth policy shared by all resizable arrays: capacity is doubled unless more space is required immediately
+#define ail_arr_grow_cap(cap, len, n) ail_max(2*(cap), (len) + (n))
+
+// Describes the fields of an SOA, which is necessary to operate on all its fields at once
+typedef struct AIL_SOA_Layout {
+    u32        count;      // Amount of fields
+    u32        el_size;    // Size of the element-struct (AIL_SOA_EL)
+    const u32 *sizes;      // Size of each field's type
+    const u32 *el_offsets; // Offset of each field in the element-struct
+} AIL_SOA_Layout;
+
 inline_func void* ail_arr_copy(void *src, u64 size, AIL_Allocator allocator);
 inline_func void ail_arr_setn(void *data, u64 el_size, u64 idx, void *elems, u64 n);
 inline_func void ail_arr_resize(void **data, u64 *cap, u64 *len, u64 el_size, u64 new_cap, AIL_Allocator allocator);
@@ -39,6 +62,12 @@ inline_func void ail_arr_grow_with_gap(void **data, u64 *cap, u64 *len, u64 el_s
 inline_func void ail_arr_maybe_grow_with_gap(void **data, u64 *cap, u64 *len, u64 el_size, u64 gap_start, u64 gap_len, AIL_Allocator allocator);
 inline_func void ail_arr_insertn(void **data, u64 *cap, u64 *len, u64 el_size, u64 idx, void *elems, u64 n, AIL_Allocator al);
 inline_func void ail_arr_rm(void *data, u64 *len, u64 el_size, u64 idx, u64 n);
+inline_func void ail_arr_soa_resize(void **fields, void **mem, u64 *cap, u64 *len, const AIL_SOA_Layout *layout, u64 new_cap, AIL_Allocator allocator);
+inline_func void ail_arr_soa_maybe_grow(void **fields, void **mem, u64 *cap, u64 *len, const AIL_SOA_Layout *layout, u64 n, AIL_Allocator allocator);
+inline_func void ail_arr_soa_set(void **fields, const AIL_SOA_Layout *layout, u64 idx, void *el, u64 el_size);
+inline_func void ail_arr_soa_get(void **fields, const AIL_SOA_Layout *layout, u64 idx, void *el, u64 el_size);
+inline_func void ail_arr_soa_rm(void **fields, u64 *len, const AIL_SOA_Layout *layout, u64 idx, u64 n);
+inline_func void ail_arr_soa_rm_swap(void **fields, u64 *len, const AIL_SOA_Layout *layout, u64 idx);
 
 #define AIL_SA_INIT(T) typedef struct AIL_SA_##T { T *data; u64 len; } AIL_SA_##T
 #define AIL_SA(T) AIL_SA_##T
@@ -178,7 +207,7 @@ AIL_SA_INIT(char);  AIL_CA_INIT(char);  AIL_DA_INIT(char);
 
 
 #define ail_ca_maybe_push(caPtr, elem) do {                                 \
-    if ((caPtr)->len < (caPtr)->cap) (caPtr)->data[(caPtr)->len++] = (elem) \
+    if ((caPtr)->len < (caPtr)->cap) (caPtr)->data[(caPtr)->len++] = (elem);\
     } while(0)
 #define ail_da_maybe_push(daPtr, elem) ail_ca_maybe_push(daPtr, elem)
 
@@ -200,7 +229,7 @@ AIL_SA_INIT(char);  AIL_CA_INIT(char);  AIL_DA_INIT(char);
 #define ail_da_grow_with_gap(daPtr, gap_start, gap_len, new_cap)       ail_ca_grow_with_gap(daPtr, gap_start, gap_len, new_cap, (daPtr)->allocator)
 #define ail_da_grow_with_gap_a(daPtr, gap_start, gap_len, new_cap, al) ail_da_grow_with_gap(daPtr, gap_start, gap_len, new_cap, al)
 
-#define ail_ca_maybe_grow_with_gap(caPtr, idx, n, al)   ail_arr_maybe_grow_with_gap(ail_field_ptr_of(caPtr, data), ail_field_ptr_of(caPtr, cap), ail_field_ptr_of(caPtr, len), sizeof((caPtr)->data[0]), idx, (idx) + (n), al)
+#define ail_ca_maybe_grow_with_gap(caPtr, idx, n, al)   ail_arr_maybe_grow_with_gap(ail_field_ptr_of(caPtr, data), ail_field_ptr_of(caPtr, cap), ail_field_ptr_of(caPtr, len), sizeof((caPtr)->data[0]), idx, n, al)
 #define ail_da_maybe_grow_with_gap(daPtr, idx, n)       ail_ca_maybe_grow_with_gap(daPtr, idx, n, (daPtr)->allocator)
 #define ail_da_maybe_grow_with_gap_a(daPtr, idx, n, al) ail_ca_maybe_grow_with_gap(daPtr, idx, n, al)
 
@@ -217,16 +246,84 @@ AIL_SA_INIT(char);  AIL_CA_INIT(char);  AIL_DA_INIT(char);
 
 // @TODO: Add ail_da_shrink & ail_da_maybe_shrink
 
-#define ail_ca_rm(caPtr, idx) ail_arr_rm(ail_field_ptr_of(caPtr, data), ail_field_ptr_of(caPtr, len), sizeof((caPtr)->data[0]), idx, 1)
+#define ail_ca_rm(caPtr, idx) ail_arr_rm((caPtr)->data, ail_field_ptr_of(caPtr, len), sizeof((caPtr)->data[0]), idx, 1)
 #define ail_da_rm(daPtr, idx) ail_ca_rm(daPtr, idx)
 
-#define ail_ca_rmn(caPtr, idx, n) ail_arr_rm(ail_field_ptr_of(caPtr, data), ail_field_ptr_of(caPtr, len), sizeof((caPtr)->data[0]), idx, n)
-#define ail_da_rmn(daPtr, idx) ail_ca_rmn(daPtr, idx)
+#define ail_ca_rmn(caPtr, idx, n) ail_arr_rm((caPtr)->data, ail_field_ptr_of(caPtr, len), sizeof((caPtr)->data[0]), idx, n)
+#define ail_da_rmn(daPtr, idx, n) ail_ca_rmn(daPtr, idx, n)
 
 #define ail_ca_rm_swap(caPtr, idx) ((caPtr)->data[(idx)] = (caPtr)->data[--(caPtr)->len])
 #define ail_da_rm_swap(daPtr, idx) ail_ca_rm_swap(daPtr, idx)
 
 
+#define _AIL_SOA_FIELD_ONE_(T, name)       +1
+#define _AIL_SOA_FIELD_PTR_(T, name)       T *name;
+#define _AIL_SOA_FIELD_VAL_(T, name)       T name;
+#define _AIL_SOA_FIELD_SIZE_(T, name)      sizeof(T),
+#define _AIL_SOA_FIELD_EL_OFFSET_(T, name) offsetof(_ail_soa_el_t_, name),
+// @Note: AIL_SOA_EL(name) is a regular struct containing a single value for each field and is used to set/get a whole row at once
+#define AIL_SOA_INIT(name, FIELDS)                                                                                                          \
+    typedef struct AIL_SOA_EL_##name { FIELDS(_AIL_SOA_FIELD_VAL_) } AIL_SOA_EL_##name;                                                     \
+    inline_func const AIL_SOA_Layout *_ail_soa_layout_##name(void) {                                                                        \
+        typedef AIL_SOA_EL_##name _ail_soa_el_t_;                                                                                           \
+        persist const u32 sizes[]      = { FIELDS(_AIL_SOA_FIELD_SIZE_) };                                                                  \
+        persist const u32 el_offsets[] = { FIELDS(_AIL_SOA_FIELD_EL_OFFSET_) };                                                             \
+        persist const AIL_SOA_Layout layout = { .count = ail_arrlen(sizes), .el_size = sizeof(_ail_soa_el_t_), .sizes = sizes, .el_offsets = el_offsets }; \
+        return &layout;                                                                                                                     \
+    }                                                                                                                                       \
+    typedef struct AIL_SOA_##name {                                                                                                         \
+        union {                                                                                                                             \
+            struct { FIELDS(_AIL_SOA_FIELD_PTR_) };                                                                                         \
+            void *_fields[0 FIELDS(_AIL_SOA_FIELD_ONE_)];                                                                                   \
+        };                                                                                                                                  \
+        void *mem;                                                                                                                          \
+        u64   len;                                                                                                                          \
+        u64   cap;                                                                                                                          \
+        const AIL_SOA_Layout *layout;                                                                                                       \
+        AIL_Allocator allocator;                                                                                                            \
+    } AIL_SOA_##name
+#define AIL_SOA(name)    AIL_SOA_##name
+#define AIL_SOA_EL(name) AIL_SOA_EL_##name
+
+#define ail_soa_empty(name)                ail_soa_empty_with_alloc(name, ail_default_allocator)
+#define ail_soa_empty_with_alloc(name, al) { .mem = NULL, .len = 0, .cap = 0, .layout = _ail_soa_layout_##name(), .allocator = (al) }
+#define ail_soa_empty_t(name)                (AIL_SOA(name))ail_soa_empty(name)
+#define ail_soa_empty_with_alloc_t(name, al) (AIL_SOA(name))ail_soa_empty_with_alloc(name, al)
+
+#define ail_soa_free(soaPtr)     ail_soa_free_a(soaPtr, (soaPtr)->allocator)
+#define ail_soa_free_a(soaPtr, al) do {                                                            \
+        if ((soaPtr)->mem) ail_call_free((al), (soaPtr)->mem);                                    \
+        for (u32 _ail_soa_i_ = 0; _ail_soa_i_ < (soaPtr)->layout->count; _ail_soa_i_++) {         \
+            (soaPtr)->_fields[_ail_soa_i_] = NULL;                                                \
+        }                                                                                         \
+        (soaPtr)->mem = NULL; (soaPtr)->len = 0; (soaPtr)->cap = 0;                               \
+    } while(0)
+
+#define ail_soa_resize(soaPtr, new_cap)       ail_soa_resize_a(soaPtr, new_cap, (soaPtr)->allocator)
+#define ail_soa_resize_a(soaPtr, new_cap, al) ail_arr_soa_resize((soaPtr)->_fields, ail_field_ptr_of(soaPtr, mem), ail_field_ptr_of(soaPtr, cap), ail_field_ptr_of(soaPtr, len), (soaPtr)->layout, new_cap, al)
+
+#define ail_soa_maybe_grow(soaPtr, n)       ail_soa_maybe_grow_a(soaPtr, n, (soaPtr)->allocator)
+#define ail_soa_maybe_grow_a(soaPtr, n, al) ail_arr_soa_maybe_grow((soaPtr)->_fields, ail_field_ptr_of(soaPtr, mem), ail_field_ptr_of(soaPtr, cap), ail_field_ptr_of(soaPtr, len), (soaPtr)->layout, n, al)
+
+// @Note: `el` needs to be an lvalue of type AIL_SOA_EL(name) (i.e. a variable or a compound literal)
+#define ail_soa_set(soaPtr, idx, el)    ail_arr_soa_set((soaPtr)->_fields, (soaPtr)->layout, idx, &(el), sizeof(el))
+#define ail_soa_get(soaPtr, idx, elPtr) ail_arr_soa_get((soaPtr)->_fields, (soaPtr)->layout, idx, elPtr, sizeof(*(elPtr)))
+
+#define ail_soa_push(soaPtr, el)       ail_soa_push_a(soaPtr, el, (soaPtr)->allocator)
+#define ail_soa_push_a(soaPtr, el, al) do {          \
+        ail_soa_maybe_grow_a(soaPtr, 1, (al));       \
+        ail_soa_set(soaPtr, (soaPtr)->len, el);      \
+        (soaPtr)->len++;                             \
+    } while(0)
+
+#define ail_soa_rm(soaPtr, idx)      ail_arr_soa_rm((soaPtr)->_fields, ail_field_ptr_of(soaPtr, len), (soaPtr)->layout, idx, 1)
+#define ail_soa_rmn(soaPtr, idx, n)  ail_arr_soa_rm((soaPtr)->_fields, ail_field_ptr_of(soaPtr, len), (soaPtr)->layout, idx, n)
+#define ail_soa_rm_swap(soaPtr, idx) ail_arr_soa_rm_swap((soaPtr)->_fields, ail_field_ptr_of(soaPtr, len), (soaPtr)->layout, idx)
+
+// Get the array of a single field with the compiler knowing about its alignment, which helps it vectorize loops over the field
+#define ail_soa_field(soaPtr, field) ail_assume_aligned((soaPtr)->field, AIL_SOA_ALIGNMENT)
+
+
 AIL_WARN_POP
 
 #endif // _AIL_ARR_H_
@@ -260,7 +357,7 @@ void ail_arr_resize(void **data, u64 *cap, u64 *len, u64 el_size, u64 new_cap, A
 void ail_arr_maybe_grow(void **data, u64 *cap, u64 *len, u64 el_size, u64 n, AIL_Allocator allocator)
 {
     if (*len + n > *cap) {
-        ail_arr_resize(data, cap, len, el_size, ail_max(2*(*cap), *len + n), allocator);
+        ail_arr_resize(data, cap, len, el_size, ail_arr_grow_cap(*cap, *len, n), allocator);
     }
 }
 
@@ -274,7 +371,7 @@ void ail_arr_maybe_pushn(void **data, u64 cap, u64 *len, u64 el_size, void *elem
 void ail_arr_pushn(void **data, u64 *cap, u64 *len, u64 el_size, void *elems, u64 n, AIL_Allocator allocator)
 {
     ail_arr_maybe_grow(data, cap, len, el_size, n, allocator);
-    ail_mem_copy((u8*)*data + *len, elems, el_size * n);
+    ail_mem_copy((u8*)*data + el_size*(*len), elems, el_size * n);
     *len += n;
 }
 
@@ -294,7 +391,7 @@ void ail_arr_grow_with_gap(void **data, u64 *cap, u64 *len, u64 el_size, u64 new
 void ail_arr_maybe_grow_with_gap(void **data, u64 *cap, u64 *len, u64 el_size, u64 gap_start, u64 gap_len, AIL_Allocator allocator)
 {
     if (*len + gap_len > *cap) {
-        ail_arr_grow_with_gap(data, cap, len, el_size, ail_max(*len + gap_len, 2*(*cap)), gap_start, gap_len, allocator);
+        ail_arr_grow_with_gap(data, cap, len, el_size, ail_arr_grow_cap(*cap, *len, gap_len), gap_start, gap_len, allocator);
     } else {
         ail_arr_push_right(*data, len, el_size, gap_start + gap_len, gap_start);
     }
@@ -313,6 +410,76 @@ void ail_arr_rm(void *data, u64 *len, u64 el_size, u64 idx, u64 n)
     *len -= n;
 }
 
+#define _ail_soa_align_forward(x) (((x) + (AIL_SOA_ALIGNMENT - 1)) & ~(u64)(AIL_SOA_ALIGNMENT - 1))
+
+void ail_arr_soa_resize(void **fields, void **mem, u64 *cap, u64 *len, const AIL_SOA_Layout *layout, u64 new_cap, AIL_Allocator allocator)
+{
+    // @Note: All fields live in a single allocation, so that growing only requires a single call to the allocator.
+    // The extra AIL_SOA_ALIGNMENT bytes allow aligning the first field, since allocators only guarantee smaller alignments
+    u8 *new_mem = NULL;
+    u8 *p       = NULL;
+    if (new_cap) {
+        u64 size = AIL_SOA_ALIGNMENT;
+        for (u32 i = 0; i < layout->count; i++) size += _ail_soa_align_forward(layout->sizes[i]*new_cap);
+        new_mem = ail_call_alloc(allocator, size);
+        p       = (u8*)ail_ptr_from_int(_ail_soa_align_forward(ail_int_from_ptr(new_mem)));
+    }
+    u64 keep = ail_min(*len, new_cap);
+    for (u32 i = 0; i < layout->count; i++) {
+        if (keep) ail_mem_copy(p, fields[i], layout->sizes[i]*keep);
+        fields[i] = p;
+        if (p) p += _ail_soa_align_forward(layout->sizes[i]*new_cap);
+    }
+    if (*mem) ail_call_free(allocator, *mem);
+    *mem = new_mem;
+    *cap = new_cap;
+    *len = keep;
+}
+
+void ail_arr_soa_maybe_grow(void **fields, void **mem, u64 *cap, u64 *len, const AIL_SOA_Layout *layout, u64 n, AIL_Allocator allocator)
+{
+    if (*len + n > *cap) {
+        ail_arr_soa_resize(fields, mem, cap, len, layout, ail_arr_grow_cap(*cap, *len, n), allocator);
+    }
+}
+
+void ail_arr_soa_set(void **fields, const AIL_SOA_Layout *layout, u64 idx, void *el, u64 el_size)
+{
+    ail_assert(el_size == layout->el_size, "Element needs to be of type AIL_SOA_EL(<name>)");
+    for (u32 i = 0; i < layout->count; i++) {
+        u64 size = layout->sizes[i];
+        ail_mem_copy((u8*)fields[i] + size*idx, (u8*)el + layout->el_offsets[i], size);
+    }
+}
+
+void ail_arr_soa_get(void **fields, const AIL_SOA_Layout *layout, u64 idx, void *el, u64 el_size)
+{
+    ail_assert(el_size == layout->el_size, "Element needs to be of type AIL_SOA_EL(<name>)");
+    for (u32 i = 0; i < layout->count; i++) {
+        u64 size = layout->sizes[i];
+        ail_mem_copy((u8*)el + layout->el_offsets[i], (u8*)fields[i] + size*idx, size);
+    }
+}
+
+void ail_arr_soa_rm(void **fields, u64 *len, const AIL_SOA_Layout *layout, u64 idx, u64 n)
+{
+    u64 j = idx + n;
+    for (u32 i = 0; i < layout->count; i++) {
+        u64 size = layout->sizes[i];
+        ail_mem_copy((u8*)fields[i] + size*idx, (u8*)fields[i] + size*j, size*(*len - j));
+    }
+    *len -= n;
+}
+
+void ail_arr_soa_rm_swap(void **fields, u64 *len, const AIL_SOA_Layout *layout, u64 idx)
+{
+    u64 last = --(*len);
+    for (u32 i = 0; i < layout->count; i++) {
+        u64 size = layout->sizes[i];
+        ail_mem_copy((u8*)fields[i] + size*idx, (u8*)fields[i] + size*last, size);
+    }
+}
+
 AIL_WARN_POP
 #endif // _AIL_ARR_IMPL_GUARD_
 #endif // AL_NO_ARR_IMPL
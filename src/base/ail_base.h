@@ -119,6 +119,12 @@
 #ifndef _AIL_BASE_H_
 #define _AIL_BASE_H_
 
+// glibc hides some of the POSIX and BSD extensions used by this library (e.g. MAP_ANONYMOUS or DT_REG) when compiling with strict flags like -std=c99
+// @Important: This only has an effect, if an ail header is included before any system header
+#if !defined(_DEFAULT_SOURCE) && !defined(_GNU_SOURCE) && !defined(_POSIX_C_SOURCE) && !defined(_XOPEN_SOURCE)
+#   define _DEFAULT_SOURCE
+#endif
+
 #include <stdint.h>         // For sized integer types
 #include "./ail_platform.h" // For platform detection
 #include "./ail_warn.h"     // For generated WarnKinds
@@ -488,6 +494,14 @@ typedef char* pchar;
 #   define AIL_FLAG_ENUM
 #endif
 
+// ail_assume_aligned
+// @Note: Returns `ptr` as a void pointer, that the compiler may assume to be aligned to `align` bytes
+#if ail_has_builtin(__builtin_assume_aligned) || _AIL_VERSION_CHECK_(_AIL_VERSION_GCC_, 4, 7, 0)
+#   define ail_assume_aligned(ptr, align) __builtin_assume_aligned((ptr), (align))
+#else
+#   define ail_assume_aligned(ptr, align) ((void *)(ptr))
+#endif
+
 // ail_typeof
 #if AIL_LANG_C && AIL_LANG_STANDARD >= 2023
 #   define ail_typeof(x) typeof_unqual(x)
@@ -9,7 +9,14 @@
 #include "./ail_base_time.h"
 #include "./ail_endian.h"
 #include "./ail_arr.h"
+#include "./ail_heap.h"
+#include "./ail_bitset.h"
+#include "./ail_btree.h"
 #include "./ail_str.h"
+#include "./ail_csb.h"
+#include "./ail_gapbuf.h"
+#include "./ail_rope.h"
+#include "./ail_multifind.h"
 #include "./ail_fmt.h"
 #include "./ail_hm.h"
 #include "./ail_idxbuf.h"
@@ -9,6 +9,11 @@
   * ail_next_2power(x):         Get the next highest value above x that is a power of 2 (if x isn't already a power of 2)
   * ail_lerp(t, min, max):      Linearly interpolate between min and max
   * ail_inv_lerp(x, min, max):  Does the inverse of a linear interpolation, returning the interpolater, such that the following holds: ail_lerp(ail_inv_lerp(x, min, max), min, max) == x
+* The following functions are provided as well:
+  * ail_popcount_u64(x):        Count the set bits in x
+  * ail_ctz_u64(x):             Count the trailing zero bits in x (x must not be 0)
+  * ail_clz_u64(x):             Count the leading zero bits in x (x must not be 0)
+  * ail_mul_wide_u64(a, b, hi): Multiply a and b to a 128-bit result, returning its lower and storing its upper 64 bits in hi
 */
 
 #ifndef _AIL_BASE_MATH_H_
@@ -42,6 +47,73 @@ u64 ail_next_2power_u64(u64 x)
     return out;
 }
 
+#if AIL_COMP_MSVC
+#   include <intrin.h>
+#endif
+
+inline_func u32 ail_popcount_u64(u64 x)
+{
+#if ail_has_builtin(__builtin_popcountll) || AIL_COMP_GCC || AIL_COMP_CLANG
+    return (u32)__builtin_popcountll(x);
+#elif AIL_COMP_MSVC && AIL_ARCH_X86 && AIL_64BIT
+    return (u32)__popcnt64(x);
+#else
+    x = x - ((x >> 1) & 0x5555555555555555ULL);
+    x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+    x = (x + (x >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+    return (u32)((x * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+inline_func u32 ail_ctz_u64(u64 x)
+{
+#if ail_has_builtin(__builtin_ctzll) || AIL_COMP_GCC || AIL_COMP_CLANG
+    return (u32)__builtin_ctzll(x);
+#elif AIL_COMP_MSVC && AIL_64BIT
+    unsigned long idx;
+    _BitScanForward64(&idx, x);
+    return (u32)idx;
+#else
+    return ail_popcount_u64((x & -x) - 1);
+#endif
+}
+
+inline_func u32 ail_clz_u64(u64 x)
+{
+#if ail_has_builtin(__builtin_clzll) || AIL_COMP_GCC || AIL_COMP_CLANG
+    return (u32)__builtin_clzll(x);
+#elif AIL_COMP_MSVC && AIL_64BIT
+    unsigned long idx;
+    _BitScanReverse64(&idx, x);
+    return 63 - (u32)idx;
+#else
+    for (u32 shift = 1; shift < 64; shift += shift) x |= x >> shift;
+    return 64 - ail_popcount_u64(x);
+#endif
+}
+
+inline_func u64 ail_mul_wide_u64(u64 a, u64 b, u64 *hi)
+{
+#if (AIL_COMP_GCC || AIL_COMP_CLANG) && defined(__SIZEOF_INT128__)
+    __extension__ unsigned __int128 res = (unsigned __int128)a * b;
+    *hi = (u64)(res >> 64);
+    return (u64)res;
+#elif AIL_COMP_MSVC && AIL_ARCH_X86 && AIL_64BIT
+    return _umul128(a, b, hi);
+#elif AIL_COMP_MSVC && AIL_ARCH_ARM && AIL_64BIT
+    *hi = __umulh(a, b);
+    return a * b;
+#else
+    u64 lo_lo = (a & 0xffffffff) * (b & 0xffffffff);
+    u64 hi_lo = (a >> 32)        * (b & 0xffffffff);
+    u64 lo_hi = (a & 0xffffffff) * (b >> 32);
+    u64 hi_hi = (a >> 32)        * (b >> 32);
+    u64 cross = (lo_lo >> 32) + (hi_lo & 0xffffffff) + lo_hi;
+    *hi = (hi_lo >> 32) + (cross >> 32) + hi_hi;
+    return (cross << 32) | (lo_lo & 0xffffffff);
+#endif
+}
+
 // ail_lerp(ail_inv_lerp(x, min, max), min, max) = x
 #define ail_lerp(t, min, max) ((min) + (t)*((max) - (min)))
 #define ail_inv_lerp(x, min, max) (((f64)(x) - (f64)(min)) / ((f64)(max) - (f64)(min)))
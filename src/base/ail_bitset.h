@@ -0,0 +1,358 @@
+/*
+*** Bitset ***
+*
+* A fixed-size array of bits, stored in 64-bit words
+* Bulk operations, popcount and searching for set bits use SIMD instructions where available (see ail_simd.h)
+*
+* @Note: All bits past `len` in the last word are always kept cleared. Functions that write whole words (like `ail_bitset_set_all`)
+* take care to maintain this invariant, which allows all other functions to process whole words without masking the end
+*
+* A rank/select index (AIL_Bitset_Rank) can be built for a bitset, to answer the following questions in O(1) and O(log n) respectively:
+  * rank(pos): How many bits are set before position `pos`?
+  * select(k): What is the position of the k-th set bit?
+* The index stores the amount of set bits before every 512-bit block and needs to be rebuilt whenever the bitset changes
+*/
+
+#ifndef _AIL_BITSET_H_
+#define _AIL_BITSET_H_
+
+#include "ail_base.h"
+#include "ail_base_math.h"
+#include "ail_mem.h"
+#include "ail_simd.h"
+
+AIL_WARN_PUSH
+AIL_WARN_DISABLE(AIL_WARN_UNUSED_FUNCTION)
+
+typedef struct AIL_Bitset {
+    u64 *words;
+    u64  len; // Amount of bits
+} AIL_Bitset;
+
+typedef struct AIL_Bitset_Rank {
+    u64 *block_ranks; // block_ranks[i] is the amount of set bits in the first i blocks
+    u64  block_count;
+    u64  ones;        // Total amount of set bits
+} AIL_Bitset_Rank;
+
+#define AIL_BITSET_WORD_BITS  64
+#define AIL_BITSET_BLOCK_WORDS 8
+#define ail_bitset_word_count(bits) (((bits) + AIL_BITSET_WORD_BITS - 1)/AIL_BITSET_WORD_BITS)
+
+internal AIL_Bitset ail_bitset_from_parts(u64 *words, u64 len);
+internal AIL_Bitset ail_bitset_new(u64 len, AIL_Allocator allocator);
+internal void ail_bitset_free(AIL_Bitset *bs, AIL_Allocator allocator);
+
+inline_func void ail_bitset_set   (AIL_Bitset bs, u64 idx);
+inline_func void ail_bitset_clear (AIL_Bitset bs, u64 idx);
+inline_func void ail_bitset_toggle(AIL_Bitset bs, u64 idx);
+inline_func void ail_bitset_assign(AIL_Bitset bs, u64 idx, b32 val);
+inline_func b32  ail_bitset_test  (AIL_Bitset bs, u64 idx);
+internal void ail_bitset_set_all  (AIL_Bitset bs);
+internal void ail_bitset_clear_all(AIL_Bitset bs);
+
+// Bulk operations; all bitsets need to have the same length and `dst` may be the same as `a` or `b`
+internal void ail_bitset_and   (AIL_Bitset dst, AIL_Bitset a, AIL_Bitset b);
+internal void ail_bitset_or    (AIL_Bitset dst, AIL_Bitset a, AIL_Bitset b);
+internal void ail_bitset_xor   (AIL_Bitset dst, AIL_Bitset a, AIL_Bitset b);
+internal void ail_bitset_andnot(AIL_Bitset dst, AIL_Bitset a, AIL_Bitset b); // dst = a & ~b
+internal void ail_bitset_not   (AIL_Bitset dst, AIL_Bitset a);
+
+internal u64 ail_bitset_popcount(AIL_Bitset bs);
+// Returns the index of the first set/cleared bit at or after `from` or `bs.len` if no such bit exists
+internal u64 ail_bitset_find_next_set  (AIL_Bitset bs, u64 from);
+internal u64 ail_bitset_find_next_clear(AIL_Bitset bs, u64 from);
+
+internal AIL_Bitset_Rank ail_bitset_rank_new(AIL_Bitset bs, AIL_Allocator allocator);
+internal void ail_bitset_rank_free(AIL_Bitset_Rank *rank, AIL_Allocator allocator);
+// Returns the amount of set bits in the range [0, pos)
+internal u64 ail_bitset_rank(AIL_Bitset bs, AIL_Bitset_Rank rank, u64 pos);
+// Returns the index of the k-th (starting at 0) set bit or `bs.len` if less than k+1 bits are set
+internal u64 ail_bitset_select(AIL_Bitset bs, AIL_Bitset_Rank rank, u64 k);
+
+#define ail_bitset_for_each_set(bs, idx) for (u64 idx = ail_bitset_find_next_set(bs, 0); idx < (bs).len; idx = ail_bitset_find_next_set(bs, idx + 1))
+
+AIL_WARN_POP
+#endif // _AIL_BITSET_H_
+
+
+#if !defined(AIL_NO_BITSET_IMPL) && !defined(AIL_NO_BASE_IMPL) && !defined(AIL_NO_IMPL)
+#ifndef _AIL_BITSET_IMPL_GUARD_
+#define _AIL_BITSET_IMPL_GUARD_
+AIL_WARN_PUSH
+AIL_WARN_DISABLE(AIL_WARN_UNUSED_FUNCTION)
+
+#if AIL_SIMD_AVX2
+    typedef __m256i _AIL_Bitset_Vec_;
+#   define _AIL_BITSET_VEC_WORDS_ 4
+#   define _ail_bitset_vec_load_(p)      _mm256_loadu_si256((const __m256i *)(p))
+#   define _ail_bitset_vec_store_(p, v)  _mm256_storeu_si256((__m256i *)(p), (v))
+#   define _ail_bitset_vec_and_(a, b)    _mm256_and_si256((a), (b))
+#   define _ail_bitset_vec_or_(a, b)     _mm256_or_si256((a), (b))
+#   define _ail_bitset_vec_xor_(a, b)    _mm256_xor_si256((a), (b))
+#   define _ail_bitset_vec_andnot_(a, b) _mm256_andnot_si256((b), (a))
+#   define _ail_bitset_vec_is_zero_(v)   _mm256_testz_si256((v), (v))
+#elif AIL_SIMD_SSE2
+    typedef __m128i _AIL_Bitset_Vec_;
+#   define _AIL_BITSET_VEC_WORDS_ 2
+#   define _ail_bitset_vec_load_(p)      _mm_loadu_si128((const __m128i *)(p))
+#   define _ail_bitset_vec_store_(p, v)  _mm_storeu_si128((__m128i *)(p), (v))
+#   define _ail_bitset_vec_and_(a, b)    _mm_and_si128((a), (b))
+#   define _ail_bitset_vec_or_(a, b)     _mm_or_si128((a), (b))
+#   define _ail_bitset_vec_xor_(a, b)    _mm_xor_si128((a), (b))
+#   define _ail_bitset_vec_andnot_(a, b) _mm_andnot_si128((b), (a))
+#   define _ail_bitset_vec_is_zero_(v)   (_mm_movemask_epi8(_mm_cmpeq_epi8((v), _mm_setzero_si128())) == 0xffff)
+#elif AIL_SIMD_NEON
+    typedef uint64x2_t _AIL_Bitset_Vec_;
+#   define _AIL_BITSET_VEC_WORDS_ 2
+#   define _ail_bitset_vec_load_(p)      vld1q_u64(p)
+#   define _ail_bitset_vec_store_(p, v)  vst1q_u64((p), (v))
+#   define _ail_bitset_vec_and_(a, b)    vandq_u64((a), (b))
+#   define _ail_bitset_vec_or_(a, b)     vorrq_u64((a), (b))
+#   define _ail_bitset_vec_xor_(a, b)    veorq_u64((a), (b))
+#   define _ail_bitset_vec_andnot_(a, b) vbicq_u64((a), (b))
+#   define _ail_bitset_vec_is_zero_(v)   (vmaxvq_u32(vreinterpretq_u32_u64(v)) == 0)
+#endif
+
+#define _ail_bitset_word_and_(a, b)    ((a) & (b))
+#define _ail_bitset_word_or_(a, b)     ((a) | (b))
+#define _ail_bitset_word_xor_(a, b)    ((a) ^ (b))
+#define _ail_bitset_word_andnot_(a, b) ((a) & ~(b))
+
+#ifdef _AIL_BITSET_VEC_WORDS_
+#   define _AIL_BITSET_BULK_VEC_LOOP_(op) for (; i + _AIL_BITSET_VEC_WORDS_ <= n; i += _AIL_BITSET_VEC_WORDS_) {                        \
+        _ail_bitset_vec_store_(dst.words + i, _ail_bitset_vec_##op##_(_ail_bitset_vec_load_(a.words + i), _ail_bitset_vec_load_(b.words + i))); \
+    }
+#else
+#   define _AIL_BITSET_BULK_VEC_LOOP_(op)
+#endif
+
+#define _AIL_BITSET_BULK_OP_(op)                                                                              \
+    void ail_bitset_##op(AIL_Bitset dst, AIL_Bitset a, AIL_Bitset b)                                          \
+    {                                                                                                         \
+        ail_assert(dst.len == a.len && a.len == b.len, "Bulk operations require bitsets of the same length"); \
+        u64 n = ail_bitset_word_count(a.len);                                                                 \
+        u64 i = 0;                                                                                            \
+        _AIL_BITSET_BULK_VEC_LOOP_(op)                                                                        \
+        for (; i < n; i++) dst.words[i] = _ail_bitset_word_##op##_(a.words[i], b.words[i]);                   \
+    }
+
+inline_func u64 _ail_bitset_last_word_mask_(u64 len)
+{
+    u64 rem = len % AIL_BITSET_WORD_BITS;
+    return rem ? ((1ULL << rem) - 1) : ~0ULL;
+}
+
+AIL_Bitset ail_bitset_from_parts(u64 *words, u64 len)
+{
+    return (AIL_Bitset) { .words = words, .len = len };
+}
+
+AIL_Bitset ail_bitset_new(u64 len, AIL_Allocator allocator)
+{
+    u64 *words = ail_call_calloc(allocator, ail_bitset_word_count(len), sizeof(u64));
+    return ail_bitset_from_parts(words, len);
+}
+
+void ail_bitset_free(AIL_Bitset *bs, AIL_Allocator allocator)
+{
+    ail_call_free(allocator, bs->words);
+    bs->words = NULL;
+    bs->len   = 0;
+}
+
+void ail_bitset_set(AIL_Bitset bs, u64 idx)
+{
+    ail_assert(idx < bs.len);
+    bs.words[idx/AIL_BITSET_WORD_BITS] |= 1ULL << (idx % AIL_BITSET_WORD_BITS);
+}
+
+void ail_bitset_clear(AIL_Bitset bs, u64 idx)
+{
+    ail_assert(idx < bs.len);
+    bs.words[idx/AIL_BITSET_WORD_BITS] &= ~(1ULL << (idx % AIL_BITSET_WORD_BITS));
+}
+
+void ail_bitset_toggle(AIL_Bitset bs, u64 idx)
+{
+    ail_assert(idx < bs.len);
+    bs.words[idx/AIL_BITSET_WORD_BITS] ^= 1ULL << (idx % AIL_BITSET_WORD_BITS);
+}
+
+void ail_bitset_assign(AIL_Bitset bs, u64 idx, b32 val)
+{
+    ail_assert(idx < bs.len);
+    u64 *w   = &bs.words[idx/AIL_BITSET_WORD_BITS];
+    u64 mask = 1ULL << (idx % AIL_BITSET_WORD_BITS);
+    *w = (*w & ~mask) | (-(u64)!!val & mask);
+}
+
+b32 ail_bitset_test(AIL_Bitset bs, u64 idx)
+{
+    ail_assert(idx < bs.len);
+    return (bs.words[idx/AIL_BITSET_WORD_BITS] >> (idx % AIL_BITSET_WORD_BITS)) & 1;
+}
+
+void ail_bitset_set_all(AIL_Bitset bs)
+{
+    u64 n = ail_bitset_word_count(bs.len);
+    if (!n) return;
+    ail_mem_set(bs.words, 0xff, n*sizeof(u64));
+    bs.words[n - 1] = _ail_bitset_last_word_mask_(bs.len);
+}
+
+void ail_bitset_clear_all(AIL_Bitset bs)
+{
+    ail_mem_set(bs.words, 0, ail_bitset_word_count(bs.len)*sizeof(u64));
+}
+
+_AIL_BITSET_BULK_OP_(and)
+_AIL_BITSET_BULK_OP_(or)
+_AIL_BITSET_BULK_OP_(xor)
+_AIL_BITSET_BULK_OP_(andnot)
+
+void ail_bitset_not(AIL_Bitset dst, AIL_Bitset a)
+{
+    ail_assert(dst.len == a.len, "Bulk operations require bitsets of the same length");
+    u64 n = ail_bitset_word_count(a.len);
+    for (u64 i = 0; i < n; i++) dst.words[i] = ~a.words[i];
+    if (n) dst.words[n - 1] &= _ail_bitset_last_word_mask_(a.len);
+}
+
+u64 ail_bitset_popcount(AIL_Bitset bs)
+{
+    u64 n   = ail_bitset_word_count(bs.len);
+    u64 i   = 0;
+    u64 res = 0;
+#if AIL_SIMD_AVX2
+    // Counts the bits of each nibble via a lookup-table (see Mula, Kurz & Lemire: "Faster Population Counts Using AVX2 Instructions")
+    const __m256i lookup   = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                              0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i low_mask = _mm256_set1_epi8(0x0f);
+    __m256i acc = _mm256_setzero_si256();
+    for (; i + 4 <= n; i += 4) {
+        __m256i v   = _mm256_loadu_si256((const __m256i *)(bs.words + i));
+        __m256i lo  = _mm256_and_si256(v, low_mask);
+        __m256i hi  = _mm256_and_si256(_mm256_srli_epi16(v, 4), low_mask);
+        __m256i cnt = _mm256_add_epi8(_mm256_shuffle_epi8(lookup, lo), _mm256_shuffle_epi8(lookup, hi));
+        acc = _mm256_add_epi64(acc, _mm256_sad_epu8(cnt, _mm256_setzero_si256()));
+    }
+    res += (u64)_mm256_extract_epi64(acc, 0) + (u64)_mm256_extract_epi64(acc, 1) + (u64)_mm256_extract_epi64(acc, 2) + (u64)_mm256_extract_epi64(acc, 3);
+#elif AIL_SIMD_NEON
+    for (; i + 2 <= n; i += 2) {
+        res += vaddlvq_u8(vcntq_u8(vreinterpretq_u8_u64(vld1q_u64(bs.words + i))));
+    }
+#endif
+    for (; i < n; i++) res += ail_popcount_u64(bs.words[i]);
+    return res;
+}
+
+u64 ail_bitset_find_next_set(AIL_Bitset bs, u64 from)
+{
+    if (from >= bs.len) return bs.len;
+    u64 n  = ail_bitset_word_count(bs.len);
+    u64 wi = from/AIL_BITSET_WORD_BITS;
+    u64 w  = bs.words[wi] & (~0ULL << (from % AIL_BITSET_WORD_BITS));
+    if (w) return wi*AIL_BITSET_WORD_BITS + ail_ctz_u64(w);
+    wi++;
+#ifdef _AIL_BITSET_VEC_WORDS_
+    // Skip over runs of empty words
+    for (; wi + _AIL_BITSET_VEC_WORDS_ <= n; wi += _AIL_BITSET_VEC_WORDS_) {
+        if (!_ail_bitset_vec_is_zero_(_ail_bitset_vec_load_(bs.words + wi))) break;
+    }
+#endif
+    for (; wi < n; wi++) {
+        if (bs.words[wi]) return wi*AIL_BITSET_WORD_BITS + ail_ctz_u64(bs.words[wi]);
+    }
+    return bs.len;
+}
+
+u64 ail_bitset_find_next_clear(AIL_Bitset bs, u64 from)
+{
+    if (from >= bs.len) return bs.len;
+    u64 n   = ail_bitset_word_count(bs.len);
+    u64 wi  = from/AIL_BITSET_WORD_BITS;
+    u64 w   = ~bs.words[wi] & (~0ULL << (from % AIL_BITSET_WORD_BITS));
+    u64 res = bs.len;
+    if (w) res = wi*AIL_BITSET_WORD_BITS + ail_ctz_u64(w);
+    else {
+        for (wi++; wi < n; wi++) {
+            if (~bs.words[wi]) {
+                res = wi*AIL_BITSET_WORD_BITS + ail_ctz_u64(~bs.words[wi]);
+                break;
+            }
+        }
+    }
+    // The bits past the end of the bitset are always cleared and thus need to be ignored here
+    return ail_min(res, bs.len);
+}
+
+AIL_Bitset_Rank ail_bitset_rank_new(AIL_Bitset bs, AIL_Allocator allocator)
+{
+    u64 n = ail_bitset_word_count(bs.len);
+    AIL_Bitset_Rank rank = {
+        .block_count = (n + AIL_BITSET_BLOCK_WORDS - 1)/AIL_BITSET_BLOCK_WORDS,
+    };
+    rank.block_ranks = ail_call_alloc(allocator, sizeof(u64)*(rank.block_count + 1));
+    rank.block_ranks[0] = 0;
+    for (u64 b = 0; b < rank.block_count; b++) {
+        u64 start = b*AIL_BITSET_BLOCK_WORDS;
+        u64 end   = ail_min(start + AIL_BITSET_BLOCK_WORDS, n);
+        u64 count = 0;
+        for (u64 i = start; i < end; i++) count += ail_popcount_u64(bs.words[i]);
+        rank.block_ranks[b + 1] = rank.block_ranks[b] + count;
+    }
+    rank.ones = rank.block_ranks[rank.block_count];
+    return rank;
+}
+
+void ail_bitset_rank_free(AIL_Bitset_Rank *rank, AIL_Allocator allocator)
+{
+    ail_call_free(allocator, rank->block_ranks);
+    rank->block_ranks = NULL;
+    rank->block_count = 0;
+    rank->ones        = 0;
+}
+
+u64 ail_bitset_rank(AIL_Bitset bs, AIL_Bitset_Rank rank, u64 pos)
+{
+    if (pos >= bs.len) return rank.ones;
+    u64 wi  = pos/AIL_BITSET_WORD_BITS;
+    u64 res = rank.block_ranks[wi/AIL_BITSET_BLOCK_WORDS];
+    for (u64 i = wi - wi%AIL_BITSET_BLOCK_WORDS; i < wi; i++) res += ail_popcount_u64(bs.words[i]);
+    u64 rem = pos % AIL_BITSET_WORD_BITS;
+    if (rem) res += ail_popcount_u64(bs.words[wi] & ((1ULL << rem) - 1));
+    return res;
+}
+
+inline_func u32 _ail_bitset_select_in_word_(u64 w, u32 k)
+{
+#if AIL_SIMD_BMI2
+    return ail_ctz_u64(_pdep_u64(1ULL << k, w));
+#else
+    for (u32 i = 0; i < k; i++) w &= w - 1;
+    return ail_ctz_u64(w);
+#endif
+}
+
+u64 ail_bitset_select(AIL_Bitset bs, AIL_Bitset_Rank rank, u64 k)
+{
+    if (k >= rank.ones) return bs.len;
+    // Find the last block that starts with at most k set bits before it
+    u64 lo = 0, hi = rank.block_count;
+    while (hi - lo > 1) {
+        u64 mid = lo + (hi - lo)/2;
+        if (rank.block_ranks[mid] <= k) lo = mid;
+        else                            hi = mid;
+    }
+    k -= rank.block_ranks[lo];
+    for (u64 wi = lo*AIL_BITSET_BLOCK_WORDS;; wi++) {
+        u64 count = ail_popcount_u64(bs.words[wi]);
+        if (k < count) return wi*AIL_BITSET_WORD_BITS + _ail_bitset_select_in_word_(bs.words[wi], (u32)k);
+        k -= count;
+    }
+}
+
+AIL_WARN_POP
+#endif // _AIL_BITSET_IMPL_GUARD_
+#endif // AIL_NO_BITSET_IMPL
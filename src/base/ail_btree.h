@@ -0,0 +1,543 @@
+/*
+*** B+Tree ***
+*
+* An ordered map from u64 keys to fixed-size values, implemented as an in-memory B+tree
+* All nodes have the same size (AIL_BTREE_NODE_SIZE), so that a pool-allocator can be used for them, i.e.:
+  * `AIL_Allocator pool = ail_alloc_pool_new(1024, AIL_BTREE_NODE_SIZE, &ail_alloc_pager);`
+  * `AIL_BTree bt = ail_btree_new(sizeof(MyVal), pool);`
+* All values are stored in the leaves, which are linked together, allowing fast ordered iteration in both directions
+* Searching inside a node is done by counting the keys smaller than the searched key via SIMD, when available (see ail_simd.h)
+*
+* Keys are always unsigned 64-bit integers, as this allows for fast comparisons inside nodes
+* Signed integers and floats can be used as keys by converting them with the order-preserving `ail_btree_key_from_*` functions
+*
+* @Note: Removing keys only merges nodes once they become completely empty ("free-at-empty"). Since insertions are usually
+* much more common than deletions, this keeps deletions cheap while only wasting little space in practice
+* (see Johnson & Shasha: "B-trees with inserts and deletes: why free-at-empty is better than merge-at-half")
+*/
+
+#ifndef _AIL_BTREE_H_
+#define _AIL_BTREE_H_
+
+#include "ail_base.h"
+#include "ail_base_math.h"
+#include "ail_mem.h"
+#include "ail_simd.h"
+
+AIL_WARN_PUSH
+AIL_WARN_DISABLE(AIL_WARN_UNUSED_FUNCTION)
+
+#ifndef AIL_BTREE_NODE_SIZE
+#   define AIL_BTREE_NODE_SIZE 512
+#endif
+// Maximum height of the tree, which is never reached in practice, as it would mean storing at least 2^(AIL_BTREE_MAX_HEIGHT) keys
+#define AIL_BTREE_MAX_HEIGHT 48
+
+typedef struct AIL_BTree_Node {
+    u32 is_leaf;
+    u32 count; // Amount of keys stored in the node (inner nodes additionally store count+1 children)
+    struct AIL_BTree_Node *prev; // Only used by leaves
+    struct AIL_BTree_Node *next; // Only used by leaves
+    u64 keys[];
+} AIL_BTree_Node;
+
+typedef struct AIL_BTree {
+    AIL_BTree_Node *root;
+    u64 len;
+    u32 height;   // Amount of levels in the tree, 0 if the tree is empty
+    u32 val_size;
+    u32 leaf_cap;
+    u32 inner_cap;
+    u32 leaf_vals_offset;
+    u32 inner_children_offset;
+    AIL_Allocator allocator;
+} AIL_BTree;
+
+typedef struct AIL_BTree_Iter {
+    AIL_BTree      *bt;
+    AIL_BTree_Node *leaf; // NULL, once the iterator went past either end of the tree
+    u32  idx;
+    u64  key;
+    void *val;
+} AIL_BTree_Iter;
+
+internal AIL_BTree ail_btree_new(u32 val_size, AIL_Allocator allocator);
+// Builds a tree with all leaves filled, where `keys` must be strictly increasing and `vals` must contain `n` values of size `val_size`
+internal AIL_BTree ail_btree_new_from_sorted(u32 val_size, u64 *keys, void *vals, u64 n, AIL_Allocator allocator);
+internal void  ail_btree_free(AIL_BTree *bt);
+// Returns a pointer to the value of `key` or NULL if the key isn't stored in the tree
+internal void *ail_btree_get(AIL_BTree *bt, u64 key);
+// Inserts or overwrites the value of `key` and returns a pointer to where the value is stored
+internal void *ail_btree_put(AIL_BTree *bt, u64 key, void *val);
+// Returns whether `key` was contained in the tree
+internal b32   ail_btree_rm (AIL_BTree *bt, u64 key);
+
+internal AIL_BTree_Iter ail_btree_first(AIL_BTree *bt);
+internal AIL_BTree_Iter ail_btree_last (AIL_BTree *bt);
+// Returns an iterator to the first key that is greater than or equal to `key`
+internal AIL_BTree_Iter ail_btree_lower_bound(AIL_BTree *bt, u64 key);
+// Returns an iterator to the first key that is greater than `key`
+internal AIL_BTree_Iter ail_btree_upper_bound(AIL_BTree *bt, u64 key);
+inline_func b32 ail_btree_iter_valid(AIL_BTree_Iter it);
+internal b32 ail_btree_iter_next(AIL_BTree_Iter *it);
+internal b32 ail_btree_iter_prev(AIL_BTree_Iter *it);
+
+// Iterate over all keys in the range [from, to)
+#define ail_btree_for_range(btPtr, it, from, to) for (AIL_BTree_Iter it = ail_btree_lower_bound(btPtr, from); ail_btree_iter_valid(it) && it.key < (to); ail_btree_iter_next(&it))
+#define ail_btree_for_each(btPtr, it)            for (AIL_BTree_Iter it = ail_btree_first(btPtr); ail_btree_iter_valid(it); ail_btree_iter_next(&it))
+
+inline_func u64 ail_btree_key_from_i64(i64 x);
+inline_func i64 ail_btree_key_to_i64(u64 key);
+inline_func u64 ail_btree_key_from_f64(f64 x);
+inline_func f64 ail_btree_key_to_f64(u64 key);
+
+AIL_WARN_POP
+#endif // _AIL_BTREE_H_
+
+
+#if !defined(AIL_NO_BTREE_IMPL) && !defined(AIL_NO_BASE_IMPL) && !defined(AIL_NO_IMPL)
+#ifndef _AIL_BTREE_IMPL_GUARD_
+#define _AIL_BTREE_IMPL_GUARD_
+AIL_WARN_PUSH
+AIL_WARN_DISABLE(AIL_WARN_UNUSED_FUNCTION)
+
+#define _ail_btree_children_(bt, node) ((AIL_BTree_Node **)((u8 *)(node) + (bt)->inner_children_offset))
+#define _ail_btree_val_(bt, leaf, idx) ((void *)((u8 *)(leaf) + (bt)->leaf_vals_offset + (u64)(idx)*(bt)->val_size))
+
+// Counts the keys that are smaller than `key` in the sorted `keys`
+internal u32 _ail_btree_count_less_(u64 *keys, u32 n, u64 key)
+{
+    // Narrow down the search range first for big nodes
+    u32 lo = 0, hi = n;
+    while (hi - lo > 32) {
+        u32 mid = lo + (hi - lo)/2;
+        if (keys[mid] < key) lo = mid + 1;
+        else                 hi = mid;
+    }
+    keys += lo;
+    n     = hi - lo;
+    u32 i = 0, res = lo;
+#if AIL_SIMD_AVX2
+    // @Note: There are no unsigned 64-bit comparisons on x86, so the sign bit is flipped before using the signed comparison
+    const __m256i bias = _mm256_set1_epi64x((i64)0x8000000000000000ULL);
+    const __m256i k    = _mm256_xor_si256(_mm256_set1_epi64x((i64)key), bias);
+    for (; i + 4 <= n; i += 4) {
+        __m256i v = _mm256_xor_si256(_mm256_loadu_si256((const __m256i *)(keys + i)), bias);
+        res += ail_popcount_u64((u64)_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(k, v))));
+    }
+#elif AIL_SIMD_SSE42
+    const __m128i bias = _mm_set1_epi64x((i64)0x8000000000000000ULL);
+    const __m128i k    = _mm_xor_si128(_mm_set1_epi64x((i64)key), bias);
+    for (; i + 2 <= n; i += 2) {
+        __m128i v = _mm_xor_si128(_mm_loadu_si128((const __m128i *)(keys + i)), bias);
+        res += ail_popcount_u64((u64)_mm_movemask_pd(_mm_castsi128_pd(_mm_cmpgt_epi64(k, v))));
+    }
+#elif AIL_SIMD_NEON
+    const uint64x2_t k = vdupq_n_u64(key);
+    uint64x2_t acc     = vdupq_n_u64(0);
+    for (; i + 2 <= n; i += 2) acc = vsubq_u64(acc, vcltq_u64(vld1q_u64(keys + i), k));
+    res += (u32)(vgetq_lane_u64(acc, 0) + vgetq_lane_u64(acc, 1));
+#endif
+    for (; i < n; i++) res += keys[i] < key;
+    return res;
+}
+
+// Counts the keys that are smaller than or equal to `key` in the sorted `keys`
+inline_func u32 _ail_btree_count_less_eq_(u64 *keys, u32 n, u64 key)
+{
+    return key == 0xffffffffffffffffULL ? n : _ail_btree_count_less_(keys, n, key + 1);
+}
+
+internal AIL_BTree_Node *_ail_btree_new_node_(AIL_BTree *bt, b32 is_leaf)
+{
+    AIL_BTree_Node *node = ail_call_alloc(bt->allocator, AIL_BTREE_NODE_SIZE);
+    node->is_leaf = is_leaf;
+    node->count   = 0;
+    node->prev    = NULL;
+    node->next    = NULL;
+    return node;
+}
+
+AIL_BTree ail_btree_new(u32 val_size, AIL_Allocator allocator)
+{
+    u32 header    = (u32)sizeof(AIL_BTree_Node);
+    u32 leaf_cap  = (AIL_BTREE_NODE_SIZE - header - 8) / (8 + val_size);
+    u32 inner_cap = (AIL_BTREE_NODE_SIZE - header - 8) / 16;
+    ail_assert(leaf_cap >= 4, "AIL_BTREE_NODE_SIZE is too small for the size of the values");
+    return (AIL_BTree) {
+        .root      = NULL,
+        .len       = 0,
+        .height    = 0,
+        .val_size  = val_size,
+        .leaf_cap  = leaf_cap,
+        .inner_cap = inner_cap,
+        .leaf_vals_offset      = header + 8*leaf_cap,
+        .inner_children_offset = header + 8*inner_cap,
+        .allocator = allocator,
+    };
+}
+
+internal void _ail_btree_free_node_(AIL_BTree *bt, AIL_BTree_Node *node)
+{
+    if (!node->is_leaf) {
+        AIL_BTree_Node **children = _ail_btree_children_(bt, node);
+        for (u32 i = 0; i <= node->count; i++) _ail_btree_free_node_(bt, children[i]);
+    }
+    ail_call_free(bt->allocator, node);
+}
+
+void ail_btree_free(AIL_BTree *bt)
+{
+    if (bt->root) _ail_btree_free_node_(bt, bt->root);
+    bt->root   = NULL;
+    bt->len    = 0;
+    bt->height = 0;
+}
+
+internal AIL_BTree_Node *_ail_btree_find_leaf_(AIL_BTree *bt, u64 key, AIL_BTree_Node **path, u32 *path_idxs)
+{
+    AIL_BTree_Node *node = bt->root;
+    for (u32 depth = 0; node && !node->is_leaf; depth++) {
+        u32 idx = _ail_btree_count_less_eq_(node->keys, node->count, key);
+        if (path) {
+            path[depth]      = node;
+            path_idxs[depth] = idx;
+        }
+        node = _ail_btree_children_(bt, node)[idx];
+    }
+    return node;
+}
+
+void *ail_btree_get(AIL_BTree *bt, u64 key)
+{
+    AIL_BTree_Node *leaf = _ail_btree_find_leaf_(bt, key, NULL, NULL);
+    if (!leaf) return NULL;
+    u32 idx = _ail_btree_count_less_(leaf->keys, leaf->count, key);
+    if (idx < leaf->count && leaf->keys[idx] == key) return _ail_btree_val_(bt, leaf, idx);
+    return NULL;
+}
+
+internal void _ail_btree_leaf_insert_(AIL_BTree *bt, AIL_BTree_Node *leaf, u32 idx, u64 key, void *val)
+{
+    u32 n = leaf->count - idx;
+    ail_mem_copy(&leaf->keys[idx + 1], &leaf->keys[idx], n*sizeof(u64));
+    ail_mem_copy(_ail_btree_val_(bt, leaf, idx + 1), _ail_btree_val_(bt, leaf, idx), n*bt->val_size);
+    leaf->keys[idx] = key;
+    ail_mem_copy(_ail_btree_val_(bt, leaf, idx), val, bt->val_size);
+    leaf->count++;
+}
+
+// Inserts `key` at position `idx` and `child` at position `idx + 1`
+internal void _ail_btree_inner_insert_(AIL_BTree *bt, AIL_BTree_Node *node, u32 idx, u64 key, AIL_BTree_Node *child)
+{
+    AIL_BTree_Node **children = _ail_btree_children_(bt, node);
+    u32 n = node->count - idx;
+    ail_mem_copy(&node->keys[idx + 1], &node->keys[idx], n*sizeof(u64));
+    ail_mem_copy(&children[idx + 2], &children[idx + 1], n*sizeof(AIL_BTree_Node *));
+    node->keys[idx]     = key;
+    children[idx + 1]   = child;
+    node->count++;
+}
+
+void *ail_btree_put(AIL_BTree *bt, u64 key, void *val)
+{
+    if (!bt->root) {
+        bt->root   = _ail_btree_new_node_(bt, 1);
+        bt->height = 1;
+    }
+    AIL_BTree_Node *path[AIL_BTREE_MAX_HEIGHT];
+    u32 path_idxs[AIL_BTREE_MAX_HEIGHT];
+    AIL_BTree_Node *leaf = _ail_btree_find_leaf_(bt, key, path, path_idxs);
+    u32 idx = _ail_btree_count_less_(leaf->keys, leaf->count, key);
+    if (idx < leaf->count && leaf->keys[idx] == key) {
+        void *dst = _ail_btree_val_(bt, leaf, idx);
+        ail_mem_copy(dst, val, bt->val_size);
+        return dst;
+    }
+    bt->len++;
+    if (leaf->count < bt->leaf_cap) {
+        _ail_btree_leaf_insert_(bt, leaf, idx, key, val);
+        return _ail_btree_val_(bt, leaf, idx);
+    }
+
+    // Split the leaf and insert the key into the correct half
+    AIL_BTree_Node *right = _ail_btree_new_node_(bt, 1);
+    u32 mid = leaf->count/2;
+    right->count = leaf->count - mid;
+    ail_mem_copy(right->keys, &leaf->keys[mid], right->count*sizeof(u64));
+    ail_mem_copy(_ail_btree_val_(bt, right, 0), _ail_btree_val_(bt, leaf, mid), right->count*bt->val_size);
+    leaf->count  = mid;
+    right->next  = leaf->next;
+    right->prev  = leaf;
+    if (leaf->next) leaf->next->prev = right;
+    leaf->next   = right;
+    void *res;
+    if (idx < mid) {
+        _ail_btree_leaf_insert_(bt, leaf, idx, key, val);
+        res = _ail_btree_val_(bt, leaf, idx);
+    } else {
+        _ail_btree_leaf_insert_(bt, right, idx - mid, key, val);
+        res = _ail_btree_val_(bt, right, idx - mid);
+    }
+
+    // Propagate the split upwards
+    u64 sep = right->keys[0];
+    AIL_BTree_Node *new_child = right;
+    for (i32 depth = (i32)bt->height - 2; depth >= 0; depth--) {
+        AIL_BTree_Node *node = path[depth];
+        u32 pos = path_idxs[depth];
+        if (node->count < bt->inner_cap) {
+            _ail_btree_inner_insert_(bt, node, pos, sep, new_child);
+            return res;
+        }
+        AIL_BTree_Node *inner_right = _ail_btree_new_node_(bt, 0);
+        AIL_BTree_Node **lchildren  = _ail_btree_children_(bt, node);
+        AIL_BTree_Node **rchildren  = _ail_btree_children_(bt, inner_right);
+        u32 imid = node->count/2;
+        u64 up   = node->keys[imid];
+        inner_right->count = node->count - imid - 1;
+        ail_mem_copy(inner_right->keys, &node->keys[imid + 1], inner_right->count*sizeof(u64));
+        ail_mem_copy(rchildren, &lchildren[imid + 1], (inner_right->count + 1)*sizeof(AIL_BTree_Node *));
+        node->count = imid;
+        if (pos <= imid) _ail_btree_inner_insert_(bt, node, pos, sep, new_child);
+        else             _ail_btree_inner_insert_(bt, inner_right, pos - imid - 1, sep, new_child);
+        sep       = up;
+        new_child = inner_right;
+    }
+
+    // The root was split, so the tree grows by one level
+    ail_assert(bt->height < AIL_BTREE_MAX_HEIGHT);
+    AIL_BTree_Node *root = _ail_btree_new_node_(bt, 0);
+    root->count   = 1;
+    root->keys[0] = sep;
+    _ail_btree_children_(bt, root)[0] = bt->root;
+    _ail_btree_children_(bt, root)[1] = new_child;
+    bt->root = root;
+    bt->height++;
+    return res;
+}
+
+b32 ail_btree_rm(AIL_BTree *bt, u64 key)
+{
+    AIL_BTree_Node *path[AIL_BTREE_MAX_HEIGHT];
+    u32 path_idxs[AIL_BTREE_MAX_HEIGHT];
+    AIL_BTree_Node *leaf = _ail_btree_find_leaf_(bt, key, path, path_idxs);
+    if (!leaf) return 0;
+    u32 idx = _ail_btree_count_less_(leaf->keys, leaf->count, key);
+    if (idx >= leaf->count || leaf->keys[idx] != key) return 0;
+
+    u32 n = leaf->count - idx - 1;
+    ail_mem_copy(&leaf->keys[idx], &leaf->keys[idx + 1], n*sizeof(u64));
+    ail_mem_copy(_ail_btree_val_(bt, leaf, idx), _ail_btree_val_(bt, leaf, idx + 1), n*bt->val_size);
+    leaf->count--;
+    bt->len--;
+    if (leaf->count || bt->height == 1) return 1;
+
+    // Remove the empty leaf and all inner nodes that become empty through that
+    if (leaf->prev) leaf->prev->next = leaf->next;
+    if (leaf->next) leaf->next->prev = leaf->prev;
+    ail_call_free(bt->allocator, leaf);
+    for (i32 depth = (i32)bt->height - 2; depth >= 0; depth--) {
+        AIL_BTree_Node *node = path[depth];
+        AIL_BTree_Node **children = _ail_btree_children_(bt, node);
+        u32 pos = path_idxs[depth];
+        if (node->count == 0) {
+            // The removed child was the only child of this node
+            if (depth == 0) {
+                ail_call_free(bt->allocator, node);
+                bt->root   = NULL;
+                bt->height = 0;
+                return 1;
+            }
+            ail_call_free(bt->allocator, node);
+            continue;
+        }
+        u32 key_pos = pos ? pos - 1 : 0;
+        ail_mem_copy(&node->keys[key_pos], &node->keys[key_pos + 1], (node->count - key_pos - 1)*sizeof(u64));
+        ail_mem_copy(&children[pos], &children[pos + 1], (node->count - pos)*sizeof(AIL_BTree_Node *));
+        node->count--;
+        break;
+    }
+    // Shrink the tree while the root only has a single child
+    while (bt->root && !bt->root->is_leaf && bt->root->count == 0) {
+        AIL_BTree_Node *old_root = bt->root;
+        bt->root = _ail_btree_children_(bt, old_root)[0];
+        bt->height--;
+        ail_call_free(bt->allocator, old_root);
+    }
+    return 1;
+}
+
+internal u64 _ail_btree_min_key_(AIL_BTree *bt, AIL_BTree_Node *node)
+{
+    while (!node->is_leaf) node = _ail_btree_children_(bt, node)[0];
+    return node->keys[0];
+}
+
+AIL_BTree ail_btree_new_from_sorted(u32 val_size, u64 *keys, void *vals, u64 n, AIL_Allocator allocator)
+{
+    AIL_BTree bt = ail_btree_new(val_size, allocator);
+    if (!n) return bt;
+
+    // Build the leaves, distributing the keys evenly among them
+    u64 leaf_count = (n + bt.leaf_cap - 1)/bt.leaf_cap;
+    AIL_BTree_Node *first = NULL, *prev = NULL;
+    for (u64 i = 0, start = 0; i < leaf_count; i++) {
+        u64 end = (n*(i + 1))/leaf_count;
+        AIL_BTree_Node *leaf = _ail_btree_new_node_(&bt, 1);
+        leaf->count = (u32)(end - start);
+        ail_mem_copy(leaf->keys, &keys[start], leaf->count*sizeof(u64));
+        ail_mem_copy(_ail_btree_val_(&bt, leaf, 0), (u8 *)vals + start*val_size, (u64)leaf->count*val_size);
+        for (u32 j = 1; j < leaf->count; j++) ail_assert(leaf->keys[j - 1] < leaf->keys[j], "Keys need to be strictly increasing");
+        if (prev) {
+            ail_assert(prev->keys[prev->count - 1] < leaf->keys[0], "Keys need to be strictly increasing");
+            prev->next = leaf;
+        } else {
+            first = leaf;
+        }
+        leaf->prev = prev;
+        prev  = leaf;
+        start = end;
+    }
+    bt.len    = n;
+    bt.height = 1;
+
+    // Build the inner levels bottom-up, temporarily linking the nodes of each level via their `next` pointer
+    AIL_BTree_Node *level       = first;
+    u64             level_count = leaf_count;
+    while (level_count > 1) {
+        u64 parent_count = (level_count + bt.inner_cap)/(bt.inner_cap + 1);
+        AIL_BTree_Node *parent_first = NULL, *parent_prev = NULL, *child = level;
+        for (u64 i = 0, start = 0; i < parent_count; i++) {
+            u64 end = (level_count*(i + 1))/parent_count;
+            AIL_BTree_Node *node = _ail_btree_new_node_(&bt, 0);
+            AIL_BTree_Node **children = _ail_btree_children_(&bt, node);
+            node->count = (u32)(end - start - 1);
+            for (u64 j = 0; j < end - start; j++) {
+                children[j] = child;
+                if (j) node->keys[j - 1] = _ail_btree_min_key_(&bt, child);
+                child = child->next;
+            }
+            if (parent_prev) parent_prev->next = node;
+            else             parent_first      = node;
+            parent_prev = node;
+            start       = end;
+        }
+        // The links were only required for building the tree and are removed again for inner nodes
+        if (!level->is_leaf) {
+            for (AIL_BTree_Node *node = level, *next; node; node = next) {
+                next       = node->next;
+                node->next = NULL;
+            }
+        }
+        level       = parent_first;
+        level_count = parent_count;
+        bt.height++;
+    }
+    if (!level->is_leaf) level->next = NULL;
+    bt.root = level;
+    return bt;
+}
+
+internal AIL_BTree_Iter _ail_btree_iter_at_(AIL_BTree *bt, AIL_BTree_Node *leaf, u32 idx)
+{
+    AIL_BTree_Iter it = { .bt = bt, .leaf = leaf, .idx = idx };
+    // Skip to the next leaf if idx is past the end of the current leaf
+    while (it.leaf && it.idx >= it.leaf->count) {
+        it.leaf = it.leaf->next;
+        it.idx  = 0;
+    }
+    if (it.leaf) {
+        it.key = it.leaf->keys[it.idx];
+        it.val = _ail_btree_val_(bt, it.leaf, it.idx);
+    }
+    return it;
+}
+
+AIL_BTree_Iter ail_btree_first(AIL_BTree *bt)
+{
+    AIL_BTree_Node *node = bt->root;
+    while (node && !node->is_leaf) node = _ail_btree_children_(bt, node)[0];
+    return _ail_btree_iter_at_(bt, node, 0);
+}
+
+AIL_BTree_Iter ail_btree_last(AIL_BTree *bt)
+{
+    AIL_BTree_Node *node = bt->root;
+    while (node && !node->is_leaf) node = _ail_btree_children_(bt, node)[node->count];
+    if (!node || !node->count) return (AIL_BTree_Iter) { .bt = bt, .leaf = NULL };
+    return _ail_btree_iter_at_(bt, node, node->count - 1);
+}
+
+AIL_BTree_Iter ail_btree_lower_bound(AIL_BTree *bt, u64 key)
+{
+    AIL_BTree_Node *leaf = _ail_btree_find_leaf_(bt, key, NULL, NULL);
+    if (!leaf) return (AIL_BTree_Iter) { .bt = bt, .leaf = NULL };
+    return _ail_btree_iter_at_(bt, leaf, _ail_btree_count_less_(leaf->keys, leaf->count, key));
+}
+
+AIL_BTree_Iter ail_btree_upper_bound(AIL_BTree *bt, u64 key)
+{
+    AIL_BTree_Node *leaf = _ail_btree_find_leaf_(bt, key, NULL, NULL);
+    if (!leaf) return (AIL_BTree_Iter) { .bt = bt, .leaf = NULL };
+    return _ail_btree_iter_at_(bt, leaf, _ail_btree_count_less_eq_(leaf->keys, leaf->count, key));
+}
+
+b32 ail_btree_iter_valid(AIL_BTree_Iter it)
+{
+    return it.leaf != NULL;
+}
+
+b32 ail_btree_iter_next(AIL_BTree_Iter *it)
+{
+    if (!it->leaf) return 0;
+    *it = _ail_btree_iter_at_(it->bt, it->leaf, it->idx + 1);
+    return it->leaf != NULL;
+}
+
+b32 ail_btree_iter_prev(AIL_BTree_Iter *it)
+{
+    if (!it->leaf) return 0;
+    AIL_BTree_Node *leaf = it->leaf;
+    u32 idx = it->idx;
+    while (leaf && idx == 0) {
+        leaf = leaf->prev;
+        idx  = leaf ? leaf->count : 0;
+    }
+    if (!leaf) {
+        it->leaf = NULL;
+        return 0;
+    }
+    *it = _ail_btree_iter_at_(it->bt, leaf, idx - 1);
+    return 1;
+}
+
+u64 ail_btree_key_from_i64(i64 x)
+{
+    return (u64)x ^ 0x8000000000000000ULL;
+}
+
+i64 ail_btree_key_to_i64(u64 key)
+{
+    return (i64)(key ^ 0x8000000000000000ULL);
+}
+
+u64 ail_btree_key_from_f64(f64 x)
+{
+    u64 bits;
+    ail_mem_copy(&bits, &x, sizeof(bits));
+    // Negative floats are ordered in reverse and need to come before all positive floats
+    return (bits & 0x8000000000000000ULL) ? ~bits : (bits | 0x8000000000000000ULL);
+}
+
+f64 ail_btree_key_to_f64(u64 key)
+{
+    u64 bits = (key & 0x8000000000000000ULL) ? (key & ~0x8000000000000000ULL) : ~key;
+    f64 x;
+    ail_mem_copy(&x, &bits, sizeof(x));
+    return x;
+}
+
+AIL_WARN_POP
+#endif // _AIL_BTREE_IMPL_GUARD_
+#endif // AIL_NO_BTREE_IMPL
@@ -0,0 +1,366 @@
+/*
+*** Chunked String Builder ***
+*
+* A chunked string builder (AIL_CSB) stores the text as a linked list of chunks instead of a single contiguous buffer.
+* Appending never reallocates or moves any of the previously written bytes, which makes it well-suited
+* for building large outputs (i.e. HTTP responses or logs), that are only ever written out as a whole
+*
+* All memory is taken from blocks, which are requested from the builder's allocator:
+* - Blocks start at AIL_CSB_BLOCK_SIZE bytes and double in size up to AIL_CSB_MAX_BLOCK_SIZE bytes,
+*   so that the amount of allocations only grows logarithmically with the length of the text
+* - The chunks themselves are stored inside the blocks as well, right in front of their data
+* - Large strings can be pushed by reference (see ail_csb_push_ref), in which case they are not copied at all
+*
+* The text can be written to a file descriptor with a single call to writev (see ail_csb_write_fd)
+* or collapsed into a contiguous string once it is actually needed (see ail_csb_collapse and ail_csb_to_str_a)
+*/
+
+#ifndef _AIL_CSB_H_
+#define _AIL_CSB_H_
+
+#include "ail_base.h"
+#include "ail_base_math.h"
+#include "ail_mem.h"
+#include "ail_str.h"
+
+AIL_WARN_PUSH
+AIL_WARN_DISABLE(AIL_WARN_UNUSED_FUNCTION)
+
+#ifndef AIL_CSB_BLOCK_SIZE
+#   define AIL_CSB_BLOCK_SIZE 4096
+#endif
+#ifndef AIL_CSB_MAX_BLOCK_SIZE
+#   define AIL_CSB_MAX_BLOCK_SIZE AIL_MB(1)
+#endif
+// Strings shorter than this are copied by ail_csb_push_ref, since a new chunk would cost more than copying them
+#ifndef AIL_CSB_REF_MIN_LEN
+#   define AIL_CSB_REF_MIN_LEN 256
+#endif
+
+typedef struct AIL_CSB_Chunk {
+    struct AIL_CSB_Chunk *next;
+    u8  *data;
+    u64  len;
+} AIL_CSB_Chunk;
+
+typedef struct AIL_CSB_Block {
+    struct AIL_CSB_Block *next;
+    u64 cap;
+    u8  data[];
+} AIL_CSB_Block;
+
+typedef struct AIL_CSB {
+    AIL_CSB_Chunk *head;       // NULL if nothing was pushed yet
+    AIL_CSB_Chunk *tail;
+    AIL_CSB_Block *blocks;     // The most recently allocated block comes first
+    u8            *spare;      // Start of the unused memory in the most recently allocated block
+    u8            *spare_end;
+    u64            len;
+    u64            chunk_count;
+    u64            block_size; // Size of the next allocated block
+    AIL_Allocator  allocator;
+} AIL_CSB;
+
+internal AIL_CSB ail_csb_new_a(AIL_Allocator allocator);
+internal void    ail_csb_free (AIL_CSB *csb);
+// Removes all text, but keeps the most recently allocated block around for reuse
+internal void    ail_csb_clear(AIL_CSB *csb);
+#define ail_csb_new() ail_csb_new_a(ail_default_allocator)
+
+inline_func void ail_csb_push_bytes(AIL_CSB *csb, const void *data, u64 n);
+inline_func void ail_csb_push_char (AIL_CSB *csb, u8 c);
+#define ail_csb_push_str(csbPtr, str) ail_csb_push_bytes(csbPtr, (str).data, (str).len)
+#define ail_csb_push_cstr(csbPtr, s)  ail_csb_push_bytes(csbPtr, s, ail_cstr_len(s))
+// Appends `str` as its own chunk without copying it
+// @Important: `str` needs to stay valid for as long as the builder is used
+internal void ail_csb_push_ref(AIL_CSB *csb, AIL_Str str);
+// Appends `n` bytes to the text and returns a pointer to them, so that they can be written in-place
+// @Important: The returned pointer is only valid until the next time anything is pushed to the builder
+inline_func u8  *ail_csb_push_space(AIL_CSB *csb, u64 n);
+internal void ail_csb_push_unsigned(AIL_CSB *csb, u64 num);
+internal void ail_csb_push_signed  (AIL_CSB *csb, i64 num);
+internal void ail_csb_push_float   (AIL_CSB *csb, f64 num);
+
+// Copies the whole text into `dst`, which needs to have space for at least csb.len bytes
+internal void    ail_csb_copy_to(AIL_CSB csb, u8 *dst);
+// Merges all chunks into a single one and returns it
+// The memory of the old chunks is freed, so that the text is only stored once
+// @Note: Returns the only chunk without copying anything, if the text already is contiguous
+// @Important: The returned string is not null-terminated and only valid until the builder is cleared or freed
+internal AIL_Str ail_csb_collapse(AIL_CSB *csb);
+// @Important: Copies the text to a new null-terminated string. Remember to free it with ail_str_free
+internal AIL_Str ail_csb_to_str_a(AIL_CSB csb, AIL_Allocator allocator);
+#define ail_csb_to_str(csb) ail_csb_to_str_a(csb, ail_default_allocator)
+
+// Writes the whole text to the file descriptor `fd`
+// On POSIX systems, all chunks are written with a single call to writev (unless there are more than IOV_MAX chunks)
+// Returns false if writing failed
+internal b32 ail_csb_write_fd(AIL_CSB csb, int fd);
+
+AIL_WARN_POP
+#endif // _AIL_CSB_H_
+
+
+#if !defined(AIL_NO_CSB_IMPL) && !defined(AIL_NO_BASE_IMPL) && !defined(AIL_NO_IMPL)
+#ifndef _AIL_CSB_IMPL_GUARD_
+#define _AIL_CSB_IMPL_GUARD_
+AIL_WARN_PUSH
+AIL_WARN_DISABLE(AIL_WARN_UNUSED_FUNCTION)
+
+#if AIL_OS_WIN
+#   include <io.h> // For _write
+#else
+#   include <unistd.h>  // For write
+#   include <limits.h>  // For IOV_MAX
+#   include <sys/uio.h> // For writev
+#   include <errno.h>
+#   ifndef IOV_MAX
+#       define IOV_MAX 1024
+#   endif
+#endif
+
+#define _AIL_CSB_CHUNK_SIZE_ ((u64)sizeof(AIL_CSB_Chunk))
+// A new chunk is only placed in the spare memory of a block, if at least this many bytes are left for its data
+#define _AIL_CSB_MIN_SPARE_  32
+
+AIL_CSB ail_csb_new_a(AIL_Allocator allocator)
+{
+    return (AIL_CSB) { .block_size = AIL_CSB_BLOCK_SIZE, .allocator = allocator };
+}
+
+void ail_csb_free(AIL_CSB *csb)
+{
+    for (AIL_CSB_Block *b = csb->blocks, *next; b; b = next) {
+        next = b->next;
+        ail_call_free(csb->allocator, b);
+    }
+    *csb = ail_csb_new_a(csb->allocator);
+}
+
+void ail_csb_clear(AIL_CSB *csb)
+{
+    AIL_CSB_Block *keep = csb->blocks;
+    if (keep) {
+        for (AIL_CSB_Block *b = keep->next, *next; b; b = next) {
+            next = b->next;
+            ail_call_free(csb->allocator, b);
+        }
+        keep->next     = NULL;
+        csb->spare     = keep->data;
+        csb->spare_end = keep->data + keep->cap;
+    }
+    csb->blocks      = keep;
+    csb->head        = NULL;
+    csb->tail        = NULL;
+    csb->len         = 0;
+    csb->chunk_count = 0;
+}
+
+// Ensures that there are at least `n` bytes of spare memory by allocating a new block if necessary
+internal void _ail_csb_reserve_(AIL_CSB *csb, u64 n)
+{
+    if ((u64)(csb->spare_end - csb->spare) >= n) return;
+    u64 cap = ail_max(csb->block_size, n);
+    AIL_CSB_Block *b = ail_call_alloc(csb->allocator, sizeof(AIL_CSB_Block) + cap);
+    b->next         = csb->blocks;
+    b->cap          = cap;
+    csb->blocks     = b;
+    csb->spare      = b->data;
+    csb->spare_end  = b->data + cap;
+    csb->block_size = ail_min(2*csb->block_size, (u64)AIL_CSB_MAX_BLOCK_SIZE);
+}
+
+// Places a new chunk pointing at `data` in the spare memory and appends it to the list of chunks
+// If `data` is NULL, the chunk's data starts right after the chunk and the chunk can be extended by writing into the spare memory
+internal AIL_CSB_Chunk *_ail_csb_chunk_new_(AIL_CSB *csb, u8 *data, u64 len, u64 min_spare)
+{
+    u64 pad = (u64)(-(uintptr_t)csb->spare & (sizeof(void *) - 1));
+    _ail_csb_reserve_(csb, pad + _AIL_CSB_CHUNK_SIZE_ + min_spare);
+    pad = (u64)(-(uintptr_t)csb->spare & (sizeof(void *) - 1)); // The spare memory might have moved to a new block
+    AIL_CSB_Chunk *c = (AIL_CSB_Chunk *)(csb->spare + pad);
+    csb->spare += pad + _AIL_CSB_CHUNK_SIZE_;
+    *c = (AIL_CSB_Chunk) { .data = data ? data : csb->spare, .len = len };
+    if (csb->tail) csb->tail->next = c;
+    else           csb->head       = c;
+    csb->tail = c;
+    csb->chunk_count++;
+    csb->len += len;
+    return c;
+}
+
+// Whether the last chunk can be extended by `n` bytes without creating a new chunk
+inline_func b32 _ail_csb_can_extend_(AIL_CSB *csb, u64 n)
+{
+    AIL_CSB_Chunk *c = csb->tail;
+    return c && c->data + c->len == csb->spare && (u64)(csb->spare_end - csb->spare) >= n;
+}
+
+// Returns the last chunk, if its data can be extended by at least one byte or a new chunk with at least `min` bytes of space otherwise
+internal AIL_CSB_Chunk *_ail_csb_writable_chunk_(AIL_CSB *csb, u64 min)
+{
+    if (_ail_csb_can_extend_(csb, 1)) return csb->tail;
+    return _ail_csb_chunk_new_(csb, NULL, 0, ail_max(min, (u64)_AIL_CSB_MIN_SPARE_));
+}
+
+// Slow path of ail_csb_push_bytes, which spreads the bytes over several chunks if necessary
+internal void _ail_csb_push_bytes_chunked_(AIL_CSB *csb, const u8 *p, u64 n)
+{
+    while (n) {
+        AIL_CSB_Chunk *c = _ail_csb_writable_chunk_(csb, n);
+        u64 k = ail_min(n, (u64)(csb->spare_end - csb->spare));
+        ail_mem_copy(csb->spare, (void *)p, k);
+        csb->spare += k;
+        c->len     += k;
+        csb->len   += k;
+        p += k;
+        n -= k;
+    }
+}
+
+void ail_csb_push_bytes(AIL_CSB *csb, const void *data, u64 n)
+{
+    if (AIL_UNLIKELY(!_ail_csb_can_extend_(csb, n))) {
+        _ail_csb_push_bytes_chunked_(csb, data, n);
+        return;
+    }
+    ail_mem_copy(csb->spare, (void *)data, n);
+    csb->spare     += n;
+    csb->tail->len += n;
+    csb->len       += n;
+}
+
+void ail_csb_push_char(AIL_CSB *csb, u8 c)
+{
+    AIL_CSB_Chunk *chunk = _ail_csb_writable_chunk_(csb, 1);
+    *csb->spare++ = c;
+    chunk->len++;
+    csb->len++;
+}
+
+void ail_csb_push_ref(AIL_CSB *csb, AIL_Str str)
+{
+    if (str.len < AIL_CSB_REF_MIN_LEN) ail_csb_push_bytes(csb, str.data, str.len);
+    else                               _ail_csb_chunk_new_(csb, str.data, str.len, 0);
+}
+
+u8 *ail_csb_push_space(AIL_CSB *csb, u64 n)
+{
+    AIL_CSB_Chunk *c = AIL_LIKELY(_ail_csb_can_extend_(csb, n)) ? csb->tail : _ail_csb_chunk_new_(csb, NULL, 0, n);
+    u8 *p = csb->spare;
+    csb->spare += n;
+    c->len     += n;
+    csb->len   += n;
+    return p;
+}
+
+// Gives back the last `n` bytes of the spare memory, that were taken by ail_csb_push_space
+internal void _ail_csb_unpush_(AIL_CSB *csb, u64 n)
+{
+    csb->spare     -= n;
+    csb->tail->len -= n;
+    csb->len       -= n;
+}
+
+void ail_csb_push_unsigned(AIL_CSB *csb, u64 num)
+{
+    u8 *p = ail_csb_push_space(csb, AIL_STR_INT_MAX_LEN);
+    _ail_csb_unpush_(csb, AIL_STR_INT_MAX_LEN - ail_str_unsigned_to_buf(num, p));
+}
+
+void ail_csb_push_signed(AIL_CSB *csb, i64 num)
+{
+    u8 *p = ail_csb_push_space(csb, AIL_STR_INT_MAX_LEN);
+    _ail_csb_unpush_(csb, AIL_STR_INT_MAX_LEN - ail_str_signed_to_buf(num, p));
+}
+
+void ail_csb_push_float(AIL_CSB *csb, f64 num)
+{
+    u8 *p = ail_csb_push_space(csb, AIL_STR_FLOAT_MAX_LEN);
+    _ail_csb_unpush_(csb, AIL_STR_FLOAT_MAX_LEN - ail_str_float_to_buf(num, p));
+}
+
+void ail_csb_copy_to(AIL_CSB csb, u8 *dst)
+{
+    for (AIL_CSB_Chunk *c = csb.head; c; c = c->next) {
+        ail_mem_copy(dst, c->data, c->len);
+        dst += c->len;
+    }
+}
+
+AIL_Str ail_csb_collapse(AIL_CSB *csb)
+{
+    if (!csb->head)            return ail_str_from_parts(NULL, 0);
+    if (csb->chunk_count == 1) return ail_str_from_parts(csb->head->data, csb->head->len);
+
+    u64 len = csb->len;
+    AIL_CSB_Block *b = ail_call_alloc(csb->allocator, sizeof(AIL_CSB_Block) + _AIL_CSB_CHUNK_SIZE_ + len);
+    b->cap  = _AIL_CSB_CHUNK_SIZE_ + len;
+    b->next = NULL;
+    AIL_CSB_Chunk *c = (AIL_CSB_Chunk *)b->data;
+    *c = (AIL_CSB_Chunk) { .data = b->data + _AIL_CSB_CHUNK_SIZE_, .len = len };
+    ail_csb_copy_to(*csb, c->data);
+
+    for (AIL_CSB_Block *old = csb->blocks, *next; old; old = next) {
+        next = old->next;
+        ail_call_free(csb->allocator, old);
+    }
+    csb->blocks      = b;
+    csb->head        = c;
+    csb->tail        = c;
+    csb->chunk_count = 1;
+    csb->spare       = b->data + b->cap;
+    csb->spare_end   = csb->spare;
+    return ail_str_from_parts(c->data, len);
+}
+
+AIL_Str ail_csb_to_str_a(AIL_CSB csb, AIL_Allocator allocator)
+{
+    u8 *s = ail_call_alloc(allocator, csb.len + 1);
+    ail_csb_copy_to(csb, s);
+    s[csb.len] = 0;
+    return ail_str_from_parts(s, csb.len);
+}
+
+b32 ail_csb_write_fd(AIL_CSB csb, int fd)
+{
+#if AIL_OS_WIN
+    for (AIL_CSB_Chunk *c = csb.head; c; c = c->next) {
+        for (u64 written = 0; written < c->len;) {
+            int res = _write(fd, c->data + written, (unsigned int)ail_min(c->len - written, (u64)INT32_MAX));
+            if (res < 0) return false;
+            written += (u64)res;
+        }
+    }
+    return true;
+#else
+    struct iovec iov[IOV_MAX < 1024 ? IOV_MAX : 1024];
+    AIL_CSB_Chunk *c = csb.head;
+    u64 skip = 0; // Amount of bytes of `c` that were already written
+    while (c) {
+        int n = 0;
+        for (AIL_CSB_Chunk *it = c; it && n < (int)ail_arrlen(iov); it = it->next, n++) {
+            iov[n] = (struct iovec) { .iov_base = it->data, .iov_len = it->len };
+        }
+        iov[0].iov_base = c->data + skip;
+        iov[0].iov_len  = c->len  - skip;
+        ssize_t res = writev(fd, iov, n);
+        if (res < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        if (res == 0 && iov[0].iov_len) return false;
+        // Skip all chunks that were written completely
+        u64 written = (u64)res + skip;
+        while (c && written >= c->len) {
+            written -= c->len;
+            c = c->next;
+        }
+        skip = written;
+    }
+    return true;
+#endif
+}
+
+AIL_WARN_POP
+#endif // _AIL_CSB_IMPL_GUARD_
+#endif // AIL_NO_CSB_IMPL
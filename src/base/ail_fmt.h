@@ -1,13 +1,608 @@
 /*
 *** String Formatting ***
 *
+* A native implementation of printf-style formatting, that writes directly into a string builder (AIL_SB)
+* The output is produced in a single pass with amortized growth of the string builder and doesn't depend on the current locale
+*
+* All of C99's conversion specifiers, flags, field widths, precisions and length modifiers are supported:
+*   %d %i %u %o %x %X %c %s %p %n %f %F %e %E %g %G %a %A %%
+* Integers and floats are converted with the fast conversions from ail_str.h,
+* while floats with more digits than their shortest representation are printed exactly (just like glibc does)
+* @Note: Long doubles (%Lf) are converted to f64 before they are formatted
+*
+* AIL_Str can be printed with "%.*s", for which the AIL_STR_FMT and AIL_STR_ARG macros are provided:
+*     ail_sb_print(&sb, "Hello " AIL_STR_FMT "!\n", AIL_STR_ARG(name));
+*
+* Formats, that are used very often (i.e. by a logger), can be parsed once with ail_fmt_compile.
+* ail_sb_print_fmt then only copies the already known literal text and formats the arguments
 */
 
 #ifndef _AIL_FMT_H_
 #define _AIL_FMT_H_
 
 #include "ail_base.h"
+#include "ail_mem.h"
+#include "ail_arr.h"
+#include "ail_str.h"
+#include <stdarg.h> // For va_<>
+#include <stddef.h> // For ptrdiff_t
+
+AIL_WARN_PUSH
+AIL_WARN_DISABLE(AIL_WARN_UNUSED_FUNCTION)
+
+#define AIL_STR_FMT    "%.*s"
+#define AIL_STR_ARG(s) (int)(s).len, (char *)(s).data
+
+#ifndef AIL_FMT_MAX_SPECS
+#   define AIL_FMT_MAX_SPECS 32
+#endif
+
+typedef enum AIL_Fmt_Flag {
+    AIL_FMT_FLAG_LEFT  = 1,  // '-'
+    AIL_FMT_FLAG_PLUS  = 2,  // '+'
+    AIL_FMT_FLAG_SPACE = 4,  // ' '
+    AIL_FMT_FLAG_ALT   = 8,  // '#'
+    AIL_FMT_FLAG_ZERO  = 16, // '0'
+} AIL_Fmt_Flag;
+
+typedef enum AIL_Fmt_Length {
+    AIL_FMT_LEN_NONE,
+    AIL_FMT_LEN_HH,
+    AIL_FMT_LEN_H,
+    AIL_FMT_LEN_L,
+    AIL_FMT_LEN_LL,
+    AIL_FMT_LEN_J,
+    AIL_FMT_LEN_Z,
+    AIL_FMT_LEN_T,
+    AIL_FMT_LEN_LD,
+} AIL_Fmt_Length;
+
+typedef struct AIL_Fmt_Spec {
+    u32 lit_len;   // Amount of literal bytes before this specifier (only used by AIL_Fmt)
+    u32 spec_len;  // Amount of bytes that the specifier takes in the format, including the '%'
+    i32 width;     // -1 if not given, -2 if given as an argument ('*')
+    i32 precision; // -1 if not given, -2 if given as an argument ('*')
+    u8  flags;     // Combination of AIL_Fmt_Flag
+    u8  length;    // AIL_Fmt_Length
+    u8  conv;      // Conversion character or 0 if the specifier is invalid and should be written as it is
+} AIL_Fmt_Spec;
 
-// @TODO
+typedef struct AIL_Fmt { // Format string, that was parsed with ail_fmt_compile
+    const char  *format;
+    u32          count;    // Amount of specifiers
+    u32          tail_len; // Amount of literal bytes after the last specifier
+    b32          compiled; // False if the format had more than AIL_FMT_MAX_SPECS specifiers, in which case it is parsed every time
+    AIL_Fmt_Spec specs[AIL_FMT_MAX_SPECS];
+} AIL_Fmt;
 
+internal ail_print_format(2, 3) void ail_sb_print(AIL_SB *sb, const char *format, ...);
+internal void ail_sb_vprint(AIL_SB *sb, const char *format, va_list args);
+// Format into a new null-terminated string
+// @Important: Remember to free the new string with ail_str_free_a
+internal ail_print_format(2, 3) AIL_Str ail_str_new_fmt_a(AIL_Allocator allocator, const char *format, ...);
+#define ail_str_new_fmt(...) ail_str_new_fmt_a(ail_default_allocator, __VA_ARGS__)
+
+// @Important: `format` needs to outlive the returned AIL_Fmt, which is usually the case for string literals
+internal AIL_Fmt ail_fmt_compile(const char *format);
+internal void ail_sb_print_fmt (AIL_SB *sb, const AIL_Fmt *fmt, ...);
+internal void ail_sb_vprint_fmt(AIL_SB *sb, const AIL_Fmt *fmt, va_list args);
+
+AIL_WARN_POP
 #endif // _AIL_FMT_H_
+
+
+#if !defined(AIL_NO_FMT_IMPL) && !defined(AIL_NO_BASE_IMPL) && !defined(AIL_NO_IMPL)
+#ifndef _AIL_FMT_IMPL_GUARD_
+#define _AIL_FMT_IMPL_GUARD_
+AIL_WARN_PUSH
+AIL_WARN_DISABLE(AIL_WARN_UNUSED_FUNCTION)
+
+internal void _ail_fmt_push_n_(AIL_SB *sb, u8 c, u64 n)
+{
+    ail_da_maybe_grow(sb, n);
+    ail_mem_set(sb->data + sb->len, c, n);
+    sb->len += n;
+}
+
+// Pads the output written since `start` to `width` bytes
+// When zero-padding, the zeros are inserted after the first `prefix_len` bytes (i.e. after the sign or "0x")
+internal void _ail_fmt_pad_(AIL_SB *sb, u64 start, u64 prefix_len, i32 width, u8 flags)
+{
+    u64 len = sb->len - start;
+    if (len >= (u64)width) return;
+    u64 n = (u64)width - len;
+    if (flags & AIL_FMT_FLAG_LEFT) {
+        _ail_fmt_push_n_(sb, ' ', n);
+        return;
+    }
+    ail_da_maybe_grow(sb, n);
+    u64 at = start + ((flags & AIL_FMT_FLAG_ZERO) ? prefix_len : 0);
+    ail_mem_copy(sb->data + at + n, sb->data + at, sb->len - at);
+    ail_mem_set(sb->data + at, (flags & AIL_FMT_FLAG_ZERO) ? '0' : ' ', n);
+    sb->len += n;
+}
+
+internal void _ail_fmt_write_bytes_(AIL_SB *sb, const AIL_Fmt_Spec *spec, const char *p, u64 n)
+{
+    u64 start = sb->len;
+    ail_da_pushn(sb, (void *)p, n);
+    _ail_fmt_pad_(sb, start, 0, spec->width, spec->flags & ~AIL_FMT_FLAG_ZERO);
+}
+
+internal void _ail_fmt_write_int_(AIL_SB *sb, const AIL_Fmt_Spec *spec, u64 val, b32 is_neg)
+{
+    static const char hex_lower[] = "0123456789abcdef";
+    static const char hex_upper[] = "0123456789ABCDEF";
+    u64 start = sb->len;
+    u8  conv  = spec->conv;
+    u8  flags = spec->flags;
+    ail_da_maybe_grow(sb, 2);
+    if      (is_neg)                                               sb->data[sb->len++] = '-';
+    else if ((conv == 'd' || conv == 'i') && (flags & AIL_FMT_FLAG_PLUS))  sb->data[sb->len++] = '+';
+    else if ((conv == 'd' || conv == 'i') && (flags & AIL_FMT_FLAG_SPACE)) sb->data[sb->len++] = ' ';
+    if ((conv == 'x' || conv == 'X') && (flags & AIL_FMT_FLAG_ALT) && val) {
+        sb->data[sb->len++] = '0';
+        sb->data[sb->len++] = conv;
+    }
+    u64 prefix_len = sb->len - start;
+
+    u8  buf[24];
+    u8 *digits = buf + sizeof(buf);
+    if (conv == 'o') {
+        for (u64 v = val; v; v >>= 3) *--digits = '0' + (u8)(v & 7);
+    } else if (conv == 'x' || conv == 'X') {
+        const char *hex = conv == 'x' ? hex_lower : hex_upper;
+        for (u64 v = val; v; v >>= 4) *--digits = (u8)hex[v & 15];
+    } else if (val) {
+        digits -= _ail_str_count_digits_(val);
+        ail_str_unsigned_to_buf(val, digits);
+    }
+    u64 nd = (u64)(buf + sizeof(buf) - digits);
+    // A value of 0 has no digits unless the precision is unspecified
+    if (!val && spec->precision != 0) *--digits = '0', nd = 1;
+    u64 zeros = spec->precision > (i32)nd ? (u64)spec->precision - nd : 0;
+    if (conv == 'o' && (flags & AIL_FMT_FLAG_ALT) && !zeros && (!nd || digits[0] != '0')) zeros = 1;
+    _ail_fmt_push_n_(sb, '0', zeros);
+    ail_da_pushn(sb, digits, nd);
+    if (spec->precision >= 0) flags &= ~AIL_FMT_FLAG_ZERO;
+    _ail_fmt_pad_(sb, start, prefix_len, spec->width, flags);
+}
+
+// Rounds the decimal to its first `n` digits (rounding up if `up` is true)
+internal void _ail_fmt_round_digits_(_AIL_Str_Decimal_ *d, i32 n, b32 up)
+{
+    d->nd = (u32)n;
+    if (up) {
+        i32 i = n - 1;
+        while (i >= 0 && d->d[i] == 9) i--;
+        if (i < 0) {
+            d->d[0] = 1;
+            d->nd   = 1;
+            d->dp++;
+            return;
+        }
+        d->d[i]++;
+        d->nd = (u32)i + 1;
+    }
+    _ail_str_decimal_trim_(d);
+}
+
+// Writes the digits of the positive finite f64 with the given `bits` into `d`, rounded to nearest (ties to even)
+// If `fixed` is true, `prec` digits after the decimal point are kept, otherwise `prec` digits after the first digit are kept
+// The shortest representation is used whenever it is guaranteed to round the same way as the exact value,
+// which is the case for all precisions, that have at most as many digits as the shortest representation, or at most 15 digits in total
+internal void _ail_fmt_float_digits_(u64 bits, b32 fixed, i32 prec, _AIL_Str_Decimal_ *d)
+{
+    d->nd    = 0;
+    d->dp    = 0;
+    d->trunc = false;
+    if (!bits) return;
+
+    u64 digits;
+    i32 exp10;
+    _ail_str_schubfach_(bits, &digits, &exp10);
+    u8  tmp[AIL_STR_INT_MAX_LEN];
+    u32 nd = ail_str_unsigned_to_buf(digits, tmp);
+    for (u32 i = 0; i < nd; i++) d->d[i] = tmp[i] - '0';
+    d->nd = nd;
+    d->dp = (i32)nd + exp10;
+    _ail_str_decimal_trim_(d);
+    i64 n = fixed ? (i64)d->dp + prec : (i64)prec + 1;
+    if (n < 0) {
+        d->nd = 0;
+        d->dp = 0;
+        return;
+    }
+    if (n >= (i64)d->nd) {
+        // Subnormals have too little precision for the shortest representation to be padded with zeros
+        if ((bits >> 52) && n <= 15) return;
+    } else if (!(d->d[n] == 5 && n + 1 == (i64)d->nd)) {
+        // Any rounding boundary between the shortest representation and the exact value would itself be shorter, unless it is a tie
+        _ail_fmt_round_digits_(d, (i32)n, d->d[n] >= 5);
+        return;
+    }
+
+    // Exact decimal expansion of the float
+    u64 man  = bits & ((1ULL << 52) - 1);
+    u32 exp2 = (u32)(bits >> 52);
+    if (exp2) man |= 1ULL << 52;
+    nd = ail_str_unsigned_to_buf(man, tmp);
+    for (u32 i = 0; i < nd; i++) d->d[i] = tmp[i] - '0';
+    d->nd = nd;
+    d->dp = (i32)nd;
+    _ail_str_decimal_trim_(d);
+    _ail_str_decimal_shift_(d, exp2 ? (i32)exp2 - 1075 : -1074);
+    n = fixed ? (i64)d->dp + prec : (i64)prec + 1;
+    if (n < 0) {
+        d->nd = 0;
+        d->dp = 0;
+    } else if (n < (i64)d->nd) {
+        b32 up = d->d[n] > 5 || (d->d[n] == 5 && (n + 1 < (i64)d->nd || d->trunc || (n > 0 && (d->d[n - 1] & 1))));
+        _ail_fmt_round_digits_(d, (i32)n, up);
+    }
+}
+
+// Writes the decimal as [-]ddd.ddd with `prec` digits after the decimal point
+internal void _ail_fmt_write_fixed_(AIL_SB *sb, const _AIL_Str_Decimal_ *d, i32 prec, b32 alt)
+{
+    u64 int_len = d->dp > 0 ? (u64)d->dp : 1;
+    ail_da_maybe_grow(sb, int_len + 1 + (u64)prec);
+    u8 *p = sb->data + sb->len;
+    if (d->dp <= 0) {
+        *p++ = '0';
+    } else {
+        for (i32 i = 0; i < d->dp; i++) *p++ = i < (i32)d->nd ? '0' + d->d[i] : '0';
+    }
+    if (prec > 0 || alt) *p++ = '.';
+    for (i32 i = d->dp; i < d->dp + prec; i++) *p++ = (i >= 0 && i < (i32)d->nd) ? '0' + d->d[i] : '0';
+    sb->len = (u64)(p - sb->data);
+}
+
+// Writes the decimal as [-]d.ddde+dd with `prec` digits after the decimal point
+internal void _ail_fmt_write_exp_(AIL_SB *sb, const _AIL_Str_Decimal_ *d, i32 prec, b32 alt, b32 upper)
+{
+    ail_da_maybe_grow(sb, (u64)prec + 8);
+    u8 *p = sb->data + sb->len;
+    *p++ = d->nd ? '0' + d->d[0] : '0';
+    if (prec > 0 || alt) *p++ = '.';
+    for (i32 i = 1; i <= prec; i++) *p++ = i < (i32)d->nd ? '0' + d->d[i] : '0';
+    i32 e = d->nd ? d->dp - 1 : 0;
+    *p++ = upper ? 'E' : 'e';
+    *p++ = e < 0 ? '-' : '+';
+    if (e < 0) e = -e;
+    if (e < 10) *p++ = '0';
+    p += ail_str_unsigned_to_buf((u64)e, p);
+    sb->len = (u64)(p - sb->data);
+}
+
+internal void _ail_fmt_write_hex_float_(AIL_SB *sb, u64 bits, i32 prec, b32 alt, b32 upper)
+{
+    const char *hex = upper ? "0123456789ABCDEF" : "0123456789abcdef";
+    u64 man  = bits & ((1ULL << 52) - 1);
+    u32 exp2 = (u32)(bits >> 52);
+    u64 lead = exp2 != 0;
+    i32 e    = !bits ? 0 : exp2 ? (i32)exp2 - 1023 : -1022;
+    i32 nd   = 13;
+    if (prec < 0) {
+        while (nd > 0 && !(man & 15)) {
+            man >>= 4;
+            nd--;
+        }
+    } else if (prec < 13) {
+        u32 shift = 4*(13 - (u32)prec);
+        u64 rem   = man & ((1ULL << shift) - 1);
+        u64 half  = 1ULL << (shift - 1);
+        man >>= shift;
+        if (rem > half || (rem == half && ((prec ? man : lead) & 1))) man++;
+        if (man >> (4*prec)) {
+            lead++;
+            man &= (1ULL << (4*prec)) - 1;
+        }
+        nd = prec;
+    }
+    ail_da_maybe_grow(sb, (u64)ail_max(prec, 13) + 12);
+    u8 *p = sb->data + sb->len;
+    *p++ = hex[lead];
+    if (nd > 0 || prec > 0 || alt) *p++ = '.';
+    for (i32 i = nd - 1; i >= 0; i--) *p++ = (u8)hex[(man >> (4*i)) & 15];
+    for (i32 i = nd; i < prec; i++)   *p++ = '0';
+    *p++ = upper ? 'P' : 'p';
+    *p++ = e < 0 ? '-' : '+';
+    p += ail_str_unsigned_to_buf((u64)(e < 0 ? -e : e), p);
+    sb->len = (u64)(p - sb->data);
+}
+
+internal void _ail_fmt_write_float_(AIL_SB *sb, const AIL_Fmt_Spec *spec, f64 val)
+{
+    _AIL_Str_F64_Bits_ conv = { .f = val };
+    u64 bits  = conv.u & ~(1ULL << 63);
+    u8  c     = spec->conv;
+    b32 upper = c == 'F' || c == 'E' || c == 'G' || c == 'A';
+    b32 alt   = spec->flags & AIL_FMT_FLAG_ALT;
+    u8  flags = spec->flags;
+    u64 start = sb->len;
+    ail_da_maybe_grow(sb, 3);
+    if      (conv.u >> 63)                 sb->data[sb->len++] = '-';
+    else if (flags & AIL_FMT_FLAG_PLUS)    sb->data[sb->len++] = '+';
+    else if (flags & AIL_FMT_FLAG_SPACE)   sb->data[sb->len++] = ' ';
+    if (bits >= _AIL_STR_F64_INF_) {
+        const char *s = bits > _AIL_STR_F64_INF_ ? (upper ? "NAN" : "nan") : (upper ? "INF" : "inf");
+        ail_da_pushn(sb, (void *)s, 3);
+        flags &= ~AIL_FMT_FLAG_ZERO;
+    } else if (c == 'a' || c == 'A') {
+        sb->data[sb->len++] = '0';
+        sb->data[sb->len++] = upper ? 'X' : 'x';
+    }
+    u64 prefix_len = sb->len - start;
+    if (bits < _AIL_STR_F64_INF_) {
+        i32 prec = spec->precision < 0 ? 6 : spec->precision;
+        _AIL_Str_Decimal_ d;
+        switch (c) {
+            case 'a': case 'A':
+                _ail_fmt_write_hex_float_(sb, bits, spec->precision, alt, upper);
+                break;
+            case 'f': case 'F':
+                _ail_fmt_float_digits_(bits, true, prec, &d);
+                _ail_fmt_write_fixed_(sb, &d, prec, alt);
+                break;
+            case 'e': case 'E':
+                _ail_fmt_float_digits_(bits, false, prec, &d);
+                _ail_fmt_write_exp_(sb, &d, prec, alt, upper);
+                break;
+            default: {
+                // %g uses the exponent X of the value rounded to P significant digits to choose between %f and %e
+                i32 p = prec ? prec : 1;
+                _ail_fmt_float_digits_(bits, false, p - 1, &d);
+                i32 x = d.nd ? d.dp - 1 : 0;
+                // Without '#', trailing zeros are removed, which the digits already are
+                if (p > x && x >= -4) {
+                    i32 fprec = p - 1 - x;
+                    if (!alt) fprec = ail_min(fprec, ail_max((i32)d.nd - d.dp, 0));
+                    _ail_fmt_write_fixed_(sb, &d, fprec, alt);
+                } else {
+                    i32 eprec = p - 1;
+                    if (!alt) eprec = ail_min(eprec, d.nd ? (i32)d.nd - 1 : 0);
+                    _ail_fmt_write_exp_(sb, &d, eprec, alt, upper);
+                }
+            } break;
+        }
+    }
+    _ail_fmt_pad_(sb, start, prefix_len, spec->width, flags);
+}
+
+// Parses the specifier at `p`, which points at a '%', into `spec`
+internal void _ail_fmt_parse_spec_(const char *p, AIL_Fmt_Spec *spec)
+{
+    const char *start = p++;
+    spec->flags = 0;
+    for (;; p++) {
+        if      (*p == '-') spec->flags |= AIL_FMT_FLAG_LEFT;
+        else if (*p == '+') spec->flags |= AIL_FMT_FLAG_PLUS;
+        else if (*p == ' ') spec->flags |= AIL_FMT_FLAG_SPACE;
+        else if (*p == '#') spec->flags |= AIL_FMT_FLAG_ALT;
+        else if (*p == '0') spec->flags |= AIL_FMT_FLAG_ZERO;
+        else break;
+    }
+    spec->width = -1;
+    if (*p == '*') {
+        spec->width = -2;
+        p++;
+    } else if (*p >= '0' && *p <= '9') {
+        for (spec->width = 0; *p >= '0' && *p <= '9'; p++) spec->width = spec->width*10 + (*p - '0');
+    }
+    spec->precision = -1;
+    if (*p == '.') {
+        p++;
+        if (*p == '*') {
+            spec->precision = -2;
+            p++;
+        } else {
+            for (spec->precision = 0; *p >= '0' && *p <= '9'; p++) spec->precision = spec->precision*10 + (*p - '0');
+        }
+    }
+    spec->length = AIL_FMT_LEN_NONE;
+    switch (*p) {
+        case 'h': spec->length = p[1] == 'h' ? AIL_FMT_LEN_HH : AIL_FMT_LEN_H; p += 1 + (p[1] == 'h'); break;
+        case 'l': spec->length = p[1] == 'l' ? AIL_FMT_LEN_LL : AIL_FMT_LEN_L; p += 1 + (p[1] == 'l'); break;
+        case 'j': spec->length = AIL_FMT_LEN_J;  p++; break;
+        case 'z': spec->length = AIL_FMT_LEN_Z;  p++; break;
+        case 't': spec->length = AIL_FMT_LEN_T;  p++; break;
+        case 'L': spec->length = AIL_FMT_LEN_LD; p++; break;
+        default: break;
+    }
+    spec->conv = 0;
+    switch (*p) {
+        case 'd': case 'i': case 'u': case 'o': case 'x': case 'X': case 'c': case 's': case 'p': case 'n':
+        case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A': case '%':
+            spec->conv = (u8)*p;
+            break;
+        default: break;
+    }
+    spec->spec_len = (u32)(p - start) + (*p != 0);
+}
+
+internal void _ail_fmt_write_arg_(AIL_SB *sb, AIL_Fmt_Spec spec, u64 start, va_list *args)
+{
+    if (spec.width == -2) {
+        i32 w = va_arg(*args, int);
+        if (w < 0) spec.flags |= AIL_FMT_FLAG_LEFT;
+        spec.width = w < 0 ? -w : w;
+    }
+    if (spec.precision == -2) {
+        i32 prec = va_arg(*args, int);
+        spec.precision = prec < 0 ? -1 : prec;
+    }
+    if (spec.width < 0) spec.width = 0;
+    if (spec.flags & AIL_FMT_FLAG_LEFT) spec.flags &= ~AIL_FMT_FLAG_ZERO;
+
+    switch (spec.conv) {
+        case 'd': case 'i': {
+            i64 v;
+            switch (spec.length) {
+                case AIL_FMT_LEN_HH: v = (signed char)va_arg(*args, int); break;
+                case AIL_FMT_LEN_H:  v = (short)va_arg(*args, int);       break;
+                case AIL_FMT_LEN_L:  v = va_arg(*args, long);             break;
+                case AIL_FMT_LEN_LL: v = va_arg(*args, long long);        break;
+                case AIL_FMT_LEN_J:  v = va_arg(*args, intmax_t);         break;
+                case AIL_FMT_LEN_Z:  v = va_arg(*args, ptrdiff_t);        break;
+                case AIL_FMT_LEN_T:  v = va_arg(*args, ptrdiff_t);        break;
+                default:             v = va_arg(*args, int);              break;
+            }
+            _ail_fmt_write_int_(sb, &spec, v < 0 ? 0 - (u64)v : (u64)v, v < 0);
+        } break;
+        case 'u': case 'o': case 'x': case 'X': {
+            u64 v;
+            switch (spec.length) {
+                case AIL_FMT_LEN_HH: v = (unsigned char)va_arg(*args, unsigned int);  break;
+                case AIL_FMT_LEN_H:  v = (unsigned short)va_arg(*args, unsigned int); break;
+                case AIL_FMT_LEN_L:  v = va_arg(*args, unsigned long);                break;
+                case AIL_FMT_LEN_LL: v = va_arg(*args, unsigned long long);           break;
+                case AIL_FMT_LEN_J:  v = va_arg(*args, uintmax_t);                    break;
+                case AIL_FMT_LEN_Z:  v = va_arg(*args, size_t);                       break;
+                case AIL_FMT_LEN_T:  v = (u64)va_arg(*args, ptrdiff_t);               break;
+                default:             v = va_arg(*args, unsigned int);                 break;
+            }
+            _ail_fmt_write_int_(sb, &spec, v, false);
+        } break;
+        case 'p': {
+            void *ptr = va_arg(*args, void *);
+            if (ptr) {
+                spec.conv   = 'x';
+                spec.flags |= AIL_FMT_FLAG_ALT;
+                _ail_fmt_write_int_(sb, &spec, (u64)(uintptr_t)ptr, false);
+            } else {
+                _ail_fmt_write_bytes_(sb, &spec, "(nil)", 5);
+            }
+        } break;
+        case 'c': {
+            char c = (char)va_arg(*args, int);
+            _ail_fmt_write_bytes_(sb, &spec, &c, 1);
+        } break;
+        case 's': {
+            const char *s = va_arg(*args, const char *);
+            if (!s) s = "(null)";
+            u64 n = 0;
+            while ((spec.precision < 0 || n < (u64)spec.precision) && s[n]) n++;
+            _ail_fmt_write_bytes_(sb, &spec, s, n);
+        } break;
+        case 'n': {
+            u64 n = sb->len - start;
+            switch (spec.length) {
+                case AIL_FMT_LEN_HH: *va_arg(*args, signed char *) = (signed char)n; break;
+                case AIL_FMT_LEN_H:  *va_arg(*args, short *)       = (short)n;       break;
+                case AIL_FMT_LEN_L:  *va_arg(*args, long *)        = (long)n;        break;
+                case AIL_FMT_LEN_LL: *va_arg(*args, long long *)   = (long long)n;   break;
+                case AIL_FMT_LEN_J:  *va_arg(*args, intmax_t *)    = (intmax_t)n;    break;
+                case AIL_FMT_LEN_Z:  *va_arg(*args, size_t *)      = (size_t)n;      break;
+                case AIL_FMT_LEN_T:  *va_arg(*args, ptrdiff_t *)   = (ptrdiff_t)n;   break;
+                default:             *va_arg(*args, int *)         = (int)n;         break;
+            }
+        } break;
+        case '%':
+            ail_da_push(sb, '%');
+            break;
+        default: { // Floats
+            f64 v = spec.length == AIL_FMT_LEN_LD ? (f64)va_arg(*args, long double) : va_arg(*args, f64);
+            _ail_fmt_write_float_(sb, &spec, v);
+        } break;
+    }
+}
+
+void ail_sb_vprint(AIL_SB *sb, const char *format, va_list args)
+{
+    // The va_list is copied, so that a pointer to it can be passed on (va_list might be an array type)
+    va_list ap;
+    va_copy(ap, args);
+    u64 start = sb->len;
+    const char *p = format;
+    for (;;) {
+        const char *lit = p;
+        while (*p && *p != '%') p++;
+        if (p > lit) ail_da_pushn(sb, (void *)lit, (u64)(p - lit));
+        if (!*p) break;
+        AIL_Fmt_Spec spec;
+        _ail_fmt_parse_spec_(p, &spec);
+        if (spec.conv) _ail_fmt_write_arg_(sb, spec, start, &ap);
+        else           ail_da_pushn(sb, (void *)p, spec.spec_len); // Invalid specifiers are written as they are
+        p += spec.spec_len;
+    }
+    va_end(ap);
+}
+
+void ail_sb_print(AIL_SB *sb, const char *format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    ail_sb_vprint(sb, format, args);
+    va_end(args);
+}
+
+AIL_Str ail_str_new_fmt_a(AIL_Allocator allocator, const char *format, ...)
+{
+    AIL_SB sb = ail_da_new_with_alloc(u8, AIL_SB_INIT_CAP, allocator);
+    va_list args;
+    va_start(args, format);
+    ail_sb_vprint(&sb, format, args);
+    va_end(args);
+    ail_da_push(&sb, 0);
+    return ail_str_from_parts(sb.data, sb.len - 1);
+}
+
+AIL_Fmt ail_fmt_compile(const char *format)
+{
+    AIL_Fmt fmt = { .format = format, .compiled = true };
+    const char *p = format;
+    for (;;) {
+        const char *lit = p;
+        while (*p && *p != '%') p++;
+        if (!*p) {
+            fmt.tail_len = (u32)(p - lit);
+            break;
+        }
+        if (fmt.count == AIL_FMT_MAX_SPECS) {
+            fmt.compiled = false;
+            break;
+        }
+        AIL_Fmt_Spec *spec = &fmt.specs[fmt.count++];
+        _ail_fmt_parse_spec_(p, spec);
+        spec->lit_len = (u32)(p - lit);
+        if (!spec->conv) spec->lit_len += spec->spec_len; // Invalid specifiers are treated as literal text
+        p += spec->spec_len;
+    }
+    return fmt;
+}
+
+void ail_sb_vprint_fmt(AIL_SB *sb, const AIL_Fmt *fmt, va_list args)
+{
+    if (!fmt->compiled) {
+        ail_sb_vprint(sb, fmt->format, args);
+        return;
+    }
+    va_list ap;
+    va_copy(ap, args);
+    u64 start = sb->len;
+    const char *p = fmt->format;
+    for (u32 i = 0; i < fmt->count; i++) {
+        const AIL_Fmt_Spec *spec = &fmt->specs[i];
+        ail_da_pushn(sb, (void *)p, spec->lit_len);
+        if (spec->conv) {
+            _ail_fmt_write_arg_(sb, *spec, start, &ap);
+            p += spec->spec_len;
+        }
+        p += spec->lit_len;
+    }
+    ail_da_pushn(sb, (void *)p, fmt->tail_len);
+    va_end(ap);
+}
+
+void ail_sb_print_fmt(AIL_SB *sb, const AIL_Fmt *fmt, ...)
+{
+    va_list args;
+    va_start(args, fmt);
+    ail_sb_vprint_fmt(sb, fmt, args);
+    va_end(args);
+}
+
+AIL_WARN_POP
+#endif // _AIL_FMT_IMPL_GUARD_
+#endif // AIL_NO_FMT_IMPL
@@ -0,0 +1,239 @@
+/*
+*** Gap-Buffer ***
+*
+* A gap-buffer stores text in a single allocation, that contains an unused region (the gap) at the current editing position:
+*     [ text before gap | gap | text after gap ]
+* Inserting or removing text at the gap is O(1), while moving the gap costs time proportional to the distance it is moved
+* Since edits usually happen close to each other (i.e. when typing or when rewriting a log line by line),
+* inserting and removing text is amortized O(1) in practice
+*
+* The text before and after the gap can always be received as AIL_Str views without copying (see ail_gapbuf_before/after)
+* To view any other range of the text as a single AIL_Str, the gap is moved out of that range first (see ail_gapbuf_view)
+*
+* For very large documents with edits spread across the whole text, see the rope in ail_rope.h instead
+*/
+
+#ifndef _AIL_GAPBUF_H_
+#define _AIL_GAPBUF_H_
+
+#include "ail_base.h"
+#include "ail_base_math.h"
+#include "ail_mem.h"
+#include "ail_arr.h"
+#include "ail_str.h"
+
+AIL_WARN_PUSH
+AIL_WARN_DISABLE(AIL_WARN_UNUSED_FUNCTION)
+
+#ifndef AIL_GAPBUF_INIT_CAP
+#   define AIL_GAPBUF_INIT_CAP AIL_SB_INIT_CAP
+#endif
+
+typedef struct AIL_GapBuf {
+    u8 *data;
+    u64 cap;
+    u64 gap_start;
+    u64 gap_end;
+    AIL_Allocator allocator;
+} AIL_GapBuf;
+
+internal AIL_GapBuf ail_gapbuf_new_a(u64 cap, AIL_Allocator allocator);
+// Copies `str` into the new buffer and places the gap at the end of the text
+internal AIL_GapBuf ail_gapbuf_new_from_str_a(AIL_Str str, AIL_Allocator allocator);
+internal void ail_gapbuf_free(AIL_GapBuf *gb);
+#define ail_gapbuf_new()             ail_gapbuf_new_a(AIL_GAPBUF_INIT_CAP, ail_default_allocator)
+#define ail_gapbuf_new_cap(cap)      ail_gapbuf_new_a(cap, ail_default_allocator)
+#define ail_gapbuf_new_from_str(str) ail_gapbuf_new_from_str_a(str, ail_default_allocator)
+
+inline_func u64 ail_gapbuf_len    (AIL_GapBuf gb);
+inline_func u64 ail_gapbuf_gap_len(AIL_GapBuf gb);
+inline_func u8  ail_gapbuf_get    (AIL_GapBuf gb, u64 idx);
+inline_func AIL_Str ail_gapbuf_before(AIL_GapBuf gb);
+inline_func AIL_Str ail_gapbuf_after (AIL_GapBuf gb);
+
+// Move the gap to start at `pos`
+internal void ail_gapbuf_move_gap(AIL_GapBuf *gb, u64 pos);
+// Make sure, that at least `n` bytes can be inserted without reallocating
+internal void ail_gapbuf_reserve (AIL_GapBuf *gb, u64 n);
+internal void ail_gapbuf_insert  (AIL_GapBuf *gb, u64 pos, AIL_Str str);
+internal void ail_gapbuf_insert_char(AIL_GapBuf *gb, u64 pos, u8 c);
+// Remove `n` bytes starting at `pos`, if there are less than `n` bytes after `pos`, all of them are removed
+internal void ail_gapbuf_rm      (AIL_GapBuf *gb, u64 pos, u64 n);
+internal void ail_gapbuf_clear   (AIL_GapBuf *gb);
+#define ail_gapbuf_push(gbPtr, str)   ail_gapbuf_insert(gbPtr, ail_gapbuf_len(*(gbPtr)), str)
+
+// Receive a view to the text in range [start, start + len)
+// @Note: If the range contains the gap, the gap is moved to whichever end of the range is closer
+// @Important: The view is only valid until the buffer is modified the next time
+internal AIL_Str ail_gapbuf_view(AIL_GapBuf *gb, u64 start, u64 len);
+// Moves the gap to the end of the text and returns a view to the whole text
+// @Important: The view is only valid until the buffer is modified the next time
+internal AIL_Str ail_gapbuf_to_str(AIL_GapBuf *gb);
+// Copy the text in range [start, start + len) into `dst` without moving the gap
+internal void ail_gapbuf_copy_to(AIL_GapBuf gb, u64 start, u64 len, u8 *dst);
+
+AIL_WARN_POP
+#endif // _AIL_GAPBUF_H_
+
+
+#if !defined(AIL_NO_GAPBUF_IMPL) && !defined(AIL_NO_BASE_IMPL) && !defined(AIL_NO_IMPL)
+#ifndef _AIL_GAPBUF_IMPL_GUARD_
+#define _AIL_GAPBUF_IMPL_GUARD_
+AIL_WARN_PUSH
+AIL_WARN_DISABLE(AIL_WARN_UNUSED_FUNCTION)
+
+AIL_GapBuf ail_gapbuf_new_a(u64 cap, AIL_Allocator allocator)
+{
+    return (AIL_GapBuf) {
+        .data      = cap ? ail_call_alloc(allocator, cap) : NULL,
+        .cap       = cap,
+        .gap_start = 0,
+        .gap_end   = cap,
+        .allocator = allocator,
+    };
+}
+
+AIL_GapBuf ail_gapbuf_new_from_str_a(AIL_Str str, AIL_Allocator allocator)
+{
+    AIL_GapBuf gb = ail_gapbuf_new_a(ail_max(str.len + AIL_GAPBUF_INIT_CAP, 2*str.len), allocator);
+    ail_mem_copy(gb.data, str.data, str.len);
+    gb.gap_start = str.len;
+    return gb;
+}
+
+void ail_gapbuf_free(AIL_GapBuf *gb)
+{
+    if (gb->data) ail_call_free(gb->allocator, gb->data);
+    gb->data = NULL;
+    gb->cap  = gb->gap_start = gb->gap_end = 0;
+}
+
+u64 ail_gapbuf_len(AIL_GapBuf gb)
+{
+    return gb.cap - (gb.gap_end - gb.gap_start);
+}
+
+u64 ail_gapbuf_gap_len(AIL_GapBuf gb)
+{
+    return gb.gap_end - gb.gap_start;
+}
+
+u8 ail_gapbuf_get(AIL_GapBuf gb, u64 idx)
+{
+    ail_assert(idx < ail_gapbuf_len(gb));
+    return gb.data[idx < gb.gap_start ? idx : idx + (gb.gap_end - gb.gap_start)];
+}
+
+AIL_Str ail_gapbuf_before(AIL_GapBuf gb)
+{
+    return ail_str_from_parts(gb.data, gb.gap_start);
+}
+
+AIL_Str ail_gapbuf_after(AIL_GapBuf gb)
+{
+    return ail_str_from_parts(gb.data + gb.gap_end, gb.cap - gb.gap_end);
+}
+
+void ail_gapbuf_move_gap(AIL_GapBuf *gb, u64 pos)
+{
+    ail_assert(pos <= ail_gapbuf_len(*gb));
+    u64 gap_len = gb->gap_end - gb->gap_start;
+    if (pos < gb->gap_start) {
+        // [pos, gap_start) is moved to the end of the gap
+        ail_mem_copy(gb->data + pos + gap_len, gb->data + pos, gb->gap_start - pos);
+    } else if (pos > gb->gap_start) {
+        // [gap_end, gap_end + (pos - gap_start)) is moved to the start of the gap
+        ail_mem_copy(gb->data + gb->gap_start, gb->data + gb->gap_end, pos - gb->gap_start);
+    }
+    gb->gap_start = pos;
+    gb->gap_end   = pos + gap_len;
+}
+
+void ail_gapbuf_reserve(AIL_GapBuf *gb, u64 n)
+{
+    u64 gap_len = gb->gap_end - gb->gap_start;
+    if (gap_len < n) {
+        // The whole allocation (including the gap) is treated as the array, so that growing it opens up a gap at gap_end
+        u64 len     = gb->cap;
+        u64 len_txt = ail_gapbuf_len(*gb);
+        u64 new_cap = ail_max(ail_arr_grow_cap(gb->cap, len_txt, n), AIL_GAPBUF_INIT_CAP);
+        u64 grow_by = new_cap - gb->cap;
+        ail_arr_grow_with_gap((void **)&gb->data, &gb->cap, &len, 1, new_cap, gb->gap_end, grow_by, gb->allocator);
+        gb->gap_end += grow_by;
+    }
+}
+
+void ail_gapbuf_insert(AIL_GapBuf *gb, u64 pos, AIL_Str str)
+{
+    if (!str.len) return;
+    ail_gapbuf_reserve(gb, str.len);
+    ail_gapbuf_move_gap(gb, pos);
+    ail_mem_copy(gb->data + gb->gap_start, str.data, str.len);
+    gb->gap_start += str.len;
+}
+
+void ail_gapbuf_insert_char(AIL_GapBuf *gb, u64 pos, u8 c)
+{
+    ail_gapbuf_reserve(gb, 1);
+    ail_gapbuf_move_gap(gb, pos);
+    gb->data[gb->gap_start++] = c;
+}
+
+void ail_gapbuf_rm(AIL_GapBuf *gb, u64 pos, u64 n)
+{
+    u64 len = ail_gapbuf_len(*gb);
+    ail_assert(pos <= len);
+    n = ail_min(n, len - pos);
+    if (!n) return;
+    // Remove by only moving the gap as little as possible and then widening it
+    if (pos + n <= gb->gap_start) {
+        ail_gapbuf_move_gap(gb, pos + n);
+        gb->gap_start -= n;
+    } else {
+        ail_gapbuf_move_gap(gb, ail_max(pos, gb->gap_start));
+        u64 before = gb->gap_start - pos; // Amount of bytes to remove before the gap
+        gb->gap_start -= before;
+        gb->gap_end   += n - before;
+    }
+}
+
+void ail_gapbuf_clear(AIL_GapBuf *gb)
+{
+    gb->gap_start = 0;
+    gb->gap_end   = gb->cap;
+}
+
+AIL_Str ail_gapbuf_view(AIL_GapBuf *gb, u64 start, u64 len)
+{
+    ail_assert(start + len <= ail_gapbuf_len(*gb));
+    if (start + len <= gb->gap_start) return ail_str_from_parts(gb->data + start, len);
+    if (start >= gb->gap_start)       return ail_str_from_parts(gb->data + start + (gb->gap_end - gb->gap_start), len);
+    // The range contains the gap, so we move the gap to the closer end of the range
+    if (gb->gap_start - start < start + len - gb->gap_start) ail_gapbuf_move_gap(gb, start);
+    else                                                     ail_gapbuf_move_gap(gb, start + len);
+    return ail_gapbuf_view(gb, start, len);
+}
+
+AIL_Str ail_gapbuf_to_str(AIL_GapBuf *gb)
+{
+    u64 len = ail_gapbuf_len(*gb);
+    ail_gapbuf_move_gap(gb, len);
+    return ail_str_from_parts(gb->data, len);
+}
+
+void ail_gapbuf_copy_to(AIL_GapBuf gb, u64 start, u64 len, u8 *dst)
+{
+    ail_assert(start + len <= ail_gapbuf_len(gb));
+    if (start < gb.gap_start) {
+        u64 n = ail_min(len, gb.gap_start - start);
+        ail_mem_copy(dst, gb.data + start, n);
+        dst   += n;
+        start += n;
+        len   -= n;
+    }
+    if (len) ail_mem_copy(dst, gb.data + start + (gb.gap_end - gb.gap_start), len);
+}
+
+AIL_WARN_POP
+#endif // _AIL_GAPBUF_IMPL_GUARD_
+#endif // AIL_NO_GAPBUF_IMPL
@@ -0,0 +1,240 @@
+/*
+*** Heaps / Priority Queues ***
+* Heaps are implemented as duck-typed templates through macros, just like arrays (see ail_arr.h)
+* The following kinds of heaps are implemented:
+  * Heap: Any Dynamic Array (AIL_DA) can be used as a heap
+    * The heap's arity is configurable (see `ail_dheap_*`), with binary (`ail_heap_*`) and 4-ary (`ail_heap4_*`) heaps provided out of the box
+    * 4-ary heaps are shallower and check all children of a node in one or two cache lines, which is usually faster for larger heaps
+  * IHEAP: "Indexed Heap"
+    * Stores ids into a fixed-size key-array and keeps track of each id's position in the heap
+    * This allows changing the key of any id in O(log n), which is useful for i.e. schedulers or Dijkstra's algorithm
+*
+* All heaps are min-heaps regarding the provided `less` comparison, which is invoked as `less(a, b)` on two elements.
+* `less` can be a function or a function-like macro. For a max-heap, simply provide a greater-than comparison instead.
+* The macros `ail_heap_lt` and `ail_heap_gt` are provided for comparing primitive types.
+*
+* @Note: Heaps always reserve one element past their length as scratch space for moving elements.
+* This avoids requiring a way of creating temporary variables of the element's type
+*/
+
+#ifndef _AIL_HEAP_H_
+#define _AIL_HEAP_H_
+
+#include "./ail_base.h"
+#include "./ail_arr.h"
+#include "./ail_mem.h"
+
+AIL_WARN_PUSH
+AIL_WARN_DISABLE(AIL_WARN_UNUSED_FUNCTION)
+
+#define ail_heap_lt(a, b) ((a) < (b))
+#define ail_heap_gt(a, b) ((a) > (b))
+
+/////////////////////////
+// Heap
+/////////////////////////
+
+#define _ail_dheap_scratch_(daPtr) (daPtr)->data[(daPtr)->len]
+
+#define _ail_dheap_sift_up_(daPtr, idx, less, d) do {                                              \
+        u64 _ail_heap_i_ = (idx);                                                                  \
+        _ail_dheap_scratch_(daPtr) = (daPtr)->data[_ail_heap_i_];                                  \
+        while (_ail_heap_i_ > 0) {                                                                 \
+            u64 _ail_heap_p_ = (_ail_heap_i_ - 1)/(d);                                             \
+            if (!less(_ail_dheap_scratch_(daPtr), (daPtr)->data[_ail_heap_p_])) break;             \
+            (daPtr)->data[_ail_heap_i_] = (daPtr)->data[_ail_heap_p_];                             \
+            _ail_heap_i_ = _ail_heap_p_;                                                           \
+        }                                                                                          \
+        (daPtr)->data[_ail_heap_i_] = _ail_dheap_scratch_(daPtr);                                  \
+    } while(0)
+
+// @Note: Expects the element to be moved down to already be stored in the scratch space
+#define _ail_dheap_sift_down_scratch_(daPtr, idx, less, d) do {                                    \
+        u64 _ail_heap_i_ = (idx);                                                                  \
+        for (;;) {                                                                                 \
+            u64 _ail_heap_c_ = (d)*_ail_heap_i_ + 1;                                               \
+            if (_ail_heap_c_ >= (daPtr)->len) break;                                               \
+            u64 _ail_heap_end_ = ail_min(_ail_heap_c_ + (d), (daPtr)->len);                        \
+            u64 _ail_heap_m_   = _ail_heap_c_;                                                     \
+            for (u64 _ail_heap_k_ = _ail_heap_c_ + 1; _ail_heap_k_ < _ail_heap_end_; _ail_heap_k_++) { \
+                if (less((daPtr)->data[_ail_heap_k_], (daPtr)->data[_ail_heap_m_])) _ail_heap_m_ = _ail_heap_k_; \
+            }                                                                                      \
+            if (!less((daPtr)->data[_ail_heap_m_], _ail_dheap_scratch_(daPtr))) break;             \
+            (daPtr)->data[_ail_heap_i_] = (daPtr)->data[_ail_heap_m_];                             \
+            _ail_heap_i_ = _ail_heap_m_;                                                           \
+        }                                                                                          \
+        (daPtr)->data[_ail_heap_i_] = _ail_dheap_scratch_(daPtr);                                  \
+    } while(0)
+
+#define _ail_dheap_sift_down_(daPtr, idx, less, d) do {                   \
+        _ail_dheap_scratch_(daPtr) = (daPtr)->data[(idx)];                \
+        _ail_dheap_sift_down_scratch_(daPtr, idx, less, d);               \
+    } while(0)
+
+#define ail_dheap_peek(daPtr) ((daPtr)->data[0])
+
+#define ail_dheap_push(daPtr, elem, less, d) do {                         \
+        ail_da_maybe_grow(daPtr, 2);                                      \
+        (daPtr)->data[(daPtr)->len++] = (elem);                           \
+        _ail_dheap_sift_up_(daPtr, (daPtr)->len - 1, less, d);            \
+    } while(0)
+
+// Removes the smallest element from the heap and stores it in `out`
+#define ail_dheap_pop(daPtr, out, less, d) do {                           \
+        ail_assert((daPtr)->len > 0, "Cannot pop from an empty heap");    \
+        (out) = (daPtr)->data[0];                                         \
+        if (--(daPtr)->len) _ail_dheap_sift_down_scratch_(daPtr, 0, less, d); \
+    } while(0)
+
+// Replaces the element at `idx` with `elem`, which must not be greater than the previous element at this index
+#define ail_dheap_decrease_key(daPtr, idx, elem, less, d) do {            \
+        ail_da_maybe_grow(daPtr, 1);                                      \
+        (daPtr)->data[(idx)] = (elem);                                    \
+        _ail_dheap_sift_up_(daPtr, idx, less, d);                         \
+    } while(0)
+
+// Reorders the elements of any Dynamic Array in O(n) to turn it into a heap
+#define ail_dheap_heapify(daPtr, less, d) do {                                                      \
+        ail_da_maybe_grow(daPtr, 1);                                                                \
+        if ((daPtr)->len > 1) {                                                                     \
+            for (u64 _ail_heapify_i_ = ((daPtr)->len - 2)/(d) + 1; _ail_heapify_i_ > 0; _ail_heapify_i_--) { \
+                _ail_dheap_sift_down_(daPtr, _ail_heapify_i_ - 1, less, d);                         \
+            }                                                                                       \
+        }                                                                                           \
+    } while(0)
+
+#define ail_heap_peek(daPtr)                           ail_dheap_peek(daPtr)
+#define ail_heap_push(daPtr, elem, less)               ail_dheap_push(daPtr, elem, less, 2)
+#define ail_heap_pop(daPtr, out, less)                 ail_dheap_pop(daPtr, out, less, 2)
+#define ail_heap_decrease_key(daPtr, idx, elem, less)  ail_dheap_decrease_key(daPtr, idx, elem, less, 2)
+#define ail_heap_heapify(daPtr, less)                  ail_dheap_heapify(daPtr, less, 2)
+
+#define ail_heap4_peek(daPtr)                          ail_dheap_peek(daPtr)
+#define ail_heap4_push(daPtr, elem, less)              ail_dheap_push(daPtr, elem, less, 4)
+#define ail_heap4_pop(daPtr, out, less)                ail_dheap_pop(daPtr, out, less, 4)
+#define ail_heap4_decrease_key(daPtr, idx, elem, less) ail_dheap_decrease_key(daPtr, idx, elem, less, 4)
+#define ail_heap4_heapify(daPtr, less)                 ail_dheap_heapify(daPtr, less, 4)
+
+
+/////////////////////////
+// Indexed Heap
+/////////////////////////
+
+// Position of all ids that are currently not stored in the heap
+#define AIL_IHEAP_NONE 0xffffffff
+
+// @Note: `keys[id]` stores the key of `id`, `ids` is the actual heap and `pos[id]` stores the index of `id` in `ids`
+// `cap` is the maximum amount of ids, which are in the range [0, cap)
+#define AIL_IHEAP_INIT(T) typedef struct AIL_IHEAP_##T { T *keys; u32 *ids; u32 *pos; u32 len; u32 cap; AIL_Allocator allocator; } AIL_IHEAP_##T
+#define AIL_IHEAP(T) AIL_IHEAP_##T
+
+inline_func u32 *ail_iheap_new_pos(u32 cap, AIL_Allocator allocator);
+
+#define ail_iheap_new(T, c)                 ail_iheap_new_with_alloc(T, c, ail_default_allocator)
+#define ail_iheap_new_with_alloc(T, c, al)  { .keys = ail_call_alloc((al), sizeof(T)*(c)), .ids = ail_call_alloc((al), sizeof(u32)*(c)), .pos = ail_iheap_new_pos((c), (al)), .len = 0, .cap = (c), .allocator = (al) }
+#define ail_iheap_new_t(T, c)                (AIL_IHEAP(T))ail_iheap_new(T, c)
+#define ail_iheap_new_with_alloc_t(T, c, al) (AIL_IHEAP(T))ail_iheap_new_with_alloc(T, c, al)
+#define ail_iheap_free(ihPtr) do {                                                       \
+        ail_call_free((ihPtr)->allocator, (ihPtr)->keys);                                \
+        ail_call_free((ihPtr)->allocator, (ihPtr)->ids);                                 \
+        ail_call_free((ihPtr)->allocator, (ihPtr)->pos);                                 \
+        (ihPtr)->keys = NULL; (ihPtr)->ids = NULL; (ihPtr)->pos = NULL;                  \
+        (ihPtr)->len  = 0;    (ihPtr)->cap = 0;                                          \
+    } while(0)
+
+#define _ail_iheap_key_at_(ihPtr, idx) (ihPtr)->keys[(ihPtr)->ids[(idx)]]
+#define _ail_iheap_place_(ihPtr, idx, id) do { (ihPtr)->ids[(idx)] = (id); (ihPtr)->pos[(id)] = (idx); } while(0)
+
+#define _ail_iheap_sift_up_(ihPtr, idx, less) do {                                                      \
+        u32 _ail_iheap_i_  = (idx);                                                                     \
+        u32 _ail_iheap_id_ = (ihPtr)->ids[_ail_iheap_i_];                                               \
+        while (_ail_iheap_i_ > 0) {                                                                     \
+            u32 _ail_iheap_p_ = (_ail_iheap_i_ - 1)/2;                                                  \
+            if (!less((ihPtr)->keys[_ail_iheap_id_], _ail_iheap_key_at_(ihPtr, _ail_iheap_p_))) break;  \
+            _ail_iheap_place_(ihPtr, _ail_iheap_i_, (ihPtr)->ids[_ail_iheap_p_]);                       \
+            _ail_iheap_i_ = _ail_iheap_p_;                                                              \
+        }                                                                                               \
+        _ail_iheap_place_(ihPtr, _ail_iheap_i_, _ail_iheap_id_);                                        \
+    } while(0)
+
+#define _ail_iheap_sift_down_(ihPtr, idx, less) do {                                                    \
+        u32 _ail_iheap_i_  = (idx);                                                                     \
+        u32 _ail_iheap_id_ = (ihPtr)->ids[_ail_iheap_i_];                                               \
+        for (;;) {                                                                                      \
+            u32 _ail_iheap_c_ = 2*_ail_iheap_i_ + 1;                                                    \
+            if (_ail_iheap_c_ >= (ihPtr)->len) break;                                                   \
+            if (_ail_iheap_c_ + 1 < (ihPtr)->len &&                                                     \
+                less(_ail_iheap_key_at_(ihPtr, _ail_iheap_c_ + 1), _ail_iheap_key_at_(ihPtr, _ail_iheap_c_))) _ail_iheap_c_++; \
+            if (!less(_ail_iheap_key_at_(ihPtr, _ail_iheap_c_), (ihPtr)->keys[_ail_iheap_id_])) break;  \
+            _ail_iheap_place_(ihPtr, _ail_iheap_i_, (ihPtr)->ids[_ail_iheap_c_]);                       \
+            _ail_iheap_i_ = _ail_iheap_c_;                                                              \
+        }                                                                                               \
+        _ail_iheap_place_(ihPtr, _ail_iheap_i_, _ail_iheap_id_);                                        \
+    } while(0)
+
+#define ail_iheap_contains(ihPtr, id) ((ihPtr)->pos[(id)] != AIL_IHEAP_NONE)
+#define ail_iheap_peek(ihPtr)         ((ihPtr)->ids[0])
+#define ail_iheap_peek_key(ihPtr)     _ail_iheap_key_at_(ihPtr, 0)
+#define ail_iheap_key(ihPtr, id)      ((ihPtr)->keys[(id)])
+
+// @Note: `id` must not already be contained in the heap
+#define ail_iheap_push(ihPtr, id, key, less) do {                                         \
+        ail_assert((id) < (ihPtr)->cap && !ail_iheap_contains(ihPtr, id));                \
+        (ihPtr)->keys[(id)] = (key);                                                      \
+        _ail_iheap_place_(ihPtr, (ihPtr)->len, id);                                       \
+        (ihPtr)->len++;                                                                   \
+        _ail_iheap_sift_up_(ihPtr, (ihPtr)->len - 1, less);                               \
+    } while(0)
+
+// Removes the id with the smallest key from the heap and stores it in `outId`
+#define ail_iheap_pop(ihPtr, outId, less) do {                                            \
+        ail_assert((ihPtr)->len > 0, "Cannot pop from an empty heap");                    \
+        (outId) = (ihPtr)->ids[0];                                                        \
+        (ihPtr)->pos[(ihPtr)->ids[0]] = AIL_IHEAP_NONE;                                   \
+        if (--(ihPtr)->len) {                                                             \
+            _ail_iheap_place_(ihPtr, 0, (ihPtr)->ids[(ihPtr)->len]);                      \
+            _ail_iheap_sift_down_(ihPtr, 0, less);                                        \
+        }                                                                                 \
+    } while(0)
+
+// Sets the key of `id` to `key`, which must not be greater than its previous key
+#define ail_iheap_decrease_key(ihPtr, id, key, less) do {                                 \
+        ail_assert(ail_iheap_contains(ihPtr, id));                                        \
+        (ihPtr)->keys[(id)] = (key);                                                      \
+        _ail_iheap_sift_up_(ihPtr, (ihPtr)->pos[(id)], less);                             \
+    } while(0)
+
+// Sets the key of `id` to `key`, which may be greater or smaller than its previous key
+#define ail_iheap_update(ihPtr, id, key, less) do {                                       \
+        ail_assert(ail_iheap_contains(ihPtr, id));                                        \
+        (ihPtr)->keys[(id)] = (key);                                                      \
+        _ail_iheap_sift_up_(ihPtr, (ihPtr)->pos[(id)], less);                             \
+        _ail_iheap_sift_down_(ihPtr, (ihPtr)->pos[(id)], less);                           \
+    } while(0)
+
+// Pushes `id` if it isn't contained in the heap yet, otherwise its key is updated
+#define ail_iheap_push_or_update(ihPtr, id, key, less) do {                               \
+        if (ail_iheap_contains(ihPtr, id)) ail_iheap_update(ihPtr, id, key, less);        \
+        else                               ail_iheap_push(ihPtr, id, key, less);          \
+    } while(0)
+
+AIL_WARN_POP
+#endif // _AIL_HEAP_H_
+
+
+#if !defined(AIL_NO_HEAP_IMPL) && !defined(AIL_NO_BASE_IMPL) && !defined(AIL_NO_IMPL)
+#ifndef _AIL_HEAP_IMPL_GUARD_
+#define _AIL_HEAP_IMPL_GUARD_
+AIL_WARN_PUSH
+AIL_WARN_DISABLE(AIL_WARN_UNUSED_FUNCTION)
+
+u32 *ail_iheap_new_pos(u32 cap, AIL_Allocator allocator)
+{
+    u32 *pos = ail_call_alloc(allocator, sizeof(u32)*cap);
+    ail_mem_set(pos, 0xff, sizeof(u32)*cap);
+    return pos;
+}
+
+AIL_WARN_POP
+#endif // _AIL_HEAP_IMPL_GUARD_
+#endif // AIL_NO_HEAP_IMPL
@@ -0,0 +1,414 @@
+/*
+*** Multi-Needle Search ***
+*
+* Compiles a set of needles once, so that any amount of haystacks can be searched for all of them at the same time
+* This is much faster than ail_str_find_of when searching for many needles or when searching many haystacks
+*
+* Two engines are used internally:
+* - For up to AIL_MULTIFIND_TEDDY_MAX needles, the "Teddy" algorithm (from Intel's Hyperscan) is used if SSSE3 or NEON is available.
+*   It looks up the nibbles of up to 3 bytes of each position via shuffles, to find the candidate positions for all needles at once
+* - Otherwise an Aho-Corasick automaton is used, which is compiled into a DFA.
+*   To keep the DFA small, bytes that behave the same in all needles share the same equivalence class,
+*   so each state only needs as many transitions as there are distinct bytes in the needles
+*
+* Usage:
+  * `AIL_MultiFind mf = ail_multifind_new(needles, needles_count);`
+  * `AIL_Str_Find_Of_Res res = ail_multifind_first(&mf, line);`
+  * `AIL_DA(AIL_Str_Find_Of_Res) all = ail_multifind_all(&mf, line);`
+  * `AIL_Str replaced = ail_multifind_replace(&mf, line, replacements);`
+  * `ail_multifind_free(&mf);`
+*
+* @Note: Empty needles are ignored
+*/
+
+#ifndef _AIL_MULTIFIND_H_
+#define _AIL_MULTIFIND_H_
+
+#include "ail_base.h"
+#include "ail_base_math.h"
+#include "ail_mem.h"
+#include "ail_arr.h"
+#include "ail_str.h"
+#include "ail_simd.h"
+
+AIL_WARN_PUSH
+AIL_WARN_DISABLE(AIL_WARN_UNUSED_FUNCTION)
+
+// Teddy stores one bit per needle in each lookup-table, so at most 8 needles are supported
+#define AIL_MULTIFIND_TEDDY_MAX 8
+#define AIL_MULTIFIND_TEDDY_LEN 3
+
+AIL_DA_INIT(AIL_Str_Find_Of_Res);
+
+typedef struct AIL_MultiFind {
+    AIL_Str *needles; // Copies of the needles, which are all stored in the same allocation
+    u32  needles_count;
+    u32  max_len;
+    // Aho-Corasick DFA
+    u32  classes_count;
+    u32  states_count;
+    u16  classes[256];  // Equivalence class of each byte
+    u32 *delta;         // Transitions stored as `state*classes_count + class`. The highest bit is set if the target state has matches
+    i32 *state_needle;  // Lowest index of the needles that end in each state or -1
+    u32 *state_link;    // Next state on the suffix-path that has matches or 0
+    i32 *same_next;     // Index of the next needle with the same content as this one or -1
+    // Teddy
+    b32  use_teddy;
+    u32  teddy_len;
+    u8   teddy_lo[AIL_MULTIFIND_TEDDY_LEN][16];
+    u8   teddy_hi[AIL_MULTIFIND_TEDDY_LEN][16];
+    AIL_Allocator allocator;
+} AIL_MultiFind;
+
+// The needles are copied, so they don't need to outlive the compiled matcher
+internal AIL_MultiFind ail_multifind_new_a(AIL_Str *needles, u32 needles_count, AIL_Allocator allocator);
+internal void ail_multifind_free(AIL_MultiFind *mf);
+#define ail_multifind_new(needles, needles_count) ail_multifind_new_a(needles, needles_count, ail_default_allocator)
+
+// Returns the match with the lowest start index in `str`
+// If several needles match at that index, the one with the lowest index is returned
+// If no needle is found, both indices are set to -1
+internal AIL_Str_Find_Of_Res ail_multifind_first(AIL_MultiFind *mf, AIL_Str str);
+// Returns all (possibly overlapping) matches in `str`, sorted by their start index and then by their needle index
+// @Important: Remember to free the returned array with ail_da_free
+internal AIL_DA(AIL_Str_Find_Of_Res) ail_multifind_all_a(AIL_MultiFind *mf, AIL_Str str, AIL_Allocator allocator);
+#define ail_multifind_all(mf, str) ail_multifind_all_a(mf, str, ail_default_allocator)
+
+// Replaces every match of the i-th needle with `replacements[i]`, after computing the exact size of the result in one pass
+// Matches are replaced from left to right and never overlap. If several needles match at the same index, the one with the lowest index is replaced
+// @Important: Copies the text to a new null-terminated string. Remember to free it with ail_str_free
+internal AIL_Str ail_multifind_replace_a(AIL_MultiFind *mf, AIL_Str str, AIL_Str *replacements, AIL_Allocator allocator);
+#define ail_multifind_replace(mf, str, replacements) ail_multifind_replace_a(mf, str, replacements, ail_default_allocator)
+// Replaces every match of `from[i]` with `to[i]` (see ail_multifind_replace_a)
+// @Note: Compiles a new matcher on every call, so prefer ail_multifind_replace_a when replacing in several strings
+internal AIL_Str ail_str_replace_many_a(AIL_Str str, AIL_Str *from, AIL_Str *to, u32 n, AIL_Allocator allocator);
+#define ail_str_replace_many(str, from, to, n) ail_str_replace_many_a(str, from, to, n, ail_default_allocator)
+
+AIL_WARN_POP
+#endif // _AIL_MULTIFIND_H_
+
+
+#if !defined(AIL_NO_MULTIFIND_IMPL) && !defined(AIL_NO_BASE_IMPL) && !defined(AIL_NO_IMPL)
+#ifndef _AIL_MULTIFIND_IMPL_GUARD_
+#define _AIL_MULTIFIND_IMPL_GUARD_
+AIL_WARN_PUSH
+AIL_WARN_DISABLE(AIL_WARN_UNUSED_FUNCTION)
+
+#define _AIL_MULTIFIND_MATCH_BIT_  0x80000000u
+#define _AIL_MULTIFIND_STATE_MASK_ 0x7fffffffu
+
+#if AIL_SIMD_SSSE3
+#   define _AIL_MULTIFIND_TEDDY_SIMD_ 1
+#   define _AIL_MULTIFIND_LANE_BITS_  1
+    typedef __m128i _ail_multifind_vec_;
+#   define _ail_multifind_vec_load_(p)         _mm_loadu_si128((__m128i *)(p))
+#   define _ail_multifind_vec_store_(p, v)     _mm_storeu_si128((__m128i *)(p), v)
+#   define _ail_multifind_vec_and_(a, b)       _mm_and_si128(a, b)
+#   define _ail_multifind_vec_lookup_(tbl, v)  _mm_shuffle_epi8(tbl, v)
+#   define _ail_multifind_vec_lo_nibble_(v)    _mm_and_si128(v, _mm_set1_epi8(0x0f))
+#   define _ail_multifind_vec_hi_nibble_(v)    _mm_and_si128(_mm_srli_epi16(v, 4), _mm_set1_epi8(0x0f))
+#   define _ail_multifind_vec_nonzero_mask_(v) ((u64)(u32)(~_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_setzero_si128())) & 0xffff))
+#elif AIL_SIMD_NEON
+#   define _AIL_MULTIFIND_TEDDY_SIMD_ 1
+#   define _AIL_MULTIFIND_LANE_BITS_  4
+    typedef uint8x16_t _ail_multifind_vec_;
+#   define _ail_multifind_vec_load_(p)         vld1q_u8(p)
+#   define _ail_multifind_vec_store_(p, v)     vst1q_u8(p, v)
+#   define _ail_multifind_vec_and_(a, b)       vandq_u8(a, b)
+#   define _ail_multifind_vec_lookup_(tbl, v)  vqtbl1q_u8(tbl, v)
+#   define _ail_multifind_vec_lo_nibble_(v)    vandq_u8(v, vdupq_n_u8(0x0f))
+#   define _ail_multifind_vec_hi_nibble_(v)    vshrq_n_u8(v, 4)
+#   define _ail_multifind_vec_nonzero_mask_(v) (vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(vtstq_u8(v, v)), 4)), 0) & 0x8888888888888888ULL)
+#else
+#   define _AIL_MULTIFIND_TEDDY_SIMD_ 0
+#endif
+
+internal b32 _ail_multifind_match_at_(AIL_Str str, u64 pos, AIL_Str needle)
+{
+    if (pos + needle.len > str.len) return false;
+    for (u64 i = 0; i < needle.len; i++) {
+        if (str.data[pos + i] != needle.data[i]) return false;
+    }
+    return true;
+}
+
+// Adds a match to `all`, while keeping the array sorted by start index and needle index
+// Since matches are found in order of their end index, they only need to be moved by a few places
+internal void _ail_multifind_push_sorted_(AIL_DA(AIL_Str_Find_Of_Res) *all, AIL_Str_Find_Of_Res res)
+{
+    ail_da_push(all, res);
+    u64 i = all->len - 1;
+    while (i > 0) {
+        AIL_Str_Find_Of_Res prev = all->data[i - 1];
+        if (prev.str_idx < res.str_idx || (prev.str_idx == res.str_idx && prev.needle_idx < res.needle_idx)) break;
+        all->data[i] = prev;
+        i--;
+    }
+    all->data[i] = res;
+}
+
+internal void _ail_multifind_build_teddy_(AIL_MultiFind *mf)
+{
+    u32 min_len = 0xffffffff;
+    for (u32 i = 0; i < mf->needles_count; i++) {
+        if (mf->needles[i].len) min_len = ail_min(min_len, (u32)mf->needles[i].len);
+    }
+    mf->teddy_len = ail_min(min_len, AIL_MULTIFIND_TEDDY_LEN);
+    for (u32 i = 0; i < mf->needles_count; i++) {
+        if (!mf->needles[i].len) continue;
+        for (u32 f = 0; f < mf->teddy_len; f++) {
+            u8 c = mf->needles[i].data[f];
+            mf->teddy_lo[f][c & 0xf] |= (u8)(1u << i);
+            mf->teddy_hi[f][c >> 4]  |= (u8)(1u << i);
+        }
+    }
+}
+
+internal void _ail_multifind_build_dfa_(AIL_MultiFind *mf, u64 total_len)
+{
+    AIL_Allocator al = mf->allocator;
+    u32 k = 1; // Class 0 is used for all bytes that don't appear in any needle
+    for (u32 i = 0; i < mf->needles_count; i++) {
+        for (u64 j = 0; j < mf->needles[i].len; j++) {
+            u8 c = mf->needles[i].data[j];
+            if (!mf->classes[c]) mf->classes[c] = (u16)k++;
+        }
+    }
+    mf->classes_count = k;
+
+    // Building the trie, where a transition of 0 means, that the child doesn't exist yet
+    u32 max_states   = (u32)total_len + 1;
+    mf->delta        = ail_call_calloc(al, (u64)max_states*mf->classes_count, sizeof(u32));
+    mf->state_needle = ail_call_alloc(al, max_states*sizeof(i32));
+    mf->state_link   = ail_call_calloc(al, max_states, sizeof(u32));
+    mf->same_next    = ail_call_alloc(al, mf->needles_count*sizeof(i32));
+    mf->states_count = 1;
+    mf->state_needle[0] = -1;
+    for (u32 i = 0; i < mf->needles_count; i++) {
+        mf->same_next[i] = -1;
+        AIL_Str needle = mf->needles[i];
+        if (!needle.len) continue;
+        u32 s = 0;
+        for (u64 j = 0; j < needle.len; j++) {
+            u32 *t = &mf->delta[s*mf->classes_count + mf->classes[needle.data[j]]];
+            if (!*t) {
+                *t = mf->states_count++;
+                mf->state_needle[*t] = -1;
+            }
+            s = *t;
+        }
+        if (mf->state_needle[s] < 0) {
+            mf->state_needle[s] = (i32)i;
+        } else {
+            i32 j = mf->state_needle[s];
+            while (mf->same_next[j] >= 0) j = mf->same_next[j];
+            mf->same_next[j] = (i32)i;
+        }
+    }
+
+    ail_assert((u64)mf->states_count*mf->classes_count <= _AIL_MULTIFIND_STATE_MASK_, "Too many needles for the multi-needle search");
+
+    // Computing the failure links in BFS order and turning the trie into a DFA
+    u32 *fail  = ail_call_calloc(al, mf->states_count, sizeof(u32));
+    u32 *queue = ail_call_alloc(al, mf->states_count*sizeof(u32));
+    u32 head = 0, tail = 0;
+    for (u32 c = 0; c < mf->classes_count; c++) {
+        u32 t = mf->delta[c];
+        if (t) queue[tail++] = t;
+    }
+    while (head < tail) {
+        u32 s = queue[head++];
+        for (u32 c = 0; c < mf->classes_count; c++) {
+            u32 *t = &mf->delta[s*mf->classes_count + c];
+            u32 f  = mf->delta[fail[s]*mf->classes_count + c] & _AIL_MULTIFIND_STATE_MASK_;
+            if (*t) {
+                fail[*t] = f;
+                mf->state_link[*t] = mf->state_needle[f] >= 0 ? f : mf->state_link[f];
+                queue[tail++] = *t;
+            } else {
+                *t = f;
+            }
+        }
+    }
+    ail_call_free(al, queue);
+    ail_call_free(al, fail);
+
+    // Marking all transitions into states that have matches and premultiplying the states
+    for (u64 i = 0; i < (u64)mf->states_count*mf->classes_count; i++) {
+        u32 t = mf->delta[i];
+        mf->delta[i] = t*mf->classes_count;
+        if (mf->state_needle[t] >= 0 || mf->state_link[t]) mf->delta[i] |= _AIL_MULTIFIND_MATCH_BIT_;
+    }
+}
+
+AIL_MultiFind ail_multifind_new_a(AIL_Str *needles, u32 needles_count, AIL_Allocator allocator)
+{
+    AIL_MultiFind mf = { .needles_count = needles_count, .allocator = allocator };
+    u64 total_len = 0;
+    for (u32 i = 0; i < needles_count; i++) {
+        total_len += needles[i].len;
+        mf.max_len = ail_max(mf.max_len, (u32)needles[i].len);
+    }
+    mf.needles = ail_call_alloc(allocator, needles_count*sizeof(AIL_Str) + total_len);
+    u8 *bytes  = (u8 *)(mf.needles + needles_count);
+    for (u32 i = 0; i < needles_count; i++) {
+        ail_mem_copy(bytes, needles[i].data, needles[i].len);
+        mf.needles[i] = ail_str_from_parts(bytes, needles[i].len);
+        bytes += needles[i].len;
+    }
+    mf.use_teddy = _AIL_MULTIFIND_TEDDY_SIMD_ && needles_count <= AIL_MULTIFIND_TEDDY_MAX && total_len > 0;
+    if (mf.use_teddy) _ail_multifind_build_teddy_(&mf);
+    else              _ail_multifind_build_dfa_(&mf, total_len);
+    return mf;
+}
+
+void ail_multifind_free(AIL_MultiFind *mf)
+{
+    AIL_Allocator al = mf->allocator;
+    ail_call_free(al, mf->needles);
+    if (mf->delta) {
+        ail_call_free(al, mf->delta);
+        ail_call_free(al, mf->state_needle);
+        ail_call_free(al, mf->state_link);
+        ail_call_free(al, mf->same_next);
+    }
+    *mf = (AIL_MultiFind){0};
+}
+
+// Searches for the first match if `all` is NULL and otherwise adds every match to `all`
+internal AIL_Str_Find_Of_Res _ail_multifind_dfa_(AIL_MultiFind *mf, AIL_Str str, AIL_DA(AIL_Str_Find_Of_Res) *all)
+{
+    AIL_Str_Find_Of_Res best = { -1, -1 };
+    if (!mf->delta) return best;
+    u32 s = 0;
+    for (u64 p = 0; p < str.len; p++) {
+        u32 t = mf->delta[s + mf->classes[str.data[p]]];
+        s = t & _AIL_MULTIFIND_STATE_MASK_;
+        if (!(t & _AIL_MULTIFIND_MATCH_BIT_)) continue;
+        u32 state = s/mf->classes_count;
+        if (mf->state_needle[state] < 0) state = mf->state_link[state];
+        while (state) {
+            for (i32 j = mf->state_needle[state]; j >= 0; j = mf->same_next[j]) {
+                AIL_Str_Find_Of_Res res = { (i64)(p + 1 - mf->needles[j].len), j };
+                if (all) _ail_multifind_push_sorted_(all, res);
+                else if (best.str_idx < 0 || res.str_idx < best.str_idx || (res.str_idx == best.str_idx && res.needle_idx < best.needle_idx)) best = res;
+            }
+            state = mf->state_link[state];
+        }
+        // Matches that end later cannot start before the best match anymore
+        if (!all && best.str_idx >= 0 && p + 2 > (u64)best.str_idx + mf->max_len) break;
+    }
+    return best;
+}
+
+internal AIL_Str_Find_Of_Res _ail_multifind_teddy_(AIL_MultiFind *mf, AIL_Str str, AIL_DA(AIL_Str_Find_Of_Res) *all)
+{
+    AIL_Str_Find_Of_Res best = { -1, -1 };
+    u64 p = 0;
+#if _AIL_MULTIFIND_TEDDY_SIMD_
+    _ail_multifind_vec_ lo[AIL_MULTIFIND_TEDDY_LEN], hi[AIL_MULTIFIND_TEDDY_LEN];
+    for (u32 f = 0; f < mf->teddy_len; f++) {
+        lo[f] = _ail_multifind_vec_load_(mf->teddy_lo[f]);
+        hi[f] = _ail_multifind_vec_load_(mf->teddy_hi[f]);
+    }
+    for (; p + 16 + mf->teddy_len - 1 <= str.len; p += 16) {
+        // Each lane contains a bit for every needle, whose first bytes match the bytes at that position
+        _ail_multifind_vec_ v   = _ail_multifind_vec_load_(str.data + p);
+        _ail_multifind_vec_ res = _ail_multifind_vec_and_(_ail_multifind_vec_lookup_(lo[0], _ail_multifind_vec_lo_nibble_(v)), _ail_multifind_vec_lookup_(hi[0], _ail_multifind_vec_hi_nibble_(v)));
+        for (u32 f = 1; f < mf->teddy_len; f++) {
+            v   = _ail_multifind_vec_load_(str.data + p + f);
+            res = _ail_multifind_vec_and_(res, _ail_multifind_vec_lookup_(lo[f], _ail_multifind_vec_lo_nibble_(v)));
+            res = _ail_multifind_vec_and_(res, _ail_multifind_vec_lookup_(hi[f], _ail_multifind_vec_hi_nibble_(v)));
+        }
+        u64 mask = _ail_multifind_vec_nonzero_mask_(res);
+        if (!mask) continue;
+        u8 lanes[16];
+        _ail_multifind_vec_store_(lanes, res);
+        while (mask) {
+            u32 lane = ail_ctz_u64(mask)/_AIL_MULTIFIND_LANE_BITS_;
+            for (u32 bits = lanes[lane]; bits; bits &= bits - 1) {
+                u32 j = ail_ctz_u64(bits);
+                if (_ail_multifind_match_at_(str, p + lane, mf->needles[j])) {
+                    AIL_Str_Find_Of_Res r = { (i64)(p + lane), (i32)j };
+                    if (!all) return r;
+                    ail_da_push(all, r);
+                }
+            }
+            mask &= mask - 1;
+        }
+    }
+#endif
+    // The last few positions are checked directly
+    for (; p < str.len; p++) {
+        for (u32 j = 0; j < mf->needles_count; j++) {
+            if (mf->needles[j].len && _ail_multifind_match_at_(str, p, mf->needles[j])) {
+                AIL_Str_Find_Of_Res r = { (i64)p, (i32)j };
+                if (!all) return r;
+                ail_da_push(all, r);
+            }
+        }
+    }
+    return best;
+}
+
+AIL_Str_Find_Of_Res ail_multifind_first(AIL_MultiFind *mf, AIL_Str str)
+{
+    if (mf->use_teddy) return _ail_multifind_teddy_(mf, str, NULL);
+    else               return _ail_multifind_dfa_(mf, str, NULL);
+}
+
+AIL_DA(AIL_Str_Find_Of_Res) ail_multifind_all_a(AIL_MultiFind *mf, AIL_Str str, AIL_Allocator allocator)
+{
+    AIL_DA(AIL_Str_Find_Of_Res) all = ail_da_new_with_alloc(AIL_Str_Find_Of_Res, 16, allocator);
+    if (mf->use_teddy) _ail_multifind_teddy_(mf, str, &all);
+    else               _ail_multifind_dfa_(mf, str, &all);
+    return all;
+}
+
+AIL_Str ail_multifind_replace_a(AIL_MultiFind *mf, AIL_Str str, AIL_Str *replacements, AIL_Allocator allocator)
+{
+    // The matches are remembered while computing the size of the result (see ail_str_replace_a)
+    AIL_Str_Find_Of_Res  match_buf[_AIL_STR_REPLACE_BUF_];
+    AIL_Str_Find_Of_Res *matches = match_buf;
+    u64 cap     = _AIL_STR_REPLACE_BUF_;
+    u64 count   = 0;
+    u64 res_len = str.len;
+    for (u64 off = 0;;) {
+        AIL_Str_Find_Of_Res m = ail_multifind_first(mf, ail_str_offset(str, off));
+        if (m.str_idx < 0) break;
+        m.str_idx += (i64)off;
+        if (count == cap) matches = _ail_str_replace_grow_buf_(matches, match_buf, &cap, sizeof(AIL_Str_Find_Of_Res), allocator);
+        matches[count++] = m;
+        res_len += replacements[m.needle_idx].len - mf->needles[m.needle_idx].len;
+        off      = (u64)m.str_idx + mf->needles[m.needle_idx].len;
+    }
+
+    u8 *res = ail_call_alloc(allocator, res_len + 1);
+    u64 src = 0, dst = 0;
+    for (u64 k = 0; k < count; k++) {
+        u64     at   = (u64)matches[k].str_idx;
+        AIL_Str with = replacements[matches[k].needle_idx];
+        _ail_str_replace_copy_(res + dst, str.data + src, at - src);
+        dst += at - src;
+        _ail_str_replace_copy_(res + dst, with.data, with.len);
+        dst += with.len;
+        src  = at + mf->needles[matches[k].needle_idx].len;
+    }
+    _ail_str_replace_copy_(res + dst, str.data + src, str.len - src);
+    ail_assert(dst + str.len - src == res_len);
+    res[res_len] = 0;
+    if (matches != match_buf) ail_call_free(allocator, matches);
+    return ail_str_from_parts(res, res_len);
+}
+
+AIL_Str ail_str_replace_many_a(AIL_Str str, AIL_Str *from, AIL_Str *to, u32 n, AIL_Allocator allocator)
+{
+    AIL_MultiFind mf = ail_multifind_new_a(from, n, allocator);
+    AIL_Str res = ail_multifind_replace_a(&mf, str, to, allocator);
+    ail_multifind_free(&mf);
+    return res;
+}
+
+AIL_WARN_POP
+#endif // _AIL_MULTIFIND_IMPL_GUARD_
+#endif // AIL_NO_MULTIFIND_IMPL
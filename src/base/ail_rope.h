@@ -0,0 +1,403 @@
+/*
+*** Rope ***
+*
+* A rope stores text as a balanced binary tree (AVL-tree), whose leaves are AIL_Str chunks of the text
+* Every inner node stores the total length of the text below it, so that any position can be found in O(log n)
+* Inserting, removing and slicing are implemented by splitting and joining trees, which are all O(log n) as well,
+* independent of how large the chunks are. This makes ropes well-suited for editing multi-MB documents
+*
+* The leaves never own the memory they point at:
+* - Text that the rope was created with (see ail_rope_new_from_str) is not copied,
+*   which means the memory needs to stay valid for as long as the rope is used
+* - Inserted text is appended to blocks of AIL_ROPE_BLOCK_SIZE bytes, which are owned by the rope.
+*   Since these blocks are never moved or modified once written, removing text never touches any bytes either.
+*   Consecutive inserts (i.e. when typing) are coalesced into a single leaf
+*/
+
+#ifndef _AIL_ROPE_H_
+#define _AIL_ROPE_H_
+
+#include "ail_base.h"
+#include "ail_base_math.h"
+#include "ail_mem.h"
+#include "ail_str.h"
+
+AIL_WARN_PUSH
+AIL_WARN_DISABLE(AIL_WARN_UNUSED_FUNCTION)
+
+#ifndef AIL_ROPE_BLOCK_SIZE
+#   define AIL_ROPE_BLOCK_SIZE 4096
+#endif
+// An AVL-tree with n leaves has a height of at most 1.44*log2(n+2), so this is enough for up to 2^64 leaves
+#define AIL_ROPE_MAX_HEIGHT 96
+
+typedef struct AIL_Rope_Node {
+    struct AIL_Rope_Node *left;  // Both children are NULL for leaves and non-NULL for inner nodes
+    struct AIL_Rope_Node *right;
+    u8  *data; // Only used by leaves
+    u64  len;  // Length of the text in the subtree
+    u32  height;
+} AIL_Rope_Node;
+
+typedef struct AIL_Rope_Block {
+    struct AIL_Rope_Block *next;
+    u64 len;
+    u64 cap;
+    u8  data[];
+} AIL_Rope_Block;
+
+typedef struct AIL_Rope {
+    AIL_Rope_Node  *root;   // NULL if the rope is empty
+    AIL_Rope_Block *blocks; // The most recently allocated block comes first
+    AIL_Allocator   allocator;
+} AIL_Rope;
+
+typedef struct AIL_Rope_Iter {
+    AIL_Rope_Node *stack[AIL_ROPE_MAX_HEIGHT];
+    u32 depth;
+    u64 skip; // Amount of bytes to skip in the next chunk
+} AIL_Rope_Iter;
+
+internal AIL_Rope ail_rope_new_a(AIL_Allocator allocator);
+// @Important: `str` is not copied and needs to outlive the rope
+internal AIL_Rope ail_rope_new_from_str_a(AIL_Str str, AIL_Allocator allocator);
+internal void     ail_rope_free(AIL_Rope *rope);
+#define ail_rope_new()             ail_rope_new_a(ail_default_allocator)
+#define ail_rope_new_from_str(str) ail_rope_new_from_str_a(str, ail_default_allocator)
+
+inline_func u64 ail_rope_len(AIL_Rope rope);
+internal u8  ail_rope_get(AIL_Rope rope, u64 idx);
+
+// `str` is copied into the rope
+internal void ail_rope_insert(AIL_Rope *rope, u64 pos, AIL_Str str);
+// Remove `n` bytes starting at `pos`, if there are less than `n` bytes after `pos`, all of them are removed
+internal void ail_rope_rm    (AIL_Rope *rope, u64 pos, u64 n);
+#define ail_rope_push(ropePtr, str) ail_rope_insert(ropePtr, ail_rope_len(*(ropePtr)), str)
+
+// Receive a view to the text in range [start, start + len) without copying
+// Returns false if the range is spread over several chunks, in which case `view` is not changed
+// @Important: The view is only valid until the rope is freed
+internal b32  ail_rope_view(AIL_Rope rope, u64 start, u64 len, AIL_Str *view);
+// Copy the text in range [start, start + len) into `dst`
+internal void ail_rope_copy_to(AIL_Rope rope, u64 start, u64 len, u8 *dst);
+// @Important: Copies the text to a new null-terminated string. Remember to free it with ail_str_free
+internal AIL_Str ail_rope_substr_a(AIL_Rope rope, u64 start, u64 len, AIL_Allocator allocator);
+#define ail_rope_substr(rope, start, len) ail_rope_substr_a(rope, start, len, ail_default_allocator)
+#define ail_rope_to_str_a(rope, al)       ail_rope_substr_a(rope, 0, ail_rope_len(rope), al)
+#define ail_rope_to_str(rope)             ail_rope_substr_a(rope, 0, ail_rope_len(rope), ail_default_allocator)
+
+// Iterate over the chunks of the text, starting at `pos`
+// ail_rope_iter_next returns an empty string once the end of the rope is reached
+internal AIL_Rope_Iter ail_rope_iter_new (AIL_Rope rope, u64 pos);
+internal AIL_Str       ail_rope_iter_next(AIL_Rope_Iter *it);
+
+AIL_WARN_POP
+#endif // _AIL_ROPE_H_
+
+
+#if !defined(AIL_NO_ROPE_IMPL) && !defined(AIL_NO_BASE_IMPL) && !defined(AIL_NO_IMPL)
+#ifndef _AIL_ROPE_IMPL_GUARD_
+#define _AIL_ROPE_IMPL_GUARD_
+AIL_WARN_PUSH
+AIL_WARN_DISABLE(AIL_WARN_UNUSED_FUNCTION)
+
+internal AIL_Rope_Node *_ail_rope_leaf_new_(AIL_Rope *rope, u8 *data, u64 len)
+{
+    AIL_Rope_Node *n = ail_call_alloc(rope->allocator, sizeof(AIL_Rope_Node));
+    *n = (AIL_Rope_Node) { .data = data, .len = len, .height = 1 };
+    return n;
+}
+
+internal void _ail_rope_update_(AIL_Rope_Node *n)
+{
+    n->len    = n->left->len + n->right->len;
+    n->height = 1 + ail_max(n->left->height, n->right->height);
+}
+
+internal AIL_Rope_Node *_ail_rope_inner_new_(AIL_Rope *rope, AIL_Rope_Node *left, AIL_Rope_Node *right)
+{
+    AIL_Rope_Node *n = ail_call_alloc(rope->allocator, sizeof(AIL_Rope_Node));
+    *n = (AIL_Rope_Node) { .left = left, .right = right };
+    _ail_rope_update_(n);
+    return n;
+}
+
+internal AIL_Rope_Node *_ail_rope_rotate_left_(AIL_Rope_Node *n)
+{
+    AIL_Rope_Node *x = n->right;
+    n->right = x->left;
+    _ail_rope_update_(n);
+    x->left = n;
+    _ail_rope_update_(x);
+    return x;
+}
+
+internal AIL_Rope_Node *_ail_rope_rotate_right_(AIL_Rope_Node *n)
+{
+    AIL_Rope_Node *x = n->left;
+    n->left = x->right;
+    _ail_rope_update_(n);
+    x->right = n;
+    _ail_rope_update_(x);
+    return x;
+}
+
+internal AIL_Rope_Node *_ail_rope_rebalance_(AIL_Rope_Node *n)
+{
+    i64 balance = (i64)n->left->height - (i64)n->right->height;
+    if (balance > 1) {
+        if (n->left->left->height < n->left->right->height) n->left = _ail_rope_rotate_left_(n->left);
+        return _ail_rope_rotate_right_(n);
+    } else if (balance < -1) {
+        if (n->right->right->height < n->right->left->height) n->right = _ail_rope_rotate_right_(n->right);
+        return _ail_rope_rotate_left_(n);
+    }
+    _ail_rope_update_(n);
+    return n;
+}
+
+// Concatenates two trees in O(|height(a) - height(b)|)
+internal AIL_Rope_Node *_ail_rope_join_(AIL_Rope *rope, AIL_Rope_Node *a, AIL_Rope_Node *b)
+{
+    if (!a) return b;
+    if (!b) return a;
+    if (a->height > b->height + 1) {
+        a->right = _ail_rope_join_(rope, a->right, b);
+        return _ail_rope_rebalance_(a);
+    } else if (b->height > a->height + 1) {
+        b->left = _ail_rope_join_(rope, a, b->left);
+        return _ail_rope_rebalance_(b);
+    }
+    return _ail_rope_inner_new_(rope, a, b);
+}
+
+// Splits the tree into the text before `pos` (stored in `l`) and the text after it (stored in `r`)
+// Since the heights of the joined trees telescope, this is O(log n) in total
+internal void _ail_rope_split_(AIL_Rope *rope, AIL_Rope_Node *n, u64 pos, AIL_Rope_Node **l, AIL_Rope_Node **r)
+{
+    if (!n || pos == 0)  { *l = NULL; *r = n; return; }
+    if (pos >= n->len)   { *l = n; *r = NULL; return; }
+    if (!n->left) {
+        *r = _ail_rope_leaf_new_(rope, n->data + pos, n->len - pos);
+        n->len = pos;
+        *l = n;
+        return;
+    }
+    AIL_Rope_Node *left  = n->left;
+    AIL_Rope_Node *right = n->right;
+    ail_call_free(rope->allocator, n);
+    if (pos < left->len) {
+        AIL_Rope_Node *a, *b;
+        _ail_rope_split_(rope, left, pos, &a, &b);
+        *l = a;
+        *r = _ail_rope_join_(rope, b, right);
+    } else if (pos == left->len) {
+        *l = left;
+        *r = right;
+    } else {
+        AIL_Rope_Node *a, *b;
+        _ail_rope_split_(rope, right, pos - left->len, &a, &b);
+        *l = _ail_rope_join_(rope, left, a);
+        *r = b;
+    }
+}
+
+internal void _ail_rope_free_node_(AIL_Rope *rope, AIL_Rope_Node *n)
+{
+    if (!n) return;
+    _ail_rope_free_node_(rope, n->left);
+    _ail_rope_free_node_(rope, n->right);
+    ail_call_free(rope->allocator, n);
+}
+
+// Returns the leaf containing `idx` and sets `offset` to the index inside that leaf
+internal AIL_Rope_Node *_ail_rope_find_leaf_(AIL_Rope_Node *n, u64 idx, u64 *offset)
+{
+    while (n->left) {
+        if (idx < n->left->len) {
+            n = n->left;
+        } else {
+            idx -= n->left->len;
+            n    = n->right;
+        }
+    }
+    *offset = idx;
+    return n;
+}
+
+// Copies `str` into the most recent block, allocating a new block if there is not enough space left
+internal u8 *_ail_rope_store_text_(AIL_Rope *rope, AIL_Str str)
+{
+    AIL_Rope_Block *b = rope->blocks;
+    if (!b || b->cap - b->len < str.len) {
+        u64 cap = ail_max(AIL_ROPE_BLOCK_SIZE, str.len);
+        b = ail_call_alloc(rope->allocator, sizeof(AIL_Rope_Block) + cap);
+        b->next = rope->blocks;
+        b->len  = 0;
+        b->cap  = cap;
+        rope->blocks = b;
+    }
+    u8 *data = b->data + b->len;
+    ail_mem_copy(data, str.data, str.len);
+    b->len += str.len;
+    return data;
+}
+
+// If the text directly before `pos` is the last text written to the current block,
+// `str` can simply be appended to the block and to that leaf, without changing the tree's structure
+internal b32 _ail_rope_try_extend_(AIL_Rope *rope, u64 pos, AIL_Str str)
+{
+    AIL_Rope_Block *b = rope->blocks;
+    if (!pos || !b || b->cap - b->len < str.len) return false;
+    AIL_Rope_Node *path[AIL_ROPE_MAX_HEIGHT];
+    u32 depth = 0;
+    u64 idx   = pos - 1;
+    AIL_Rope_Node *n = rope->root;
+    while (n->left) {
+        path[depth++] = n;
+        if (idx < n->left->len) {
+            n = n->left;
+        } else {
+            idx -= n->left->len;
+            n    = n->right;
+        }
+    }
+    if (idx + 1 != n->len || n->data + n->len != b->data + b->len) return false;
+    _ail_rope_store_text_(rope, str);
+    n->len += str.len;
+    for (u32 i = 0; i < depth; i++) path[i]->len += str.len;
+    return true;
+}
+
+AIL_Rope ail_rope_new_a(AIL_Allocator allocator)
+{
+    return (AIL_Rope) { .allocator = allocator };
+}
+
+AIL_Rope ail_rope_new_from_str_a(AIL_Str str, AIL_Allocator allocator)
+{
+    AIL_Rope rope = ail_rope_new_a(allocator);
+    if (str.len) rope.root = _ail_rope_leaf_new_(&rope, str.data, str.len);
+    return rope;
+}
+
+void ail_rope_free(AIL_Rope *rope)
+{
+    _ail_rope_free_node_(rope, rope->root);
+    AIL_Rope_Block *b = rope->blocks;
+    while (b) {
+        AIL_Rope_Block *next = b->next;
+        ail_call_free(rope->allocator, b);
+        b = next;
+    }
+    rope->root   = NULL;
+    rope->blocks = NULL;
+}
+
+u64 ail_rope_len(AIL_Rope rope)
+{
+    return rope.root ? rope.root->len : 0;
+}
+
+u8 ail_rope_get(AIL_Rope rope, u64 idx)
+{
+    ail_assert(idx < ail_rope_len(rope));
+    u64 offset;
+    AIL_Rope_Node *leaf = _ail_rope_find_leaf_(rope.root, idx, &offset);
+    return leaf->data[offset];
+}
+
+void ail_rope_insert(AIL_Rope *rope, u64 pos, AIL_Str str)
+{
+    ail_assert(pos <= ail_rope_len(*rope));
+    if (!str.len || _ail_rope_try_extend_(rope, pos, str)) return;
+    AIL_Rope_Node *leaf = _ail_rope_leaf_new_(rope, _ail_rope_store_text_(rope, str), str.len);
+    AIL_Rope_Node *l, *r;
+    _ail_rope_split_(rope, rope->root, pos, &l, &r);
+    rope->root = _ail_rope_join_(rope, _ail_rope_join_(rope, l, leaf), r);
+}
+
+void ail_rope_rm(AIL_Rope *rope, u64 pos, u64 n)
+{
+    u64 len = ail_rope_len(*rope);
+    ail_assert(pos <= len);
+    n = ail_min(n, len - pos);
+    if (!n) return;
+    AIL_Rope_Node *l, *mid, *r;
+    _ail_rope_split_(rope, rope->root, pos, &l, &r);
+    _ail_rope_split_(rope, r, n, &mid, &r);
+    _ail_rope_free_node_(rope, mid);
+    rope->root = _ail_rope_join_(rope, l, r);
+}
+
+b32 ail_rope_view(AIL_Rope rope, u64 start, u64 len, AIL_Str *view)
+{
+    ail_assert(start + len <= ail_rope_len(rope));
+    if (!len) {
+        *view = ail_str_from_parts(NULL, 0);
+        return true;
+    }
+    u64 offset;
+    AIL_Rope_Node *leaf = _ail_rope_find_leaf_(rope.root, start, &offset);
+    if (offset + len > leaf->len) return false;
+    *view = ail_str_from_parts(leaf->data + offset, len);
+    return true;
+}
+
+void ail_rope_copy_to(AIL_Rope rope, u64 start, u64 len, u8 *dst)
+{
+    ail_assert(start + len <= ail_rope_len(rope));
+    AIL_Rope_Iter it = ail_rope_iter_new(rope, start);
+    while (len) {
+        AIL_Str chunk = ail_rope_iter_next(&it);
+        u64 n = ail_min(len, chunk.len);
+        ail_mem_copy(dst, chunk.data, n);
+        dst += n;
+        len -= n;
+    }
+}
+
+AIL_Str ail_rope_substr_a(AIL_Rope rope, u64 start, u64 len, AIL_Allocator allocator)
+{
+    u8 *data = ail_call_alloc(allocator, len + 1);
+    ail_rope_copy_to(rope, start, len, data);
+    data[len] = 0;
+    return ail_str_from_parts(data, len);
+}
+
+AIL_Rope_Iter ail_rope_iter_new(AIL_Rope rope, u64 pos)
+{
+    AIL_Rope_Iter it = {0};
+    AIL_Rope_Node *n = rope.root;
+    if (!n || pos >= n->len) return it;
+    // Only the right children that still need to be visited are kept on the stack
+    while (n->left) {
+        if (pos < n->left->len) {
+            it.stack[it.depth++] = n->right;
+            n = n->left;
+        } else {
+            pos -= n->left->len;
+            n    = n->right;
+        }
+    }
+    it.stack[it.depth++] = n;
+    it.skip = pos;
+    return it;
+}
+
+AIL_Str ail_rope_iter_next(AIL_Rope_Iter *it)
+{
+    if (!it->depth) return ail_str_from_parts(NULL, 0);
+    AIL_Rope_Node *n = it->stack[--it->depth];
+    while (n->left) {
+        it->stack[it->depth++] = n->right;
+        n = n->left;
+    }
+    AIL_Str chunk = ail_str_from_parts(n->data + it->skip, n->len - it->skip);
+    it->skip = 0;
+    return chunk;
+}
+
+AIL_WARN_POP
+#endif // _AIL_ROPE_IMPL_GUARD_
+#endif // AIL_NO_ROPE_IMPL
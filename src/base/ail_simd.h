@@ -1,6 +1,19 @@
 /*
 *** SIMD ***
 *
+* Identifies the SIMD instruction sets available at compile-time and includes the required headers for their intrinsics.
+* Each of the following macros is defined to be either 1 or 0:
+  * AIL_SIMD_SSE2   - Always available on x86-64
+  * AIL_SIMD_SSSE3
+  * AIL_SIMD_SSE42
+  * AIL_SIMD_AVX2   - Requires i.e. `-mavx2` or `-march=native` with gcc/clang or `/arch:AVX2` with msvc
+  * AIL_SIMD_BMI2
+  * AIL_SIMD_NEON   - Always available on AArch64
+  * AIL_SIMD        - Whether any SIMD instruction set (SSE2 or NEON) is available at all
+*
+* Define AIL_SIMD_DISABLE before including this file to disable all SIMD code paths (useful for testing the scalar fallbacks)
+*
+* @TODO: Provide a portable SIMD vector type, so that less code needs to be written per instruction set
 */
 
 #ifndef _AIL_SIMD_H_
@@ -8,6 +21,48 @@
 
 #include "ail_base.h"
 
-// @TODO
+#if !defined(AIL_SIMD_DISABLE) && AIL_ARCH_X86 && (defined(__SSE2__) || (AIL_COMP_MSVC && (AIL_64BIT || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))))
+#   define AIL_SIMD_SSE2 1
+#   include <emmintrin.h>
+#else
+#   define AIL_SIMD_SSE2 0
+#endif
+
+#if AIL_SIMD_SSE2 && (defined(__SSSE3__) || defined(__AVX__))
+#   define AIL_SIMD_SSSE3 1
+#   include <tmmintrin.h>
+#else
+#   define AIL_SIMD_SSSE3 0
+#endif
+
+#if AIL_SIMD_SSE2 && (defined(__SSE4_2__) || defined(__AVX__))
+#   define AIL_SIMD_SSE42 1
+#   include <nmmintrin.h>
+#else
+#   define AIL_SIMD_SSE42 0
+#endif
+
+#if AIL_SIMD_SSE2 && defined(__AVX2__)
+#   define AIL_SIMD_AVX2 1
+#   include <immintrin.h>
+#else
+#   define AIL_SIMD_AVX2 0
+#endif
+
+#if AIL_SIMD_SSE2 && defined(__BMI2__)
+#   define AIL_SIMD_BMI2 1
+#   include <immintrin.h>
+#else
+#   define AIL_SIMD_BMI2 0
+#endif
+
+#if !defined(AIL_SIMD_DISABLE) && AIL_ARCH_ARM && AIL_64BIT && (defined(__ARM_NEON) || defined(__ARM_NEON__) || AIL_COMP_MSVC)
+#   define AIL_SIMD_NEON 1
+#   include <arm_neon.h>
+#else
+#   define AIL_SIMD_NEON 0
+#endif
+
+#define AIL_SIMD (AIL_SIMD_SSE2 || AIL_SIMD_NEON)
 
 #endif // _AIL_SIMD_H_
@@ -35,6 +35,7 @@
 #include "ail_base.h"
 #include "ail_base_math.h"
 #include "ail_arr.h"
+#include "ail_simd.h"
 
 AIL_WARN_PUSH
 AIL_WARN_DISABLE(AIL_WARN_UNUSED_FUNCTION)
@@ -102,10 +103,26 @@ typedef struct AIL_Str_Parse_F_Res {
     u32 len;
 } AIL_Str_Parse_F_Res;
 
+typedef enum AIL_Str_Split_Kind {
+    AIL_STR_SPLIT_CHAR,
+    AIL_STR_SPLIT_STR,
+    AIL_STR_SPLIT_LINES,
+    AIL_STR_SPLIT_WHITESPACE,
+} AIL_Str_Split_Kind;
+
+typedef struct AIL_Str_Split_Iter { // Iterator created by ail_str_split_iter* functions
+    AIL_Str8 str;
+    AIL_Str8 split_by; // Only used for AIL_STR_SPLIT_STR
+    u64  idx;          // Start of the next token
+    u64  block;        // Offset of the 64 bytes, that `mask` describes
+    u64  mask;         // Bit i is set, if str.data[block + i] is a delimiter that wasn't consumed yet
+    u8   split_char;
+    u8   kind;
+    u8   ignore_empty;
+} AIL_Str_Split_Iter;
+
 // @TODO: Implement the following functions:
 // - split by list of splitters
-// - parse float
-// - convert to float
 
 
 ////////////////////
@@ -113,8 +130,8 @@ typedef struct AIL_Str_Parse_F_Res {
 ////////////////////
 
 #define ail_str8_from_lit(lit)  { .data = (u8*)(lit),  .len = (sizeof(lit)/1) - 1 }
-#define ail_str32_from_lit(lit) { .data = (u32*)(lit), .len = (sizeof(lit)/2) - 1 }
-#define ail_str16_from_lit(lit) { .data = (u16*)(lit), .len = (sizeof(lit)/4) - 1 }
+#define ail_str32_from_lit(lit) { .data = (u32*)(lit), .len = (sizeof(lit)/4) - 1 }
+#define ail_str16_from_lit(lit) { .data = (u16*)(lit), .len = (sizeof(lit)/2) - 1 }
 #define ail_str8_from_lit_t(lit)  ((AIL_Str8)  ail_str8_from_lit(lit))
 #define ail_str16_from_lit_t(lit) ((AIL_Str16) ail_str16_from_lit(lit))
 #define ail_str32_from_lit_t(lit) ((AIL_Str32) ail_str32_from_lit(lit))
@@ -142,6 +159,18 @@ internal AIL_Str8 ail_str_new_float_a   (f64 num, AIL_Allocator allocator);
 #define ail_str_free_a(str,al) ail_call_free(al, (str).data)
 #define ail_str_free(str) ail_str_free_a(str, ail_default_allocator)
 
+// Maximum amount of bytes that ail_str_unsigned_to_buf and ail_str_signed_to_buf write
+#define AIL_STR_INT_MAX_LEN 20
+// Writes the decimal representation of `num` into `buf` and returns its length (no null-terminator is written)
+internal u32 ail_str_unsigned_to_buf(u64 num, u8 *buf);
+internal u32 ail_str_signed_to_buf  (i64 num, u8 *buf);
+// Maximum amount of bytes that ail_str_float_to_buf writes
+#define AIL_STR_FLOAT_MAX_LEN 32
+// Writes the shortest string into `buf`, that parses back to exactly `num`, and returns its length (no null-terminator is written)
+// Numbers are written like in JavaScript: Exponents below -6 or above 20 use scientific notation (i.e. "1e+21", "1.5e-7"), while all other numbers don't (i.e. "0.000001", "123.25")
+// Special values are written as "nan", "inf" and "-inf"
+internal u32 ail_str_float_to_buf(f64 num, u8 *buf);
+
 
 ///////////////////
 // Creating a SB //
@@ -188,9 +217,12 @@ internal char* ail_str_to_cstr_full(char *s, u64 len, AIL_Allocator allocator);
 
 // When parsing, `len` will be set to he number of bytes that the number takes in the string
 // @Important: If `str` doesn't start witha digit, '+', '-' or '.', 0 will be returned with len set to 0
+// The same happens if an integer is too large for its type
 // To check for errors, you thus need to check whether `len` is 0
 internal AIL_Str_Parse_U_Res ail_str_parse_unsigned(AIL_Str8 str);
 internal AIL_Str_Parse_I_Res ail_str_parse_signed  (AIL_Str8 str);
+// Floats are parsed from decimals with an optional fraction and exponent (i.e. "-12", "1.5e-3", ".5", "5.") or from "inf", "infinity" and "nan" (case-insensitive)
+// The result is always correctly rounded (to nearest, ties to even)
 internal AIL_Str_Parse_F_Res ail_str_parse_float   (AIL_Str8 str);
 
 
@@ -198,22 +230,44 @@ internal AIL_Str_Parse_F_Res ail_str_parse_float   (AIL_Str8 str);
 // Unicode //
 /////////////
 
-// @TODO: Implement
+// @Note: UTF-16 and UTF-32 strings are stored in the platform's native byte order
+// Validating, measuring and converting strings is done with SIMD when available (see ail_simd.h), where characters of more than one byte need SSSE3 for the conversions
 internal b32 ail_str8_is_valid_utf8    (AIL_Str8  str);
 internal b32 ail_str16_is_valid_utf16  (AIL_Str16 str);
 internal b32 ail_str32_is_valid_utf32  (AIL_Str32 str);
-internal AIL_Str8  ail_str8_from_str16 (AIL_Str16 str);
-internal AIL_Str8  ail_str8_from_str32 (AIL_Str32 str);
-internal AIL_Str8  ail_str8_new_str16  (AIL_Str16 str);
-internal AIL_Str8  ail_str8_new_str32  (AIL_Str32 str);
-internal AIL_Str16 ail_str16_from_str8 (AIL_Str8  str);
-internal AIL_Str16 ail_str16_from_str32(AIL_Str32 str);
-internal AIL_Str16 ail_str16_new_str8  (AIL_Str8  str);
-internal AIL_Str16 ail_str16_new_str32 (AIL_Str32 str);
-internal AIL_Str32 ail_str32_from_str16(AIL_Str16 str);
-internal AIL_Str32 ail_str32_from_str8 (AIL_Str8  str);
-internal AIL_Str32 ail_str32_new_str16 (AIL_Str16 str);
-internal AIL_Str32 ail_str32_new_str8  (AIL_Str8  str);
+
+// Exact amount of code units that converting the valid string `str` produces
+internal u64 ail_str8_len_from_str16 (AIL_Str16 str);
+internal u64 ail_str8_len_from_str32 (AIL_Str32 str);
+internal u64 ail_str16_len_from_str8 (AIL_Str8  str);
+internal u64 ail_str16_len_from_str32(AIL_Str32 str);
+internal u64 ail_str32_len_from_str8 (AIL_Str8  str);
+internal u64 ail_str32_len_from_str16(AIL_Str16 str);
+
+// Convert `str` into `buf`, which needs to have space for at least as many code units as the respective ail_str*_len_from_* function returns
+// @Important: `str` needs to be valid, which can be checked with the respective ail_str*_is_valid_* function
+internal AIL_Str8  ail_str8_from_str16 (AIL_Str16 str, u8  *buf);
+internal AIL_Str8  ail_str8_from_str32 (AIL_Str32 str, u8  *buf);
+internal AIL_Str16 ail_str16_from_str8 (AIL_Str8  str, u16 *buf);
+internal AIL_Str16 ail_str16_from_str32(AIL_Str32 str, u16 *buf);
+internal AIL_Str32 ail_str32_from_str8 (AIL_Str8  str, u32 *buf);
+internal AIL_Str32 ail_str32_from_str16(AIL_Str16 str, u32 *buf);
+
+// Validate `str` and convert it into a new null-terminated string, that is allocated exactly once
+// If `str` is not valid, an empty string with `data` set to NULL is returned
+// @Important: Remember to free the new string with ail_str_free_a
+internal AIL_Str8  ail_str8_new_str16_a (AIL_Str16 str, AIL_Allocator allocator);
+internal AIL_Str8  ail_str8_new_str32_a (AIL_Str32 str, AIL_Allocator allocator);
+internal AIL_Str16 ail_str16_new_str8_a (AIL_Str8  str, AIL_Allocator allocator);
+internal AIL_Str16 ail_str16_new_str32_a(AIL_Str32 str, AIL_Allocator allocator);
+internal AIL_Str32 ail_str32_new_str8_a (AIL_Str8  str, AIL_Allocator allocator);
+internal AIL_Str32 ail_str32_new_str16_a(AIL_Str16 str, AIL_Allocator allocator);
+#define ail_str8_new_str16(str)  ail_str8_new_str16_a(str,  ail_default_allocator)
+#define ail_str8_new_str32(str)  ail_str8_new_str32_a(str,  ail_default_allocator)
+#define ail_str16_new_str8(str)  ail_str16_new_str8_a(str,  ail_default_allocator)
+#define ail_str16_new_str32(str) ail_str16_new_str32_a(str, ail_default_allocator)
+#define ail_str32_new_str8(str)  ail_str32_new_str8_a(str,  ail_default_allocator)
+#define ail_str32_new_str16(str) ail_str32_new_str16_a(str, ail_default_allocator)
 
 ////////////////////////////////
 // Comparison, Prefix, Suffix //
@@ -233,17 +287,53 @@ internal b32 ail_str_ends_with_char(AIL_Str8 str, char   suffix);
 internal b32 ail_str_contains     (AIL_Str8 str, AIL_Str8 needle);
 internal b32 ail_str_contains_cp  (AIL_Str8 str, u32    needle);
 internal b32 ail_str_contains_char(AIL_Str8 str, char   needle);
+// Hashes the bytes of `str`, i.e. to use strings as keys in ail_hm.h
+internal u32 ail_str_hash(AIL_Str8 str);
+
+/////////////////////
+// Case Conversion //
+/////////////////////
+
+// @Note: Only ASCII letters are converted or compared case-insensitively, all other bytes (including UTF-8 sequences) are left as they are
+// Strings are processed in blocks of 16 or 32 bytes with SIMD when available (see ail_simd.h)
+
+// Write `str` with all letters converted to lower-/uppercase into `buf` and receive the converted string
+// `buf` needs to have space for at least str.len bytes and may be the same as str.data to convert the string in-place
+internal AIL_Str8 ail_str_to_lower(AIL_Str8 str, u8 *buf);
+internal AIL_Str8 ail_str_to_upper(AIL_Str8 str, u8 *buf);
+// @Important: To avoid memory leaks, make sure to free the returned string
+internal AIL_Str8 ail_str_new_lower_a(AIL_Str8 str, AIL_Allocator allocator);
+internal AIL_Str8 ail_str_new_upper_a(AIL_Str8 str, AIL_Allocator allocator);
+#define ail_str_new_lower(str) ail_str_new_lower_a(str, ail_default_allocator)
+#define ail_str_new_upper(str) ail_str_new_upper_a(str, ail_default_allocator)
+
+internal b32 ail_str_full_eq_nocase (char *astr, u64 alen, char *bstr, u64 blen);
+internal i32 ail_str_full_cmp_nocase(char *astr, u64 alen, char *bstr, u64 blen);
+#define ail_str_eq_nocase(a, b)  ail_str_full_eq_nocase ((char*)(a).data, (a).len, (char*)(b).data, (b).len)
+#define ail_str_cmp_nocase(a, b) ail_str_full_cmp_nocase((char*)(a).data, (a).len, (char*)(b).data, (b).len)
+internal b32 ail_str_starts_with_nocase(AIL_Str8 str, AIL_Str8 prefix);
+internal b32 ail_str_ends_with_nocase  (AIL_Str8 str, AIL_Str8 suffix);
+// Get the first index in `str` that the substring `needle` appears at, ignoring the case of letters
+// @Note: Unlike ail_str_find, this takes O(n*m) time in the worst case
+internal i64 ail_str_find_nocase(AIL_Str8 str, AIL_Str8 needle);
+// Hash, that is the same for all strings, which are equal according to ail_str_eq_nocase
+internal u32 ail_str_hash_nocase(AIL_Str8 str);
 
 
 ///////////
 // Find  //
 ///////////
 
+// @Note: Substrings and chars are searched for with SIMD when available (see ail_simd.h)
+// Searching for a substring takes O(n + m) time in the worst case
+
 // Get the first index in `str` that the substring `neddle` appears at
 internal i64 ail_str_find(AIL_Str str, AIL_Str needle);
 // Get the last index in `str` that the substring `neddle` appears at
 internal i64 ail_str_find_last(AIL_Str str, AIL_Str needle);
 // Get the first index in `str` that any of the substrings in `neddles` appears at
+// If several needles appear at the same index, the first of them is returned. Empty needles appear at every index of `str` (but not in an empty `str`)
+// @Note: When searching for many needles or in many strings, compiling the needles with ail_multifind.h is much faster
 internal AIL_Str_Find_Of_Res ail_str_find_of(AIL_Str str, AIL_Str *needles, i32 needles_count);
 // Get the last index in `str` that any of the substrings in `neddles` appears at
 internal AIL_Str_Find_Of_Res ail_str_find_last_of(AIL_Str str, AIL_Str *needles, i32 needles_count);
@@ -269,10 +359,10 @@ internal AIL_Str_Find_Of_Res ail_str_find_last_of_chars(AIL_Str str, char *needl
     b32 ignore_empty = true;
     AIL_Str str     = ail_str_from_cstr(",,Hello,World,");
     AIL_Str first  = ail_str_split_next_char(&str, ',', ignore_empty);
-    // str points at ",World," now
+    // str points at "World," now
     AIL_Str second = ail_str_split_next_char(&str, ',', ignore_empty);
     assert(ail_str_eq(ail_str_from_cstr("Hello"), first));
-    assert(ail_str_eq(ail_str_from_cstr("World"), first));
+    assert(ail_str_eq(ail_str_from_cstr("World"), second));
 */
 
 // @Note: Every splitting function further takes a boolean parameter determining whether empty values should be ignored
@@ -280,6 +370,9 @@ internal AIL_Str_Find_Of_Res ail_str_find_last_of_chars(AIL_Str str, char *needl
 
 internal AIL_Str ail_str_split_next_char(AIL_Str *str, char   split_by, b32 ignore_empty);
 internal AIL_Str ail_str_split_next     (AIL_Str *str, AIL_Str split_by, b32 ignore_empty);
+// Lines are split at '\n' and have a trailing '\r' removed
+internal AIL_Str ail_str_split_next_line      (AIL_Str *str, b32 ignore_empty);
+internal AIL_Str ail_str_split_next_whitespace(AIL_Str *str, b32 ignore_empty);
 internal AIL_DA(AIL_Str) ail_str_split_char_a(AIL_Str str, char   split_by, b32 ignore_empty, AIL_Allocator allocator);
 internal AIL_DA(AIL_Str) ail_str_split_a     (AIL_Str str, AIL_Str split_by, b32 ignore_empty, AIL_Allocator allocator);
 internal AIL_DA(AIL_Str) ail_str_split_lines_a(AIL_Str str, b32 ignore_empty, AIL_Allocator allocator);
@@ -289,6 +382,23 @@ internal AIL_DA(AIL_Str) ail_str_split_whitespace_a(AIL_Str str, b32 ignore_empt
 #define ail_str_split_lines(str, ignore_empty)          ail_str_split_lines_a(str, ignore_empty, ail_default_allocator)
 #define ail_str_split_whitespace(str, ignore_empty)     ail_str_split_whitespace_a(str, ignore_empty, ail_default_allocator)
 
+// @Note: The split iterators produce the same substrings as the greedy functions above without allocating anything
+// Delimiters are found 64 bytes at a time with SIMD and kept as a bitmask in the iterator,
+// so that short tokens don't cause the same bytes to be scanned repeatedly. Example:
+/*
+    AIL_Str_Split_Iter it = ail_str_split_iter_lines(file_content, true);
+    ail_str_split_for_each(&it, line) {
+        // ...
+    }
+*/
+internal AIL_Str_Split_Iter ail_str_split_iter_char      (AIL_Str str, char    split_by, b32 ignore_empty);
+internal AIL_Str_Split_Iter ail_str_split_iter           (AIL_Str str, AIL_Str split_by, b32 ignore_empty);
+internal AIL_Str_Split_Iter ail_str_split_iter_lines     (AIL_Str str, b32 ignore_empty);
+internal AIL_Str_Split_Iter ail_str_split_iter_whitespace(AIL_Str str, b32 ignore_empty);
+// Writes the next substring into `token` and returns false once there are no more substrings
+internal b32 ail_str_split_iter_next(AIL_Str_Split_Iter *it, AIL_Str *token);
+#define ail_str_split_for_each(itPtr, token) for (AIL_Str token; ail_str_split_iter_next(itPtr, &token);)
+
 // @Note: rev_join joins the splitted substrings in reverse order
 // @Important: To avoid memory leaks, make sure to free the underlying string
 internal AIL_Str ail_str_join_a    (AIL_Str *list, u64 n, AIL_Str joiner, AIL_Allocator allocator);
@@ -296,25 +406,34 @@ internal AIL_Str ail_str_rev_join_a(AIL_Str *list, u64 n, AIL_Str joiner, AIL_Al
 #define ail_str_join(list, n, joiner)     ail_str_join_a(list, n, joiner, ail_default_allocator)
 #define ail_str_rev_join(list, n, joiner) ail_str_rev_join_a(list, n, joiner, ail_default_allocator)
 #define ail_str_join_da(list, joiner)     ail_str_join_a((list).data, (list).len, joiner, ail_default_allocator)
-#define ail_str_rev_join_da(list, joiner) ail_str_rev_join_da_a((list).data, (list).len, joiner, ail_default_allocator)
+#define ail_str_rev_join_da(list, joiner) ail_str_rev_join_a((list).data, (list).len, joiner, ail_default_allocator)
 
 //////////////////
 // Miscellanous //
 //////////////////
 
 #define ail_sb_push_str(sbptr, str) ail_da_pushn(sbptr, str.data, str.len)
-internal ail_print_format(2, 3) void ail_sb_print(AIL_SB *sb, char *format, ...);
+// Append the decimal representation of `num` (see ail_str_*_to_buf) without any intermediate allocations
+internal void ail_sb_push_unsigned(AIL_SB *sb, u64 num);
+internal void ail_sb_push_signed  (AIL_SB *sb, i64 num);
+internal void ail_sb_push_float   (AIL_SB *sb, f64 num);
+// @Note: Formatted printing into string builders (ail_sb_print) is provided by ail_fmt.h
 internal AIL_Str ail_sb_to_str(AIL_SB sb);
 
 internal b32 ail_str_is_space(char c);
 internal b32 ail_str_is_alpha(char c);
 internal b32 ail_str_is_digit(char c);
+internal b32 ail_str_is_lower(char c);
+internal b32 ail_str_is_upper(char c);
+internal char ail_str_lower_char(char c);
+internal char ail_str_upper_char(char c);
 
 // Receive a new STR, that points at the same underlying string as `str` but offset by `offset` bytes.
 // If `offset` is greater than the length of `str`, then a STR with zero length is returned
 internal AIL_Str ail_str_offset(AIL_Str str, u64 offset);
 
 // Receive a new STR, that has the beginning and ending whitespace from `str` removed
+// @Note: Whitespace is skipped in blocks of 16 or 32 bytes with SIMD when available
 internal AIL_Str ail_str_trim(AIL_Str str);
 internal AIL_Str ail_str_ltrim(AIL_Str str);
 internal AIL_Str ail_str_rtrim(AIL_Str str);
@@ -404,57 +523,26 @@ AIL_Str8 ail_str_new_from_parts_a(u8 *data, u64 len, AIL_Allocator allocator)
 
 AIL_DA(u8) _ail_da_from_unsigned_a(u64 num, AIL_Allocator allocator)
 {
-    AIL_DA(u8) da = ail_da_new_with_alloc(u8, 24, allocator);
-    if (num == 0) {
-        ail_da_push(&da, '0');
-    } else {
-        while (num > 0) {
-            ail_da_push(&da, '0' + (num % 10));
-            num /= 10;
-        }
-        for (u64 i = 0, j = da.len - 1; i < da.len/2; i++, j--) {
-            u8 tmp   = da.data[i];
-            da.data[i] = da.data[j];
-            da.data[j] = tmp;
-        }
-    }
-    ail_da_push(&da, 0);
-    da.len--;
+    AIL_DA(u8) da = ail_da_new_with_alloc(u8, AIL_STR_INT_MAX_LEN + 1, allocator);
+    da.len = ail_str_unsigned_to_buf(num, da.data);
+    da.data[da.len] = 0;
     return da;
 }
 
 AIL_DA(u8) _ail_da_from_signed_a(i64 num, AIL_Allocator allocator)
 {
-    AIL_DA(u8) da = ail_da_new_with_alloc(u8, 24, allocator);
-    if (num == 0) {
-        ail_da_push(&da, '0');
-    } else {
-        b32 is_neg = num < 0;
-        if (is_neg) {
-            ail_da_push(&da, '-');
-            num *= -1;
-        }
-        while (num > 0) {
-            ail_da_push(&da, '0' + (num % 10));
-            num /= 10;
-        }
-        for (u64 i = (u64)is_neg, j = da.len - 1; i < da.len/2; i++, j--) {
-            u8 tmp   = da.data[i];
-            da.data[i] = da.data[j];
-            da.data[j] = tmp;
-        }
-    }
-    ail_da_push(&da, 0);
-    da.len--;
+    AIL_DA(u8) da = ail_da_new_with_alloc(u8, AIL_STR_INT_MAX_LEN + 1, allocator);
+    da.len = ail_str_signed_to_buf(num, da.data);
+    da.data[da.len] = 0;
     return da;
 }
 
 AIL_DA(u8) _ail_da_from_float_a(f64 num, AIL_Allocator allocator)
 {
-    AIL_UNUSED(num);
-    AIL_UNUSED(allocator);
-    AIL_TODO();
-    return (AIL_DA(u8)) {0};
+    AIL_DA(u8) da = ail_da_new_with_alloc(u8, AIL_STR_FLOAT_MAX_LEN + 1, allocator);
+    da.len = ail_str_float_to_buf(num, da.data);
+    da.data[da.len] = 0;
+    return da;
 }
 
 AIL_Str8 ail_str_new_unsigned_a(u64 num, AIL_Allocator allocator)
@@ -492,17 +580,89 @@ char* ail_str_to_cstr_full(char *s, u64 len, AIL_Allocator allocator)
     return res;
 }
 
+/////////////////////////
+// Integer Conversions //
+/////////////////////////
+
+// Integers are parsed 8 digits at a time with SWAR (SIMD within a register), as described by Daniel Lemire (https://lemire.me/blog/2022/01/21/swar-explained-parsing-eight-digits/)
+// They are written 2 digits at a time from a lookup table, after their length was computed from the amount of their significant bits
+
+static const u64 _ail_str_pow10_u64_[20] = {
+    1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL, 100000000ULL, 1000000000ULL,
+    10000000000ULL, 100000000000ULL, 1000000000000ULL, 10000000000000ULL, 100000000000000ULL,
+    1000000000000000ULL, 10000000000000000ULL, 100000000000000000ULL, 1000000000000000000ULL, 10000000000000000000ULL,
+};
+
+static const char _ail_str_digit_pairs_[201] =
+    "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+    "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+// Loads 8 bytes in little-endian order (compilers turn this into a single load on little-endian platforms)
+inline_func u64 _ail_str_load_u64_le_(const u8 *p)
+{
+    return (u64)p[0]       | (u64)p[1] << 8  | (u64)p[2] << 16 | (u64)p[3] << 24 |
+           (u64)p[4] << 32 | (u64)p[5] << 40 | (u64)p[6] << 48 | (u64)p[7] << 56;
+}
+
+// Amount of consecutive digits at the start of the 8 bytes in `chunk`
+inline_func u32 _ail_str_swar_count_digits_(u64 chunk)
+{
+    // A byte is a digit iff its high nibble is 3 and adding 6 to its low nibble doesn't carry
+    // Adding 6 to a non-digit might carry into the following bytes, but the first non-digit is always detected correctly
+    u64 x = chunk ^ 0x3030303030303030ULL;
+    u64 non_digits = (x | (x + 0x0606060606060606ULL)) & 0xF0F0F0F0F0F0F0F0ULL;
+    return non_digits ? ail_ctz_u64(non_digits) / 8 : 8;
+}
+
+// Value of the 8 digits in `chunk`, where the first byte is the most significant digit
+inline_func u64 _ail_str_swar_parse_8_digits_(u64 chunk)
+{
+    chunk -= 0x3030303030303030ULL;
+    chunk  = chunk*10 + (chunk >> 8); // Combine pairs of digits
+    return (((chunk & 0x000000FF000000FFULL) * (100 + (1000000ULL << 32))) + (((chunk >> 16) & 0x000000FF000000FFULL) * (1 + (10000ULL << 32)))) >> 32;
+}
+
+// Parses all digits starting at p[*idx] into `*val` and returns whether the value overflowed
+internal b32 _ail_str_parse_digits_(u8 *p, u64 n, u64 *idx, u64 *val)
+{
+    u64 i = *idx, v = 0;
+    b32 overflow = false;
+    for (;;) {
+        u64 chunk;
+        if (i + 8 <= n) {
+            chunk = _ail_str_load_u64_le_(p + i);
+        } else {
+            u8 tmp[8] = {0};
+            if (n > i) ail_mem_copy(tmp, p + i, n - i);
+            chunk = _ail_str_load_u64_le_(tmp);
+        }
+        u32 count = _ail_str_swar_count_digits_(chunk);
+        if (!count) break;
+        // Move the digits to the end of the chunk and fill the start with '0's
+        if (count < 8) chunk = (chunk << (8*(8 - count))) | (0x3030303030303030ULL >> (8*count));
+        u64 hi, lo = ail_mul_wide_u64(v, _ail_str_pow10_u64_[count], &hi);
+        v = lo + _ail_str_swar_parse_8_digits_(chunk);
+        overflow |= hi != 0 || v < lo;
+        i += count;
+        if (count < 8) break;
+    }
+    *idx = i;
+    *val = v;
+    return overflow;
+}
+
 AIL_Str_Parse_U_Res ail_str_parse_unsigned(AIL_Str8 str)
 {
     AIL_Str_Parse_U_Res res = {0};
-    u64 i   = 0;
+    u64 i = 0, val;
     if (str.len && str.data[0] == '+') i++;
-    while (i < str.len && str.data[i] >= '0' && str.data[i] <= '9') {
-        res.val *= 10;
-        res.val += str.data[i] - '0';
-        i++;
+    u64 start = i;
+    b32 overflow = _ail_str_parse_digits_(str.data, str.len, &i, &val);
+    if (i > start && !overflow) {
+        res.val = val;
+        res.len = (u32)i;
     }
-    if (!(i == 1 && str.data[0] == '+')) res.len = (u32)i;
     return res;
 }
 
@@ -510,378 +670,2553 @@ AIL_Str_Parse_I_Res ail_str_parse_signed(AIL_Str8 str)
 {
     AIL_Str_Parse_I_Res res = {0};
     b32 is_neg = false;
-    u64 i   = 0;
-    if (str.len) {
-        if (str.data[0] == '+') {
-            i++;
-        } else if (str.data[0] == '-') {
-            is_neg = true;
-            i++;
-        }
+    u64 i = 0, val;
+    if (str.len && (str.data[0] == '+' || str.data[0] == '-')) is_neg = str.data[i++] == '-';
+    u64 start = i;
+    b32 overflow = _ail_str_parse_digits_(str.data, str.len, &i, &val);
+    if (i > start && !overflow && val <= (1ULL << 63) - !is_neg) {
+        res.val = is_neg ? (val ? -(i64)(val - 1) - 1 : 0) : (i64)val;
+        res.len = (u32)i;
     }
-    while (i < str.len && str.data[i] >= '0' && str.data[i] <= '9') {
-        res.val *= 10;
-        res.val += str.data[i] - '0';
-        i++;
-    }
-    if (is_neg) res.val *= -1;
-    if (!(i == 1 && (is_neg || str.data[0] == '+'))) res.len = (u32)i;
     return res;
 }
 
-AIL_Str_Parse_F_Res ail_str_parse_float(AIL_Str8 str)
+inline_func u32 _ail_str_count_digits_(u64 num)
 {
-    (void)str;
-    AIL_Str_Parse_F_Res res = {0};
-    AIL_TODO();
-    return res;
+    // (bits*1233) >> 12 approximates log10(2^bits) and is off by at most one
+    u32 t = ((64 - ail_clz_u64(num | 1)) * 1233) >> 12;
+    return t + (num >= _ail_str_pow10_u64_[t]) + (num == 0);
 }
 
-b32 ail_str_full_eq(char *astr, u64 alen, char *bstr, u64 blen)
+u32 ail_str_unsigned_to_buf(u64 num, u8 *buf)
 {
-    if (alen != blen) return false;
-    for (u64 i = 0; i < alen; i++) {
-        if (astr[i] != bstr[i]) return false;
+    u32 len = _ail_str_count_digits_(num);
+    u8 *p   = buf + len;
+    while (num >= 100) {
+        u64 quo = num / 100;
+        u32 rem = (u32)(num - 100*quo);
+        p   -= 2;
+        p[0] = (u8)_ail_str_digit_pairs_[2*rem];
+        p[1] = (u8)_ail_str_digit_pairs_[2*rem + 1];
+        num  = quo;
     }
-    return true;
+    if (num >= 10) {
+        p[-2] = (u8)_ail_str_digit_pairs_[2*num];
+        p[-1] = (u8)_ail_str_digit_pairs_[2*num + 1];
+    } else {
+        p[-1] = '0' + (u8)num;
+    }
+    return len;
 }
 
-i32  ail_str_full_cmp(char *astr, u64 alen, char *bstr, u64 blen)
+u32 ail_str_signed_to_buf(i64 num, u8 *buf)
 {
-    for (u64 i = 0; i < alen && i < blen; i++) {
-        if (astr[i] != bstr[i]) return astr[i] - bstr[i];
-    }
-    if      (alen  > blen) return astr[blen];
-    else if (alen == blen) return 0;
-    else                   return bstr[alen];
+    if (num >= 0) return ail_str_unsigned_to_buf((u64)num, buf);
+    buf[0] = '-';
+    return 1 + ail_str_unsigned_to_buf(0 - (u64)num, buf + 1);
 }
 
-b32 ail_str_starts_with(AIL_Str8 str, AIL_Str8 prefix)
+void ail_sb_push_unsigned(AIL_SB *sb, u64 num)
 {
-    if (prefix.len > str.len) return false;
-    for (u64 i = 0; i < prefix.len; i++) {
-        if (str.data[i] != prefix.data[i]) return false;
-    }
-    return true;
+    ail_da_maybe_grow(sb, AIL_STR_INT_MAX_LEN);
+    sb->len += ail_str_unsigned_to_buf(num, sb->data + sb->len);
 }
 
-b32 ail_str_starts_with_char(AIL_Str8 str, char prefix)
+void ail_sb_push_signed(AIL_SB *sb, i64 num)
 {
-    return str.len > 0 && str.data[0] == prefix;
+    ail_da_maybe_grow(sb, AIL_STR_INT_MAX_LEN);
+    sb->len += ail_str_signed_to_buf(num, sb->data + sb->len);
 }
 
-b32 ail_str_ends_with(AIL_Str8 str, AIL_Str8 suffix)
+void ail_sb_push_float(AIL_SB *sb, f64 num)
+{
+    ail_da_maybe_grow(sb, AIL_STR_FLOAT_MAX_LEN);
+    sb->len += ail_str_float_to_buf(num, sb->data + sb->len);
+}
+
+//////////////////////
+// Float Conversion //
+//////////////////////
+
+// Parsing uses the algorithm by Michael Eisel & Daniel Lemire ("Number Parsing at a Gigabyte per Second", 2021) in the form used by Go's strconv package:
+// Up to 19 significant digits are multiplied with a 128-bit approximation of the power of ten, which is precise enough to round correctly in almost all cases.
+// The rare cases, where this isn't enough to decide how to round (or where more than 19 digits are relevant, or where the result is subnormal), fall back to exact decimal arithmetic.
+// Printing uses the Schubfach algorithm by Raffaello Giulietti ("The Schubfach way to render doubles", 2020), which finds the shortest decimal that rounds back to the same float
+// (or the closest one to the float, if there are several shortest decimals).
+// Neither depends on libc.
+
+#define _AIL_STR_POW10_MIN_ -342
+#define _AIL_STR_POW10_MAX_  324
+// The upper 128 bits of 10^q (shifted, such that the highest bit is set, and rounded down) for q in [_AIL_STR_POW10_MIN_, _AIL_STR_POW10_MAX_] stored as {hi, lo}
+static const u64 _ail_str_pow10_128_[_AIL_STR_POW10_MAX_ - _AIL_STR_POW10_MIN_ + 1][2] = {
+        {0xEEF453D6923BD65AULL, 0x113FAA2906A13B3FULL}, {0x9558B4661B6565F8ULL, 0x4AC7CA59A424C507ULL},
+        {0xBAAEE17FA23EBF76ULL, 0x5D79BCF00D2DF649ULL}, {0xE95A99DF8ACE6F53ULL, 0xF4D82C2C107973DCULL},
+        {0x91D8A02BB6C10594ULL, 0x79071B9B8A4BE869ULL}, {0xB64EC836A47146F9ULL, 0x9748E2826CDEE284ULL},
+        {0xE3E27A444D8D98B7ULL, 0xFD1B1B2308169B25ULL}, {0x8E6D8C6AB0787F72ULL, 0xFE30F0F5E50E20F7ULL},
+        {0xB208EF855C969F4FULL, 0xBDBD2D335E51A935ULL}, {0xDE8B2B66B3BC4723ULL, 0xAD2C788035E61382ULL},
+        {0x8B16FB203055AC76ULL, 0x4C3BCB5021AFCC31ULL}, {0xADDCB9E83C6B1793ULL, 0xDF4ABE242A1BBF3DULL},
+        {0xD953E8624B85DD78ULL, 0xD71D6DAD34A2AF0DULL}, {0x87D4713D6F33AA6BULL, 0x8672648C40E5AD68ULL},
+        {0xA9C98D8CCB009506ULL, 0x680EFDAF511F18C2ULL}, {0xD43BF0EFFDC0BA48ULL, 0x0212BD1B2566DEF2ULL},
+        {0x84A57695FE98746DULL, 0x014BB630F7604B57ULL}, {0xA5CED43B7E3E9188ULL, 0x419EA3BD35385E2DULL},
+        {0xCF42894A5DCE35EAULL, 0x52064CAC828675B9ULL}, {0x818995CE7AA0E1B2ULL, 0x7343EFEBD1940993ULL},
+        {0xA1EBFB4219491A1FULL, 0x1014EBE6C5F90BF8ULL}, {0xCA66FA129F9B60A6ULL, 0xD41A26E077774EF6ULL},
+        {0xFD00B897478238D0ULL, 0x8920B098955522B4ULL}, {0x9E20735E8CB16382ULL, 0x55B46E5F5D5535B0ULL},
+        {0xC5A890362FDDBC62ULL, 0xEB2189F734AA831DULL}, {0xF712B443BBD52B7BULL, 0xA5E9EC7501D523E4ULL},
+        {0x9A6BB0AA55653B2DULL, 0x47B233C92125366EULL}, {0xC1069CD4EABE89F8ULL, 0x999EC0BB696E840AULL},
+        {0xF148440A256E2C76ULL, 0xC00670EA43CA250DULL}, {0x96CD2A865764DBCAULL, 0x380406926A5E5728ULL},
+        {0xBC807527ED3E12BCULL, 0xC605083704F5ECF2ULL}, {0xEBA09271E88D976BULL, 0xF7864A44C633682EULL},
+        {0x93445B8731587EA3ULL, 0x7AB3EE6AFBE0211DULL}, {0xB8157268FDAE9E4CULL, 0x5960EA05BAD82964ULL},
+        {0xE61ACF033D1A45DFULL, 0x6FB92487298E33BDULL}, {0x8FD0C16206306BABULL, 0xA5D3B6D479F8E056ULL},
+        {0xB3C4F1BA87BC8696ULL, 0x8F48A4899877186CULL}, {0xE0B62E2929ABA83CULL, 0x331ACDABFE94DE87ULL},
+        {0x8C71DCD9BA0B4925ULL, 0x9FF0C08B7F1D0B14ULL}, {0xAF8E5410288E1B6FULL, 0x07ECF0AE5EE44DD9ULL},
+        {0xDB71E91432B1A24AULL, 0xC9E82CD9F69D6150ULL}, {0x892731AC9FAF056EULL, 0xBE311C083A225CD2ULL},
+        {0xAB70FE17C79AC6CAULL, 0x6DBD630A48AAF406ULL}, {0xD64D3D9DB981787DULL, 0x092CBBCCDAD5B108ULL},
+        {0x85F0468293F0EB4EULL, 0x25BBF56008C58EA5ULL}, {0xA76C582338ED2621ULL, 0xAF2AF2B80AF6F24EULL},
+        {0xD1476E2C07286FAAULL, 0x1AF5AF660DB4AEE1ULL}, {0x82CCA4DB847945CAULL, 0x50D98D9FC890ED4DULL},
+        {0xA37FCE126597973CULL, 0xE50FF107BAB528A0ULL}, {0xCC5FC196FEFD7D0CULL, 0x1E53ED49A96272C8ULL},
+        {0xFF77B1FCBEBCDC4FULL, 0x25E8E89C13BB0F7AULL}, {0x9FAACF3DF73609B1ULL, 0x77B191618C54E9ACULL},
+        {0xC795830D75038C1DULL, 0xD59DF5B9EF6A2417ULL}, {0xF97AE3D0D2446F25ULL, 0x4B0573286B44AD1DULL},
+        {0x9BECCE62836AC577ULL, 0x4EE367F9430AEC32ULL}, {0xC2E801FB244576D5ULL, 0x229C41F793CDA73FULL},
+        {0xF3A20279ED56D48AULL, 0x6B43527578C1110FULL}, {0x9845418C345644D6ULL, 0x830A13896B78AAA9ULL},
+        {0xBE5691EF416BD60CULL, 0x23CC986BC656D553ULL}, {0xEDEC366B11C6CB8FULL, 0x2CBFBE86B7EC8AA8ULL},
+        {0x94B3A202EB1C3F39ULL, 0x7BF7D71432F3D6A9ULL}, {0xB9E08A83A5E34F07ULL, 0xDAF5CCD93FB0CC53ULL},
+        {0xE858AD248F5C22C9ULL, 0xD1B3400F8F9CFF68ULL}, {0x91376C36D99995BEULL, 0x23100809B9C21FA1ULL},
+        {0xB58547448FFFFB2DULL, 0xABD40A0C2832A78AULL}, {0xE2E69915B3FFF9F9ULL, 0x16C90C8F323F516CULL},
+        {0x8DD01FAD907FFC3BULL, 0xAE3DA7D97F6792E3ULL}, {0xB1442798F49FFB4AULL, 0x99CD11CFDF41779CULL},
+        {0xDD95317F31C7FA1DULL, 0x40405643D711D583ULL}, {0x8A7D3EEF7F1CFC52ULL, 0x482835EA666B2572ULL},
+        {0xAD1C8EAB5EE43B66ULL, 0xDA3243650005EECFULL}, {0xD863B256369D4A40ULL, 0x90BED43E40076A82ULL},
+        {0x873E4F75E2224E68ULL, 0x5A7744A6E804A291ULL}, {0xA90DE3535AAAE202ULL, 0x711515D0A205CB36ULL},
+        {0xD3515C2831559A83ULL, 0x0D5A5B44CA873E03ULL}, {0x8412D9991ED58091ULL, 0xE858790AFE9486C2ULL},
+        {0xA5178FFF668AE0B6ULL, 0x626E974DBE39A872ULL}, {0xCE5D73FF402D98E3ULL, 0xFB0A3D212DC8128FULL},
+        {0x80FA687F881C7F8EULL, 0x7CE66634BC9D0B99ULL}, {0xA139029F6A239F72ULL, 0x1C1FFFC1EBC44E80ULL},
+        {0xC987434744AC874EULL, 0xA327FFB266B56220ULL}, {0xFBE9141915D7A922ULL, 0x4BF1FF9F0062BAA8ULL},
+        {0x9D71AC8FADA6C9B5ULL, 0x6F773FC3603DB4A9ULL}, {0xC4CE17B399107C22ULL, 0xCB550FB4384D21D3ULL},
+        {0xF6019DA07F549B2BULL, 0x7E2A53A146606A48ULL}, {0x99C102844F94E0FBULL, 0x2EDA7444CBFC426DULL},
+        {0xC0314325637A1939ULL, 0xFA911155FEFB5308ULL}, {0xF03D93EEBC589F88ULL, 0x793555AB7EBA27CAULL},
+        {0x96267C7535B763B5ULL, 0x4BC1558B2F3458DEULL}, {0xBBB01B9283253CA2ULL, 0x9EB1AAEDFB016F16ULL},
+        {0xEA9C227723EE8BCBULL, 0x465E15A979C1CADCULL}, {0x92A1958A7675175FULL, 0x0BFACD89EC191EC9ULL},
+        {0xB749FAED14125D36ULL, 0xCEF980EC671F667BULL}, {0xE51C79A85916F484ULL, 0x82B7E12780E7401AULL},
+        {0x8F31CC0937AE58D2ULL, 0xD1B2ECB8B0908810ULL}, {0xB2FE3F0B8599EF07ULL, 0x861FA7E6DCB4AA15ULL},
+        {0xDFBDCECE67006AC9ULL, 0x67A791E093E1D49AULL}, {0x8BD6A141006042BDULL, 0xE0C8BB2C5C6D24E0ULL},
+        {0xAECC49914078536DULL, 0x58FAE9F773886E18ULL}, {0xDA7F5BF590966848ULL, 0xAF39A475506A899EULL},
+        {0x888F99797A5E012DULL, 0x6D8406C952429603ULL}, {0xAAB37FD7D8F58178ULL, 0xC8E5087BA6D33B83ULL},
+        {0xD5605FCDCF32E1D6ULL, 0xFB1E4A9A90880A64ULL}, {0x855C3BE0A17FCD26ULL, 0x5CF2EEA09A55067FULL},
+        {0xA6B34AD8C9DFC06FULL, 0xF42FAA48C0EA481EULL}, {0xD0601D8EFC57B08BULL, 0xF13B94DAF124DA26ULL},
+        {0x823C12795DB6CE57ULL, 0x76C53D08D6B70858ULL}, {0xA2CB1717B52481EDULL, 0x54768C4B0C64CA6EULL},
+        {0xCB7DDCDDA26DA268ULL, 0xA9942F5DCF7DFD09ULL}, {0xFE5D54150B090B02ULL, 0xD3F93B35435D7C4CULL},
+        {0x9EFA548D26E5A6E1ULL, 0xC47BC5014A1A6DAFULL}, {0xC6B8E9B0709F109AULL, 0x359AB6419CA1091BULL},
+        {0xF867241C8CC6D4C0ULL, 0xC30163D203C94B62ULL}, {0x9B407691D7FC44F8ULL, 0x79E0DE63425DCF1DULL},
+        {0xC21094364DFB5636ULL, 0x985915FC12F542E4ULL}, {0xF294B943E17A2BC4ULL, 0x3E6F5B7B17B2939DULL},
+        {0x979CF3CA6CEC5B5AULL, 0xA705992CEECF9C42ULL}, {0xBD8430BD08277231ULL, 0x50C6FF782A838353ULL},
+        {0xECE53CEC4A314EBDULL, 0xA4F8BF5635246428ULL}, {0x940F4613AE5ED136ULL, 0x871B7795E136BE99ULL},
+        {0xB913179899F68584ULL, 0x28E2557B59846E3FULL}, {0xE757DD7EC07426E5ULL, 0x331AEADA2FE589CFULL},
+        {0x9096EA6F3848984FULL, 0x3FF0D2C85DEF7621ULL}, {0xB4BCA50B065ABE63ULL, 0x0FED077A756B53A9ULL},
+        {0xE1EBCE4DC7F16DFBULL, 0xD3E8495912C62894ULL}, {0x8D3360F09CF6E4BDULL, 0x64712DD7ABBBD95CULL},
+        {0xB080392CC4349DECULL, 0xBD8D794D96AACFB3ULL}, {0xDCA04777F541C567ULL, 0xECF0D7A0FC5583A0ULL},
+        {0x89E42CAAF9491B60ULL, 0xF41686C49DB57244ULL}, {0xAC5D37D5B79B6239ULL, 0x311C2875C522CED5ULL},
+        {0xD77485CB25823AC7ULL, 0x7D633293366B828BULL}, {0x86A8D39EF77164BCULL, 0xAE5DFF9C02033197ULL},
+        {0xA8530886B54DBDEBULL, 0xD9F57F830283FDFCULL}, {0xD267CAA862A12D66ULL, 0xD072DF63C324FD7BULL},
+        {0x8380DEA93DA4BC60ULL, 0x4247CB9E59F71E6DULL}, {0xA46116538D0DEB78ULL, 0x52D9BE85F074E608ULL},
+        {0xCD795BE870516656ULL, 0x67902E276C921F8BULL}, {0x806BD9714632DFF6ULL, 0x00BA1CD8A3DB53B6ULL},
+        {0xA086CFCD97BF97F3ULL, 0x80E8A40ECCD228A4ULL}, {0xC8A883C0FDAF7DF0ULL, 0x6122CD128006B2CDULL},
+        {0xFAD2A4B13D1B5D6CULL, 0x796B805720085F81ULL}, {0x9CC3A6EEC6311A63ULL, 0xCBE3303674053BB0ULL},
+        {0xC3F490AA77BD60FCULL, 0xBEDBFC4411068A9CULL}, {0xF4F1B4D515ACB93BULL, 0xEE92FB5515482D44ULL},
+        {0x991711052D8BF3C5ULL, 0x751BDD152D4D1C4AULL}, {0xBF5CD54678EEF0B6ULL, 0xD262D45A78A0635DULL},
+        {0xEF340A98172AACE4ULL, 0x86FB897116C87C34ULL}, {0x9580869F0E7AAC0EULL, 0xD45D35E6AE3D4DA0ULL},
+        {0xBAE0A846D2195712ULL, 0x8974836059CCA109ULL}, {0xE998D258869FACD7ULL, 0x2BD1A438703FC94BULL},
+        {0x91FF83775423CC06ULL, 0x7B6306A34627DDCFULL}, {0xB67F6455292CBF08ULL, 0x1A3BC84C17B1D542ULL},
+        {0xE41F3D6A7377EECAULL, 0x20CABA5F1D9E4A93ULL}, {0x8E938662882AF53EULL, 0x547EB47B7282EE9CULL},
+        {0xB23867FB2A35B28DULL, 0xE99E619A4F23AA43ULL}, {0xDEC681F9F4C31F31ULL, 0x6405FA00E2EC94D4ULL},
+        {0x8B3C113C38F9F37EULL, 0xDE83BC408DD3DD04ULL}, {0xAE0B158B4738705EULL, 0x9624AB50B148D445ULL},
+        {0xD98DDAEE19068C76ULL, 0x3BADD624DD9B0957ULL}, {0x87F8A8D4CFA417C9ULL, 0xE54CA5D70A80E5D6ULL},
+        {0xA9F6D30A038D1DBCULL, 0x5E9FCF4CCD211F4CULL}, {0xD47487CC8470652BULL, 0x7647C3200069671FULL},
+        {0x84C8D4DFD2C63F3BULL, 0x29ECD9F40041E073ULL}, {0xA5FB0A17C777CF09ULL, 0xF468107100525890ULL},
+        {0xCF79CC9DB955C2CCULL, 0x7182148D4066EEB4ULL}, {0x81AC1FE293D599BFULL, 0xC6F14CD848405530ULL},
+        {0xA21727DB38CB002FULL, 0xB8ADA00E5A506A7CULL}, {0xCA9CF1D206FDC03BULL, 0xA6D90811F0E4851CULL},
+        {0xFD442E4688BD304AULL, 0x908F4A166D1DA663ULL}, {0x9E4A9CEC15763E2EULL, 0x9A598E4E043287FEULL},
+        {0xC5DD44271AD3CDBAULL, 0x40EFF1E1853F29FDULL}, {0xF7549530E188C128ULL, 0xD12BEE59E68EF47CULL},
+        {0x9A94DD3E8CF578B9ULL, 0x82BB74F8301958CEULL}, {0xC13A148E3032D6E7ULL, 0xE36A52363C1FAF01ULL},
+        {0xF18899B1BC3F8CA1ULL, 0xDC44E6C3CB279AC1ULL}, {0x96F5600F15A7B7E5ULL, 0x29AB103A5EF8C0B9ULL},
+        {0xBCB2B812DB11A5DEULL, 0x7415D448F6B6F0E7ULL}, {0xEBDF661791D60F56ULL, 0x111B495B3464AD21ULL},
+        {0x936B9FCEBB25C995ULL, 0xCAB10DD900BEEC34ULL}, {0xB84687C269EF3BFBULL, 0x3D5D514F40EEA742ULL},
+        {0xE65829B3046B0AFAULL, 0x0CB4A5A3112A5112ULL}, {0x8FF71A0FE2C2E6DCULL, 0x47F0E785EABA72ABULL},
+        {0xB3F4E093DB73A093ULL, 0x59ED216765690F56ULL}, {0xE0F218B8D25088B8ULL, 0x306869C13EC3532CULL},
+        {0x8C974F7383725573ULL, 0x1E414218C73A13FBULL}, {0xAFBD2350644EEACFULL, 0xE5D1929EF90898FAULL},
+        {0xDBAC6C247D62A583ULL, 0xDF45F746B74ABF39ULL}, {0x894BC396CE5DA772ULL, 0x6B8BBA8C328EB783ULL},
+        {0xAB9EB47C81F5114FULL, 0x066EA92F3F326564ULL}, {0xD686619BA27255A2ULL, 0xC80A537B0EFEFEBDULL},
+        {0x8613FD0145877585ULL, 0xBD06742CE95F5F36ULL}, {0xA798FC4196E952E7ULL, 0x2C48113823B73704ULL},
+        {0xD17F3B51FCA3A7A0ULL, 0xF75A15862CA504C5ULL}, {0x82EF85133DE648C4ULL, 0x9A984D73DBE722FBULL},
+        {0xA3AB66580D5FDAF5ULL, 0xC13E60D0D2E0EBBAULL}, {0xCC963FEE10B7D1B3ULL, 0x318DF905079926A8ULL},
+        {0xFFBBCFE994E5C61FULL, 0xFDF17746497F7052ULL}, {0x9FD561F1FD0F9BD3ULL, 0xFEB6EA8BEDEFA633ULL},
+        {0xC7CABA6E7C5382C8ULL, 0xFE64A52EE96B8FC0ULL}, {0xF9BD690A1B68637BULL, 0x3DFDCE7AA3C673B0ULL},
+        {0x9C1661A651213E2DULL, 0x06BEA10CA65C084EULL}, {0xC31BFA0FE5698DB8ULL, 0x486E494FCFF30A62ULL},
+        {0xF3E2F893DEC3F126ULL, 0x5A89DBA3C3EFCCFAULL}, {0x986DDB5C6B3A76B7ULL, 0xF89629465A75E01CULL},
+        {0xBE89523386091465ULL, 0xF6BBB397F1135823ULL}, {0xEE2BA6C0678B597FULL, 0x746AA07DED582E2CULL},
+        {0x94DB483840B717EFULL, 0xA8C2A44EB4571CDCULL}, {0xBA121A4650E4DDEBULL, 0x92F34D62616CE413ULL},
+        {0xE896A0D7E51E1566ULL, 0x77B020BAF9C81D17ULL}, {0x915E2486EF32CD60ULL, 0x0ACE1474DC1D122EULL},
+        {0xB5B5ADA8AAFF80B8ULL, 0x0D819992132456BAULL}, {0xE3231912D5BF60E6ULL, 0x10E1FFF697ED6C69ULL},
+        {0x8DF5EFABC5979C8FULL, 0xCA8D3FFA1EF463C1ULL}, {0xB1736B96B6FD83B3ULL, 0xBD308FF8A6B17CB2ULL},
+        {0xDDD0467C64BCE4A0ULL, 0xAC7CB3F6D05DDBDEULL}, {0x8AA22C0DBEF60EE4ULL, 0x6BCDF07A423AA96BULL},
+        {0xAD4AB7112EB3929DULL, 0x86C16C98D2C953C6ULL}, {0xD89D64D57A607744ULL, 0xE871C7BF077BA8B7ULL},
+        {0x87625F056C7C4A8BULL, 0x11471CD764AD4972ULL}, {0xA93AF6C6C79B5D2DULL, 0xD598E40D3DD89BCFULL},
+        {0xD389B47879823479ULL, 0x4AFF1D108D4EC2C3ULL}, {0x843610CB4BF160CBULL, 0xCEDF722A585139BAULL},
+        {0xA54394FE1EEDB8FEULL, 0xC2974EB4EE658828ULL}, {0xCE947A3DA6A9273EULL, 0x733D226229FEEA32ULL},
+        {0x811CCC668829B887ULL, 0x0806357D5A3F525FULL}, {0xA163FF802A3426A8ULL, 0xCA07C2DCB0CF26F7ULL},
+        {0xC9BCFF6034C13052ULL, 0xFC89B393DD02F0B5ULL}, {0xFC2C3F3841F17C67ULL, 0xBBAC2078D443ACE2ULL},
+        {0x9D9BA7832936EDC0ULL, 0xD54B944B84AA4C0DULL}, {0xC5029163F384A931ULL, 0x0A9E795E65D4DF11ULL},
+        {0xF64335BCF065D37DULL, 0x4D4617B5FF4A16D5ULL}, {0x99EA0196163FA42EULL, 0x504BCED1BF8E4E45ULL},
+        {0xC06481FB9BCF8D39ULL, 0xE45EC2862F71E1D6ULL}, {0xF07DA27A82C37088ULL, 0x5D767327BB4E5A4CULL},
+        {0x964E858C91BA2655ULL, 0x3A6A07F8D510F86FULL}, {0xBBE226EFB628AFEAULL, 0x890489F70A55368BULL},
+        {0xEADAB0ABA3B2DBE5ULL, 0x2B45AC74CCEA842EULL}, {0x92C8AE6B464FC96FULL, 0x3B0B8BC90012929DULL},
+        {0xB77ADA0617E3BBCBULL, 0x09CE6EBB40173744ULL}, {0xE55990879DDCAABDULL, 0xCC420A6A101D0515ULL},
+        {0x8F57FA54C2A9EAB6ULL, 0x9FA946824A12232DULL}, {0xB32DF8E9F3546564ULL, 0x47939822DC96ABF9ULL},
+        {0xDFF9772470297EBDULL, 0x59787E2B93BC56F7ULL}, {0x8BFBEA76C619EF36ULL, 0x57EB4EDB3C55B65AULL},
+        {0xAEFAE51477A06B03ULL, 0xEDE622920B6B23F1ULL}, {0xDAB99E59958885C4ULL, 0xE95FAB368E45ECEDULL},
+        {0x88B402F7FD75539BULL, 0x11DBCB0218EBB414ULL}, {0xAAE103B5FCD2A881ULL, 0xD652BDC29F26A119ULL},
+        {0xD59944A37C0752A2ULL, 0x4BE76D3346F0495FULL}, {0x857FCAE62D8493A5ULL, 0x6F70A4400C562DDBULL},
+        {0xA6DFBD9FB8E5B88EULL, 0xCB4CCD500F6BB952ULL}, {0xD097AD07A71F26B2ULL, 0x7E2000A41346A7A7ULL},
+        {0x825ECC24C873782FULL, 0x8ED400668C0C28C8ULL}, {0xA2F67F2DFA90563BULL, 0x728900802F0F32FAULL},
+        {0xCBB41EF979346BCAULL, 0x4F2B40A03AD2FFB9ULL}, {0xFEA126B7D78186BCULL, 0xE2F610C84987BFA8ULL},
+        {0x9F24B832E6B0F436ULL, 0x0DD9CA7D2DF4D7C9ULL}, {0xC6EDE63FA05D3143ULL, 0x91503D1C79720DBBULL},
+        {0xF8A95FCF88747D94ULL, 0x75A44C6397CE912AULL}, {0x9B69DBE1B548CE7CULL, 0xC986AFBE3EE11ABAULL},
+        {0xC24452DA229B021BULL, 0xFBE85BADCE996168ULL}, {0xF2D56790AB41C2A2ULL, 0xFAE27299423FB9C3ULL},
+        {0x97C560BA6B0919A5ULL, 0xDCCD879FC967D41AULL}, {0xBDB6B8E905CB600FULL, 0x5400E987BBC1C920ULL},
+        {0xED246723473E3813ULL, 0x290123E9AAB23B68ULL}, {0x9436C0760C86E30BULL, 0xF9A0B6720AAF6521ULL},
+        {0xB94470938FA89BCEULL, 0xF808E40E8D5B3E69ULL}, {0xE7958CB87392C2C2ULL, 0xB60B1D1230B20E04ULL},
+        {0x90BD77F3483BB9B9ULL, 0xB1C6F22B5E6F48C2ULL}, {0xB4ECD5F01A4AA828ULL, 0x1E38AEB6360B1AF3ULL},
+        {0xE2280B6C20DD5232ULL, 0x25C6DA63C38DE1B0ULL}, {0x8D590723948A535FULL, 0x579C487E5A38AD0EULL},
+        {0xB0AF48EC79ACE837ULL, 0x2D835A9DF0C6D851ULL}, {0xDCDB1B2798182244ULL, 0xF8E431456CF88E65ULL},
+        {0x8A08F0F8BF0F156BULL, 0x1B8E9ECB641B58FFULL}, {0xAC8B2D36EED2DAC5ULL, 0xE272467E3D222F3FULL},
+        {0xD7ADF884AA879177ULL, 0x5B0ED81DCC6ABB0FULL}, {0x86CCBB52EA94BAEAULL, 0x98E947129FC2B4E9ULL},
+        {0xA87FEA27A539E9A5ULL, 0x3F2398D747B36224ULL}, {0xD29FE4B18E88640EULL, 0x8EEC7F0D19A03AADULL},
+        {0x83A3EEEEF9153E89ULL, 0x1953CF68300424ACULL}, {0xA48CEAAAB75A8E2BULL, 0x5FA8C3423C052DD7ULL},
+        {0xCDB02555653131B6ULL, 0x3792F412CB06794DULL}, {0x808E17555F3EBF11ULL, 0xE2BBD88BBEE40BD0ULL},
+        {0xA0B19D2AB70E6ED6ULL, 0x5B6ACEAEAE9D0EC4ULL}, {0xC8DE047564D20A8BULL, 0xF245825A5A445275ULL},
+        {0xFB158592BE068D2EULL, 0xEED6E2F0F0D56712ULL}, {0x9CED737BB6C4183DULL, 0x55464DD69685606BULL},
+        {0xC428D05AA4751E4CULL, 0xAA97E14C3C26B886ULL}, {0xF53304714D9265DFULL, 0xD53DD99F4B3066A8ULL},
+        {0x993FE2C6D07B7FABULL, 0xE546A8038EFE4029ULL}, {0xBF8FDB78849A5F96ULL, 0xDE98520472BDD033ULL},
+        {0xEF73D256A5C0F77CULL, 0x963E66858F6D4440ULL}, {0x95A8637627989AADULL, 0xDDE7001379A44AA8ULL},
+        {0xBB127C53B17EC159ULL, 0x5560C018580D5D52ULL}, {0xE9D71B689DDE71AFULL, 0xAAB8F01E6E10B4A6ULL},
+        {0x9226712162AB070DULL, 0xCAB3961304CA70E8ULL}, {0xB6B00D69BB55C8D1ULL, 0x3D607B97C5FD0D22ULL},
+        {0xE45C10C42A2B3B05ULL, 0x8CB89A7DB77C506AULL}, {0x8EB98A7A9A5B04E3ULL, 0x77F3608E92ADB242ULL},
+        {0xB267ED1940F1C61CULL, 0x55F038B237591ED3ULL}, {0xDF01E85F912E37A3ULL, 0x6B6C46DEC52F6688ULL},
+        {0x8B61313BBABCE2C6ULL, 0x2323AC4B3B3DA015ULL}, {0xAE397D8AA96C1B77ULL, 0xABEC975E0A0D081AULL},
+        {0xD9C7DCED53C72255ULL, 0x96E7BD358C904A21ULL}, {0x881CEA14545C7575ULL, 0x7E50D64177DA2E54ULL},
+        {0xAA242499697392D2ULL, 0xDDE50BD1D5D0B9E9ULL}, {0xD4AD2DBFC3D07787ULL, 0x955E4EC64B44E864ULL},
+        {0x84EC3C97DA624AB4ULL, 0xBD5AF13BEF0B113EULL}, {0xA6274BBDD0FADD61ULL, 0xECB1AD8AEACDD58EULL},
+        {0xCFB11EAD453994BAULL, 0x67DE18EDA5814AF2ULL}, {0x81CEB32C4B43FCF4ULL, 0x80EACF948770CED7ULL},
+        {0xA2425FF75E14FC31ULL, 0xA1258379A94D028DULL}, {0xCAD2F7F5359A3B3EULL, 0x096EE45813A04330ULL},
+        {0xFD87B5F28300CA0DULL, 0x8BCA9D6E188853FCULL}, {0x9E74D1B791E07E48ULL, 0x775EA264CF55347DULL},
+        {0xC612062576589DDAULL, 0x95364AFE032A819DULL}, {0xF79687AED3EEC551ULL, 0x3A83DDBD83F52204ULL},
+        {0x9ABE14CD44753B52ULL, 0xC4926A9672793542ULL}, {0xC16D9A0095928A27ULL, 0x75B7053C0F178293ULL},
+        {0xF1C90080BAF72CB1ULL, 0x5324C68B12DD6338ULL}, {0x971DA05074DA7BEEULL, 0xD3F6FC16EBCA5E03ULL},
+        {0xBCE5086492111AEAULL, 0x88F4BB1CA6BCF584ULL}, {0xEC1E4A7DB69561A5ULL, 0x2B31E9E3D06C32E5ULL},
+        {0x9392EE8E921D5D07ULL, 0x3AFF322E62439FCFULL}, {0xB877AA3236A4B449ULL, 0x09BEFEB9FAD487C2ULL},
+        {0xE69594BEC44DE15BULL, 0x4C2EBE687989A9B3ULL}, {0x901D7CF73AB0ACD9ULL, 0x0F9D37014BF60A10ULL},
+        {0xB424DC35095CD80FULL, 0x538484C19EF38C94ULL}, {0xE12E13424BB40E13ULL, 0x2865A5F206B06FB9ULL},
+        {0x8CBCCC096F5088CBULL, 0xF93F87B7442E45D3ULL}, {0xAFEBFF0BCB24AAFEULL, 0xF78F69A51539D748ULL},
+        {0xDBE6FECEBDEDD5BEULL, 0xB573440E5A884D1BULL}, {0x89705F4136B4A597ULL, 0x31680A88F8953030ULL},
+        {0xABCC77118461CEFCULL, 0xFDC20D2B36BA7C3DULL}, {0xD6BF94D5E57A42BCULL, 0x3D32907604691B4CULL},
+        {0x8637BD05AF6C69B5ULL, 0xA63F9A49C2C1B10FULL}, {0xA7C5AC471B478423ULL, 0x0FCF80DC33721D53ULL},
+        {0xD1B71758E219652BULL, 0xD3C36113404EA4A8ULL}, {0x83126E978D4FDF3BULL, 0x645A1CAC083126E9ULL},
+        {0xA3D70A3D70A3D70AULL, 0x3D70A3D70A3D70A3ULL}, {0xCCCCCCCCCCCCCCCCULL, 0xCCCCCCCCCCCCCCCCULL},
+        {0x8000000000000000ULL, 0x0000000000000000ULL}, {0xA000000000000000ULL, 0x0000000000000000ULL},
+        {0xC800000000000000ULL, 0x0000000000000000ULL}, {0xFA00000000000000ULL, 0x0000000000000000ULL},
+        {0x9C40000000000000ULL, 0x0000000000000000ULL}, {0xC350000000000000ULL, 0x0000000000000000ULL},
+        {0xF424000000000000ULL, 0x0000000000000000ULL}, {0x9896800000000000ULL, 0x0000000000000000ULL},
+        {0xBEBC200000000000ULL, 0x0000000000000000ULL}, {0xEE6B280000000000ULL, 0x0000000000000000ULL},
+        {0x9502F90000000000ULL, 0x0000000000000000ULL}, {0xBA43B74000000000ULL, 0x0000000000000000ULL},
+        {0xE8D4A51000000000ULL, 0x0000000000000000ULL}, {0x9184E72A00000000ULL, 0x0000000000000000ULL},
+        {0xB5E620F480000000ULL, 0x0000000000000000ULL}, {0xE35FA931A0000000ULL, 0x0000000000000000ULL},
+        {0x8E1BC9BF04000000ULL, 0x0000000000000000ULL}, {0xB1A2BC2EC5000000ULL, 0x0000000000000000ULL},
+        {0xDE0B6B3A76400000ULL, 0x0000000000000000ULL}, {0x8AC7230489E80000ULL, 0x0000000000000000ULL},
+        {0xAD78EBC5AC620000ULL, 0x0000000000000000ULL}, {0xD8D726B7177A8000ULL, 0x0000000000000000ULL},
+        {0x878678326EAC9000ULL, 0x0000000000000000ULL}, {0xA968163F0A57B400ULL, 0x0000000000000000ULL},
+        {0xD3C21BCECCEDA100ULL, 0x0000000000000000ULL}, {0x84595161401484A0ULL, 0x0000000000000000ULL},
+        {0xA56FA5B99019A5C8ULL, 0x0000000000000000ULL}, {0xCECB8F27F4200F3AULL, 0x0000000000000000ULL},
+        {0x813F3978F8940984ULL, 0x4000000000000000ULL}, {0xA18F07D736B90BE5ULL, 0x5000000000000000ULL},
+        {0xC9F2C9CD04674EDEULL, 0xA400000000000000ULL}, {0xFC6F7C4045812296ULL, 0x4D00000000000000ULL},
+        {0x9DC5ADA82B70B59DULL, 0xF020000000000000ULL}, {0xC5371912364CE305ULL, 0x6C28000000000000ULL},
+        {0xF684DF56C3E01BC6ULL, 0xC732000000000000ULL}, {0x9A130B963A6C115CULL, 0x3C7F400000000000ULL},
+        {0xC097CE7BC90715B3ULL, 0x4B9F100000000000ULL}, {0xF0BDC21ABB48DB20ULL, 0x1E86D40000000000ULL},
+        {0x96769950B50D88F4ULL, 0x1314448000000000ULL}, {0xBC143FA4E250EB31ULL, 0x17D955A000000000ULL},
+        {0xEB194F8E1AE525FDULL, 0x5DCFAB0800000000ULL}, {0x92EFD1B8D0CF37BEULL, 0x5AA1CAE500000000ULL},
+        {0xB7ABC627050305ADULL, 0xF14A3D9E40000000ULL}, {0xE596B7B0C643C719ULL, 0x6D9CCD05D0000000ULL},
+        {0x8F7E32CE7BEA5C6FULL, 0xE4820023A2000000ULL}, {0xB35DBF821AE4F38BULL, 0xDDA2802C8A800000ULL},
+        {0xE0352F62A19E306EULL, 0xD50B2037AD200000ULL}, {0x8C213D9DA502DE45ULL, 0x4526F422CC340000ULL},
+        {0xAF298D050E4395D6ULL, 0x9670B12B7F410000ULL}, {0xDAF3F04651D47B4CULL, 0x3C0CDD765F114000ULL},
+        {0x88D8762BF324CD0FULL, 0xA5880A69FB6AC800ULL}, {0xAB0E93B6EFEE0053ULL, 0x8EEA0D047A457A00ULL},
+        {0xD5D238A4ABE98068ULL, 0x72A4904598D6D880ULL}, {0x85A36366EB71F041ULL, 0x47A6DA2B7F864750ULL},
+        {0xA70C3C40A64E6C51ULL, 0x999090B65F67D924ULL}, {0xD0CF4B50CFE20765ULL, 0xFFF4B4E3F741CF6DULL},
+        {0x82818F1281ED449FULL, 0xBFF8F10E7A8921A4ULL}, {0xA321F2D7226895C7ULL, 0xAFF72D52192B6A0DULL},
+        {0xCBEA6F8CEB02BB39ULL, 0x9BF4F8A69F764490ULL}, {0xFEE50B7025C36A08ULL, 0x02F236D04753D5B4ULL},
+        {0x9F4F2726179A2245ULL, 0x01D762422C946590ULL}, {0xC722F0EF9D80AAD6ULL, 0x424D3AD2B7B97EF5ULL},
+        {0xF8EBAD2B84E0D58BULL, 0xD2E0898765A7DEB2ULL}, {0x9B934C3B330C8577ULL, 0x63CC55F49F88EB2FULL},
+        {0xC2781F49FFCFA6D5ULL, 0x3CBF6B71C76B25FBULL}, {0xF316271C7FC3908AULL, 0x8BEF464E3945EF7AULL},
+        {0x97EDD871CFDA3A56ULL, 0x97758BF0E3CBB5ACULL}, {0xBDE94E8E43D0C8ECULL, 0x3D52EEED1CBEA317ULL},
+        {0xED63A231D4C4FB27ULL, 0x4CA7AAA863EE4BDDULL}, {0x945E455F24FB1CF8ULL, 0x8FE8CAA93E74EF6AULL},
+        {0xB975D6B6EE39E436ULL, 0xB3E2FD538E122B44ULL}, {0xE7D34C64A9C85D44ULL, 0x60DBBCA87196B616ULL},
+        {0x90E40FBEEA1D3A4AULL, 0xBC8955E946FE31CDULL}, {0xB51D13AEA4A488DDULL, 0x6BABAB6398BDBE41ULL},
+        {0xE264589A4DCDAB14ULL, 0xC696963C7EED2DD1ULL}, {0x8D7EB76070A08AECULL, 0xFC1E1DE5CF543CA2ULL},
+        {0xB0DE65388CC8ADA8ULL, 0x3B25A55F43294BCBULL}, {0xDD15FE86AFFAD912ULL, 0x49EF0EB713F39EBEULL},
+        {0x8A2DBF142DFCC7ABULL, 0x6E3569326C784337ULL}, {0xACB92ED9397BF996ULL, 0x49C2C37F07965404ULL},
+        {0xD7E77A8F87DAF7FBULL, 0xDC33745EC97BE906ULL}, {0x86F0AC99B4E8DAFDULL, 0x69A028BB3DED71A3ULL},
+        {0xA8ACD7C0222311BCULL, 0xC40832EA0D68CE0CULL}, {0xD2D80DB02AABD62BULL, 0xF50A3FA490C30190ULL},
+        {0x83C7088E1AAB65DBULL, 0x792667C6DA79E0FAULL}, {0xA4B8CAB1A1563F52ULL, 0x577001B891185938ULL},
+        {0xCDE6FD5E09ABCF26ULL, 0xED4C0226B55E6F86ULL}, {0x80B05E5AC60B6178ULL, 0x544F8158315B05B4ULL},
+        {0xA0DC75F1778E39D6ULL, 0x696361AE3DB1C721ULL}, {0xC913936DD571C84CULL, 0x03BC3A19CD1E38E9ULL},
+        {0xFB5878494ACE3A5FULL, 0x04AB48A04065C723ULL}, {0x9D174B2DCEC0E47BULL, 0x62EB0D64283F9C76ULL},
+        {0xC45D1DF942711D9AULL, 0x3BA5D0BD324F8394ULL}, {0xF5746577930D6500ULL, 0xCA8F44EC7EE36479ULL},
+        {0x9968BF6ABBE85F20ULL, 0x7E998B13CF4E1ECBULL}, {0xBFC2EF456AE276E8ULL, 0x9E3FEDD8C321A67EULL},
+        {0xEFB3AB16C59B14A2ULL, 0xC5CFE94EF3EA101EULL}, {0x95D04AEE3B80ECE5ULL, 0xBBA1F1D158724A12ULL},
+        {0xBB445DA9CA61281FULL, 0x2A8A6E45AE8EDC97ULL}, {0xEA1575143CF97226ULL, 0xF52D09D71A3293BDULL},
+        {0x924D692CA61BE758ULL, 0x593C2626705F9C56ULL}, {0xB6E0C377CFA2E12EULL, 0x6F8B2FB00C77836CULL},
+        {0xE498F455C38B997AULL, 0x0B6DFB9C0F956447ULL}, {0x8EDF98B59A373FECULL, 0x4724BD4189BD5EACULL},
+        {0xB2977EE300C50FE7ULL, 0x58EDEC91EC2CB657ULL}, {0xDF3D5E9BC0F653E1ULL, 0x2F2967B66737E3EDULL},
+        {0x8B865B215899F46CULL, 0xBD79E0D20082EE74ULL}, {0xAE67F1E9AEC07187ULL, 0xECD8590680A3AA11ULL},
+        {0xDA01EE641A708DE9ULL, 0xE80E6F4820CC9495ULL}, {0x884134FE908658B2ULL, 0x3109058D147FDCDDULL},
+        {0xAA51823E34A7EEDEULL, 0xBD4B46F0599FD415ULL}, {0xD4E5E2CDC1D1EA96ULL, 0x6C9E18AC7007C91AULL},
+        {0x850FADC09923329EULL, 0x03E2CF6BC604DDB0ULL}, {0xA6539930BF6BFF45ULL, 0x84DB8346B786151CULL},
+        {0xCFE87F7CEF46FF16ULL, 0xE612641865679A63ULL}, {0x81F14FAE158C5F6EULL, 0x4FCB7E8F3F60C07EULL},
+        {0xA26DA3999AEF7749ULL, 0xE3BE5E330F38F09DULL}, {0xCB090C8001AB551CULL, 0x5CADF5BFD3072CC5ULL},
+        {0xFDCB4FA002162A63ULL, 0x73D9732FC7C8F7F6ULL}, {0x9E9F11C4014DDA7EULL, 0x2867E7FDDCDD9AFAULL},
+        {0xC646D63501A1511DULL, 0xB281E1FD541501B8ULL}, {0xF7D88BC24209A565ULL, 0x1F225A7CA91A4226ULL},
+        {0x9AE757596946075FULL, 0x3375788DE9B06958ULL}, {0xC1A12D2FC3978937ULL, 0x0052D6B1641C83AEULL},
+        {0xF209787BB47D6B84ULL, 0xC0678C5DBD23A49AULL}, {0x9745EB4D50CE6332ULL, 0xF840B7BA963646E0ULL},
+        {0xBD176620A501FBFFULL, 0xB650E5A93BC3D898ULL}, {0xEC5D3FA8CE427AFFULL, 0xA3E51F138AB4CEBEULL},
+        {0x93BA47C980E98CDFULL, 0xC66F336C36B10137ULL}, {0xB8A8D9BBE123F017ULL, 0xB80B0047445D4184ULL},
+        {0xE6D3102AD96CEC1DULL, 0xA60DC059157491E5ULL}, {0x9043EA1AC7E41392ULL, 0x87C89837AD68DB2FULL},
+        {0xB454E4A179DD1877ULL, 0x29BABE4598C311FBULL}, {0xE16A1DC9D8545E94ULL, 0xF4296DD6FEF3D67AULL},
+        {0x8CE2529E2734BB1DULL, 0x1899E4A65F58660CULL}, {0xB01AE745B101E9E4ULL, 0x5EC05DCFF72E7F8FULL},
+        {0xDC21A1171D42645DULL, 0x76707543F4FA1F73ULL}, {0x899504AE72497EBAULL, 0x6A06494A791C53A8ULL},
+        {0xABFA45DA0EDBDE69ULL, 0x0487DB9D17636892ULL}, {0xD6F8D7509292D603ULL, 0x45A9D2845D3C42B6ULL},
+        {0x865B86925B9BC5C2ULL, 0x0B8A2392BA45A9B2ULL}, {0xA7F26836F282B732ULL, 0x8E6CAC7768D7141EULL},
+        {0xD1EF0244AF2364FFULL, 0x3207D795430CD926ULL}, {0x8335616AED761F1FULL, 0x7F44E6BD49E807B8ULL},
+        {0xA402B9C5A8D3A6E7ULL, 0x5F16206C9C6209A6ULL}, {0xCD036837130890A1ULL, 0x36DBA887C37A8C0FULL},
+        {0x802221226BE55A64ULL, 0xC2494954DA2C9789ULL}, {0xA02AA96B06DEB0FDULL, 0xF2DB9BAA10B7BD6CULL},
+        {0xC83553C5C8965D3DULL, 0x6F92829494E5ACC7ULL}, {0xFA42A8B73ABBF48CULL, 0xCB772339BA1F17F9ULL},
+        {0x9C69A97284B578D7ULL, 0xFF2A760414536EFBULL}, {0xC38413CF25E2D70DULL, 0xFEF5138519684ABAULL},
+        {0xF46518C2EF5B8CD1ULL, 0x7EB258665FC25D69ULL}, {0x98BF2F79D5993802ULL, 0xEF2F773FFBD97A61ULL},
+        {0xBEEEFB584AFF8603ULL, 0xAAFB550FFACFD8FAULL}, {0xEEAABA2E5DBF6784ULL, 0x95BA2A53F983CF38ULL},
+        {0x952AB45CFA97A0B2ULL, 0xDD945A747BF26183ULL}, {0xBA756174393D88DFULL, 0x94F971119AEEF9E4ULL},
+        {0xE912B9D1478CEB17ULL, 0x7A37CD5601AAB85DULL}, {0x91ABB422CCB812EEULL, 0xAC62E055C10AB33AULL},
+        {0xB616A12B7FE617AAULL, 0x577B986B314D6009ULL}, {0xE39C49765FDF9D94ULL, 0xED5A7E85FDA0B80BULL},
+        {0x8E41ADE9FBEBC27DULL, 0x14588F13BE847307ULL}, {0xB1D219647AE6B31CULL, 0x596EB2D8AE258FC8ULL},
+        {0xDE469FBD99A05FE3ULL, 0x6FCA5F8ED9AEF3BBULL}, {0x8AEC23D680043BEEULL, 0x25DE7BB9480D5854ULL},
+        {0xADA72CCC20054AE9ULL, 0xAF561AA79A10AE6AULL}, {0xD910F7FF28069DA4ULL, 0x1B2BA1518094DA04ULL},
+        {0x87AA9AFF79042286ULL, 0x90FB44D2F05D0842ULL}, {0xA99541BF57452B28ULL, 0x353A1607AC744A53ULL},
+        {0xD3FA922F2D1675F2ULL, 0x42889B8997915CE8ULL}, {0x847C9B5D7C2E09B7ULL, 0x69956135FEBADA11ULL},
+        {0xA59BC234DB398C25ULL, 0x43FAB9837E699095ULL}, {0xCF02B2C21207EF2EULL, 0x94F967E45E03F4BBULL},
+        {0x8161AFB94B44F57DULL, 0x1D1BE0EEBAC278F5ULL}, {0xA1BA1BA79E1632DCULL, 0x6462D92A69731732ULL},
+        {0xCA28A291859BBF93ULL, 0x7D7B8F7503CFDCFEULL}, {0xFCB2CB35E702AF78ULL, 0x5CDA735244C3D43EULL},
+        {0x9DEFBF01B061ADABULL, 0x3A0888136AFA64A7ULL}, {0xC56BAEC21C7A1916ULL, 0x088AAA1845B8FDD0ULL},
+        {0xF6C69A72A3989F5BULL, 0x8AAD549E57273D45ULL}, {0x9A3C2087A63F6399ULL, 0x36AC54E2F678864BULL},
+        {0xC0CB28A98FCF3C7FULL, 0x84576A1BB416A7DDULL}, {0xF0FDF2D3F3C30B9FULL, 0x656D44A2A11C51D5ULL},
+        {0x969EB7C47859E743ULL, 0x9F644AE5A4B1B325ULL}, {0xBC4665B596706114ULL, 0x873D5D9F0DDE1FEEULL},
+        {0xEB57FF22FC0C7959ULL, 0xA90CB506D155A7EAULL}, {0x9316FF75DD87CBD8ULL, 0x09A7F12442D588F2ULL},
+        {0xB7DCBF5354E9BECEULL, 0x0C11ED6D538AEB2FULL}, {0xE5D3EF282A242E81ULL, 0x8F1668C8A86DA5FAULL},
+        {0x8FA475791A569D10ULL, 0xF96E017D694487BCULL}, {0xB38D92D760EC4455ULL, 0x37C981DCC395A9ACULL},
+        {0xE070F78D3927556AULL, 0x85BBE253F47B1417ULL}, {0x8C469AB843B89562ULL, 0x93956D7478CCEC8EULL},
+        {0xAF58416654A6BABBULL, 0x387AC8D1970027B2ULL}, {0xDB2E51BFE9D0696AULL, 0x06997B05FCC0319EULL},
+        {0x88FCF317F22241E2ULL, 0x441FECE3BDF81F03ULL}, {0xAB3C2FDDEEAAD25AULL, 0xD527E81CAD7626C3ULL},
+        {0xD60B3BD56A5586F1ULL, 0x8A71E223D8D3B074ULL}, {0x85C7056562757456ULL, 0xF6872D5667844E49ULL},
+        {0xA738C6BEBB12D16CULL, 0xB428F8AC016561DBULL}, {0xD106F86E69D785C7ULL, 0xE13336D701BEBA52ULL},
+        {0x82A45B450226B39CULL, 0xECC0024661173473ULL}, {0xA34D721642B06084ULL, 0x27F002D7F95D0190ULL},
+        {0xCC20CE9BD35C78A5ULL, 0x31EC038DF7B441F4ULL}, {0xFF290242C83396CEULL, 0x7E67047175A15271ULL},
+        {0x9F79A169BD203E41ULL, 0x0F0062C6E984D386ULL}, {0xC75809C42C684DD1ULL, 0x52C07B78A3E60868ULL},
+        {0xF92E0C3537826145ULL, 0xA7709A56CCDF8A82ULL}, {0x9BBCC7A142B17CCBULL, 0x88A66076400BB691ULL},
+        {0xC2ABF989935DDBFEULL, 0x6ACFF893D00EA435ULL}, {0xF356F7EBF83552FEULL, 0x0583F6B8C4124D43ULL},
+        {0x98165AF37B2153DEULL, 0xC3727A337A8B704AULL}, {0xBE1BF1B059E9A8D6ULL, 0x744F18C0592E4C5CULL},
+        {0xEDA2EE1C7064130CULL, 0x1162DEF06F79DF73ULL}, {0x9485D4D1C63E8BE7ULL, 0x8ADDCB5645AC2BA8ULL},
+        {0xB9A74A0637CE2EE1ULL, 0x6D953E2BD7173692ULL}, {0xE8111C87C5C1BA99ULL, 0xC8FA8DB6CCDD0437ULL},
+        {0x910AB1D4DB9914A0ULL, 0x1D9C9892400A22A2ULL}, {0xB54D5E4A127F59C8ULL, 0x2503BEB6D00CAB4BULL},
+        {0xE2A0B5DC971F303AULL, 0x2E44AE64840FD61DULL}, {0x8DA471A9DE737E24ULL, 0x5CEAECFED289E5D2ULL},
+        {0xB10D8E1456105DADULL, 0x7425A83E872C5F47ULL}, {0xDD50F1996B947518ULL, 0xD12F124E28F77719ULL},
+        {0x8A5296FFE33CC92FULL, 0x82BD6B70D99AAA6FULL}, {0xACE73CBFDC0BFB7BULL, 0x636CC64D1001550BULL},
+        {0xD8210BEFD30EFA5AULL, 0x3C47F7E05401AA4EULL}, {0x8714A775E3E95C78ULL, 0x65ACFAEC34810A71ULL},
+        {0xA8D9D1535CE3B396ULL, 0x7F1839A741A14D0DULL}, {0xD31045A8341CA07CULL, 0x1EDE48111209A050ULL},
+        {0x83EA2B892091E44DULL, 0x934AED0AAB460432ULL}, {0xA4E4B66B68B65D60ULL, 0xF81DA84D5617853FULL},
+        {0xCE1DE40642E3F4B9ULL, 0x36251260AB9D668EULL}, {0x80D2AE83E9CE78F3ULL, 0xC1D72B7C6B426019ULL},
+        {0xA1075A24E4421730ULL, 0xB24CF65B8612F81FULL}, {0xC94930AE1D529CFCULL, 0xDEE033F26797B627ULL},
+        {0xFB9B7CD9A4A7443CULL, 0x169840EF017DA3B1ULL}, {0x9D412E0806E88AA5ULL, 0x8E1F289560EE864EULL},
+        {0xC491798A08A2AD4EULL, 0xF1A6F2BAB92A27E2ULL}, {0xF5B5D7EC8ACB58A2ULL, 0xAE10AF696774B1DBULL},
+        {0x9991A6F3D6BF1765ULL, 0xACCA6DA1E0A8EF29ULL}, {0xBFF610B0CC6EDD3FULL, 0x17FD090A58D32AF3ULL},
+        {0xEFF394DCFF8A948EULL, 0xDDFC4B4CEF07F5B0ULL}, {0x95F83D0A1FB69CD9ULL, 0x4ABDAF101564F98EULL},
+        {0xBB764C4CA7A4440FULL, 0x9D6D1AD41ABE37F1ULL}, {0xEA53DF5FD18D5513ULL, 0x84C86189216DC5EDULL},
+        {0x92746B9BE2F8552CULL, 0x32FD3CF5B4E49BB4ULL}, {0xB7118682DBB66A77ULL, 0x3FBC8C33221DC2A1ULL},
+        {0xE4D5E82392A40515ULL, 0x0FABAF3FEAA5334AULL}, {0x8F05B1163BA6832DULL, 0x29CB4D87F2A7400EULL},
+        {0xB2C71D5BCA9023F8ULL, 0x743E20E9EF511012ULL}, {0xDF78E4B2BD342CF6ULL, 0x914DA9246B255416ULL},
+        {0x8BAB8EEFB6409C1AULL, 0x1AD089B6C2F7548EULL}, {0xAE9672ABA3D0C320ULL, 0xA184AC2473B529B1ULL},
+        {0xDA3C0F568CC4F3E8ULL, 0xC9E5D72D90A2741EULL}, {0x8865899617FB1871ULL, 0x7E2FA67C7A658892ULL},
+        {0xAA7EEBFB9DF9DE8DULL, 0xDDBB901B98FEEAB7ULL}, {0xD51EA6FA85785631ULL, 0x552A74227F3EA565ULL},
+        {0x8533285C936B35DEULL, 0xD53A88958F87275FULL}, {0xA67FF273B8460356ULL, 0x8A892ABAF368F137ULL},
+        {0xD01FEF10A657842CULL, 0x2D2B7569B0432D85ULL}, {0x8213F56A67F6B29BULL, 0x9C3B29620E29FC73ULL},
+        {0xA298F2C501F45F42ULL, 0x8349F3BA91B47B8FULL}, {0xCB3F2F7642717713ULL, 0x241C70A936219A73ULL},
+        {0xFE0EFB53D30DD4D7ULL, 0xED238CD383AA0110ULL}, {0x9EC95D1463E8A506ULL, 0xF4363804324A40AAULL},
+        {0xC67BB4597CE2CE48ULL, 0xB143C6053EDCD0D5ULL}, {0xF81AA16FDC1B81DAULL, 0xDD94B7868E94050AULL},
+        {0x9B10A4E5E9913128ULL, 0xCA7CF2B4191C8326ULL}, {0xC1D4CE1F63F57D72ULL, 0xFD1C2F611F63A3F0ULL},
+        {0xF24A01A73CF2DCCFULL, 0xBC633B39673C8CECULL}, {0x976E41088617CA01ULL, 0xD5BE0503E085D813ULL},
+        {0xBD49D14AA79DBC82ULL, 0x4B2D8644D8A74E18ULL}, {0xEC9C459D51852BA2ULL, 0xDDF8E7D60ED1219EULL},
+        {0x93E1AB8252F33B45ULL, 0xCABB90E5C942B503ULL}, {0xB8DA1662E7B00A17ULL, 0x3D6A751F3B936243ULL},
+        {0xE7109BFBA19C0C9DULL, 0x0CC512670A783AD4ULL}, {0x906A617D450187E2ULL, 0x27FB2B80668B24C5ULL},
+        {0xB484F9DC9641E9DAULL, 0xB1F9F660802DEDF6ULL}, {0xE1A63853BBD26451ULL, 0x5E7873F8A0396973ULL},
+        {0x8D07E33455637EB2ULL, 0xDB0B487B6423E1E8ULL}, {0xB049DC016ABC5E5FULL, 0x91CE1A9A3D2CDA62ULL},
+        {0xDC5C5301C56B75F7ULL, 0x7641A140CC7810FBULL}, {0x89B9B3E11B6329BAULL, 0xA9E904C87FCB0A9DULL},
+        {0xAC2820D9623BF429ULL, 0x546345FA9FBDCD44ULL}, {0xD732290FBACAF133ULL, 0xA97C177947AD4095ULL},
+        {0x867F59A9D4BED6C0ULL, 0x49ED8EABCCCC485DULL}, {0xA81F301449EE8C70ULL, 0x5C68F256BFFF5A74ULL},
+        {0xD226FC195C6A2F8CULL, 0x73832EEC6FFF3111ULL}, {0x83585D8FD9C25DB7ULL, 0xC831FD53C5FF7EABULL},
+        {0xA42E74F3D032F525ULL, 0xBA3E7CA8B77F5E55ULL}, {0xCD3A1230C43FB26FULL, 0x28CE1BD2E55F35EBULL},
+        {0x80444B5E7AA7CF85ULL, 0x7980D163CF5B81B3ULL}, {0xA0555E361951C366ULL, 0xD7E105BCC332621FULL},
+        {0xC86AB5C39FA63440ULL, 0x8DD9472BF3FEFAA7ULL}, {0xFA856334878FC150ULL, 0xB14F98F6F0FEB951ULL},
+        {0x9C935E00D4B9D8D2ULL, 0x6ED1BF9A569F33D3ULL}, {0xC3B8358109E84F07ULL, 0x0A862F80EC4700C8ULL},
+        {0xF4A642E14C6262C8ULL, 0xCD27BB612758C0FAULL}, {0x98E7E9CCCFBD7DBDULL, 0x8038D51CB897789CULL},
+        {0xBF21E44003ACDD2CULL, 0xE0470A63E6BD56C3ULL}, {0xEEEA5D5004981478ULL, 0x1858CCFCE06CAC74ULL},
+        {0x95527A5202DF0CCBULL, 0x0F37801E0C43EBC8ULL}, {0xBAA718E68396CFFDULL, 0xD30560258F54E6BAULL},
+        {0xE950DF20247C83FDULL, 0x47C6B82EF32A2069ULL}, {0x91D28B7416CDD27EULL, 0x4CDC331D57FA5441ULL},
+        {0xB6472E511C81471DULL, 0xE0133FE4ADF8E952ULL}, {0xE3D8F9E563A198E5ULL, 0x58180FDDD97723A6ULL},
+        {0x8E679C2F5E44FF8FULL, 0x570F09EAA7EA7648ULL}, {0xB201833B35D63F73ULL, 0x2CD2CC6551E513DAULL},
+        {0xDE81E40A034BCF4FULL, 0xF8077F7EA65E58D1ULL}, {0x8B112E86420F6191ULL, 0xFB04AFAF27FAF782ULL},
+        {0xADD57A27D29339F6ULL, 0x79C5DB9AF1F9B563ULL}, {0xD94AD8B1C7380874ULL, 0x18375281AE7822BCULL},
+        {0x87CEC76F1C830548ULL, 0x8F2293910D0B15B5ULL}, {0xA9C2794AE3A3C69AULL, 0xB2EB3875504DDB22ULL},
+        {0xD433179D9C8CB841ULL, 0x5FA60692A46151EBULL}, {0x849FEEC281D7F328ULL, 0xDBC7C41BA6BCD333ULL},
+        {0xA5C7EA73224DEFF3ULL, 0x12B9B522906C0800ULL}, {0xCF39E50FEAE16BEFULL, 0xD768226B34870A00ULL},
+        {0x81842F29F2CCE375ULL, 0xE6A1158300D46640ULL}, {0xA1E53AF46F801C53ULL, 0x60495AE3C1097FD0ULL},
+        {0xCA5E89B18B602368ULL, 0x385BB19CB14BDFC4ULL}, {0xFCF62C1DEE382C42ULL, 0x46729E03DD9ED7B5ULL},
+        {0x9E19DB92B4E31BA9ULL, 0x6C07A2C26A8346D1ULL},
+};
+
+typedef union _AIL_Str_F64_Bits_ {
+    f64 f;
+    u64 u;
+} _AIL_Str_F64_Bits_;
+
+#define _AIL_STR_F64_INF_ 0x7FF0000000000000ULL
+#define _AIL_STR_F64_NAN_ 0x7FF8000000000000ULL
+
+// Returns the bits of the correctly rounded f64 closest to `man * 10^exp10` or -1 if they can't be determined this way
+// `man` must not be 0 and exp10 must be in [_AIL_STR_POW10_MIN_, _AIL_STR_POW10_MAX_]
+internal i64 _ail_str_eisel_lemire_(u64 man, i32 exp10)
 {
-    if (suffix.len > str.len) return false;
-    for (u64 i = suffix.len; i > 0; i--) {
-        if (str.data[str.len - i] != suffix.data[suffix.len - i]) return false;
+    u32 clz = ail_clz_u64(man);
+    man <<= clz;
+    // (217706*exp10) >> 16 == floor(log2(10^exp10))
+    u64 exp2 = (u64)(((217706*exp10) >> 16) + 64 + 1023) - clz;
+    const u64 *pow = _ail_str_pow10_128_[exp10 - _AIL_STR_POW10_MIN_];
+    u64 x_hi, x_lo = ail_mul_wide_u64(man, pow[0], &x_hi);
+
+    // If the lower bits of the product are all ones, the truncated part of the power of ten might carry into the result, so more bits of it are used
+    if ((x_hi & 0x1FF) == 0x1FF && x_lo + man < man) {
+        u64 y_hi, y_lo = ail_mul_wide_u64(man, pow[1], &y_hi);
+        u64 merged_hi  = x_hi, merged_lo = x_lo + y_hi;
+        if (merged_lo < x_lo) merged_hi++;
+        if ((merged_hi & 0x1FF) == 0x1FF && merged_lo + 1 == 0 && y_lo + man < man) return -1;
+        x_hi = merged_hi;
+        x_lo = merged_lo;
     }
-    return true;
+
+    // Shift to 54 bits and round to 53 bits
+    u64 msb = x_hi >> 63;
+    u64 res = x_hi >> (msb + 9);
+    exp2 -= 1 ^ msb;
+    if (x_lo == 0 && (x_hi & 0x1FF) == 0 && (res & 3) == 1) return -1; // Might be exactly halfway between two floats
+    res += res & 1;
+    res >>= 1;
+    if (res >> 53) {
+        res >>= 1;
+        exp2++;
+    }
+    if (exp2 - 1 >= 0x7FF - 1) return -1; // Subnormal or infinite
+    return (i64)((exp2 << 52) | (res & 0x000FFFFFFFFFFFFFULL));
 }
 
-b32 ail_str_ends_with_char(AIL_Str8 str, char suffix)
+// Arbitrary precision decimal for the slow path of parsing floats (see Go's strconv/decimal.go)
+// 800 digits are enough to round correctly in all cases, since any f64 can be written exactly with at most 767 significant digits
+#define _AIL_STR_DECIMAL_DIGITS_ 800
+typedef struct _AIL_Str_Decimal_ {
+    u8  d[_AIL_STR_DECIMAL_DIGITS_]; // Digits as values from 0 to 9, without leading or trailing zeros
+    u32 nd;    // Amount of digits
+    i32 dp;    // Position of the decimal point relative to the start of `d`
+    b32 trunc; // Whether any non-zero digits were discarded
+} _AIL_Str_Decimal_;
+
+internal void _ail_str_decimal_trim_(_AIL_Str_Decimal_ *a)
 {
-    return str.len > 0 && str.data[str.len - 1] == suffix;
+    while (a->nd > 0 && a->d[a->nd - 1] == 0) a->nd--;
+    if (a->nd == 0) a->dp = 0;
 }
 
-b32 ail_str_contains(AIL_Str8 str, AIL_Str8 needle)
+// Multiply with 2^k for k <= 60
+internal void _ail_str_decimal_lshift_(_AIL_Str_Decimal_ *a, u32 k)
 {
-    if (needle.len > str.len) return false;
-    for (u64 i = 0; i < str.len - needle.len; i++) {
-        if (ail_str_eq(ail_str_offset(str, i), needle)) return true;
+    // The result has at most 19 digits more, so it is written from back to front into a temporary buffer first
+    u8  tmp[_AIL_STR_DECIMAL_DIGITS_ + 20];
+    u32 w = sizeof(tmp);
+    u64 n = 0;
+    for (u32 r = a->nd; r > 0; r--) {
+        n += (u64)a->d[r - 1] << k;
+        u64 quo  = n / 10;
+        tmp[--w] = (u8)(n - 10*quo);
+        n = quo;
     }
-    return false;
+    while (n) {
+        u64 quo  = n / 10;
+        tmp[--w] = (u8)(n - 10*quo);
+        n = quo;
+    }
+    u32 count = sizeof(tmp) - w;
+    a->dp += (i32)count - (i32)a->nd;
+    if (count > _AIL_STR_DECIMAL_DIGITS_) {
+        for (u32 i = _AIL_STR_DECIMAL_DIGITS_; i < count; i++) a->trunc |= tmp[w + i] != 0;
+        count = _AIL_STR_DECIMAL_DIGITS_;
+    }
+    ail_mem_copy(a->d, tmp + w, count);
+    a->nd = count;
+    _ail_str_decimal_trim_(a);
 }
 
-b32 ail_str_contains_char(AIL_Str8 str, char needle)
+// Divide by 2^k for k <= 60
+internal void _ail_str_decimal_rshift_(_AIL_Str_Decimal_ *a, u32 k)
 {
-    for (u64 i = 0; i < str.len; i++) {
-        if (str.data[i] == needle) return true;
+    u32 r = 0, w = 0;
+    u64 n = 0;
+    // Read digits until the first digit of the result is known
+    for (; (n >> k) == 0; r++) {
+        if (r >= a->nd) {
+            if (n == 0) {
+                a->nd = 0;
+                return;
+            }
+            while ((n >> k) == 0) {
+                n *= 10;
+                r++;
+            }
+            break;
+        }
+        n = n*10 + a->d[r];
     }
-    return false;
+    a->dp -= (i32)r - 1;
+    u64 mask = ((u64)1 << k) - 1;
+    for (; r < a->nd; r++) {
+        a->d[w++] = (u8)(n >> k);
+        n = (n & mask)*10 + a->d[r];
+    }
+    while (n) {
+        u8 dig = (u8)(n >> k);
+        n = (n & mask)*10;
+        if (w < _AIL_STR_DECIMAL_DIGITS_) a->d[w++] = dig;
+        else if (dig)                     a->trunc = true;
+    }
+    a->nd = w;
+    _ail_str_decimal_trim_(a);
 }
 
-i64 ail_str_find(AIL_Str8 str, AIL_Str8 needle)
+internal void _ail_str_decimal_shift_(_AIL_Str_Decimal_ *a, i32 k)
 {
-    for (u64 i = 0; i <= str.len - needle.len; i++) {
-        if (ail_str_starts_with(ail_str_offset(str, i), needle)) return (i64)i;
-    }
-    return -1;
+    if (a->nd == 0) return;
+    for (; k >  60; k -= 60) _ail_str_decimal_lshift_(a, 60);
+    for (; k < -60; k += 60) _ail_str_decimal_rshift_(a, 60);
+    if      (k > 0) _ail_str_decimal_lshift_(a, (u32)k);
+    else if (k < 0) _ail_str_decimal_rshift_(a, (u32)-k);
 }
 
-i64 ail_str_find_last(AIL_Str8 str, AIL_Str8 needle)
+// Integer part of the decimal rounded to nearest (ties to even)
+internal u64 _ail_str_decimal_round_(_AIL_Str_Decimal_ *a)
 {
-    for (i64 i = str.len - needle.len; i >= 0; i--) {
-        if (ail_str_starts_with(ail_str_offset(str, i), needle)) return i;
+    if (a->dp > 20) return 0xFFFFFFFFFFFFFFFFULL;
+    u64 n = 0;
+    i32 i = 0;
+    for (; i < a->dp && i < (i32)a->nd; i++) n = n*10 + a->d[i];
+    for (; i < a->dp; i++) n *= 10;
+    i32 dp = a->dp;
+    if (dp >= 0 && dp < (i32)a->nd) {
+        b32 round_up;
+        if (a->d[dp] == 5 && dp + 1 == (i32)a->nd) round_up = a->trunc || (dp > 0 && (a->d[dp - 1] & 1)); // Exactly halfway
+        else                                        round_up = a->d[dp] >= 5;
+        n += round_up;
     }
-    return -1;
+    return n;
 }
 
-AIL_Str_Find_Of_Res ail_str_find_of(AIL_Str8 str, AIL_Str8 *needles, i32 needles_count)
+internal u64 _ail_str_decimal_to_f64_bits_(_AIL_Str_Decimal_ *a)
 {
-    for (i64 i = 0; i < (i64)str.len; i++) {
-        AIL_Str8 offset = ail_str_offset(str, i);
-        for (i32 j = 0; j < needles_count; j++) {
-            if (ail_str_starts_with(offset, needles[j])) return (AIL_Str_Find_Of_Res){ .str_idx = i, .needle_idx = j };
-        }
+    static const u8 pow2_in_pow10[] = { 1, 3, 6, 9, 13, 16, 19, 23, 26 }; // Largest power of two below 10^i
+    if (a->nd == 0 || a->dp < -330) return 0;
+    if (a->dp > 310) return _AIL_STR_F64_INF_;
+
+    // Scale by powers of two until the decimal is in [0.5, 1)
+    i32 exp = 0;
+    while (a->dp > 0) {
+        i32 n = a->dp >= (i32)sizeof(pow2_in_pow10) ? 27 : pow2_in_pow10[a->dp];
+        _ail_str_decimal_shift_(a, -n);
+        exp += n;
     }
-    return (AIL_Str_Find_Of_Res){ -1, -1 };
+    while (a->dp < 0 || (a->dp == 0 && a->d[0] < 5)) {
+        i32 n = -a->dp >= (i32)sizeof(pow2_in_pow10) ? 27 : pow2_in_pow10[-a->dp];
+        _ail_str_decimal_shift_(a, n);
+        exp -= n;
+    }
+    exp--; // Now in [1, 2)
+
+    if (exp < -1022) { // Subnormal
+        i32 n = -1022 - exp;
+        _ail_str_decimal_shift_(a, -n);
+        exp += n;
+    }
+    if (exp + 1023 >= 0x7FF) return _AIL_STR_F64_INF_;
+
+    _ail_str_decimal_shift_(a, 53);
+    u64 man = _ail_str_decimal_round_(a);
+    if (man == (2ULL << 52)) { // Rounding overflowed into another bit
+        man >>= 1;
+        exp++;
+        if (exp + 1023 >= 0x7FF) return _AIL_STR_F64_INF_;
+    }
+    if (!(man & (1ULL << 52))) exp = -1023;
+    return (man & ((1ULL << 52) - 1)) | ((u64)(exp + 1023) << 52);
 }
 
-AIL_Str_Find_Of_Res ail_str_find_last_of(AIL_Str8 str, AIL_Str8 *needles, i32 needles_count)
+// Case-insensitive comparison with the lowercase string `lower`
+internal b32 _ail_str_starts_with_lower_(u8 *p, u64 n, const char *lower)
 {
-    for (i64 i = str.len - 1; i >= 0; i--) {
-       AIL_Str8 offset = ail_str_offset(str, i);
-        for (i32 j = 0; j < needles_count; j++) {
-            if (ail_str_starts_with(offset, needles[j])) return (AIL_Str_Find_Of_Res){ .str_idx = i, .needle_idx = j };
-        }
+    u64 i = 0;
+    for (; lower[i]; i++) {
+        if (i >= n || (p[i] | 0x20) != (u8)lower[i]) return false;
     }
-    return (AIL_Str_Find_Of_Res){ -1, -1 };
+    return true;
 }
 
-i64 ail_str_find_char(AIL_Str8 str, char needle)
+AIL_Str_Parse_F_Res ail_str_parse_float(AIL_Str8 str)
 {
-    for (u64 i = 0; i < str.len; i++) {
-        if (str.data[i] == needle) return (i64)i;
+    static const f64 exact_pow10[] = {
+        1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+    };
+    AIL_Str_Parse_F_Res res = {0};
+    _AIL_Str_F64_Bits_ conv;
+    u8 *p = str.data;
+    u64 n = str.len, i = 0;
+    b32 is_neg = false;
+    if (i < n && (p[i] == '+' || p[i] == '-')) is_neg = p[i++] == '-';
+
+    if (i < n && ((p[i] | 0x20) == 'i' || (p[i] | 0x20) == 'n')) {
+        if      (_ail_str_starts_with_lower_(p + i, n - i, "nan"))      { conv.u = _AIL_STR_F64_NAN_; i += 3; }
+        else if (_ail_str_starts_with_lower_(p + i, n - i, "infinity")) { conv.u = _AIL_STR_F64_INF_; i += 8; }
+        else if (_ail_str_starts_with_lower_(p + i, n - i, "inf"))      { conv.u = _AIL_STR_F64_INF_; i += 3; }
+        else return res;
+        res.val = is_neg ? -conv.f : conv.f;
+        res.len = (u32)i;
+        return res;
     }
-    return -1;
+
+    // Up to 19 significant digits are accumulated in `man`, the remaining ones are only checked for whether they're 0
+    u64 start = i, man = 0;
+    u32 man_digits = 0;
+    i32 exp10 = 0;
+    b32 any_digits = false, trunc = false;
+    for (; i < n && p[i] >= '0' && p[i] <= '9'; i++) {
+        any_digits = true;
+        if (man_digits < 19) {
+            man = man*10 + (p[i] - '0');
+            man_digits += man != 0;
+        } else {
+            if (exp10 < 100000) exp10++;
+            trunc |= p[i] != '0';
+        }
+    }
+    if (i < n && p[i] == '.') {
+        u64 j = i + 1;
+        for (; j < n && p[j] >= '0' && p[j] <= '9'; j++) {
+            any_digits = true;
+            if (man_digits < 19) {
+                man = man*10 + (p[j] - '0');
+                man_digits += man != 0;
+                if (exp10 > -100000) exp10--;
+            } else {
+                trunc |= p[j] != '0';
+            }
+        }
+        if (any_digits) i = j;
+    }
+    if (!any_digits) return res;
+    u64 man_end = i;
+
+    i32 exp_part = 0;
+    if (i < n && (p[i] | 0x20) == 'e') {
+        u64 j = i + 1;
+        b32 exp_neg = false;
+        if (j < n && (p[j] == '+' || p[j] == '-')) exp_neg = p[j++] == '-';
+        if (j < n && p[j] >= '0' && p[j] <= '9') {
+            for (; j < n && p[j] >= '0' && p[j] <= '9'; j++) {
+                if (exp_part < 100000) exp_part = exp_part*10 + (p[j] - '0');
+            }
+            if (exp_neg) exp_part = -exp_part;
+            i = j;
+        }
+    }
+    exp10 += exp_part;
+    res.len = (u32)i;
+
+    if (man == 0 || exp10 < _AIL_STR_POW10_MIN_) {
+        conv.u = 0;
+    } else if (exp10 > 308) {
+        conv.u = _AIL_STR_F64_INF_;
+#if !defined(__FLT_EVAL_METHOD__) || __FLT_EVAL_METHOD__ == 0
+    } else if (!trunc && man <= (1ULL << 53) && exp10 >= -22 && exp10 <= 22) {
+        // Both the mantissa and the power of ten are exact, so a single rounding operation gives the correct result (Clinger's fast path)
+        conv.f = exp10 < 0 ? (f64)man / exact_pow10[-exp10] : (f64)man * exact_pow10[exp10];
+#endif
+    } else {
+        i64 bits = _ail_str_eisel_lemire_(man, exp10);
+        // If digits were truncated, the exact value is in [man, man + 1) * 10^exp10, so the result is only correct if both ends round to the same float
+        if (bits >= 0 && trunc && _ail_str_eisel_lemire_(man + 1, exp10) != bits) bits = -1;
+        if (bits >= 0) {
+            conv.u = (u64)bits;
+        } else {
+            _AIL_Str_Decimal_ d;
+            d.nd    = 0;
+            d.trunc = false;
+            i64 dp  = 0;
+            b32 after_dot = false;
+            for (u64 k = start; k < man_end; k++) {
+                if (p[k] == '.') {
+                    after_dot = true;
+                    continue;
+                }
+                u8 c = p[k] - '0';
+                if (c == 0 && d.nd == 0) { // Leading zeros
+                    dp -= after_dot;
+                    continue;
+                }
+                dp += !after_dot;
+                if (d.nd < _AIL_STR_DECIMAL_DIGITS_) d.d[d.nd++] = c;
+                else                                 d.trunc |= c != 0;
+            }
+            dp  += exp_part;
+            d.dp = (i32)ail_clamp(dp, -100000, 100000);
+            _ail_str_decimal_trim_(&d);
+            conv.u = _ail_str_decimal_to_f64_bits_(&d);
+        }
+    }
+    res.val = is_neg ? -conv.f : conv.f;
+    return res;
 }
 
-i64 ail_str_find_last_char(AIL_Str8 str, char needle)
+internal u64 _ail_str_round_to_odd_(u64 g_hi, u64 g_lo, u64 cp)
 {
-    for (i64 i = str.len - 1; i >= 0; i--) {
-        if (str.data[i] == needle) return i;
-    }
-    return -1;
+    u64 x_hi;
+    ail_mul_wide_u64(g_lo, cp, &x_hi);
+    u64 y_hi, y_lo = ail_mul_wide_u64(g_hi, cp, &y_hi);
+    u64 z = y_lo + x_hi;
+    return (y_hi + (z < y_lo)) | (z > 1);
 }
 
-AIL_Str_Find_Of_Res ail_str_find_of_chars(AIL_Str8 str, char *needles, i32 needles_count)
+// Finds the shortest `*digits * 10^*exp10` that rounds to the positive, finite and non-zero f64 with the given `bits` (Schubfach)
+internal void _ail_str_schubfach_(u64 bits, u64 *digits, i32 *exp10)
 {
-    for (i64 i = 0; i < (i64)str.len; i++) {
-        char c = str.data[i];
-        for (i32 j = 0; j < needles_count; j++) {
-            if (c == needles[j]) return (AIL_Str_Find_Of_Res){ .str_idx = i, .needle_idx = j };
+    u64 ieee_man = bits & ((1ULL << 52) - 1);
+    u32 ieee_exp = (u32)(bits >> 52);
+    u64 c;
+    i32 q;
+    if (ieee_exp) {
+        c = ieee_man | (1ULL << 52);
+        q = (i32)ieee_exp - 1075;
+        // Integers below 2^53 are written as they are
+        if (q <= 0 && q > -53 && !(c & (((u64)1 << -q) - 1))) {
+            *digits = c >> -q;
+            *exp10  = 0;
+            return;
         }
+    } else {
+        c = ieee_man;
+        q = -1074;
     }
-    return (AIL_Str_Find_Of_Res){ -1, -1 };
-}
 
-AIL_Str_Find_Of_Res ail_str_find_last_of_chars(AIL_Str8 str, char *needles, i32 needles_count)
-{
-    for (i64 i = str.len - 1; i >= 0; i--) {
-        char c = str.data[i];
-        for (i32 j = 0; j < needles_count; j++) {
-            if (c == needles[j]) return (AIL_Str_Find_Of_Res){ .str_idx = i, .needle_idx = j };
+    // The float is in the middle of the interval [cbl, cbr] * 2^(q-2) of all numbers, that round to it
+    b32 is_even      = !(c & 1);
+    b32 lower_closer = ieee_man == 0 && ieee_exp > 1;
+    u64 cbl = 4*c - 2 + lower_closer;
+    u64 cb  = 4*c;
+    u64 cbr = 4*c + 2;
+
+    // (q*1262611) >> 22 == floor(log10(2^q)) and (q*1262611 - 524031) >> 22 == floor(log10(3/4 * 2^q))
+    // (k*1741647) >> 19 == floor(log2(10^k))
+    i32 k = (q*1262611 - (lower_closer ? 524031 : 0)) >> 22;
+    i32 h = q + ((-k*1741647) >> 19) + 1;
+    const u64 *pow = _ail_str_pow10_128_[-k - _AIL_STR_POW10_MIN_];
+    // The powers of ten need to be rounded up here, which only changes them if they aren't exact (i.e. 10^-k doesn't fit into 128 bits)
+    u64 g_lo = pow[1] + (-k < 0 || -k > 55);
+    u64 g_hi = pow[0] + (g_lo < pow[1]);
+    u64 vbl  = _ail_str_round_to_odd_(g_hi, g_lo, cbl << h);
+    u64 vb   = _ail_str_round_to_odd_(g_hi, g_lo, cb  << h);
+    u64 vbr  = _ail_str_round_to_odd_(g_hi, g_lo, cbr << h);
+    u64 lower = vbl + !is_even;
+    u64 upper = vbr - !is_even;
+
+    // Try one digit less first, then the digits right below and above the float
+    u64 s = vb / 4;
+    if (s >= 10) {
+        u64 sp = s / 10;
+        b32 up_inside = lower <= 40*sp;
+        b32 wp_inside = 40*sp + 40 <= upper;
+        if (up_inside != wp_inside) {
+            *digits = sp + wp_inside;
+            *exp10  = k + 1;
+            return;
         }
     }
-    return (AIL_Str_Find_Of_Res){ -1, -1 };
+    b32 u_inside = lower <= 4*s;
+    b32 w_inside = 4*s + 4 <= upper;
+    if (u_inside != w_inside) {
+        *digits = s + w_inside;
+        *exp10  = k;
+        return;
+    }
+    u64 mid = 4*s + 2;
+    *digits = s + (vb > mid || (vb == mid && (s & 1)));
+    *exp10  = k;
 }
 
-AIL_Str8 ail_str_split_next_char(AIL_Str8 *str, char split_by, b32 ignore_empty)
+u32 ail_str_float_to_buf(f64 num, u8 *buf)
 {
-    size_t i = 0;
-    if (ignore_empty) {
-        while (i < str->len && str->data[i] == split_by) i++;
+    _AIL_Str_F64_Bits_ conv = { .f = num };
+    u64 bits = conv.u & ~(1ULL << 63);
+    u32 len  = 0;
+    if (bits > _AIL_STR_F64_INF_) {
+        buf[0] = 'n'; buf[1] = 'a'; buf[2] = 'n';
+        return 3;
     }
-    size_t j = i;
-    while (j < str->len) {
-        size_t tmp_idx = j;
-        j++;
-        if (str->data[tmp_idx] == split_by) break;
+    if (conv.u >> 63) buf[len++] = '-';
+    if (bits == _AIL_STR_F64_INF_) {
+        buf[len++] = 'i'; buf[len++] = 'n'; buf[len++] = 'f';
+        return len;
     }
-    AIL_Str8 res = ail_str_from_parts(&str->data[i], j - i);
-    *str = ail_str_offset(*str, j);
-    return res;
+    if (bits == 0) {
+        buf[len++] = '0';
+        return len;
+    }
+
+    u64 digits;
+    i32 exp10;
+    _ail_str_schubfach_(bits, &digits, &exp10);
+    while (digits % 10 == 0) {
+        digits /= 10;
+        exp10++;
+    }
+    u8  d[AIL_STR_INT_MAX_LEN];
+    u32 nd = ail_str_unsigned_to_buf(digits, d);
+
+    // The value is 0.d[0]d[1]... * 10^point
+    i32 point = (i32)nd + exp10;
+    if ((i32)nd <= point && point <= 21) {
+        ail_mem_copy(buf + len, d, nd);
+        len += nd;
+        for (i32 i = (i32)nd; i < point; i++) buf[len++] = '0';
+    } else if (0 < point && point <= 21) {
+        ail_mem_copy(buf + len, d, (u64)point);
+        len += (u32)point;
+        buf[len++] = '.';
+        ail_mem_copy(buf + len, d + point, nd - (u32)point);
+        len += nd - (u32)point;
+    } else if (-6 < point && point <= 0) {
+        buf[len++] = '0';
+        buf[len++] = '.';
+        for (i32 i = point; i < 0; i++) buf[len++] = '0';
+        ail_mem_copy(buf + len, d, nd);
+        len += nd;
+    } else {
+        buf[len++] = d[0];
+        if (nd > 1) {
+            buf[len++] = '.';
+            ail_mem_copy(buf + len, d + 1, nd - 1);
+            len += nd - 1;
+        }
+        buf[len++] = 'e';
+        i32 e = point - 1;
+        buf[len++] = e < 0 ? '-' : '+';
+        len += ail_str_unsigned_to_buf((u64)(e < 0 ? -e : e), buf + len);
+    }
+    return len;
 }
 
-AIL_Str8 ail_str_split_next(AIL_Str8 *str, AIL_Str8 split_by, b32 ignore_empty)
+/////////////
+// Unicode //
+/////////////
+
+// UTF-8 is validated with the lookup-table algorithm by John Keiser & Daniel Lemire ("Validating UTF-8 In Less Than One Instruction Per Byte", 2021):
+// The high and low nibble of each byte and the high nibble of the byte after it are each used to look up a bitset of the errors that this pair of bytes could be part of.
+// The bitwise AND of the three lookups is only non-zero if the pair is invalid.
+// Three- and four-byte sequences additionally require the 3rd/4th byte to be a continuation byte, which is checked separately.
+// All blocks that only contain ASCII are skipped without any lookups.
+#define _AIL_UTF8_TOO_SHORT_      (1<<0)
+#define _AIL_UTF8_TOO_LONG_       (1<<1)
+#define _AIL_UTF8_OVERLONG_3_     (1<<2)
+#define _AIL_UTF8_TOO_LARGE_      (1<<3)
+#define _AIL_UTF8_SURROGATE_      (1<<4)
+#define _AIL_UTF8_OVERLONG_2_     (1<<5)
+#define _AIL_UTF8_TOO_LARGE_1000_ (1<<6)
+#define _AIL_UTF8_OVERLONG_4_     (1<<6)
+#define _AIL_UTF8_TWO_CONTS_      (1<<7)
+#define _AIL_UTF8_CARRY_          (_AIL_UTF8_TOO_SHORT_ | _AIL_UTF8_TOO_LONG_ | _AIL_UTF8_TWO_CONTS_)
+
+#if AIL_SIMD_AVX2
+#   define _AIL_UTF8_VEC_SIZE_ 32
+    typedef __m256i _ail_utf8_vec_;
+#   define _ail_utf8_vec_load_(p)          _mm256_loadu_si256((__m256i *)(p))
+#   define _ail_utf8_vec_splat_(c)         _mm256_set1_epi8((char)(c))
+#   define _ail_utf8_vec_table_(t)         _mm256_broadcastsi128_si256(_mm_loadu_si128((__m128i *)(t)))
+#   define _ail_utf8_vec_lookup_(t, idx)   _mm256_shuffle_epi8(t, idx)
+#   define _ail_utf8_vec_shr4_(v)          _mm256_and_si256(_mm256_srli_epi16(v, 4), _mm256_set1_epi8(0x0f))
+#   define _ail_utf8_vec_and_(a, b)        _mm256_and_si256(a, b)
+#   define _ail_utf8_vec_or_(a, b)         _mm256_or_si256(a, b)
+#   define _ail_utf8_vec_xor_(a, b)        _mm256_xor_si256(a, b)
+#   define _ail_utf8_vec_subs_(a, b)       _mm256_subs_epu8(a, b)
+#   define _ail_utf8_vec_prev_(cur, prev, n) _mm256_alignr_epi8(cur, _mm256_permute2x128_si256(prev, cur, 0x21), 16 - (n))
+#   define _ail_utf8_vec_is_ascii_(v)      (_mm256_movemask_epi8(v) == 0)
+#   define _ail_utf8_vec_any_(v)           (!_mm256_testz_si256(v, v))
+#elif AIL_SIMD_SSSE3
+#   define _AIL_UTF8_VEC_SIZE_ 16
+    typedef __m128i _ail_utf8_vec_;
+#   define _ail_utf8_vec_load_(p)          _mm_loadu_si128((__m128i *)(p))
+#   define _ail_utf8_vec_splat_(c)         _mm_set1_epi8((char)(c))
+#   define _ail_utf8_vec_table_(t)         _mm_loadu_si128((__m128i *)(t))
+#   define _ail_utf8_vec_lookup_(t, idx)   _mm_shuffle_epi8(t, idx)
+#   define _ail_utf8_vec_shr4_(v)          _mm_and_si128(_mm_srli_epi16(v, 4), _mm_set1_epi8(0x0f))
+#   define _ail_utf8_vec_and_(a, b)        _mm_and_si128(a, b)
+#   define _ail_utf8_vec_or_(a, b)         _mm_or_si128(a, b)
+#   define _ail_utf8_vec_xor_(a, b)        _mm_xor_si128(a, b)
+#   define _ail_utf8_vec_subs_(a, b)       _mm_subs_epu8(a, b)
+#   define _ail_utf8_vec_prev_(cur, prev, n) _mm_alignr_epi8(cur, prev, 16 - (n))
+#   define _ail_utf8_vec_is_ascii_(v)      (_mm_movemask_epi8(v) == 0)
+#   define _ail_utf8_vec_any_(v)           (_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_setzero_si128())) != 0xffff)
+#elif AIL_SIMD_NEON
+#   define _AIL_UTF8_VEC_SIZE_ 16
+    typedef uint8x16_t _ail_utf8_vec_;
+#   define _ail_utf8_vec_load_(p)          vld1q_u8(p)
+#   define _ail_utf8_vec_splat_(c)         vdupq_n_u8((u8)(c))
+#   define _ail_utf8_vec_table_(t)         vld1q_u8(t)
+#   define _ail_utf8_vec_lookup_(t, idx)   vqtbl1q_u8(t, idx)
+#   define _ail_utf8_vec_shr4_(v)          vshrq_n_u8(v, 4)
+#   define _ail_utf8_vec_and_(a, b)        vandq_u8(a, b)
+#   define _ail_utf8_vec_or_(a, b)         vorrq_u8(a, b)
+#   define _ail_utf8_vec_xor_(a, b)        veorq_u8(a, b)
+#   define _ail_utf8_vec_subs_(a, b)       vqsubq_u8(a, b)
+#   define _ail_utf8_vec_prev_(cur, prev, n) vextq_u8(prev, cur, 16 - (n))
+#   define _ail_utf8_vec_is_ascii_(v)      (vmaxvq_u8(v) < 0x80)
+#   define _ail_utf8_vec_any_(v)           (vmaxvq_u8(v) != 0)
+#else
+#   define _AIL_UTF8_VEC_SIZE_ 0
+#endif
+
+// Scalar validation of all characters starting in [*idx, end), that might read up to 3 bytes past `end` as long as they are in [0, n)
+internal b32 _ail_utf8_validate_scalar_(u8 *p, u64 n, u64 *idx, u64 end)
 {
-    size_t i = 0;
-    if (ignore_empty) {
-        while (i < str->len - split_by.len && ail_str_starts_with(ail_str_offset(*str, i), split_by)) {
-            i += split_by.len;
+    u64 i = *idx;
+    while (i < end) {
+        u8 c = p[i];
+        if (c < 0x80) {
+            i++;
+        } else if (c < 0xC2) {
+            return false; // Continuation byte without leading byte or overlong 2-byte sequence
+        } else if (c < 0xE0) {
+            if (i + 1 >= n || (p[i+1] & 0xC0) != 0x80) return false;
+            i += 2;
+        } else if (c < 0xF0) {
+            if (i + 2 >= n || (p[i+1] & 0xC0) != 0x80 || (p[i+2] & 0xC0) != 0x80) return false;
+            if (c == 0xE0 && p[i+1] <  0xA0) return false; // Overlong
+            if (c == 0xED && p[i+1] >= 0xA0) return false; // Surrogate
+            i += 3;
+        } else if (c < 0xF5) {
+            if (i + 3 >= n || (p[i+1] & 0xC0) != 0x80 || (p[i+2] & 0xC0) != 0x80 || (p[i+3] & 0xC0) != 0x80) return false;
+            if (c == 0xF0 && p[i+1] <  0x90) return false; // Overlong
+            if (c == 0xF4 && p[i+1] >= 0x90) return false; // Larger than U+10FFFF
+            i += 4;
+        } else {
+            return false;
         }
     }
-    size_t j = i;
-    while (j < str->len - split_by.len && !ail_str_starts_with(ail_str_offset(*str, j), split_by)) {
-        j++;
-    }
-    *str = ail_str_offset(*str, j);
-    return (AIL_Str) {
-        .data = &str->data[i],
-        .len = j - i,
-    };
+    *idx = i;
+    return true;
 }
 
-AIL_DA(AIL_Str) ail_str_split_char_a(AIL_Str str, char split_by, b32 ignore_empty, AIL_Allocator allocator)
+#if _AIL_UTF8_VEC_SIZE_
+internal b32 _ail_utf8_validate_vec_(u8 *p, u64 n)
 {
-    AIL_DA(AIL_Str) res = ail_da_new_with_alloc(AIL_Str, AIL_ARR_INIT_CAP, allocator);
-    u64 lstart = 0;
-    u64 llen   = 0;
-    for (u64 i = 0; i < str.len; i++) {
-        if (str.data[i] == split_by) {
-            if (!ignore_empty || llen > 0) {
-                ail_da_push(&res, ail_str_from_parts(&str.data[lstart], llen));
-            }
-            lstart = i + 1;
-            llen   = 0;
+    static const u8 byte_1_high[16] = {
+        // 0_______ ________ <ASCII in byte 1>
+        _AIL_UTF8_TOO_LONG_, _AIL_UTF8_TOO_LONG_, _AIL_UTF8_TOO_LONG_, _AIL_UTF8_TOO_LONG_,
+        _AIL_UTF8_TOO_LONG_, _AIL_UTF8_TOO_LONG_, _AIL_UTF8_TOO_LONG_, _AIL_UTF8_TOO_LONG_,
+        // 10______ ________ <continuation in byte 1>
+        _AIL_UTF8_TWO_CONTS_, _AIL_UTF8_TWO_CONTS_, _AIL_UTF8_TWO_CONTS_, _AIL_UTF8_TWO_CONTS_,
+        // 1100____ ________ <two byte lead in byte 1>
+        _AIL_UTF8_TOO_SHORT_ | _AIL_UTF8_OVERLONG_2_,
+        // 1101____ ________ <two byte lead in byte 1>
+        _AIL_UTF8_TOO_SHORT_,
+        // 1110____ ________ <three byte lead in byte 1>
+        _AIL_UTF8_TOO_SHORT_ | _AIL_UTF8_OVERLONG_3_ | _AIL_UTF8_SURROGATE_,
+        // 1111____ ________ <four+ byte lead in byte 1>
+        _AIL_UTF8_TOO_SHORT_ | _AIL_UTF8_TOO_LARGE_ | _AIL_UTF8_TOO_LARGE_1000_ | _AIL_UTF8_OVERLONG_4_,
+    };
+    static const u8 byte_1_low[16] = {
+        // ____0000 ________
+        _AIL_UTF8_CARRY_ | _AIL_UTF8_OVERLONG_3_ | _AIL_UTF8_OVERLONG_2_ | _AIL_UTF8_OVERLONG_4_,
+        // ____0001 ________
+        _AIL_UTF8_CARRY_ | _AIL_UTF8_OVERLONG_2_,
+        // ____001_ ________
+        _AIL_UTF8_CARRY_,
+        _AIL_UTF8_CARRY_,
+        // ____0100 ________
+        _AIL_UTF8_CARRY_ | _AIL_UTF8_TOO_LARGE_,
+        // ____0101 ________ and above
+        _AIL_UTF8_CARRY_ | _AIL_UTF8_TOO_LARGE_ | _AIL_UTF8_TOO_LARGE_1000_,
+        _AIL_UTF8_CARRY_ | _AIL_UTF8_TOO_LARGE_ | _AIL_UTF8_TOO_LARGE_1000_,
+        _AIL_UTF8_CARRY_ | _AIL_UTF8_TOO_LARGE_ | _AIL_UTF8_TOO_LARGE_1000_,
+        _AIL_UTF8_CARRY_ | _AIL_UTF8_TOO_LARGE_ | _AIL_UTF8_TOO_LARGE_1000_,
+        _AIL_UTF8_CARRY_ | _AIL_UTF8_TOO_LARGE_ | _AIL_UTF8_TOO_LARGE_1000_,
+        _AIL_UTF8_CARRY_ | _AIL_UTF8_TOO_LARGE_ | _AIL_UTF8_TOO_LARGE_1000_,
+        _AIL_UTF8_CARRY_ | _AIL_UTF8_TOO_LARGE_ | _AIL_UTF8_TOO_LARGE_1000_,
+        _AIL_UTF8_CARRY_ | _AIL_UTF8_TOO_LARGE_ | _AIL_UTF8_TOO_LARGE_1000_,
+        // ____1101 ________
+        _AIL_UTF8_CARRY_ | _AIL_UTF8_TOO_LARGE_ | _AIL_UTF8_TOO_LARGE_1000_ | _AIL_UTF8_SURROGATE_,
+        _AIL_UTF8_CARRY_ | _AIL_UTF8_TOO_LARGE_ | _AIL_UTF8_TOO_LARGE_1000_,
+        _AIL_UTF8_CARRY_ | _AIL_UTF8_TOO_LARGE_ | _AIL_UTF8_TOO_LARGE_1000_,
+    };
+    static const u8 byte_2_high[16] = {
+        // ________ 0_______ <ASCII in byte 2>
+        _AIL_UTF8_TOO_SHORT_, _AIL_UTF8_TOO_SHORT_, _AIL_UTF8_TOO_SHORT_, _AIL_UTF8_TOO_SHORT_,
+        _AIL_UTF8_TOO_SHORT_, _AIL_UTF8_TOO_SHORT_, _AIL_UTF8_TOO_SHORT_, _AIL_UTF8_TOO_SHORT_,
+        // ________ 1000____
+        _AIL_UTF8_TOO_LONG_ | _AIL_UTF8_OVERLONG_2_ | _AIL_UTF8_TWO_CONTS_ | _AIL_UTF8_OVERLONG_3_ | _AIL_UTF8_TOO_LARGE_1000_ | _AIL_UTF8_OVERLONG_4_,
+        // ________ 1001____
+        _AIL_UTF8_TOO_LONG_ | _AIL_UTF8_OVERLONG_2_ | _AIL_UTF8_TWO_CONTS_ | _AIL_UTF8_OVERLONG_3_ | _AIL_UTF8_TOO_LARGE_,
+        // ________ 101_____
+        _AIL_UTF8_TOO_LONG_ | _AIL_UTF8_OVERLONG_2_ | _AIL_UTF8_TWO_CONTS_ | _AIL_UTF8_SURROGATE_ | _AIL_UTF8_TOO_LARGE_,
+        _AIL_UTF8_TOO_LONG_ | _AIL_UTF8_OVERLONG_2_ | _AIL_UTF8_TWO_CONTS_ | _AIL_UTF8_SURROGATE_ | _AIL_UTF8_TOO_LARGE_,
+        // ________ 11______ <lead in byte 2>
+        _AIL_UTF8_TOO_SHORT_, _AIL_UTF8_TOO_SHORT_, _AIL_UTF8_TOO_SHORT_, _AIL_UTF8_TOO_SHORT_,
+    };
+    // Subtracting this from the last block leaves a non-zero byte if the block ends in an incomplete sequence
+    static const u8 max_incomplete[32] = {
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xEF, 0xDF, 0xBF,
+    };
+    _ail_utf8_vec_ t_1_high = _ail_utf8_vec_table_(byte_1_high);
+    _ail_utf8_vec_ t_1_low  = _ail_utf8_vec_table_(byte_1_low);
+    _ail_utf8_vec_ t_2_high = _ail_utf8_vec_table_(byte_2_high);
+    _ail_utf8_vec_ t_max    = _ail_utf8_vec_load_(max_incomplete + 32 - _AIL_UTF8_VEC_SIZE_);
+    _ail_utf8_vec_ prev     = _ail_utf8_vec_splat_(0);
+    _ail_utf8_vec_ err      = _ail_utf8_vec_splat_(0);
+    _ail_utf8_vec_ incomplete = _ail_utf8_vec_splat_(0);
+    u8 tail[_AIL_UTF8_VEC_SIZE_];
+
+    for (u64 i = 0; i < n; i += _AIL_UTF8_VEC_SIZE_) {
+        _ail_utf8_vec_ cur;
+        if (i + _AIL_UTF8_VEC_SIZE_ <= n) {
+            cur = _ail_utf8_vec_load_(p + i);
         } else {
-            llen++;
+            // The tail is padded with zeros, which are ASCII and thus make any unfinished sequence too short
+            ail_mem_set(tail, 0, sizeof(tail));
+            ail_mem_copy(tail, p + i, n - i);
+            cur = _ail_utf8_vec_load_(tail);
         }
+        if (_ail_utf8_vec_is_ascii_(cur)) {
+            err = _ail_utf8_vec_or_(err, incomplete);
+            incomplete = _ail_utf8_vec_splat_(0);
+        } else {
+            _ail_utf8_vec_ prev1 = _ail_utf8_vec_prev_(cur, prev, 1);
+            _ail_utf8_vec_ sc = _ail_utf8_vec_and_(_ail_utf8_vec_and_(
+                _ail_utf8_vec_lookup_(t_1_high, _ail_utf8_vec_shr4_(prev1)),
+                _ail_utf8_vec_lookup_(t_1_low,  _ail_utf8_vec_and_(prev1, _ail_utf8_vec_splat_(0x0f)))),
+                _ail_utf8_vec_lookup_(t_2_high, _ail_utf8_vec_shr4_(cur)));
+            // Bytes 2 or 3 positions after a 3- or 4-byte lead need to be continuation bytes, which sc marks with TWO_CONTS (0x80)
+            _ail_utf8_vec_ is_third  = _ail_utf8_vec_subs_(_ail_utf8_vec_prev_(cur, prev, 2), _ail_utf8_vec_splat_(0xE0 - 0x80));
+            _ail_utf8_vec_ is_fourth = _ail_utf8_vec_subs_(_ail_utf8_vec_prev_(cur, prev, 3), _ail_utf8_vec_splat_(0xF0 - 0x80));
+            _ail_utf8_vec_ must23    = _ail_utf8_vec_and_(_ail_utf8_vec_or_(is_third, is_fourth), _ail_utf8_vec_splat_(0x80));
+            err = _ail_utf8_vec_or_(err, _ail_utf8_vec_xor_(must23, sc));
+            incomplete = _ail_utf8_vec_subs_(cur, t_max);
+        }
+        prev = cur;
     }
-    if (lstart < str.len) {
-        ail_da_push(&res, ail_str_from_parts(&str.data[lstart], llen));
+    err = _ail_utf8_vec_or_(err, incomplete);
+    return !_ail_utf8_vec_any_(err);
+}
+#endif
+
+b32 ail_str8_is_valid_utf8(AIL_Str8 str)
+{
+#if _AIL_UTF8_VEC_SIZE_
+    return _ail_utf8_validate_vec_(str.data, str.len);
+#else
+    u64 i = 0;
+#   if AIL_SIMD_SSE2
+    // Without byte shuffles, only blocks of ASCII are skipped with SIMD
+    while (i + 16 <= str.len) {
+        if (!_mm_movemask_epi8(_mm_loadu_si128((__m128i *)(str.data + i)))) i += 16;
+        else if (!_ail_utf8_validate_scalar_(str.data, str.len, &i, i + 16)) return false;
     }
-    return res;
+#   endif
+    return _ail_utf8_validate_scalar_(str.data, str.len, &i, str.len);
+#endif
 }
 
-AIL_DA(AIL_Str) ail_str_split_a(AIL_Str str, AIL_Str split_by, b32 ignore_empty, AIL_Allocator allocator)
+b32 ail_str16_is_valid_utf16(AIL_Str16 str)
 {
-    AIL_DA(AIL_Str) res = ail_da_new_with_alloc(AIL_Str, AIL_ARR_INIT_CAP, allocator);
-    u64 lstart = 0;
-    u64 llen   = 0;
-    if (str.len >= split_by.len) {
-        u64 i = 0;
-        for (; i <= str.len - split_by.len; i++) {
-            if (ail_str_starts_with(ail_str_offset(str, i), split_by)) {
-                if (!ignore_empty || llen > 0) {
-                    ail_da_push(&res, ail_str_from_parts(&str.data[lstart], llen));
-                }
-                i += split_by.len - 1;
-                lstart = i + 1;
-                llen   = 0;
-            } else {
-                llen++;
-            }
+    u16 *p = str.data;
+    u64  n = str.len;
+    for (u64 i = 0; i < n;) {
+#if AIL_SIMD_SSE2
+        // Skip blocks without any surrogates
+        if (i + 8 <= n) {
+            __m128i v = _mm_loadu_si128((__m128i *)(p + i));
+            __m128i s = _mm_cmpeq_epi16(_mm_and_si128(v, _mm_set1_epi16((i16)0xF800)), _mm_set1_epi16((i16)0xD800));
+            if (!_mm_movemask_epi8(s)) { i += 8; continue; }
         }
-        if (!ail_str_starts_with(ail_str_offset(str, i), split_by)) llen += str.len - i;
-    } else {
-        llen = str.len;
+#elif AIL_SIMD_NEON
+        if (i + 8 <= n) {
+            uint16x8_t v = vld1q_u16(p + i);
+            if (!vmaxvq_u16(vceqq_u16(vandq_u16(v, vdupq_n_u16(0xF800)), vdupq_n_u16(0xD800)))) { i += 8; continue; }
+        }
+#endif
+        u16 c = p[i];
+        if ((c & 0xF800) != 0xD800) i++;
+        else if (c < 0xDC00 && i + 1 < n && (p[i+1] & 0xFC00) == 0xDC00) i += 2;
+        else return false;
     }
-    if (lstart < str.len) {
-        ail_da_push(&res, ail_str_from_parts(&str.data[lstart], llen));
+    return true;
+}
+
+b32 ail_str32_is_valid_utf32(AIL_Str32 str)
+{
+    // Branchless, so that the compiler can vectorize it
+    u32 invalid = 0;
+    for (u64 i = 0; i < str.len; i++) {
+        u32 c = str.data[i];
+        invalid |= (c > 0x10FFFF) | ((c & 0xFFFFF800) == 0xD800);
     }
-    return res;
+    return !invalid;
 }
 
-AIL_DA(AIL_Str) ail_str_split_lines_a(AIL_Str str, b32 ignore_empty, AIL_Allocator allocator)
+// Count the amount of leading bytes and the amount of 4-byte leading bytes in `p`
+internal void _ail_utf8_count_leads_(u8 *p, u64 n, u64 *leads, u64 *leads4)
 {
-    // @Cleanup: Almost identical to ail_str_split - maybe we can unite them somehow
-    AIL_DA(AIL_Str) res = ail_da_new_with_alloc(AIL_Str, AIL_ARR_INIT_CAP, allocator);
-    u64 lstart = 0;
-    u64 llen   = 0;
-    if (str.len > 0) {
-        for (u64 i = 0; i < str.len; i++) {
-            if (str.data[i] == '\n') {
-                if (!ignore_empty || llen > 0) {
-                    do {
-                        do {
-                            if ((&res)->len + (1) > (&res)->cap) do {
-                                (&res)->data = (((((&res)->allocator)))).alloc((((((&res)->allocator)))).data, AIL_MEM_REALLOC, (sizeof((&res)->data[0])*((((2*(&res)->cap) > ((&res)->cap + (1))) ? (2*(&res)->cap) : ((&res)->cap + (1))))), ((&res)->data));
-                                (&res)->cap = ((((2*(&res)->cap) > ((&res)->cap + (1))) ? (2*(&res)->cap) : ((&res)->cap + (1))));
-                                if ((&res)->len > (&res)->cap) (&res)->len = (&res)->cap;
-                            } while(0);
-                        } while(0);
-                        (&res)->data[(&res)->len++] = (ail_str_from_parts(&str.data[lstart], llen));
-                    } while(0);
-                }
-                lstart = i + 1;
-                llen   = 0;
-            } else if (str.data[i] == '\r') {
-                if (AIL_LIKELY(i + 1 < str.len && str.data[i + 1] == '\n')) continue;
-                else AIL_UNREACHABLE();
-            } else {
-                llen++;
-            }
-        }
+    u64 conts = 0, fours = 0, i = 0;
+#if AIL_SIMD_AVX2
+    for (; i + 32 <= n; i += 32) {
+        __m256i v = _mm256_loadu_si256((__m256i *)(p + i));
+        conts += ail_popcount_u64((u32)_mm256_movemask_epi8(_mm256_cmpgt_epi8(_mm256_set1_epi8(-64), v)));
+        fours += ail_popcount_u64((u32)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_max_epu8(v, _mm256_set1_epi8((char)0xF0)), v)));
     }
-    if (lstart < str.len && (!ignore_empty || llen > 0)) {
-        ail_da_push(&res, ail_str_from_parts(&str.data[lstart], llen));
+#elif AIL_SIMD_SSE2
+    for (; i + 16 <= n; i += 16) {
+        __m128i v = _mm_loadu_si128((__m128i *)(p + i));
+        conts += ail_popcount_u64((u32)_mm_movemask_epi8(_mm_cmplt_epi8(v, _mm_set1_epi8(-64))));
+        fours += ail_popcount_u64((u32)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_max_epu8(v, _mm_set1_epi8((char)0xF0)), v)));
     }
-    return res;
+#elif AIL_SIMD_NEON
+    for (; i + 16 <= n; i += 16) {
+        uint8x16_t v = vld1q_u8(p + i);
+        conts += vaddvq_u8(vandq_u8(vceqq_u8(vandq_u8(v, vdupq_n_u8(0xC0)), vdupq_n_u8(0x80)), vdupq_n_u8(1)));
+        fours += vaddvq_u8(vandq_u8(vcgeq_u8(v, vdupq_n_u8(0xF0)), vdupq_n_u8(1)));
+    }
+#endif
+    for (; i < n; i++) {
+        conts += (p[i] & 0xC0) == 0x80;
+        fours += p[i] >= 0xF0;
+    }
+    *leads  = n - conts;
+    *leads4 = fours;
 }
 
-AIL_DA(AIL_Str) ail_str_split_whitespace_a(AIL_Str str, b32 ignore_empty, AIL_Allocator allocator)
+u64 ail_str8_len_from_str16(AIL_Str16 str)
 {
-    // @Cleanup: Almost identical to ail_str_split_lines - maybe we can unite them somehow
-    AIL_DA(AIL_Str) res = ail_da_new_with_alloc(AIL_Str, AIL_ARR_INIT_CAP, allocator);
-    u64 lstart = 0;
-    u64 llen   = 0;
-    if (str.len > 0) {
-        for (u64 i = 0; i < str.len; i++) {
-            if (ail_str_is_space(str.data[i])) {
-                if (!ignore_empty || llen > 0) {
-                    ail_da_push(&res, ail_str_from_parts(&str.data[lstart], llen));
-                }
-                lstart = i + 1;
-                llen   = 0;
-            } else {
-                llen++;
-            }
-        }
+    // Each surrogate adds 2 bytes, so that a pair adds up to 4
+    u64 len = 0;
+    for (u64 i = 0; i < str.len; i++) {
+        u16 c = str.data[i];
+        len += 1 + (c >= 0x80) + (c >= 0x800) - ((c & 0xF800) == 0xD800);
     }
-    if (lstart < str.len && (!ignore_empty || llen > 0)) {
-        ail_da_push(&res, ail_str_from_parts(&str.data[lstart], llen));
+    return len;
+}
+
+u64 ail_str8_len_from_str32(AIL_Str32 str)
+{
+    u64 len = 0;
+    for (u64 i = 0; i < str.len; i++) {
+        u32 c = str.data[i];
+        len += 1 + (c >= 0x80) + (c >= 0x800) + (c >= 0x10000);
     }
-    return res;
+    return len;
 }
 
-AIL_Str ail_str_offset(AIL_Str str, u64 offset)
+u64 ail_str16_len_from_str8(AIL_Str8 str)
 {
-    if (AIL_UNLIKELY(offset >= str.len))
-        return ail_str_from_parts(str.data + str.len, 0);
-    else
-        return ail_str_from_parts(str.data + offset, str.len - offset);
+    u64 leads, leads4;
+    _ail_utf8_count_leads_(str.data, str.len, &leads, &leads4);
+    return leads + leads4;
 }
 
-b32 ail_str_is_space(char c)
+u64 ail_str16_len_from_str32(AIL_Str32 str)
 {
-    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+    u64 len = 0;
+    for (u64 i = 0; i < str.len; i++) len += 1 + (str.data[i] >= 0x10000);
+    return len;
 }
 
-b32 ail_str_is_digit(char c)
+u64 ail_str32_len_from_str8(AIL_Str8 str)
 {
-    return '0' <= c && c <= '9';
+    u64 leads, leads4;
+    _ail_utf8_count_leads_(str.data, str.len, &leads, &leads4);
+    return leads;
 }
 
-b32 ail_str_is_alpha(char c)
+u64 ail_str32_len_from_str16(AIL_Str16 str)
 {
-    return ('a' <= c && c <= 'z') || ('A' <= c && c <= 'Z');
+    u64 len = 0;
+    for (u64 i = 0; i < str.len; i++) len += (str.data[i] & 0xFC00) != 0xDC00;
+    return len;
 }
 
-AIL_Str ail_str_ltrim(AIL_Str str)
+// Decode the character starting at p[*idx]
+inline_func u32 _ail_utf8_decode_(u8 *p, u64 *idx)
 {
-    if (str.len == 0) return str;
-    u64 start = 0;
-    while (start < str.len && ail_str_is_space(str.data[start])) start++;
-    return ail_str_offset(str, start);
+    u64 i = *idx;
+    u8  c = p[i];
+    u32 cp;
+    if (c < 0x80) {
+        cp = c;
+        i += 1;
+    } else if (c < 0xE0) {
+        cp = ((u32)(c & 0x1F) << 6) | (p[i+1] & 0x3F);
+        i += 2;
+    } else if (c < 0xF0) {
+        cp = ((u32)(c & 0x0F) << 12) | ((u32)(p[i+1] & 0x3F) << 6) | (p[i+2] & 0x3F);
+        i += 3;
+    } else {
+        cp = ((u32)(c & 0x07) << 18) | ((u32)(p[i+1] & 0x3F) << 12) | ((u32)(p[i+2] & 0x3F) << 6) | (p[i+3] & 0x3F);
+        i += 4;
+    }
+    *idx = i;
+    return cp;
 }
 
-AIL_Str ail_str_rtrim(AIL_Str str)
+inline_func u64 _ail_utf8_encode_(u32 cp, u8 *out)
 {
-    u64 end = str.len;
-    while (end > 0 && ail_str_is_space(str.data[end - 1])) end--;
-    return ail_str_from_parts(str.data, end);
+    if (cp < 0x80) {
+        out[0] = (u8)cp;
+        return 1;
+    } else if (cp < 0x800) {
+        out[0] = (u8)(0xC0 | (cp >> 6));
+        out[1] = (u8)(0x80 | (cp & 0x3F));
+        return 2;
+    } else if (cp < 0x10000) {
+        out[0] = (u8)(0xE0 | (cp >> 12));
+        out[1] = (u8)(0x80 | ((cp >> 6) & 0x3F));
+        out[2] = (u8)(0x80 | (cp & 0x3F));
+        return 3;
+    } else {
+        out[0] = (u8)(0xF0 | (cp >> 18));
+        out[1] = (u8)(0x80 | ((cp >> 12) & 0x3F));
+        out[2] = (u8)(0x80 | ((cp >> 6) & 0x3F));
+        out[3] = (u8)(0x80 | (cp & 0x3F));
+        return 4;
+    }
 }
 
+inline_func u64 _ail_utf16_encode_(u32 cp, u16 *out)
+{
+    if (cp < 0x10000) {
+        out[0] = (u16)cp;
+        return 1;
+    }
+    cp -= 0x10000;
+    out[0] = (u16)(0xD800 | (cp >> 10));
+    out[1] = (u16)(0xDC00 | (cp & 0x3FF));
+    return 2;
+}
 
-AIL_Str ail_str_trim(AIL_Str str)
+inline_func u32 _ail_utf16_decode_(u16 *p, u64 *idx)
 {
-    // return ail_str_rtrim(ail_str_ltrim(str));
-    if (str.len == 0) return str;
-    u64 start = 0;
-    u64 end   = str.len - 1;
-    while (start < str.len && ail_str_is_space(str.data[start])) start++;
-    while (end > start && ail_str_is_space(str.data[end])) end--;
-    if (start < str.len) return ail_str_from_parts(&str.data[start], end - start + 1);
-    else return (AIL_Str) {0};
+    u64 i = *idx;
+    u32 c = p[i];
+    if ((c & 0xFC00) == 0xD800) {
+        *idx = i + 2;
+        return 0x10000 + ((c - 0xD800) << 10) + (p[i+1] - 0xDC00);
+    }
+    *idx = i + 1;
+    return c;
 }
 
-AIL_Str ail_str_join_a(AIL_Str *list, u64 n, AIL_Str joiner, AIL_Allocator allocator)
+// The following functions convert 16 code units at once with SIMD, if they are all ASCII (or, between UTF-16 and UTF-32, need no surrogates)
+// They return false without writing anything otherwise
+internal b32 _ail_utf_ascii8_to16_(u8 *p, u16 *out)
 {
-    if (n == 0) return (AIL_Str) {0};
-    u64 res_len = joiner.len*(n - 1);
-    for (u64 i = 0; i < n; i++) res_len += list[i].len;
+#if AIL_SIMD_SSE2
+    __m128i v = _mm_loadu_si128((__m128i *)p);
+    if (_mm_movemask_epi8(v)) return false;
+    _mm_storeu_si128((__m128i *)out,     _mm_unpacklo_epi8(v, _mm_setzero_si128()));
+    _mm_storeu_si128((__m128i *)out + 1, _mm_unpackhi_epi8(v, _mm_setzero_si128()));
+    return true;
+#elif AIL_SIMD_NEON
+    uint8x16_t v = vld1q_u8(p);
+    if (vmaxvq_u8(v) >= 0x80) return false;
+    vst1q_u16(out,     vmovl_u8(vget_low_u8(v)));
+    vst1q_u16(out + 8, vmovl_high_u8(v));
+    return true;
+#else
+    (void)p; (void)out;
+    return false;
+#endif
+}
+
+internal b32 _ail_utf_ascii8_to32_(u8 *p, u32 *out)
+{
+#if AIL_SIMD_SSE2
+    __m128i v = _mm_loadu_si128((__m128i *)p);
+    if (_mm_movemask_epi8(v)) return false;
+    __m128i z  = _mm_setzero_si128();
+    __m128i lo = _mm_unpacklo_epi8(v, z);
+    __m128i hi = _mm_unpackhi_epi8(v, z);
+    _mm_storeu_si128((__m128i *)out,     _mm_unpacklo_epi16(lo, z));
+    _mm_storeu_si128((__m128i *)out + 1, _mm_unpackhi_epi16(lo, z));
+    _mm_storeu_si128((__m128i *)out + 2, _mm_unpacklo_epi16(hi, z));
+    _mm_storeu_si128((__m128i *)out + 3, _mm_unpackhi_epi16(hi, z));
+    return true;
+#elif AIL_SIMD_NEON
+    uint8x16_t v = vld1q_u8(p);
+    if (vmaxvq_u8(v) >= 0x80) return false;
+    uint16x8_t lo = vmovl_u8(vget_low_u8(v));
+    uint16x8_t hi = vmovl_high_u8(v);
+    vst1q_u32(out,      vmovl_u16(vget_low_u16(lo)));
+    vst1q_u32(out + 4,  vmovl_high_u16(lo));
+    vst1q_u32(out + 8,  vmovl_u16(vget_low_u16(hi)));
+    vst1q_u32(out + 12, vmovl_high_u16(hi));
+    return true;
+#else
+    (void)p; (void)out;
+    return false;
+#endif
+}
+
+internal b32 _ail_utf_ascii16_to8_(u16 *p, u8 *out)
+{
+#if AIL_SIMD_SSE2
+    __m128i a = _mm_loadu_si128((__m128i *)p);
+    __m128i b = _mm_loadu_si128((__m128i *)p + 1);
+    __m128i non_ascii = _mm_and_si128(_mm_or_si128(a, b), _mm_set1_epi16((i16)0xFF80));
+    if (_mm_movemask_epi8(_mm_cmpeq_epi8(non_ascii, _mm_setzero_si128())) != 0xffff) return false;
+    _mm_storeu_si128((__m128i *)out, _mm_packus_epi16(a, b));
+    return true;
+#elif AIL_SIMD_NEON
+    uint16x8_t a = vld1q_u16(p);
+    uint16x8_t b = vld1q_u16(p + 8);
+    if (vmaxvq_u16(vorrq_u16(a, b)) >= 0x80) return false;
+    vst1q_u8(out, vcombine_u8(vmovn_u16(a), vmovn_u16(b)));
+    return true;
+#else
+    (void)p; (void)out;
+    return false;
+#endif
+}
+
+internal b32 _ail_utf_ascii32_to8_(u32 *p, u8 *out)
+{
+#if AIL_SIMD_SSE2
+    __m128i a = _mm_loadu_si128((__m128i *)p);
+    __m128i b = _mm_loadu_si128((__m128i *)p + 1);
+    __m128i c = _mm_loadu_si128((__m128i *)p + 2);
+    __m128i d = _mm_loadu_si128((__m128i *)p + 3);
+    __m128i non_ascii = _mm_and_si128(_mm_or_si128(_mm_or_si128(a, b), _mm_or_si128(c, d)), _mm_set1_epi32((i32)0xFFFFFF80));
+    if (_mm_movemask_epi8(_mm_cmpeq_epi8(non_ascii, _mm_setzero_si128())) != 0xffff) return false;
+    _mm_storeu_si128((__m128i *)out, _mm_packus_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d)));
+    return true;
+#elif AIL_SIMD_NEON
+    uint32x4_t a = vld1q_u32(p);
+    uint32x4_t b = vld1q_u32(p + 4);
+    uint32x4_t c = vld1q_u32(p + 8);
+    uint32x4_t d = vld1q_u32(p + 12);
+    if (vmaxvq_u32(vorrq_u32(vorrq_u32(a, b), vorrq_u32(c, d))) >= 0x80) return false;
+    uint16x8_t lo = vcombine_u16(vmovn_u32(a), vmovn_u32(b));
+    uint16x8_t hi = vcombine_u16(vmovn_u32(c), vmovn_u32(d));
+    vst1q_u8(out, vcombine_u8(vmovn_u16(lo), vmovn_u16(hi)));
+    return true;
+#else
+    (void)p; (void)out;
+    return false;
+#endif
+}
+
+internal b32 _ail_utf_bmp16_to32_(u16 *p, u32 *out)
+{
+#if AIL_SIMD_SSE2
+    __m128i a = _mm_loadu_si128((__m128i *)p);
+    __m128i b = _mm_loadu_si128((__m128i *)p + 1);
+    __m128i m = _mm_set1_epi16((i16)0xF800);
+    __m128i s = _mm_set1_epi16((i16)0xD800);
+    if (_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi16(_mm_and_si128(a, m), s), _mm_cmpeq_epi16(_mm_and_si128(b, m), s)))) return false;
+    __m128i z = _mm_setzero_si128();
+    _mm_storeu_si128((__m128i *)out,     _mm_unpacklo_epi16(a, z));
+    _mm_storeu_si128((__m128i *)out + 1, _mm_unpackhi_epi16(a, z));
+    _mm_storeu_si128((__m128i *)out + 2, _mm_unpacklo_epi16(b, z));
+    _mm_storeu_si128((__m128i *)out + 3, _mm_unpackhi_epi16(b, z));
+    return true;
+#elif AIL_SIMD_NEON
+    uint16x8_t a = vld1q_u16(p);
+    uint16x8_t b = vld1q_u16(p + 8);
+    uint16x8_t m = vdupq_n_u16(0xF800);
+    uint16x8_t s = vdupq_n_u16(0xD800);
+    if (vmaxvq_u16(vorrq_u16(vceqq_u16(vandq_u16(a, m), s), vceqq_u16(vandq_u16(b, m), s)))) return false;
+    vst1q_u32(out,      vmovl_u16(vget_low_u16(a)));
+    vst1q_u32(out + 4,  vmovl_high_u16(a));
+    vst1q_u32(out + 8,  vmovl_u16(vget_low_u16(b)));
+    vst1q_u32(out + 12, vmovl_high_u16(b));
+    return true;
+#else
+    (void)p; (void)out;
+    return false;
+#endif
+}
+
+// Narrows 16 code points to UTF-16 and returns how many of them at the start don't need a surrogate pair
+// @Important: All 16 code units are written, but only the returned amount of them is valid
+internal u64 _ail_utf_bmp32_to16_(u32 *p, u16 *out)
+{
+#if AIL_SIMD_SSE2
+    __m128i a = _mm_loadu_si128((__m128i *)p);
+    __m128i b = _mm_loadu_si128((__m128i *)p + 1);
+    __m128i c = _mm_loadu_si128((__m128i *)p + 2);
+    __m128i d = _mm_loadu_si128((__m128i *)p + 3);
+    __m128i max = _mm_set1_epi32(0xFFFF);
+    __m128i non_bmp = _mm_packs_epi16(_mm_packs_epi32(_mm_cmpgt_epi32(a, max), _mm_cmpgt_epi32(b, max)),
+                                      _mm_packs_epi32(_mm_cmpgt_epi32(c, max), _mm_cmpgt_epi32(d, max)));
+    u32 m = (u32)_mm_movemask_epi8(non_bmp);
+    // SSE2 can only pack with signed saturation, so the code points are moved into the range of i16 and back
+    __m128i bias = _mm_set1_epi32(0x8000);
+    __m128i flip = _mm_set1_epi16((i16)0x8000);
+    __m128i lo   = _mm_packs_epi32(_mm_sub_epi32(a, bias), _mm_sub_epi32(b, bias));
+    __m128i hi   = _mm_packs_epi32(_mm_sub_epi32(c, bias), _mm_sub_epi32(d, bias));
+    _mm_storeu_si128((__m128i *)out,     _mm_xor_si128(lo, flip));
+    _mm_storeu_si128((__m128i *)out + 1, _mm_xor_si128(hi, flip));
+    return m ? ail_ctz_u64(m) : 16;
+#elif AIL_SIMD_NEON
+    uint32x4_t a = vld1q_u32(p);
+    uint32x4_t b = vld1q_u32(p + 4);
+    uint32x4_t c = vld1q_u32(p + 8);
+    uint32x4_t d = vld1q_u32(p + 12);
+    vst1q_u16(out,     vcombine_u16(vmovn_u32(a), vmovn_u32(b)));
+    vst1q_u16(out + 8, vcombine_u16(vmovn_u32(c), vmovn_u32(d)));
+    if (vmaxvq_u32(vorrq_u32(vorrq_u32(a, b), vorrq_u32(c, d))) < 0x10000) return 16;
+    u64 n = 0;
+    while (p[n] < 0x10000) n++;
+    return n;
+#else
+    (void)p; (void)out;
+    return 0;
+#endif
+}
+
+// Blocks with characters of up to 3 bytes are converted between UTF-8 and UTF-16 with SSSE3 as well:
+// Every character is first expanded to a fixed-size lane in a vector, after which the used bytes of all lanes are compacted with a byte shuffle from a lookup table.
+// These kernels write past the end of their output, so they are only used, if enough input is left to be converted afterwards.
+// @TODO: Port these kernels to NEON, which only converts blocks of ASCII with SIMD so far
+#if AIL_SIMD_SSSE3
+// Shuffles for compacting 4 lanes of 32 bits with the 1 to 3 bytes of a UTF-8 sequence each
+// The table is indexed with the lanes' lengths minus one as the digits of a number in base 3 with the first lane as the least significant digit
+#define _AIL_UTF_SHUF_1_(j) 4*j
+#define _AIL_UTF_SHUF_2_(j) 4*j, 4*j+1
+#define _AIL_UTF_SHUF_3_(j) 4*j, 4*j+1, 4*j+2
+#define _AIL_UTF_SHUF_(a, b, c, d) { _AIL_UTF_SHUF_##a##_(0), _AIL_UTF_SHUF_##b##_(1), _AIL_UTF_SHUF_##c##_(2), _AIL_UTF_SHUF_##d##_(3) }
+#define _AIL_UTF_SHUF_L1_(b, c, d) _AIL_UTF_SHUF_(1, b, c, d), _AIL_UTF_SHUF_(2, b, c, d), _AIL_UTF_SHUF_(3, b, c, d)
+#define _AIL_UTF_SHUF_L2_(c, d)    _AIL_UTF_SHUF_L1_(1, c, d), _AIL_UTF_SHUF_L1_(2, c, d), _AIL_UTF_SHUF_L1_(3, c, d)
+#define _AIL_UTF_SHUF_L3_(d)       _AIL_UTF_SHUF_L2_(1, d), _AIL_UTF_SHUF_L2_(2, d), _AIL_UTF_SHUF_L2_(3, d)
+global const u8 _ail_utf_shuf_32_to_8_[81][16] = { _AIL_UTF_SHUF_L3_(1), _AIL_UTF_SHUF_L3_(2), _AIL_UTF_SHUF_L3_(3) };
+#undef _AIL_UTF_SHUF_1_
+#undef _AIL_UTF_SHUF_2_
+#undef _AIL_UTF_SHUF_3_
+#undef _AIL_UTF_SHUF_
+#undef _AIL_UTF_SHUF_L1_
+#undef _AIL_UTF_SHUF_L2_
+#undef _AIL_UTF_SHUF_L3_
+// Sum of 3^j for every bit j set in the index, which turns the masks of 2- and 3-byte lanes into an index into the table above
+global const u8 _ail_utf_pow3_sums_[16] = { 0, 1, 3, 4, 9, 10, 12, 13, 27, 28, 30, 31, 36, 37, 39, 40 };
+
+// Shuffles for compacting the 16-bit lanes selected by a mask of 4 bits
+global const u8 _ail_utf_shuf_16_[16][8] = {
+    {0},          {0, 1},             {2, 3},             {0, 1, 2, 3},
+    {4, 5},       {0, 1, 4, 5},       {2, 3, 4, 5},       {0, 1, 2, 3, 4, 5},
+    {6, 7},       {0, 1, 6, 7},       {2, 3, 6, 7},       {0, 1, 2, 3, 6, 7},
+    {4, 5, 6, 7}, {0, 1, 4, 5, 6, 7}, {2, 3, 4, 5, 6, 7}, {0, 1, 2, 3, 4, 5, 6, 7},
+};
+
+// Converts 8 code units to UTF-8 and returns the amount of bytes written or 0, if there was a surrogate among them
+// @Important: Always writes 16 bytes past the last 4 code units
+internal u64 _ail_utf_bmp16_to8_(u16 *p, u8 *out)
+{
+    __m128i v = _mm_loadu_si128((__m128i *)p);
+    if (_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(v, _mm_set1_epi16((i16)0xF800)), _mm_set1_epi16((i16)0xD800)))) return 0;
+    __m128i m6 = _mm_set1_epi32(0x3F);
+    __m128i c0 = _mm_set1_epi32(0x80);
+    u64 n = 0;
+    for (u32 h = 0; h < 2; h++) {
+        __m128i c    = h ? _mm_unpackhi_epi16(v, _mm_setzero_si128()) : _mm_unpacklo_epi16(v, _mm_setzero_si128());
+        __m128i low  = _mm_or_si128(_mm_and_si128(c, m6), c0);
+        __m128i mid  = _mm_or_si128(_mm_and_si128(_mm_srli_epi32(c, 6), m6), c0);
+        __m128i two   = _mm_or_si128(_mm_or_si128(_mm_srli_epi32(c, 6),  _mm_set1_epi32(0xC0)), _mm_slli_epi32(low, 8));
+        __m128i three = _mm_or_si128(_mm_or_si128(_mm_srli_epi32(c, 12), _mm_set1_epi32(0xE0)), _mm_or_si128(_mm_slli_epi32(mid, 8), _mm_slli_epi32(low, 16)));
+        __m128i is2  = _mm_cmpgt_epi32(c, _mm_set1_epi32(0x7F));
+        __m128i is3  = _mm_cmpgt_epi32(c, _mm_set1_epi32(0x7FF));
+        __m128i w    = _mm_or_si128(_mm_andnot_si128(is2, c), _mm_and_si128(is2, two));
+        w = _mm_or_si128(_mm_andnot_si128(is3, w), _mm_and_si128(is3, three));
+        u32 m2 = (u32)_mm_movemask_ps(_mm_castsi128_ps(is2));
+        u32 m3 = (u32)_mm_movemask_ps(_mm_castsi128_ps(is3));
+        __m128i shuf = _mm_loadu_si128((__m128i *)_ail_utf_shuf_32_to_8_[_ail_utf_pow3_sums_[m2] + _ail_utf_pow3_sums_[m3]]);
+        _mm_storeu_si128((__m128i *)(out + n), _mm_shuffle_epi8(w, shuf));
+        n += 4 + ail_popcount_u64(m2) + ail_popcount_u64(m3);
+    }
+    return n;
+}
+
+// Decodes all characters of up to 3 bytes, that end within the 16 bytes at p, to UTF-16
+// Returns the amount of bytes consumed and the amount of code units written in `units`, or 0 if there was a 4-byte sequence in the block
+// @Important: Reads p[16] as well and always writes 4 code units past the last one
+internal u64 _ail_utf_bmp8_to16_(u8 *p, u16 *out, u64 *units)
+{
+    __m128i v    = _mm_loadu_si128((__m128i *)p);
+    __m128i next = _mm_loadu_si128((__m128i *)(p + 1));
+    if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_max_epu8(v, _mm_set1_epi8((char)0xF0)), v))) return 0;
+    // Every byte, that isn't followed by a continuation byte, is the last byte of a character
+    u32 ends = ~(u32)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(next, _mm_set1_epi8((char)0xC0)), _mm_set1_epi8((char)0x80))) & 0xFFFF;
+    if (!ends) return 0;
+    // The code point is calculated at every byte, as if it was the last byte of its character
+    __m128i prev1 = _mm_slli_si128(v, 1);
+    __m128i prev2 = _mm_slli_si128(v, 2);
+    __m128i m6    = _mm_set1_epi16(0x3F);
+    __m128i z     = _mm_setzero_si128();
+    u64 n = 0;
+    for (u32 h = 0; h < 2; h++) {
+        __m128i b0 = h ? _mm_unpackhi_epi8(v, z)     : _mm_unpacklo_epi8(v, z);
+        __m128i b1 = h ? _mm_unpackhi_epi8(prev1, z) : _mm_unpacklo_epi8(prev1, z);
+        __m128i b2 = h ? _mm_unpackhi_epi8(prev2, z) : _mm_unpacklo_epi8(prev2, z);
+        __m128i low   = _mm_and_si128(b0, m6);
+        __m128i two   = _mm_or_si128(_mm_slli_epi16(_mm_and_si128(b1, _mm_set1_epi16(0x1F)), 6), low);
+        __m128i three = _mm_or_si128(_mm_or_si128(_mm_slli_epi16(b2, 12), _mm_slli_epi16(_mm_and_si128(b1, m6), 6)), low);
+        __m128i is1   = _mm_cmplt_epi16(b0, _mm_set1_epi16(0x80));
+        __m128i is2   = _mm_cmpgt_epi16(b1, _mm_set1_epi16(0xBF));
+        __m128i cp    = _mm_or_si128(_mm_and_si128(is2, two), _mm_andnot_si128(is2, three));
+        cp = _mm_or_si128(_mm_and_si128(is1, b0), _mm_andnot_si128(is1, cp));
+        u32 m = (ends >> 8*h) & 0xFF;
+        __m128i shuf = _mm_unpacklo_epi64(_mm_loadl_epi64((__m128i *)_ail_utf_shuf_16_[m & 15]),
+                                          _mm_add_epi8(_mm_loadl_epi64((__m128i *)_ail_utf_shuf_16_[m >> 4]), _mm_set1_epi8(8)));
+        cp = _mm_shuffle_epi8(cp, shuf);
+        _mm_storel_epi64((__m128i *)(out + n), cp);
+        n += ail_popcount_u64(m & 15);
+        _mm_storel_epi64((__m128i *)(out + n), _mm_srli_si128(cp, 8));
+        n += ail_popcount_u64(m >> 4);
+    }
+    *units = n;
+    return 64 - ail_clz_u64(ends);
+}
+#endif
+
+// Whenever a block of 16 code units can't be converted with SIMD, all characters starting in that block are converted one by one
+AIL_Str8 ail_str8_from_str16(AIL_Str16 str, u8 *buf)
+{
+    u64 i = 0, j = 0;
+    while (i < str.len) {
+        u64 end = str.len;
+        if (AIL_SIMD && i + 16 <= str.len) {
+            if (_ail_utf_ascii16_to8_(str.data + i, buf + j)) { i += 16; j += 16; continue; }
+#if AIL_SIMD_SSSE3
+            // Every one of the 16 code units after this block becomes at least one byte, which covers what the kernel writes past its output
+            u64 n;
+            if (i + 32 <= str.len && (n = _ail_utf_bmp16_to8_(str.data + i, buf + j))) { i += 8; j += n; continue; }
+#endif
+            end = i + 16;
+        }
+        while (i < end) j += _ail_utf8_encode_(_ail_utf16_decode_(str.data, &i), buf + j);
+    }
+    return ail_str_from_parts(buf, j);
+}
+
+AIL_Str8 ail_str8_from_str32(AIL_Str32 str, u8 *buf)
+{
+    u64 i = 0, j = 0;
+    while (i < str.len) {
+        if (AIL_SIMD && i + 16 <= str.len) {
+            if (_ail_utf_ascii32_to8_(str.data + i, buf + j)) { i += 16; j += 16; continue; }
+#if AIL_SIMD_SSSE3
+            u16 units[16];
+            u64 n1, n2;
+            if (i + 32 <= str.len && _ail_utf_bmp32_to16_(str.data + i, units) == 16 &&
+                (n1 = _ail_utf_bmp16_to8_(units, buf + j)) && (n2 = _ail_utf_bmp16_to8_(units + 8, buf + j + n1))) {
+                i += 16; j += n1 + n2;
+                continue;
+            }
+#endif
+            for (u64 end = i + 16; i < end; i++) j += _ail_utf8_encode_(str.data[i], buf + j);
+        } else {
+            j += _ail_utf8_encode_(str.data[i++], buf + j);
+        }
+    }
+    return ail_str_from_parts(buf, j);
+}
+
+AIL_Str16 ail_str16_from_str8(AIL_Str8 str, u16 *buf)
+{
+    u64 i = 0, j = 0;
+    while (i < str.len) {
+        u64 end = str.len;
+        if (AIL_SIMD && i + 16 <= str.len) {
+            if (_ail_utf_ascii8_to16_(str.data + i, buf + j)) { i += 16; j += 16; continue; }
+#if AIL_SIMD_SSSE3
+            // The 16 bytes after this block become at least 4 code units, which covers what the kernel writes past its output
+            u64 n, units;
+            if (i + 32 <= str.len && (n = _ail_utf_bmp8_to16_(str.data + i, buf + j, &units))) { i += n; j += units; continue; }
+#endif
+            end = i + 16;
+        }
+        while (i < end) j += _ail_utf16_encode_(_ail_utf8_decode_(str.data, &i), buf + j);
+    }
+    return (AIL_Str16){ .data = buf, .len = j };
+}
+
+AIL_Str16 ail_str16_from_str32(AIL_Str32 str, u16 *buf)
+{
+    u64 i = 0, j = 0;
+    while (i < str.len) {
+        if (AIL_SIMD && i + 16 <= str.len) {
+            // The code units after the first surrogate pair are overwritten again, since each of the 16 code points needs at least one
+            u64 n = _ail_utf_bmp32_to16_(str.data + i, buf + j);
+            i += n; j += n;
+            if (n == 16) continue;
+        }
+        j += _ail_utf16_encode_(str.data[i++], buf + j);
+    }
+    return (AIL_Str16){ .data = buf, .len = j };
+}
+
+AIL_Str32 ail_str32_from_str8(AIL_Str8 str, u32 *buf)
+{
+    u64 i = 0, j = 0;
+    while (i < str.len) {
+        u64 end = str.len;
+        if (AIL_SIMD && i + 16 <= str.len) {
+            if (_ail_utf_ascii8_to32_(str.data + i, buf + j)) { i += 16; j += 16; continue; }
+#if AIL_SIMD_SSSE3
+            u16 tmp[20];
+            u64 n, units;
+            if (i + 32 <= str.len && (n = _ail_utf_bmp8_to16_(str.data + i, tmp, &units))) {
+                for (u64 k = 0; k < units; k += 4) _mm_storeu_si128((__m128i *)(buf + j + k), _mm_unpacklo_epi16(_mm_loadl_epi64((__m128i *)(tmp + k)), _mm_setzero_si128()));
+                i += n; j += units;
+                continue;
+            }
+#endif
+            end = i + 16;
+        }
+        while (i < end) buf[j++] = _ail_utf8_decode_(str.data, &i);
+    }
+    return (AIL_Str32){ .data = buf, .len = j };
+}
+
+AIL_Str32 ail_str32_from_str16(AIL_Str16 str, u32 *buf)
+{
+    u64 i = 0, j = 0;
+    while (i < str.len) {
+        u64 end = str.len;
+        if (AIL_SIMD && i + 16 <= str.len) {
+            if (_ail_utf_bmp16_to32_(str.data + i, buf + j)) { i += 16; j += 16; continue; }
+            end = i + 16;
+        }
+        while (i < end) buf[j++] = _ail_utf16_decode_(str.data, &i);
+    }
+    return (AIL_Str32){ .data = buf, .len = j };
+}
+
+#define _AIL_UTF_NEW_(dst_t, dst_unit, dst_n, src_n, src_t)                                    \
+    dst_t ail_str##dst_n##_new_str##src_n##_a(src_t str, AIL_Allocator allocator)              \
+    {                                                                                          \
+        dst_t res = {0};                                                                       \
+        if (!ail_str##src_n##_is_valid_utf##src_n(str)) return res;                            \
+        u64 len = ail_str##dst_n##_len_from_str##src_n(str);                                   \
+        dst_unit *buf = ail_call_alloc(allocator, (len + 1)*sizeof(dst_unit));                 \
+        res = ail_str##dst_n##_from_str##src_n(str, buf);                                      \
+        ail_assert(res.len == len);                                                            \
+        buf[len] = 0;                                                                          \
+        return res;                                                                            \
+    }
+_AIL_UTF_NEW_(AIL_Str8,  u8,  8,  16, AIL_Str16)
+_AIL_UTF_NEW_(AIL_Str8,  u8,  8,  32, AIL_Str32)
+_AIL_UTF_NEW_(AIL_Str16, u16, 16, 8,  AIL_Str8)
+_AIL_UTF_NEW_(AIL_Str16, u16, 16, 32, AIL_Str32)
+_AIL_UTF_NEW_(AIL_Str32, u32, 32, 8,  AIL_Str8)
+_AIL_UTF_NEW_(AIL_Str32, u32, 32, 16, AIL_Str16)
+#undef _AIL_UTF_NEW_
+
+////////////////////////////////////
+// Comparison and Case Conversion //
+////////////////////////////////////
+
+// Vectors of bytes used for comparisons, case conversion, trimming, searching and splitting
+#if AIL_SIMD_AVX2
+#   define _AIL_STR_VEC_SIZE_      32
+#   define _AIL_STR_VEC_LANE_BITS_ 1
+    typedef __m256i _ail_str_vec_;
+#   define _ail_str_vec_splat_(c)  _mm256_set1_epi8((char)(c))
+#   define _ail_str_vec_eq_(p, v)  _mm256_cmpeq_epi8(_mm256_loadu_si256((__m256i *)(p)), v)
+#   define _ail_str_vec_and_(a, b) _mm256_and_si256(a, b)
+#   define _ail_str_vec_or_(a, b)  _mm256_or_si256(a, b)
+#   define _ail_str_vec_mask_(v)   ((u64)(u32)_mm256_movemask_epi8(v))
+#   define _AIL_STR_VEC_FULL_MASK_ 0xFFFFFFFFULL
+#   define _ail_str_vec_load_(p)     _mm256_loadu_si256((__m256i *)(p))
+#   define _ail_str_vec_store_(p, v) _mm256_storeu_si256((__m256i *)(p), v)
+#   define _ail_str_vec_cmpeq_(a, b) _mm256_cmpeq_epi8(a, b)
+#   define _ail_str_vec_xor_(a, b)   _mm256_xor_si256(a, b)
+// Sets every lane, whose byte is in [lo, lo + n), with signed comparisons after moving lo to the smallest signed byte
+#   define _ail_str_vec_in_range_(v, lo, n) _mm256_cmpgt_epi8(_mm256_set1_epi8((char)(-128 + (n))), _mm256_add_epi8(v, _mm256_set1_epi8((char)(0x80 - (lo)))))
+#elif AIL_SIMD_SSE2
+#   define _AIL_STR_VEC_SIZE_      16
+#   define _AIL_STR_VEC_LANE_BITS_ 1
+    typedef __m128i _ail_str_vec_;
+#   define _ail_str_vec_splat_(c)  _mm_set1_epi8((char)(c))
+#   define _ail_str_vec_eq_(p, v)  _mm_cmpeq_epi8(_mm_loadu_si128((__m128i *)(p)), v)
+#   define _ail_str_vec_and_(a, b) _mm_and_si128(a, b)
+#   define _ail_str_vec_or_(a, b)  _mm_or_si128(a, b)
+#   define _ail_str_vec_mask_(v)   ((u64)(u32)_mm_movemask_epi8(v))
+#   define _AIL_STR_VEC_FULL_MASK_ 0xFFFFULL
+#   define _ail_str_vec_load_(p)     _mm_loadu_si128((__m128i *)(p))
+#   define _ail_str_vec_store_(p, v) _mm_storeu_si128((__m128i *)(p), v)
+#   define _ail_str_vec_cmpeq_(a, b) _mm_cmpeq_epi8(a, b)
+#   define _ail_str_vec_xor_(a, b)   _mm_xor_si128(a, b)
+#   define _ail_str_vec_in_range_(v, lo, n) _mm_cmplt_epi8(_mm_add_epi8(v, _mm_set1_epi8((char)(0x80 - (lo)))), _mm_set1_epi8((char)(-128 + (n))))
+#elif AIL_SIMD_NEON
+// NEON has no movemask, so the comparison results are narrowed to 4 bits per lane instead, of which only one is kept
+#   define _AIL_STR_VEC_SIZE_      16
+#   define _AIL_STR_VEC_LANE_BITS_ 4
+    typedef uint8x16_t _ail_str_vec_;
+#   define _ail_str_vec_splat_(c)  vdupq_n_u8((u8)(c))
+#   define _ail_str_vec_eq_(p, v)  vceqq_u8(vld1q_u8(p), v)
+#   define _ail_str_vec_and_(a, b) vandq_u8(a, b)
+#   define _ail_str_vec_or_(a, b)  vorrq_u8(a, b)
+#   define _ail_str_vec_mask_(v)   (vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(v), 4)), 0) & 0x8888888888888888ULL)
+#   define _AIL_STR_VEC_FULL_MASK_ 0x8888888888888888ULL
+#   define _ail_str_vec_load_(p)     vld1q_u8(p)
+#   define _ail_str_vec_store_(p, v) vst1q_u8(p, v)
+#   define _ail_str_vec_cmpeq_(a, b) vceqq_u8(a, b)
+#   define _ail_str_vec_xor_(a, b)   veorq_u8(a, b)
+#   define _ail_str_vec_in_range_(v, lo, n) vcltq_u8(vsubq_u8(v, vdupq_n_u8(lo)), vdupq_n_u8(n))
+#else
+#   define _AIL_STR_VEC_SIZE_      0
+#endif
+
+#if _AIL_STR_VEC_SIZE_
+// Flips the case of every byte in [first, first + 26), i.e. converts uppercase letters to lowercase if `first` is 'A'
+#define _ail_str_vec_flip_case_(v, first) _ail_str_vec_xor_(v, _ail_str_vec_and_(_ail_str_vec_in_range_(v, first, 26), _ail_str_vec_splat_(0x20)))
+#define _ail_str_vec_lower_(v) _ail_str_vec_flip_case_(v, 'A')
+
+// Sets every lane, whose byte is whitespace according to ail_str_is_space
+inline_func _ail_str_vec_ _ail_str_vec_space_(u8 *p)
+{
+    return _ail_str_vec_or_(_ail_str_vec_or_(_ail_str_vec_eq_(p, _ail_str_vec_splat_(' ')),  _ail_str_vec_eq_(p, _ail_str_vec_splat_('\t'))),
+                            _ail_str_vec_or_(_ail_str_vec_eq_(p, _ail_str_vec_splat_('\n')), _ail_str_vec_eq_(p, _ail_str_vec_splat_('\r'))));
+}
+#endif
+
+inline_func u8 _ail_str_lower_(u8 c)
+{
+    return (u8)(c | ((u8)(c - 'A') < 26) << 5);
+}
+
+// Index of the first byte, at which `a` and `b` differ, or `n` if there is none
+// If `nocase` is true, the case of letters is ignored
+inline_func u64 _ail_str_mismatch_(u8 *a, u8 *b, u64 n, b32 nocase)
+{
+    u64 i = 0;
+#if _AIL_STR_VEC_SIZE_
+    for (; i + _AIL_STR_VEC_SIZE_ <= n; i += _AIL_STR_VEC_SIZE_) {
+        _ail_str_vec_ va = _ail_str_vec_load_(a + i);
+        _ail_str_vec_ vb = _ail_str_vec_load_(b + i);
+        if (nocase) {
+            va = _ail_str_vec_lower_(va);
+            vb = _ail_str_vec_lower_(vb);
+        }
+        u64 mask = ~_ail_str_vec_mask_(_ail_str_vec_cmpeq_(va, vb)) & _AIL_STR_VEC_FULL_MASK_;
+        if (mask) return i + ail_ctz_u64(mask)/_AIL_STR_VEC_LANE_BITS_;
+    }
+#endif
+    if (nocase) while (i < n && _ail_str_lower_(a[i]) == _ail_str_lower_(b[i])) i++;
+    else        while (i < n && a[i] == b[i]) i++;
+    return i;
+}
+
+b32 ail_str_full_eq(char *astr, u64 alen, char *bstr, u64 blen)
+{
+    return alen == blen && _ail_str_mismatch_((u8 *)astr, (u8 *)bstr, alen, false) == alen;
+}
+
+i32  ail_str_full_cmp(char *astr, u64 alen, char *bstr, u64 blen)
+{
+    u64 i = _ail_str_mismatch_((u8 *)astr, (u8 *)bstr, ail_min(alen, blen), false);
+    if (i < alen && i < blen) return astr[i] - bstr[i];
+    if      (alen  > blen) return astr[blen];
+    else if (alen == blen) return 0;
+    else                   return bstr[alen];
+}
+
+b32 ail_str_starts_with(AIL_Str8 str, AIL_Str8 prefix)
+{
+    return prefix.len <= str.len && _ail_str_mismatch_(str.data, prefix.data, prefix.len, false) == prefix.len;
+}
+
+b32 ail_str_starts_with_char(AIL_Str8 str, char prefix)
+{
+    return str.len > 0 && str.data[0] == prefix;
+}
+
+b32 ail_str_ends_with(AIL_Str8 str, AIL_Str8 suffix)
+{
+    return suffix.len <= str.len && _ail_str_mismatch_(str.data + str.len - suffix.len, suffix.data, suffix.len, false) == suffix.len;
+}
+
+b32 ail_str_ends_with_char(AIL_Str8 str, char suffix)
+{
+    return str.len > 0 && str.data[str.len - 1] == suffix;
+}
+
+// Bytes are hashed 8 at a time (see FxHash), where the bytes are first converted to lowercase with SWAR if `nocase` is true
+inline_func u32 _ail_str_hash_(AIL_Str8 str, b32 nocase)
+{
+    const u64 ones = 0x0101010101010101ULL;
+    u64 h = str.len;
+    for (u64 i = 0; i < str.len; i += 8) {
+        u64 w = 0;
+        memcpy(&w, str.data + i, ail_min(8, str.len - i));
+        if (nocase) {
+            // The highest bit of each byte is set if the byte is in ['A', 'Z']
+            u64 x     = w & (0x7F*ones);
+            u64 upper = (x + (0x80 - 'A')*ones) & ~(x + (0x80 - 'Z' - 1)*ones) & ~w & (0x80*ones);
+            w |= upper >> 2;
+        }
+        h = (((h << 5) | (h >> 59)) ^ w)*0x517CC1B727220A95ULL;
+    }
+    return (u32)(h ^ (h >> 32));
+}
+
+u32 ail_str_hash(AIL_Str8 str)
+{
+    return _ail_str_hash_(str, false);
+}
+
+u32 ail_str_hash_nocase(AIL_Str8 str)
+{
+    return _ail_str_hash_(str, true);
+}
+
+// Flips the case of every byte in [first, first + 26)
+internal AIL_Str8 _ail_str_convert_case_(AIL_Str8 str, u8 *buf, u8 first)
+{
+    u64 i = 0;
+#if _AIL_STR_VEC_SIZE_
+    for (; i + _AIL_STR_VEC_SIZE_ <= str.len; i += _AIL_STR_VEC_SIZE_) {
+        _ail_str_vec_store_(buf + i, _ail_str_vec_flip_case_(_ail_str_vec_load_(str.data + i), first));
+    }
+#endif
+    for (; i < str.len; i++) buf[i] = str.data[i] ^ ((u8)(str.data[i] - first) < 26) << 5;
+    return ail_str_from_parts(buf, str.len);
+}
+
+AIL_Str8 ail_str_to_lower(AIL_Str8 str, u8 *buf)
+{
+    return _ail_str_convert_case_(str, buf, 'A');
+}
+
+AIL_Str8 ail_str_to_upper(AIL_Str8 str, u8 *buf)
+{
+    return _ail_str_convert_case_(str, buf, 'a');
+}
+
+AIL_Str8 ail_str_new_lower_a(AIL_Str8 str, AIL_Allocator allocator)
+{
+    u8 *buf = ail_call_alloc(allocator, str.len + 1);
+    buf[str.len] = 0;
+    return ail_str_to_lower(str, buf);
+}
+
+AIL_Str8 ail_str_new_upper_a(AIL_Str8 str, AIL_Allocator allocator)
+{
+    u8 *buf = ail_call_alloc(allocator, str.len + 1);
+    buf[str.len] = 0;
+    return ail_str_to_upper(str, buf);
+}
+
+b32 ail_str_full_eq_nocase(char *astr, u64 alen, char *bstr, u64 blen)
+{
+    return alen == blen && _ail_str_mismatch_((u8 *)astr, (u8 *)bstr, alen, true) == alen;
+}
+
+i32 ail_str_full_cmp_nocase(char *astr, u64 alen, char *bstr, u64 blen)
+{
+    u64 i = _ail_str_mismatch_((u8 *)astr, (u8 *)bstr, ail_min(alen, blen), true);
+    if (i < alen && i < blen) return (i32)_ail_str_lower_((u8)astr[i]) - (i32)_ail_str_lower_((u8)bstr[i]);
+    return (alen > blen) - (alen < blen);
+}
+
+b32 ail_str_starts_with_nocase(AIL_Str8 str, AIL_Str8 prefix)
+{
+    return prefix.len <= str.len && _ail_str_mismatch_(str.data, prefix.data, prefix.len, true) == prefix.len;
+}
+
+b32 ail_str_ends_with_nocase(AIL_Str8 str, AIL_Str8 suffix)
+{
+    return suffix.len <= str.len && _ail_str_mismatch_(str.data + str.len - suffix.len, suffix.data, suffix.len, true) == suffix.len;
+}
+
+// Candidates are filtered by the first and last byte of the needle like in _ail_str_find_, after converting both to lowercase
+i64 ail_str_find_nocase(AIL_Str8 str, AIL_Str8 needle)
+{
+    if (needle.len == 0)      return 0;
+    if (needle.len > str.len) return -1;
+    u64 m   = needle.len;
+    u64 end = str.len - m + 1;
+    u64 i   = 0;
+#if _AIL_STR_VEC_SIZE_
+    _ail_str_vec_ first = _ail_str_vec_splat_(_ail_str_lower_(needle.data[0]));
+    _ail_str_vec_ last  = _ail_str_vec_splat_(_ail_str_lower_(needle.data[m - 1]));
+    for (; i + _AIL_STR_VEC_SIZE_ <= end; i += _AIL_STR_VEC_SIZE_) {
+        _ail_str_vec_ f = _ail_str_vec_cmpeq_(_ail_str_vec_lower_(_ail_str_vec_load_(str.data + i)), first);
+        _ail_str_vec_ l = _ail_str_vec_cmpeq_(_ail_str_vec_lower_(_ail_str_vec_load_(str.data + i + m - 1)), last);
+        for (u64 mask = _ail_str_vec_mask_(_ail_str_vec_and_(f, l)); mask; mask &= mask - 1) {
+            u64 k = i + ail_ctz_u64(mask)/_AIL_STR_VEC_LANE_BITS_;
+            if (_ail_str_mismatch_(str.data + k, needle.data, m, true) == m) return (i64)k;
+        }
+    }
+#endif
+    for (; i < end; i++) {
+        if (_ail_str_mismatch_(str.data + i, needle.data, m, true) == m) return (i64)i;
+    }
+    return -1;
+}
+
+//////////////////////
+// Substring Search //
+//////////////////////
+
+// Needles are searched for with the SIMD filter described by Wojciech Muła (http://0x80.pl/articles/simd-strfind.html):
+// The first and last byte of the needle are compared against a whole vector of positions at once
+// and only positions at which both bytes match are verified.
+// Since lots of false positives (i.e. "aaa...ab" in "aaa...a") would make this O(n*m), the amount of verified bytes is tracked.
+// Once it exceeds a linear budget, the search falls back to the Two-Way algorithm (Crochemore & Perrin), which guarantees O(n+m)
+
+// Amount of bytes that may be verified per byte of the haystack before falling back to Two-Way
+#define _AIL_STR_FIND_BUDGET_(scanned) (4*(scanned) + 256)
+
+internal b32 _ail_str_mem_eq_(u8 *a, u8 *b, u64 n)
+{
+    for (u64 i = 0; i < n; i++) {
+        if (a[i] != b[i]) return false;
+    }
+    return true;
+}
+
+internal i64 _ail_str_find_byte_(u8 *p, u64 n, u8 c)
+{
+    u64 i = 0;
+#if _AIL_STR_VEC_SIZE_
+    _ail_str_vec_ v = _ail_str_vec_splat_(c);
+    for (; i + _AIL_STR_VEC_SIZE_ <= n; i += _AIL_STR_VEC_SIZE_) {
+        u64 mask = _ail_str_vec_mask_(_ail_str_vec_eq_(p + i, v));
+        if (mask) return (i64)(i + ail_ctz_u64(mask)/_AIL_STR_VEC_LANE_BITS_);
+    }
+#endif
+    for (; i < n; i++) {
+        if (p[i] == c) return (i64)i;
+    }
+    return -1;
+}
+
+internal i64 _ail_str_find_last_byte_(u8 *p, u64 n, u8 c)
+{
+    u64 end = n;
+#if _AIL_STR_VEC_SIZE_
+    _ail_str_vec_ v = _ail_str_vec_splat_(c);
+    for (; end >= _AIL_STR_VEC_SIZE_; end -= _AIL_STR_VEC_SIZE_) {
+        u64 mask = _ail_str_vec_mask_(_ail_str_vec_eq_(p + end - _AIL_STR_VEC_SIZE_, v));
+        if (mask) return (i64)(end - _AIL_STR_VEC_SIZE_ + (63 - ail_clz_u64(mask))/_AIL_STR_VEC_LANE_BITS_);
+    }
+#endif
+    while (end > 0) {
+        if (p[--end] == c) return (i64)end;
+    }
+    return -1;
+}
+
+// Computes the maximal suffix of `x` for either the normal or the inverted alphabetical order
+// `dir` is either 1 or -1, in which case `x` points at the last byte of the string and the reversed string is used
+internal i64 _ail_str_max_suffix_(u8 *x, i64 m, i64 dir, b32 inverted, i64 *period)
+{
+    i64 ms = -1, j = 0, k = 1, p = 1;
+    while (j + k < m) {
+        u8 a = x[dir*(j + k)];
+        u8 b = x[dir*(ms + k)];
+        if (inverted ? a > b : a < b) {
+            j += k;
+            k  = 1;
+            p  = j - ms;
+        } else if (a == b) {
+            if (k != p) {
+                k++;
+            } else {
+                j += p;
+                k  = 1;
+            }
+        } else {
+            ms = j;
+            j  = ms + 1;
+            k  = p = 1;
+        }
+    }
+    *period = p;
+    return ms;
+}
+
+// Two-Way string matching in O(n + m) time and O(1) space
+// Returns the first position of `needle` in `hay` or -1 if it isn't contained
+// If `dir` is -1, `hay` and `needle` point at their last bytes and both strings are searched in reverse,
+// in which case the returned position is relative to the reversed haystack
+internal i64 _ail_str_two_way_(u8 *hay, i64 n, u8 *needle, i64 m, i64 dir)
+{
+    if (m > n) return -1;
+    i64 p, q;
+    i64 i   = _ail_str_max_suffix_(needle, m, dir, false, &p);
+    i64 j   = _ail_str_max_suffix_(needle, m, dir, true,  &q);
+    i64 ell = i > j ? i : j;
+    i64 per = i > j ? p : q;
+
+    b32 periodic = true;
+    for (i64 k = 0; k <= ell && periodic; k++) periodic = needle[dir*k] == needle[dir*(k + per)];
+    if (periodic) {
+        i64 memory = -1;
+        for (j = 0; j <= n - m;) {
+            i = ail_max(ell, memory) + 1;
+            while (i < m && needle[dir*i] == hay[dir*(i + j)]) i++;
+            if (i >= m) {
+                i = ell;
+                while (i > memory && needle[dir*i] == hay[dir*(i + j)]) i--;
+                if (i <= memory) return j;
+                j     += per;
+                memory = m - per - 1;
+            } else {
+                j     += i - ell;
+                memory = -1;
+            }
+        }
+    } else {
+        per = ail_max(ell + 1, m - ell - 1) + 1;
+        for (j = 0; j <= n - m;) {
+            i = ell + 1;
+            while (i < m && needle[dir*i] == hay[dir*(i + j)]) i++;
+            if (i >= m) {
+                i = ell;
+                while (i >= 0 && needle[dir*i] == hay[dir*(i + j)]) i--;
+                if (i < 0) return j;
+                j += per;
+            } else {
+                j += i - ell;
+            }
+        }
+    }
+    return -1;
+}
+
+internal i64 _ail_str_find_(u8 *hay, u64 n, u8 *needle, u64 m)
+{
+    if (m == 0) return 0;
+    if (m > n)  return -1;
+    if (m == 1) return _ail_str_find_byte_(hay, n, needle[0]);
+    u64 start = 0;
+#if _AIL_STR_VEC_SIZE_
+    u64 verified = 0;
+    b32 fallback = false;
+    _ail_str_vec_ first = _ail_str_vec_splat_(needle[0]);
+    _ail_str_vec_ last  = _ail_str_vec_splat_(needle[m - 1]);
+    for (; !fallback && start + m - 1 + _AIL_STR_VEC_SIZE_ <= n; start += _AIL_STR_VEC_SIZE_) {
+        u64 mask = _ail_str_vec_mask_(_ail_str_vec_and_(_ail_str_vec_eq_(hay + start, first), _ail_str_vec_eq_(hay + start + m - 1, last)));
+        while (mask) {
+            u64 k = start + ail_ctz_u64(mask)/_AIL_STR_VEC_LANE_BITS_;
+            if (_ail_str_mem_eq_(hay + k + 1, needle + 1, m - 2)) return (i64)k;
+            verified += m;
+            if (verified > _AIL_STR_FIND_BUDGET_(k)) {
+                fallback = true;
+                start    = k + 1 - _AIL_STR_VEC_SIZE_; // Undoes the increment at the end of the loop
+                break;
+            }
+            mask &= mask - 1;
+        }
+    }
+#endif
+    // Positions that were not yet checked are searched for with Two-Way
+    i64 res = _ail_str_two_way_(hay + start, (i64)(n - start), needle, (i64)m, 1);
+    return res < 0 ? -1 : (i64)start + res;
+}
+
+// State for finding all non-overlapping matches of a needle from left to right in a single scan
+// Unlike calling _ail_str_find_ for every match, the candidates of the current block are kept between matches,
+// so that the haystack is only read once, no matter how many matches it contains
+typedef struct _AIL_Str_Find_Scan_ {
+    u8  *hay;
+    u8  *needle;
+    u64  n;
+    u64  m;
+    u64  pos;        // All matches before `pos` were already returned
+    u64  next_block; // Start of the next block, whose candidates weren't computed yet
+    u64  mask;       // Candidates of the current block, that weren't verified yet
+    u64  block;
+    u64  verified;
+    b32  fallback;   // Whether the remaining haystack is searched with _ail_str_find_ instead
+} _AIL_Str_Find_Scan_;
+
+internal _AIL_Str_Find_Scan_ _ail_str_find_scan_new_(u8 *hay, u64 n, u8 *needle, u64 m)
+{
+    // Single-byte needles are already found by a single vectorized pass in _ail_str_find_byte_
+    return (_AIL_Str_Find_Scan_) { .hay = hay, .needle = needle, .n = n, .m = m, .fallback = !_AIL_STR_VEC_SIZE_ || m < 2 };
+}
+
+// Returns the index of the next match or -1 if there is none
+// @Note: The needle must not be empty
+internal i64 _ail_str_find_scan_next_(_AIL_Str_Find_Scan_ *s)
+{
+    u64 m = s->m;
+#if _AIL_STR_VEC_SIZE_
+    if (!s->fallback) {
+        _ail_str_vec_ first = _ail_str_vec_splat_(s->needle[0]);
+        _ail_str_vec_ last  = _ail_str_vec_splat_(s->needle[m - 1]);
+        for (;;) {
+            while (s->mask) {
+                u64 k = s->block + ail_ctz_u64(s->mask)/_AIL_STR_VEC_LANE_BITS_;
+                s->mask &= s->mask - 1;
+                if (k < s->pos) continue;
+                if (_ail_str_mem_eq_(s->hay + k + 1, s->needle + 1, m - 2)) {
+                    s->pos = k + m;
+                    return (i64)k;
+                }
+                s->verified += m;
+                if (s->verified > _AIL_STR_FIND_BUDGET_(k)) goto fallback;
+            }
+            u64 b = ail_max(s->next_block, s->pos);
+            if (b + m - 1 + _AIL_STR_VEC_SIZE_ > s->n) break;
+            s->mask       = _ail_str_vec_mask_(_ail_str_vec_and_(_ail_str_vec_eq_(s->hay + b, first), _ail_str_vec_eq_(s->hay + b + m - 1, last)));
+            s->block      = b;
+            s->next_block = b + _AIL_STR_VEC_SIZE_;
+        }
+fallback:
+        // Every position before `pos` was already checked (see the loop above), so the rest is searched from there on
+        s->fallback = true;
+    }
+#endif
+    if (s->pos + m > s->n) return -1;
+    i64 res = _ail_str_find_(s->hay + s->pos, s->n - s->pos, s->needle, m);
+    if (res < 0) {
+        s->pos = s->n;
+        return -1;
+    }
+    res   += (i64)s->pos;
+    s->pos = (u64)res + m;
+    return res;
+}
+
+internal i64 _ail_str_find_last_(u8 *hay, u64 n, u8 *needle, u64 m)
+{
+    if (m == 0) return (i64)n;
+    if (m > n)  return -1;
+    if (m == 1) return _ail_str_find_last_byte_(hay, n, needle[0]);
+    u64 end = n - m + 1; // All positions in [0, end) still need to be checked
+#if _AIL_STR_VEC_SIZE_
+    u64 verified = 0;
+    b32 fallback = false;
+    _ail_str_vec_ first = _ail_str_vec_splat_(needle[0]);
+    _ail_str_vec_ last  = _ail_str_vec_splat_(needle[m - 1]);
+    for (; !fallback && end >= _AIL_STR_VEC_SIZE_; end -= _AIL_STR_VEC_SIZE_) {
+        u64 start = end - _AIL_STR_VEC_SIZE_;
+        u64 mask  = _ail_str_vec_mask_(_ail_str_vec_and_(_ail_str_vec_eq_(hay + start, first), _ail_str_vec_eq_(hay + start + m - 1, last)));
+        while (mask) {
+            u32 bit = 63 - ail_clz_u64(mask);
+            u64 k   = start + bit/_AIL_STR_VEC_LANE_BITS_;
+            if (_ail_str_mem_eq_(hay + k + 1, needle + 1, m - 2)) return (i64)k;
+            verified += m;
+            if (verified > _AIL_STR_FIND_BUDGET_(n - k)) {
+                fallback = true;
+                end      = k + _AIL_STR_VEC_SIZE_; // Undoes the decrement at the end of the loop
+                break;
+            }
+            mask &= ~(1ULL << bit);
+        }
+    }
+#endif
+    u64 len = end + m - 1;
+    i64 res = _ail_str_two_way_(hay + len - 1, (i64)len, needle + m - 1, (i64)m, -1);
+    return res < 0 ? -1 : (i64)(len - m) - res;
+}
+
+b32 ail_str_contains(AIL_Str8 str, AIL_Str8 needle)
+{
+    return _ail_str_find_(str.data, str.len, needle.data, needle.len) >= 0;
+}
+
+b32 ail_str_contains_char(AIL_Str8 str, char needle)
+{
+    return _ail_str_find_byte_(str.data, str.len, (u8)needle) >= 0;
+}
+
+i64 ail_str_find(AIL_Str8 str, AIL_Str8 needle)
+{
+    return _ail_str_find_(str.data, str.len, needle.data, needle.len);
+}
+
+i64 ail_str_find_last(AIL_Str8 str, AIL_Str8 needle)
+{
+    return _ail_str_find_last_(str.data, str.len, needle.data, needle.len);
+}
+
+AIL_Str_Find_Of_Res ail_str_find_of(AIL_Str8 str, AIL_Str8 *needles, i32 needles_count)
+{
+    // Each needle only needs to be searched for in the part of `str` that would lead to an earlier match
+    AIL_Str_Find_Of_Res res = { -1, -1 };
+    if (!str.len) return res; // Like every other needle, empty needles are only found at the indices of `str`
+    for (i32 j = 0; j < needles_count && res.str_idx != 0; j++) {
+        u64 len = res.str_idx < 0 ? str.len : ail_min(str.len, (u64)res.str_idx - 1 + needles[j].len);
+        i64 idx = _ail_str_find_(str.data, len, needles[j].data, needles[j].len);
+        if (idx >= 0) res = (AIL_Str_Find_Of_Res){ .str_idx = idx, .needle_idx = j };
+    }
+    return res;
+}
+
+AIL_Str_Find_Of_Res ail_str_find_last_of(AIL_Str8 str, AIL_Str8 *needles, i32 needles_count)
+{
+    AIL_Str_Find_Of_Res res = { -1, -1 };
+    for (i32 j = 0; j < needles_count; j++) {
+        u64 start = (u64)(res.str_idx + 1);
+        if (start >= str.len) break;
+        i64 idx = _ail_str_find_last_(str.data + start, str.len - start, needles[j].data, needles[j].len);
+        if (!needles[j].len) idx = (i64)(str.len - start) - 1; // Empty needles are found at the last index of `str`, not behind it
+        if (idx >= 0) res = (AIL_Str_Find_Of_Res){ .str_idx = (i64)start + idx, .needle_idx = j };
+    }
+    return res;
+}
+
+i64 ail_str_find_char(AIL_Str8 str, char needle)
+{
+    return _ail_str_find_byte_(str.data, str.len, (u8)needle);
+}
+
+i64 ail_str_find_last_char(AIL_Str8 str, char needle)
+{
+    return _ail_str_find_last_byte_(str.data, str.len, (u8)needle);
+}
+
+AIL_Str_Find_Of_Res ail_str_find_of_chars(AIL_Str8 str, char *needles, i32 needles_count)
+{
+    for (i64 i = 0; i < (i64)str.len; i++) {
+        char c = str.data[i];
+        for (i32 j = 0; j < needles_count; j++) {
+            if (c == needles[j]) return (AIL_Str_Find_Of_Res){ .str_idx = i, .needle_idx = j };
+        }
+    }
+    return (AIL_Str_Find_Of_Res){ -1, -1 };
+}
+
+AIL_Str_Find_Of_Res ail_str_find_last_of_chars(AIL_Str8 str, char *needles, i32 needles_count)
+{
+    for (i64 i = str.len - 1; i >= 0; i--) {
+        char c = str.data[i];
+        for (i32 j = 0; j < needles_count; j++) {
+            if (c == needles[j]) return (AIL_Str_Find_Of_Res){ .str_idx = i, .needle_idx = j };
+        }
+    }
+    return (AIL_Str_Find_Of_Res){ -1, -1 };
+}
+
+///////////////
+// Splitting //
+///////////////
+
+// Delimiters of single bytes are collected into a bitmask for 64 bytes at a time (see "Parsing Gigabytes of JSON per Second" by Langdale & Lemire)
+// Each token then only costs a count-trailing-zeros, while the input is only scanned once
+
+inline_func b32 _ail_str_split_is_delim_(u8 kind, u8 split_char, u8 c)
+{
+    if (kind == AIL_STR_SPLIT_WHITESPACE) return ail_str_is_space((char)c);
+    return c == split_char;
+}
+
+#if _AIL_STR_VEC_SIZE_
+inline_func _ail_str_vec_ _ail_str_split_vec_(u8 kind, _ail_str_vec_ split_char, u8 *p)
+{
+    if (kind != AIL_STR_SPLIT_WHITESPACE) return _ail_str_vec_eq_(p, split_char);
+    return _ail_str_vec_space_(p);
+}
+#endif
+
+// Bitmask of the delimiters in the first min(n, 64) bytes of `p`, where bit i is set if p[i] is a delimiter
+internal u64 _ail_str_split_mask_(u8 kind, u8 split_char, u8 *p, u64 n)
+{
+    u64 mask = 0;
+#if _AIL_STR_VEC_SIZE_
+    if (n >= 64) {
+        _ail_str_vec_ v = _ail_str_vec_splat_(split_char);
+#   if AIL_SIMD_NEON
+        // Without movemask, lanes are weighted by their bit and then summed up pairwise until one byte holds 8 lanes
+        static const u8 weights[16] = { 1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128 };
+        uint8x16_t w  = vld1q_u8(weights);
+        uint8x16_t s0 = vpaddq_u8(vandq_u8(_ail_str_split_vec_(kind, v, p +  0), w), vandq_u8(_ail_str_split_vec_(kind, v, p + 16), w));
+        uint8x16_t s1 = vpaddq_u8(vandq_u8(_ail_str_split_vec_(kind, v, p + 32), w), vandq_u8(_ail_str_split_vec_(kind, v, p + 48), w));
+        s0 = vpaddq_u8(s0, s1);
+        s0 = vpaddq_u8(s0, s0);
+        return vgetq_lane_u64(vreinterpretq_u64_u8(s0), 0);
+#   else
+        for (u32 k = 0; k < 64; k += _AIL_STR_VEC_SIZE_) mask |= _ail_str_vec_mask_(_ail_str_split_vec_(kind, v, p + k)) << k;
+        return mask;
+#   endif
+    }
+#endif
+    n = ail_min(n, 64);
+    for (u64 i = 0; i < n; i++) mask |= (u64)_ail_str_split_is_delim_(kind, split_char, p[i]) << i;
+    return mask;
+}
+
+// Index of the first delimiter in `p` or -1 if there is none
+internal i64 _ail_str_split_find_(u8 kind, u8 split_char, u8 *p, u64 n)
+{
+    if (kind != AIL_STR_SPLIT_WHITESPACE) return _ail_str_find_byte_(p, n, split_char);
+    for (u64 i = 0; i < n; i += 64) {
+        u64 mask = _ail_str_split_mask_(kind, split_char, p + i, n - i);
+        if (mask) return (i64)(i + ail_ctz_u64(mask));
+    }
+    return -1;
+}
+
+internal AIL_Str8 _ail_str_split_next_(AIL_Str8 *str, u8 kind, u8 split_char, b32 ignore_empty)
+{
+    AIL_Str8 res;
+    do {
+        i64 idx = _ail_str_split_find_(kind, split_char, str->data, str->len);
+        u64 end = idx < 0 ? str->len : (u64)idx;
+        res  = ail_str_from_parts(str->data, end);
+        *str = ail_str_offset(*str, end + 1);
+        if (kind == AIL_STR_SPLIT_LINES && res.len && res.data[res.len - 1] == '\r') res.len--;
+    } while (ignore_empty && !res.len && str->len);
+    return res;
+}
+
+AIL_Str8 ail_str_split_next_char(AIL_Str8 *str, char split_by, b32 ignore_empty)
+{
+    return _ail_str_split_next_(str, AIL_STR_SPLIT_CHAR, (u8)split_by, ignore_empty);
+}
+
+AIL_Str8 ail_str_split_next_line(AIL_Str8 *str, b32 ignore_empty)
+{
+    return _ail_str_split_next_(str, AIL_STR_SPLIT_LINES, '\n', ignore_empty);
+}
+
+AIL_Str8 ail_str_split_next_whitespace(AIL_Str8 *str, b32 ignore_empty)
+{
+    return _ail_str_split_next_(str, AIL_STR_SPLIT_WHITESPACE, 0, ignore_empty);
+}
+
+AIL_Str8 ail_str_split_next(AIL_Str8 *str, AIL_Str8 split_by, b32 ignore_empty)
+{
+    AIL_Str8 res;
+    do {
+        i64 idx = split_by.len ? _ail_str_find_(str->data, str->len, split_by.data, split_by.len) : -1;
+        u64 end = idx < 0 ? str->len : (u64)idx;
+        res  = ail_str_from_parts(str->data, end);
+        *str = ail_str_offset(*str, end + split_by.len);
+    } while (ignore_empty && !res.len && str->len);
+    return res;
+}
+
+internal AIL_Str_Split_Iter _ail_str_split_iter_new_(AIL_Str str, AIL_Str split_by, u8 split_char, AIL_Str_Split_Kind kind, b32 ignore_empty)
+{
+    AIL_Str_Split_Iter it = {
+        .str          = str,
+        .split_by     = split_by,
+        .split_char   = split_char,
+        .kind         = (u8)kind,
+        .ignore_empty = (u8)ignore_empty,
+    };
+    if (kind != AIL_STR_SPLIT_STR) it.mask = _ail_str_split_mask_(it.kind, split_char, str.data, str.len);
+    return it;
+}
+
+AIL_Str_Split_Iter ail_str_split_iter_char(AIL_Str str, char split_by, b32 ignore_empty)
+{
+    return _ail_str_split_iter_new_(str, ail_str_from_parts(NULL, 0), (u8)split_by, AIL_STR_SPLIT_CHAR, ignore_empty);
+}
+
+AIL_Str_Split_Iter ail_str_split_iter(AIL_Str str, AIL_Str split_by, b32 ignore_empty)
+{
+    return _ail_str_split_iter_new_(str, split_by, 0, AIL_STR_SPLIT_STR, ignore_empty);
+}
+
+AIL_Str_Split_Iter ail_str_split_iter_lines(AIL_Str str, b32 ignore_empty)
+{
+    return _ail_str_split_iter_new_(str, ail_str_from_parts(NULL, 0), '\n', AIL_STR_SPLIT_LINES, ignore_empty);
+}
+
+AIL_Str_Split_Iter ail_str_split_iter_whitespace(AIL_Str str, b32 ignore_empty)
+{
+    return _ail_str_split_iter_new_(str, ail_str_from_parts(NULL, 0), 0, AIL_STR_SPLIT_WHITESPACE, ignore_empty);
+}
+
+b32 ail_str_split_iter_next(AIL_Str_Split_Iter *it, AIL_Str *token)
+{
+    // @Note: Once the last token was returned, `idx` is set past the end of the string
+    while (it->idx <= it->str.len) {
+        u64 end, next;
+        if (it->kind == AIL_STR_SPLIT_STR) {
+            i64 pos = it->split_by.len ? _ail_str_find_(it->str.data + it->idx, it->str.len - it->idx, it->split_by.data, it->split_by.len) : -1;
+            end  = pos < 0 ? it->str.len : it->idx + (u64)pos;
+            next = pos < 0 ? it->str.len + 1 : end + it->split_by.len;
+        } else {
+            while (!it->mask && it->block + 64 < it->str.len) {
+                it->block += 64;
+                it->mask   = _ail_str_split_mask_(it->kind, it->split_char, it->str.data + it->block, it->str.len - it->block);
+            }
+            end = it->mask ? it->block + ail_ctz_u64(it->mask) : it->str.len;
+            it->mask &= it->mask - 1;
+            next = end + 1;
+        }
+        AIL_Str res = ail_str_from_parts(it->str.data + it->idx, end - it->idx);
+        it->idx = next;
+        if (end == it->str.len && !res.len) break; // An empty string after the last delimiter is not a token
+        if (it->kind == AIL_STR_SPLIT_LINES && res.len && res.data[res.len - 1] == '\r') res.len--;
+        if (it->ignore_empty && !res.len) continue;
+        *token = res;
+        return true;
+    }
+    it->idx = it->str.len + 1;
+    return false;
+}
+
+internal AIL_DA(AIL_Str) _ail_str_split_collect_(AIL_Str_Split_Iter it, AIL_Allocator allocator)
+{
+    AIL_DA(AIL_Str) res = ail_da_new_with_alloc(AIL_Str, AIL_ARR_INIT_CAP, allocator);
+    ail_str_split_for_each(&it, token) ail_da_push(&res, token);
+    return res;
+}
+
+AIL_DA(AIL_Str) ail_str_split_char_a(AIL_Str str, char split_by, b32 ignore_empty, AIL_Allocator allocator)
+{
+    return _ail_str_split_collect_(ail_str_split_iter_char(str, split_by, ignore_empty), allocator);
+}
+
+AIL_DA(AIL_Str) ail_str_split_a(AIL_Str str, AIL_Str split_by, b32 ignore_empty, AIL_Allocator allocator)
+{
+    return _ail_str_split_collect_(ail_str_split_iter(str, split_by, ignore_empty), allocator);
+}
+
+AIL_DA(AIL_Str) ail_str_split_lines_a(AIL_Str str, b32 ignore_empty, AIL_Allocator allocator)
+{
+    return _ail_str_split_collect_(ail_str_split_iter_lines(str, ignore_empty), allocator);
+}
+
+AIL_DA(AIL_Str) ail_str_split_whitespace_a(AIL_Str str, b32 ignore_empty, AIL_Allocator allocator)
+{
+    return _ail_str_split_collect_(ail_str_split_iter_whitespace(str, ignore_empty), allocator);
+}
+
+AIL_Str ail_str_offset(AIL_Str str, u64 offset)
+{
+    if (AIL_UNLIKELY(offset >= str.len))
+        return ail_str_from_parts(str.data + str.len, 0);
+    else
+        return ail_str_from_parts(str.data + offset, str.len - offset);
+}
+
+b32 ail_str_is_space(char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+b32 ail_str_is_digit(char c)
+{
+    return (u8)(c - '0') < 10;
+}
+
+b32 ail_str_is_alpha(char c)
+{
+    return (u8)((c | 0x20) - 'a') < 26;
+}
+
+b32 ail_str_is_lower(char c)
+{
+    return (u8)(c - 'a') < 26;
+}
+
+b32 ail_str_is_upper(char c)
+{
+    return (u8)(c - 'A') < 26;
+}
+
+char ail_str_lower_char(char c)
+{
+    return (char)_ail_str_lower_((u8)c);
+}
+
+char ail_str_upper_char(char c)
+{
+    return (char)(c ^ (ail_str_is_lower(c) << 5));
+}
+
+// Index of the first byte in `p`, that isn't whitespace, or `n` if there is none
+internal u64 _ail_str_skip_space_(u8 *p, u64 n)
+{
+    u64 i = 0;
+#if _AIL_STR_VEC_SIZE_
+    for (; i + _AIL_STR_VEC_SIZE_ <= n; i += _AIL_STR_VEC_SIZE_) {
+        u64 mask = ~_ail_str_vec_mask_(_ail_str_vec_space_(p + i)) & _AIL_STR_VEC_FULL_MASK_;
+        if (mask) return i + ail_ctz_u64(mask)/_AIL_STR_VEC_LANE_BITS_;
+    }
+#endif
+    while (i < n && ail_str_is_space(p[i])) i++;
+    return i;
+}
+
+// One past the index of the last byte in `p`, that isn't whitespace, or 0 if there is none
+internal u64 _ail_str_skip_space_back_(u8 *p, u64 n)
+{
+#if _AIL_STR_VEC_SIZE_
+    for (; n >= _AIL_STR_VEC_SIZE_; n -= _AIL_STR_VEC_SIZE_) {
+        u64 mask = ~_ail_str_vec_mask_(_ail_str_vec_space_(p + n - _AIL_STR_VEC_SIZE_)) & _AIL_STR_VEC_FULL_MASK_;
+        if (mask) return n - _AIL_STR_VEC_SIZE_ + (63 - ail_clz_u64(mask))/_AIL_STR_VEC_LANE_BITS_ + 1;
+    }
+#endif
+    while (n > 0 && ail_str_is_space(p[n - 1])) n--;
+    return n;
+}
+
+AIL_Str ail_str_ltrim(AIL_Str str)
+{
+    if (str.len == 0) return str;
+    return ail_str_offset(str, _ail_str_skip_space_(str.data, str.len));
+}
+
+AIL_Str ail_str_rtrim(AIL_Str str)
+{
+    return ail_str_from_parts(str.data, _ail_str_skip_space_back_(str.data, str.len));
+}
+
+
+AIL_Str ail_str_trim(AIL_Str str)
+{
+    if (str.len == 0) return str;
+    u64 start = _ail_str_skip_space_(str.data, str.len);
+    if (start == str.len) return (AIL_Str) {0};
+    u64 end = start + _ail_str_skip_space_back_(str.data + start, str.len - start);
+    return ail_str_from_parts(&str.data[start], end - start);
+}
+
+AIL_Str ail_str_join_a(AIL_Str *list, u64 n, AIL_Str joiner, AIL_Allocator allocator)
+{
+    if (n == 0) return (AIL_Str) {0};
+    u64 res_len = joiner.len*(n - 1);
+    for (u64 i = 0; i < n; i++) res_len += list[i].len;
     u8 *res = ail_call_alloc(allocator, res_len + 1);
     for (u64 i = 0, j = 0; i < n; i++) {
         memcpy(&res[j], list[i].data, list[i].len);
@@ -901,14 +3236,12 @@ AIL_Str ail_str_rev_join_a(AIL_Str *list, u64 n, AIL_Str joiner, AIL_Allocator a
     u64 res_len = joiner.len*(n - 1);
     for (u64 i = 0; i < n; i++) res_len += list[i].len;
     u8 *res = ail_call_alloc(allocator, res_len + 1);
-    for (u64 i = n-1, j = res_len; i > 0; i--) {
-        u64 el_len = list[i].len;
-        memcpy(&res[j - el_len], list[i].data, el_len);
-        j -= el_len;
+    for (u64 i = n, j = 0; i > 0; i--) {
+        memcpy(&res[j], list[i - 1].data, list[i - 1].len);
+        j += list[i - 1].len;
         if (i > 1) {
-            el_len = joiner.len;
-            memcpy(&res[j - el_len], joiner.data, el_len);
-            j -= el_len;
+            memcpy(&res[j], joiner.data, joiner.len);
+            j += joiner.len;
         }
     }
     res[res_len] = 0;
@@ -990,12 +3323,60 @@ AIL_Str ail_str_concat_a(AIL_Allocator allocator, u32 str_count, ...)
     return ail_str_from_parts(s, filled_count);
 }
 
+// Amount of matches that are remembered on the stack while computing the size of a replacement's result
+// The matches are remembered, so that the string only needs to be scanned once. If there are more matches, they are moved to a temporary buffer
+#define _AIL_STR_REPLACE_BUF_ 256
+
+// Doubles the capacity of a buffer of remembered matches, which starts out as `stack_buf` before being moved to a temporary allocation
+internal void *_ail_str_replace_grow_buf_(void *buf, void *stack_buf, u64 *cap, u64 el_size, AIL_Allocator allocator)
+{
+    void *res;
+    if (buf == stack_buf) {
+        res = ail_call_alloc(allocator, 2*(*cap)*el_size);
+        memcpy(res, buf, (*cap)*el_size);
+    } else {
+        res = ail_call_realloc(allocator, buf, 2*(*cap)*el_size);
+    }
+    *cap *= 2;
+    return res;
+}
+
+// Copies a part of a replacement's result, where `src` may be NULL if `n` is 0 (e.g. for an empty string)
+internal void _ail_str_replace_copy_(u8 *dst, u8 *src, u64 n)
+{
+    if (n) memcpy(dst, src, n);
+}
+
 AIL_Str ail_str_replace_a(AIL_Str str, AIL_Str to_replace, AIL_Str replace_with, AIL_Allocator allocator)
 {
-    AIL_DA(AIL_Str) list = ail_str_split_a(str, to_replace, false, allocator);
-    AIL_Str out = ail_str_join_a(list.data, list.len, replace_with, allocator);
-    ail_da_free(&list);
-    return out;
+    u64  pos_buf[_AIL_STR_REPLACE_BUF_];
+    u64 *pos   = pos_buf;
+    u64  cap   = _AIL_STR_REPLACE_BUF_;
+    u64  count = 0;
+    // An empty `to_replace` isn't replaced anywhere, so that the result is just a (zero-terminated) copy of `str`
+    if (to_replace.len) {
+        _AIL_Str_Find_Scan_ scan = _ail_str_find_scan_new_(str.data, str.len, to_replace.data, to_replace.len);
+        for (i64 i; (i = _ail_str_find_scan_next_(&scan)) >= 0;) {
+            if (count == cap) pos = _ail_str_replace_grow_buf_(pos, pos_buf, &cap, sizeof(u64), allocator);
+            pos[count++] = (u64)i;
+        }
+    }
+
+    u64 res_len = str.len - count*to_replace.len + count*replace_with.len;
+    u8 *res = ail_call_alloc(allocator, res_len + 1);
+    u64 src = 0, dst = 0;
+    for (u64 k = 0; k < count; k++) {
+        _ail_str_replace_copy_(res + dst, str.data + src, pos[k] - src);
+        dst += pos[k] - src;
+        _ail_str_replace_copy_(res + dst, replace_with.data, replace_with.len);
+        dst += replace_with.len;
+        src  = pos[k] + to_replace.len;
+    }
+    _ail_str_replace_copy_(res + dst, str.data + src, str.len - src);
+    ail_assert(dst + str.len - src == res_len);
+    res[res_len] = 0;
+    if (pos != pos_buf) ail_call_free(allocator, pos);
+    return ail_str_from_parts(res, res_len);
 }
 
 AIL_WARN_POP
@@ -1,14 +1,494 @@
 /*
 *** Dealing with Directories ***
 *
+* Glob patterns can be expanded over a directory tree with an `AIL_FS_Glob`:
+  * `AIL_FS_Glob *g = ail_fs_glob_new(pattern, threads);`
+  * `if (g->failed) { ... }`                          // The pattern couldn't be compiled, see `g->err`
+  * `for (AIL_Str path; ail_fs_glob_next(g, &path);) { ... }`
+  * `ail_fs_glob_free(g);`
+*
+* The pattern is split at every '/' into one component per directory level, each of which is compiled once as a glob pattern (see ail_pm.h).
+* Besides the glob syntax of ail_pm.h, a component consisting only of "**" matches any amount of directory levels (including none).
+* The entries "." and ".." are only matched by components without any wildcards (e.g. in "./logs" or "../logs").
+* Patterns starting with '/' are expanded from the root directory, all other patterns from the current working directory.
+*
+* The walker keeps track of the set of components, that the path of each directory has matched so far, like an NFA does.
+* Directories, for which no component can match anymore, are never read, and components without any wildcards are looked up directly.
+* Directories are read by several threads (with getdents64 on Linux and readdir on other Unix systems), which share a stack of directories to read.
+* Matching paths are streamed to `ail_fs_glob_next` as soon as they are found, so they arrive in no particular order.
+* Once `AIL_FS_GLOB_MAX_RESULTS` paths are waiting to be taken by `ail_fs_glob_next`, the threads pause until some of them were taken.
+* Symbolic links are matched like files, but never followed, so cycles in the file system can't cause endless walks.
+* @Note: Walking directories is not implemented on Windows yet
 */
 
 #ifndef _AIL_DIR_H_
 #define _AIL_DIR_H_
 
 #include "../base/ail_base.h"
+#include "../base/ail_alloc.h"
+#include "../base/ail_str.h"
+#include "../pm/ail_pm.h"
 #include "ail_file.h"
 
-// @TODO
+// @Note: fstatat and getdents64 need the feature-test macros, that ail_base.h defines, so ail headers should be included before any system headers
+// If the includer chose stricter feature-test macros (at least _POSIX_C_SOURCE 200809L is required), directories are read with readdir instead
+
+#if AIL_OS_UNIX
+#include <pthread.h> // For pthread_create, pthread_mutex_t, pthread_cond_t
+#include <unistd.h>  // For sysconf
+#endif
+
+// Maximum amount of directory levels in a pattern for AIL_FS_Glob (at most 63)
+#ifndef AIL_FS_GLOB_MAX_COMPONENTS
+#define AIL_FS_GLOB_MAX_COMPONENTS 63
+#endif
+#ifndef AIL_FS_GLOB_MAX_THREADS
+#define AIL_FS_GLOB_MAX_THREADS 64
+#endif
+// Amount of results that can be queued before the threads wait for ail_fs_glob_next
+// @Note: The results of a single directory are always queued together, so the queue can be longer by that amount
+#ifndef AIL_FS_GLOB_MAX_RESULTS
+#define AIL_FS_GLOB_MAX_RESULTS 4096
+#endif
+
+typedef struct AIL_FS_Glob_Component {
+    AIL_PM_Pattern pattern; // Glob pattern anchored at both ends, which has to match the whole name of a file or directory
+    const char *literal;    // Points into the pattern, if the component has no wildcards, NULL otherwise
+    u32  literal_len;
+    b32  any_dirs;          // Whether the component is "**"
+} AIL_FS_Glob_Component;
+
+// A directory that still needs to be read or a path that matched the pattern
+typedef struct AIL_FS_Glob_Item {
+    struct AIL_FS_Glob_Item *next;
+    u64  active;            // Set of components, that the next level below the directory can match (see _ail_fs_glob_closure_)
+    AIL_FS_Entry_Type type;
+    u32  len;
+    char path[];
+} AIL_FS_Glob_Item;
+
+typedef struct AIL_FS_Glob {
+    AIL_FS_Glob_Component *components;
+    u32  components_count;
+    b32  failed;
+    AIL_PM_Err err;         // Error of compiling the pattern, where `idx` is relative to the whole pattern (AIL_PM_ERR_TOO_MANY_LEVELS if it has more than AIL_FS_GLOB_MAX_COMPONENTS)
+    AIL_FS_Glob_Item *work; // Stack of directories, that still need to be read
+    AIL_FS_Glob_Item *results_head;
+    AIL_FS_Glob_Item *results_tail;
+    u32  results_count;
+    AIL_FS_Glob_Item *last; // Result that was returned last and is freed on the next call to ail_fs_glob_next
+    u32  busy;              // Amount of threads currently reading a directory
+    u32  running;           // Amount of threads that didn't finish yet
+    b32  stop;
+    u32  threads_count;
+    AIL_PM_DFA *dfas;       // Only used if no thread could be created, in which case ail_fs_glob_next walks the directories itself
+#if AIL_OS_UNIX
+    pthread_t       threads[AIL_FS_GLOB_MAX_THREADS];
+    pthread_mutex_t lock;
+    pthread_cond_t  work_cond;
+    pthread_cond_t  results_cond;
+    pthread_cond_t  space_cond; // Signaled whenever ail_fs_glob_next takes a result and the queue isn't full anymore
+#endif
+    AIL_Allocator allocator;
+} AIL_FS_Glob;
+
+// If `threads` is 0, one thread per CPU core is used
+// If no thread can be created, ail_fs_glob_next walks the directories on the calling thread instead
+// @Important: Since the threads allocate paths concurrently, `allocator` needs to be thread-safe
+// @Note: The walker is always allocated, so it needs to be freed with ail_fs_glob_free even if compiling the pattern failed
+internal AIL_FS_Glob *ail_fs_glob_new_a(const char *pattern, u32 threads, AIL_Allocator allocator);
+// Waits for the next path matching the pattern, returns false once the whole tree was walked
+// @Note: `path` is zero-terminated and stays valid until the next call
+internal b32          ail_fs_glob_next(AIL_FS_Glob *g, AIL_Str *path);
+// Stops the walk, if it isn't finished yet
+internal void         ail_fs_glob_free(AIL_FS_Glob *g);
+#define ail_fs_glob_new(pattern, threads) ail_fs_glob_new_a(pattern, threads, ail_default_allocator)
 
 #endif // _AIL_DIR_H_
+
+
+#if !defined(AIL_NO_FS_IMPL) && !defined(AIL_NO_IMPL)
+#ifndef _AIL_DIR_IMPL_GUARD_
+#define _AIL_DIR_IMPL_GUARD_
+AIL_WARN_PUSH
+AIL_WARN_DISABLE(AIL_WARN_UNUSED_FUNCTION)
+
+// glibc only declares syscall with _DEFAULT_SOURCE
+#if AIL_OS_LINUX && (defined(_DEFAULT_SOURCE) || defined(_GNU_SOURCE))
+#   define _AIL_FS_GLOB_GETDENTS_ 1
+#   include <sys/syscall.h> // For SYS_getdents64
+#else
+#   define _AIL_FS_GLOB_GETDENTS_ 0
+#endif
+
+// Adds every component after a "**", since "**" can also match no directory at all
+internal u64 _ail_fs_glob_closure_(AIL_FS_Glob *g, u64 active)
+{
+    for (u32 k = 0; k < g->components_count; k++) {
+        if (((active >> k) & 1) && g->components[k].any_dirs) active |= 1ULL << (k + 1);
+    }
+    return active;
+}
+
+// Get the set of components, that the level below an entry called `name` can match, if the entry's level could match `active`
+// If the bit of `components_count` is set, the entry's path matches the whole pattern
+// "." and ".." are only matched by literal components, so that wildcards never walk back up the tree
+internal u64 _ail_fs_glob_step_(AIL_FS_Glob *g, AIL_PM_DFA *dfas, u64 active, const char *name, u32 len)
+{
+    b32 dots = name[0] == '.' && (len == 1 || (len == 2 && name[1] == '.'));
+    u64 next = 0;
+    for (u64 bits = active & ((1ULL << g->components_count) - 1); bits; bits &= bits - 1) {
+        u32 k = ail_ctz_u64(bits);
+        AIL_FS_Glob_Component *c = &g->components[k];
+        if (c->literal)       next |= (u64)(c->literal_len == len && memcmp(c->literal, name, len) == 0) << (k + 1);
+        else if (dots)        continue;
+        else if (c->any_dirs) next |= 1ULL << k;
+        else                  next |= (u64)ail_pm_dfa_matches(&dfas[k], name, len) << (k + 1);
+    }
+    return _ail_fs_glob_closure_(g, next);
+}
+
+internal AIL_FS_Glob_Item *_ail_fs_glob_item_(AIL_FS_Glob *g, const char *dir, u32 dir_len, const char *name, u32 name_len, u64 active, AIL_FS_Entry_Type type)
+{
+    b32 sep = dir_len && dir[dir_len - 1] != '/';
+    u32 len = dir_len + sep + name_len;
+    AIL_FS_Glob_Item *item = ail_call_alloc(g->allocator, sizeof(AIL_FS_Glob_Item) + len + 1);
+    memcpy(item->path, dir, dir_len);
+    item->path[dir_len] = '/';
+    memcpy(item->path + dir_len + sep, name, name_len);
+    item->path[len] = 0;
+    item->len    = len;
+    item->active = active;
+    item->type   = type;
+    item->next   = NULL;
+    return item;
+}
+
+#if AIL_OS_UNIX
+// Directories and results found while reading a single directory, which are handed to the walker all at once
+typedef struct _AIL_FS_Glob_Batch_ {
+    AIL_FS_Glob_Item *work;
+    AIL_FS_Glob_Item *results_head;
+    AIL_FS_Glob_Item *results_tail;
+    u32 results_count;
+} _AIL_FS_Glob_Batch_;
+
+internal void _ail_fs_glob_entry_(AIL_FS_Glob *g, AIL_PM_DFA *dfas, AIL_FS_Glob_Item *dir, const char *name, u32 len, AIL_FS_Entry_Type type, _AIL_FS_Glob_Batch_ *batch)
+{
+    u64 next = _ail_fs_glob_step_(g, dfas, dir->active, name, len);
+    if ((next >> g->components_count) & 1) {
+        AIL_FS_Glob_Item *res = _ail_fs_glob_item_(g, dir->path, dir->len, name, len, 0, type);
+        if (batch->results_tail) batch->results_tail->next = res;
+        else                     batch->results_head = res;
+        batch->results_tail = res;
+        batch->results_count++;
+    }
+    // Directories are pruned, if no component can match any path below them
+    if (type == AIL_FS_ENTRY_DIR && (next & ((1ULL << g->components_count) - 1))) {
+        AIL_FS_Glob_Item *sub = _ail_fs_glob_item_(g, dir->path, dir->len, name, len, next, type);
+        sub->next   = batch->work;
+        batch->work = sub;
+    }
+}
+
+// Returns false, if the file doesn't exist
+internal b32 _ail_fs_glob_stat_type_(int dirfd, const char *name, AIL_FS_Entry_Type *type)
+{
+    struct stat st;
+    if (fstatat(dirfd, name, &st, AT_SYMLINK_NOFOLLOW)) return false;
+    if      (S_ISDIR(st.st_mode)) *type = AIL_FS_ENTRY_DIR;
+    else if (S_ISREG(st.st_mode)) *type = AIL_FS_ENTRY_FILE;
+    else                          *type = AIL_FS_ENTRY_OTHER;
+    return true;
+}
+
+internal void _ail_fs_glob_read_dir_(AIL_FS_Glob *g, AIL_PM_DFA *dfas, AIL_FS_Glob_Item *dir, _AIL_FS_Glob_Batch_ *batch)
+{
+    // If only a single component without wildcards can match, the directory doesn't need to be read
+    u64 pending = dir->active & ((1ULL << g->components_count) - 1);
+    if (ail_popcount_u64(pending) == 1) {
+        AIL_FS_Glob_Component *c = &g->components[ail_ctz_u64(pending)];
+        if (c->literal) {
+            AIL_FS_Glob_Item *path = _ail_fs_glob_item_(g, dir->path, dir->len, c->literal, c->literal_len, 0, AIL_FS_ENTRY_OTHER);
+            AIL_FS_Entry_Type type;
+            if (_ail_fs_glob_stat_type_(AT_FDCWD, path->path, &type)) _ail_fs_glob_entry_(g, dfas, dir, c->literal, c->literal_len, type, batch);
+            ail_call_free(g->allocator, path);
+            return;
+        }
+    }
+
+    const char *dirpath = dir->len ? dir->path : ".";
+#if _AIL_FS_GLOB_GETDENTS_
+    // The layout of the entries returned by getdents64 (see `man 2 getdents`)
+    typedef struct { u64 ino; i64 off; u16 reclen; u8 type; char name[]; } Linux_Dirent64;
+    enum { LINUX_DT_UNKNOWN = 0, LINUX_DT_DIR = 4, LINUX_DT_REG = 8 };
+    int fd = open(dirpath, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd < 0) return;
+    _Alignas(8) char buf[AIL_KB(32)];
+    for (long n; (n = syscall(SYS_getdents64, fd, buf, sizeof(buf))) > 0;) {
+        for (long off = 0; off < n;) {
+            Linux_Dirent64 *d = (Linux_Dirent64 *)(buf + off);
+            off += d->reclen;
+            AIL_FS_Entry_Type type;
+            switch (d->type) {
+                case LINUX_DT_DIR:     type = AIL_FS_ENTRY_DIR;  break;
+                case LINUX_DT_REG:     type = AIL_FS_ENTRY_FILE; break;
+                case LINUX_DT_UNKNOWN: if (!_ail_fs_glob_stat_type_(fd, d->name, &type)) continue; break;
+                default:               type = AIL_FS_ENTRY_OTHER; break;
+            }
+            _ail_fs_glob_entry_(g, dfas, dir, d->name, (u32)strlen(d->name), type, batch);
+        }
+    }
+    close(fd);
+#else
+    DIR *d = opendir(dirpath);
+    if (!d) return;
+    for (struct dirent *e; (e = readdir(d));) {
+        AIL_FS_Entry_Type type;
+#ifdef DT_REG
+        switch (e->d_type) {
+            case DT_DIR:     type = AIL_FS_ENTRY_DIR;  break;
+            case DT_REG:     type = AIL_FS_ENTRY_FILE; break;
+            case DT_UNKNOWN: if (!_ail_fs_glob_stat_type_(dirfd(d), e->d_name, &type)) continue; break;
+            default:         type = AIL_FS_ENTRY_OTHER; break;
+        }
+#else
+        // `d_type` is a BSD extension, which isn't available with strict feature-test macros
+        if (!_ail_fs_glob_stat_type_(dirfd(d), e->d_name, &type)) continue;
+#endif
+        _ail_fs_glob_entry_(g, dfas, dir, e->d_name, (u32)strlen(e->d_name), type, batch);
+    }
+    closedir(d);
+#endif
+}
+
+// The lazy DFAs are changed while matching, so every thread needs its own
+internal AIL_PM_DFA *_ail_fs_glob_dfas_new_(AIL_FS_Glob *g)
+{
+    AIL_PM_DFA *dfas = ail_call_calloc(g->allocator, g->components_count, sizeof(AIL_PM_DFA));
+    for (u32 k = 0; k < g->components_count; k++) {
+        AIL_FS_Glob_Component *c = &g->components[k];
+        if (!c->any_dirs && !c->literal) dfas[k] = ail_pm_dfa_new_a(c->pattern, g->allocator);
+    }
+    return dfas;
+}
+
+internal void _ail_fs_glob_dfas_free_(AIL_FS_Glob *g, AIL_PM_DFA *dfas)
+{
+    for (u32 k = 0; k < g->components_count; k++) {
+        if (!g->components[k].any_dirs && !g->components[k].literal) ail_pm_dfa_free(&dfas[k]);
+    }
+    ail_call_free(g->allocator, dfas);
+}
+
+// Adds the results and subdirectories found in one directory to the walker
+// @Note: Needs to be called with the lock held, if the walker uses threads
+internal void _ail_fs_glob_push_batch_(AIL_FS_Glob *g, _AIL_FS_Glob_Batch_ *batch)
+{
+    if (batch->results_head) {
+        if (g->results_tail) g->results_tail->next = batch->results_head;
+        else                 g->results_head = batch->results_head;
+        g->results_tail   = batch->results_tail;
+        g->results_count += batch->results_count;
+    }
+    while (batch->work) {
+        AIL_FS_Glob_Item *next = batch->work->next;
+        batch->work->next = g->work;
+        g->work     = batch->work;
+        batch->work = next;
+    }
+}
+
+internal void *_ail_fs_glob_thread_(void *arg)
+{
+    AIL_FS_Glob *g    = arg;
+    AIL_PM_DFA  *dfas = _ail_fs_glob_dfas_new_(g);
+    pthread_mutex_lock(&g->lock);
+    for (;;) {
+        while (!g->work && g->busy && !g->stop) pthread_cond_wait(&g->work_cond, &g->lock);
+        if (!g->work || g->stop) break;
+        AIL_FS_Glob_Item *dir = g->work;
+        g->work = dir->next;
+        g->busy++;
+        pthread_mutex_unlock(&g->lock);
+
+        _AIL_FS_Glob_Batch_ batch = {0};
+        _ail_fs_glob_read_dir_(g, dfas, dir, &batch);
+        ail_call_free(g->allocator, dir);
+
+        pthread_mutex_lock(&g->lock);
+        // The thread still counts as busy while waiting, so that the others don't finish before its directories were pushed
+        if (batch.results_head) {
+            while (g->results_count >= AIL_FS_GLOB_MAX_RESULTS && !g->stop) pthread_cond_wait(&g->space_cond, &g->lock);
+            pthread_cond_signal(&g->results_cond);
+        }
+        _ail_fs_glob_push_batch_(g, &batch);
+        g->busy--;
+        // Either there is new work or all threads might be done, so that waiting threads need to check again
+        pthread_cond_broadcast(&g->work_cond);
+    }
+    g->running--;
+    pthread_cond_broadcast(&g->work_cond);
+    pthread_cond_broadcast(&g->results_cond);
+    pthread_mutex_unlock(&g->lock);
+
+    _ail_fs_glob_dfas_free_(g, dfas);
+    return NULL;
+}
+#endif
+
+AIL_FS_Glob *ail_fs_glob_new_a(const char *pattern, u32 threads, AIL_Allocator allocator)
+{
+    AIL_FS_Glob *g = ail_call_calloc(allocator, 1, sizeof(AIL_FS_Glob));
+    g->allocator   = allocator;
+    u32 plen = (u32)strlen(pattern);
+    u32 start = pattern[0] == '/';
+    g->components = ail_call_calloc(allocator, AIL_FS_GLOB_MAX_COMPONENTS, sizeof(AIL_FS_Glob_Component));
+    for (u32 i = start; i < plen;) {
+        u32 end = i;
+        while (end < plen && pattern[end] != '/') end++;
+        if (end > i) {
+            if (g->components_count == AIL_FS_GLOB_MAX_COMPONENTS) {
+                g->failed = true;
+                g->err    = (AIL_PM_Err){ .type = AIL_PM_ERR_TOO_MANY_LEVELS, .idx = i };
+                return g;
+            }
+            AIL_FS_Glob_Component *c = &g->components[g->components_count];
+            b32 wildcards = false;
+            for (u32 j = i; j < end; j++) wildcards |= pattern[j] == '*' || pattern[j] == '?' || pattern[j] == '[' || pattern[j] == '\\';
+            if (end - i == 2 && pattern[i] == '*' && pattern[i + 1] == '*') {
+                // Several "**" in a row match the same as a single one
+                if (!g->components_count || !g->components[g->components_count - 1].any_dirs) {
+                    c->any_dirs = true;
+                    g->components_count++;
+                }
+            } else if (!wildcards) {
+                c->literal     = pattern + i;
+                c->literal_len = end - i;
+                g->components_count++;
+            } else {
+                AIL_PM_Comp_Res res = ail_pm_compile_a(pattern + i, end - i, AIL_PM_EXP_GLOB, allocator);
+                if (res.failed) {
+                    g->failed  = true;
+                    g->err     = res.err;
+                    g->err.idx += i;
+                    return g;
+                }
+                c->pattern = res.pattern;
+                c->pattern.attrs |= AIL_PM_ATTR_START | AIL_PM_ATTR_END;
+                g->components_count++;
+            }
+        }
+        i = end + 1;
+    }
+
+#if AIL_OS_UNIX
+    g->work = _ail_fs_glob_item_(g, "/", start, "", 0, _ail_fs_glob_closure_(g, 1), AIL_FS_ENTRY_DIR);
+    if (!g->components_count) return g;
+    if (!threads) {
+        long n = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = n > 0 ? (u32)n : 1;
+    }
+    threads = ail_min(threads, AIL_FS_GLOB_MAX_THREADS);
+    pthread_mutex_init(&g->lock, NULL);
+    pthread_cond_init(&g->work_cond, NULL);
+    pthread_cond_init(&g->results_cond, NULL);
+    pthread_cond_init(&g->space_cond, NULL);
+    // The threads can only start walking once they were all counted
+    pthread_mutex_lock(&g->lock);
+    for (u32 i = 0; i < threads; i++) {
+        if (pthread_create(&g->threads[g->threads_count], NULL, _ail_fs_glob_thread_, g) == 0) g->threads_count++;
+    }
+    g->running = g->threads_count;
+    pthread_mutex_unlock(&g->lock);
+    if (!g->threads_count) {
+        // Instead of failing, the tree is walked lazily by ail_fs_glob_next then
+        pthread_mutex_destroy(&g->lock);
+        pthread_cond_destroy(&g->work_cond);
+        pthread_cond_destroy(&g->results_cond);
+        pthread_cond_destroy(&g->space_cond);
+        g->dfas = _ail_fs_glob_dfas_new_(g);
+    }
+#else
+    AIL_UNUSED(threads);
+    AIL_TODO();
+#endif
+    return g;
+}
+
+b32 ail_fs_glob_next(AIL_FS_Glob *g, AIL_Str *path)
+{
+    if (g->last) {
+        ail_call_free(g->allocator, g->last);
+        g->last = NULL;
+    }
+#if AIL_OS_UNIX
+    if (g->dfas) {
+        while (!g->results_head && g->work) {
+            AIL_FS_Glob_Item *dir = g->work;
+            g->work = dir->next;
+            _AIL_FS_Glob_Batch_ batch = {0};
+            _ail_fs_glob_read_dir_(g, g->dfas, dir, &batch);
+            ail_call_free(g->allocator, dir);
+            _ail_fs_glob_push_batch_(g, &batch);
+        }
+        g->last = g->results_head;
+        if (g->last) {
+            g->results_head = g->last->next;
+            if (!g->results_head) g->results_tail = NULL;
+            g->results_count--;
+            *path = ail_str_from_parts((u8 *)g->last->path, g->last->len);
+        }
+        return g->last != NULL;
+    }
+    if (!g->threads_count) return false;
+    pthread_mutex_lock(&g->lock);
+    while (!g->results_head && g->running) pthread_cond_wait(&g->results_cond, &g->lock);
+    g->last = g->results_head;
+    if (g->last) {
+        g->results_head = g->last->next;
+        if (!g->results_head) g->results_tail = NULL;
+        if (--g->results_count < AIL_FS_GLOB_MAX_RESULTS) pthread_cond_signal(&g->space_cond);
+        *path = ail_str_from_parts((u8 *)g->last->path, g->last->len);
+    }
+    pthread_mutex_unlock(&g->lock);
+#endif
+    return g->last != NULL;
+}
+
+void ail_fs_glob_free(AIL_FS_Glob *g)
+{
+#if AIL_OS_UNIX
+    if (g->threads_count) {
+        pthread_mutex_lock(&g->lock);
+        g->stop = true;
+        pthread_cond_broadcast(&g->work_cond);
+        pthread_cond_broadcast(&g->space_cond);
+        pthread_mutex_unlock(&g->lock);
+        for (u32 i = 0; i < g->threads_count; i++) pthread_join(g->threads[i], NULL);
+        pthread_mutex_destroy(&g->lock);
+        pthread_cond_destroy(&g->work_cond);
+        pthread_cond_destroy(&g->results_cond);
+        pthread_cond_destroy(&g->space_cond);
+    }
+    if (g->dfas) _ail_fs_glob_dfas_free_(g, g->dfas);
+#endif
+    // The last result still links to the remaining results, so it can't be freed as part of a list
+    if (g->last) ail_call_free(g->allocator, g->last);
+    AIL_FS_Glob_Item *lists[] = { g->work, g->results_head };
+    for (u32 i = 0; i < ail_arrlen(lists); i++) {
+        for (AIL_FS_Glob_Item *item = lists[i], *next; item; item = next) {
+            next = item->next;
+            ail_call_free(g->allocator, item);
+        }
+    }
+    for (u32 k = 0; k < g->components_count; k++) {
+        if (g->components[k].pattern.els) ail_pm_free_a(g->components[k].pattern, g->allocator);
+    }
+    ail_call_free(g->allocator, g->components);
+    ail_call_free(g->allocator, g);
+}
+
+AIL_WARN_POP
+#endif // _AIL_DIR_IMPL_GUARD_
+#endif // AIL_NO_FS_IMPL
@@ -39,6 +39,7 @@ AIL_WARN_DISABLE(AIL_WARN_UNUSED_FUNCTION)
 #   define S_ISDIR(m) (((m) & S_IFMT) == S_IFDIR)
 #else
 #   include <dirent.h>
+#   include <unistd.h> // For read, write, close
 #endif
 
 ///////////////////
@@ -110,7 +111,10 @@ internal b32  ail_fs_write_file(const char *fpath, const char *buf, u64 size);
 // Miscellanous //
 //////////////////
 
-// @Important: Not yet implemented
+// Get the names of all regular files directly inside `dirpath`
+// @Note: Each name is allocated with the default allocator and needs to be freed by the caller
+// @Note: Needs fstatat, so if this header isn't included before any system header (see ail_base.h), _POSIX_C_SOURCE has to be at least 200809L
+// @Important: Not yet implemented on Windows
 internal AIL_DA(pchar) ail_fs_get_files_in_dir(const char *dirpath);
 
 inline_func b32 ail_fs_dir_exists(const char *dirpath);
@@ -201,6 +205,7 @@ void ail_fs_read_dir_deinit(AIL_FS_Read_Dir_Res dir)
 #if AIL_OS_WIN
     FindClose(dir.handle);
 #else
+    AIL_UNUSED(dir);
     AIL_TODO();
 #endif
 }
@@ -222,7 +227,7 @@ b32 ail_fs_open_file(const char *fpath, u64 *file, b32 writeable)
     return true;
 #else
     u32 access = O_RDONLY;
-    if (writeable) access = O_RDWR;
+    if (writeable) access = O_RDWR | O_CREAT; // Same as OPEN_ALWAYS on Windows
     int fd = open(fpath, access, 0777);
     if (fd == -1) return false;
     *file = fd;
@@ -289,8 +294,8 @@ b32 ail_fs_read_n_bytes(u64 fd, void *buf, u64 maxN, u64 *actualN)
 b32 ail_fs_read_file(const char *fpath, void *buf, u64 maxN, u64 *actualN)
 {
     u64 file;
-    b32 res = ail_fs_open_file(fpath, &file, false);
-    if (res) res = ail_fs_read_n_bytes((u64)file, buf, maxN, actualN);
+    if (!ail_fs_open_file(fpath, &file, false)) return false;
+    b32 res = ail_fs_read_n_bytes((u64)file, buf, maxN, actualN);
     ail_fs_close_file(file);
     return res;
 }
@@ -363,8 +368,8 @@ b32 ail_fs_write_n_bytes(u64 fd, const char *buf, u64 size)
 b32 ail_fs_write_file(const char *fpath, const char *buf, u64 size)
 {
     u64 file;
-    b32 res = ail_fs_open_file(fpath, &file, true);
-    if (res) res = ail_fs_write_n_bytes((u64)file, buf, size);
+    if (!ail_fs_open_file(fpath, &file, true)) return false;
+    b32 res = ail_fs_write_n_bytes((u64)file, buf, size);
     ail_fs_close_file(file);
     return res;
 }
@@ -375,9 +380,35 @@ b32 ail_fs_write_file(const char *fpath, const char *buf, u64 size)
 
 AIL_DA(pchar) ail_fs_get_files_in_dir(const char *dirpath)
 {
-    AIL_UNUSED(dirpath);
     AIL_DA(pchar) files = ail_da_new_with_cap(pchar, 16);
+#if AIL_OS_WIN
+    AIL_UNUSED(dirpath);
     AIL_TODO();
+#else
+    DIR *d = opendir(dirpath);
+    if (!d) return files;
+    for (struct dirent *e; (e = readdir(d));) {
+#ifdef DT_REG
+        b32 is_file = e->d_type == DT_REG;
+        b32 unknown = e->d_type == DT_UNKNOWN;
+#else
+        // `d_type` is a BSD extension, which isn't available with strict feature-test macros
+        b32 is_file = false;
+        b32 unknown = true;
+#endif
+        if (unknown) {
+            struct stat st;
+            is_file = fstatat(dirfd(d), e->d_name, &st, AT_SYMLINK_NOFOLLOW) == 0 && S_ISREG(st.st_mode);
+        }
+        if (is_file) {
+            u64 len = strlen(e->d_name);
+            char *name = ail_call_alloc(files.allocator, len + 1);
+            memcpy(name, e->d_name, len + 1);
+            ail_da_push(&files, name);
+        }
+    }
+    closedir(d);
+#endif
     return files;
 }
 
@@ -1,15 +1,57 @@
 /*
 *** Random Number Generators ***
 *
+* Fast pseudo-random numbers, that are reproducible for a given seed, which makes them well suited for tests and benchmarks
+* @Important: None of these generators are cryptographically secure
+*
+* The xorshift64 generator (see https://www.jstatsoft.org/article/view/v008i14) can either be used with an explicit state:
+  * `u64 state = AIL_RAND_DEFAULT_SEED;`
+  * `u64 x = ail_rand_xorshift64(&state);`
+* or with the global state `ail_rand_state`:
+  * `ail_rand_seed(42);`
+  * `u64 x = ail_rand_u64();`
 */
 
 #ifndef _AIL_RAND_H_
 #define _AIL_RAND_H_
 
 #include "../base/ail_base.h"
-#include "../base/ail_base_math.h"
-#include "ail_math.h"
 
-// @TODO
+#define AIL_RAND_DEFAULT_SEED 0x2545F4914F6CDD1DULL
+
+// State of the generator used by ail_rand_u64 and ail_rand_seed
+global u64 ail_rand_state = AIL_RAND_DEFAULT_SEED;
+
+// @Note: `state` must never be 0, since the generator would only produce zeros afterwards
+inline_func u64  ail_rand_xorshift64(u64 *state);
+inline_func u64  ail_rand_u64(void);
+inline_func void ail_rand_seed(u64 seed);
 
 #endif // _AIL_RAND_H_
+
+
+#if !defined(AIL_NO_RAND_IMPL) && !defined(AIL_NO_IMPL)
+#ifndef _AIL_RAND_IMPL_GUARD_
+#define _AIL_RAND_IMPL_GUARD_
+
+u64 ail_rand_xorshift64(u64 *state)
+{
+    u64 x = *state;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    return *state = x;
+}
+
+u64 ail_rand_u64(void)
+{
+    return ail_rand_xorshift64(&ail_rand_state);
+}
+
+void ail_rand_seed(u64 seed)
+{
+    ail_rand_state = seed ? seed : AIL_RAND_DEFAULT_SEED;
+}
+
+#endif // _AIL_RAND_IMPL_GUARD_
+#endif // AIL_NO_RAND_IMPL
@@ -9,6 +9,58 @@
 * Then you can match strings against the pattern with `ail_pm_match_greedy` or `ail_pm_match_lazy`
 * @TODO: For now, lazy matching is not implemented yet
 *
+* `ail_pm_match_greedy` uses backtracking, which can take super-quadratic time for some patterns.
+* For untrusted patterns or inputs, a compiled pattern can be turned into an `AIL_PM_DFA` instead:
+  * `AIL_PM_DFA dfa = ail_pm_dfa_new(pattern);`
+  * `AIL_PM_Match m = ail_pm_dfa_match(&dfa, s, len);`
+  * `ail_pm_dfa_free(&dfa);`
+* The pattern is converted into an NFA, whose sets of states are turned into DFA states lazily while matching.
+* The DFA states are stored in a cache of at most AIL_PM_DFA_MAX_STATES states, which is flushed when it is full.
+* Every byte of the input is therefore looked at a constant amount of times, and no memory is allocated while matching.
+* The DFA finds the leftmost-longest non-empty match.
+*
+* On x86-64 Linux, the DFA of a hot pattern can additionally be compiled to machine code with `ail_pm_dfa_jit(&dfa)`.
+* All states of the DFA are computed upfront and every state becomes a block of code, which branches on the ranges of bytes leading to each next state.
+* This only works for patterns with at most AIL_PM_JIT_MAX_STATES states, which mostly holds for simple patterns.
+* If the DFA can't be compiled (or AIL_PM_JIT is 0 on this platform), `ail_pm_dfa_jit` returns false and the DFA keeps being interpreted.
+*
+* When compiling a pattern, the longest run of literal characters, that every match has to contain, is extracted from it
+* (or the rarest single character if there is no such run). Unanchored searches use the SIMD substring search from ail_str.h
+* to skip to the next occurrence of this literal, so that the matchers only run close to positions at which a match is possible.
+*
+* Many patterns can also be matched together in a single scan over the input with an `AIL_PM_Set`:
+  * `AIL_PM_Set set = ail_pm_set_new(patterns, count);`
+  * `i32 id = ail_pm_set_matches_any(&set, s, len);`             // Index of any matching pattern or -1
+  * `u32 n  = ail_pm_set_matches_all(&set, s, len, matched);`    // Sets the bit of every matching pattern in the AIL_Bitset `matched`
+  * `ail_pm_set_free(&set);`
+* The NFAs of all patterns are combined into one lazy DFA, so the cost per byte doesn't depend on the amount of patterns.
+*
+* Inputs, that aren't available all at once (e.g. when tailing logs or reading from sockets), can be scanned in chunks with an `AIL_PM_Stream`:
+  * `AIL_PM_Stream st = ail_pm_stream_new(pattern);`
+  * For every chunk: `ail_pm_stream_feed(&st, chunk, len); while (ail_pm_stream_next(&st, &end)) { ... }`
+  * At the end of the input: `if (ail_pm_stream_finish(&st, &end)) { ... }`
+  * `ail_pm_stream_free(&st);`
+* The stream reports the absolute offset after the last byte of every match, i.e. every position at which any match of the pattern ends.
+* Matches of patterns anchored at the end are only reported by `ail_pm_stream_finish`.
+* The chunks don't need to be kept around after they were scanned, since only the state of the DFA is carried over between them.
+*
+* All non-overlapping matches in a buffer of any size can be iterated over with `ail_pm_match_iter` and `ail_pm_match_iter_next`.
+* `ail_pm_find_all` collects all these matches as well, but splits large buffers into line-aligned chunks, which are matched in parallel
+* by several threads (with pthreads or the Windows API). The matches of all chunks are merged in order, so the result is the same as with the iterator.
+* Patterns, that can match line breaks, are matched by a single thread, since their matches could span several chunks.
+*
+* Programs, that compile the same pattern strings over and over (e.g. filters read from a config), can keep the compiled patterns in an `AIL_PM_Cache`:
+  * `AIL_PM_Cache cache = ail_pm_cache_new(capacity);`
+  * `AIL_PM_Comp_Res res = ail_pm_cache_compile(&cache, p, plen, type);` // Same as `ail_pm_compile`, but only compiles `p` on a cache miss
+  * `ail_pm_cache_free(&cache);`
+* The cache keeps the `capacity` most recently used patterns (and compilation errors) for every pair of pattern text and expression type.
+* They are stored in an arena, which is compacted once most of its memory belongs to evicted patterns.
+* Every lookup returns a copy of the cached pattern, which has to be freed with `ail_pm_free` as usual.
+* Lookups are protected by a mutex, so the same cache can be used by several threads.
+*
+* Every element of a compiled pattern stores the set of bytes it matches as a 256-bit bitmap, so that testing a byte is a single lookup.
+* Runs of bytes matched by repeated elements ('*' and '+') are skipped 16 or 32 bytes at a time with SIMD when available.
+*
 *  *** REGEX Support ***
 *  * '.'        Dot, matches any character
 *  * '^'        Start anchor, matches beginning of string
@@ -39,9 +91,40 @@
 #define _AIL_PM_H_
 
 #include "../base/ail_base.h"
+#include "../base/ail_base_math.h"
 #include "../base/ail_str.h"
 #include "../base/ail_arr.h"
 #include "../base/ail_alloc.h"
+#include "../base/ail_bitset.h"
+
+#if AIL_OS_WIN
+AIL_WARN_PUSH
+AIL_WARN_DISABLE(AIL_WARN_ALL)
+#include <Windows.h> // For CreateThread, WaitForSingleObject, SRWLOCK
+AIL_WARN_POP
+#   define _AIL_PM_THREADS_ 1
+    typedef SRWLOCK _AIL_PM_Mutex_;
+#   define _AIL_PM_MUTEX_INIT_       SRWLOCK_INIT
+#   define _ail_pm_mutex_lock_(m)    AcquireSRWLockExclusive(m)
+#   define _ail_pm_mutex_unlock_(m)  ReleaseSRWLockExclusive(m)
+#   define _ail_pm_mutex_deinit_(m)  AIL_UNUSED(m)
+#elif AIL_OS_UNIX
+#include <pthread.h> // For pthread_create, pthread_join, pthread_mutex_t
+#include <unistd.h>  // For sysconf
+#   define _AIL_PM_THREADS_ 1
+    typedef pthread_mutex_t _AIL_PM_Mutex_;
+#   define _AIL_PM_MUTEX_INIT_       PTHREAD_MUTEX_INITIALIZER
+#   define _ail_pm_mutex_lock_(m)    pthread_mutex_lock(m)
+#   define _ail_pm_mutex_unlock_(m)  pthread_mutex_unlock(m)
+#   define _ail_pm_mutex_deinit_(m)  pthread_mutex_destroy(m)
+#else
+#   define _AIL_PM_THREADS_ 0
+    typedef u8 _AIL_PM_Mutex_;
+#   define _AIL_PM_MUTEX_INIT_       0
+#   define _ail_pm_mutex_lock_(m)    AIL_UNUSED(m)
+#   define _ail_pm_mutex_unlock_(m)  AIL_UNUSED(m)
+#   define _ail_pm_mutex_deinit_(m)  AIL_UNUSED(m)
+#endif
 
 typedef enum AIL_PM_Exp_Type {
     AIL_PM_EXP_REGEX,
@@ -96,26 +179,15 @@ global const char *ail_pm_el_type_strs[] = {
     [AIL_PM_EL_COUNT]        = "",
 };
 
-typedef struct AIL_PM_Range {
-    char start;
-    char end;
-} AIL_PM_Range;
-AIL_DA_INIT(AIL_PM_Range);
-AIL_SA_INIT(AIL_PM_Range);
-
-// @Memory: This struct takes up much more space than neccessary rn (pack attributes together to improve this)
-// @Note: The implementation uses the assumption that the 0-value for AIL_PM_El means that exactly one non-inverted character with c=='\0'
-// @TODO: anonymous unions require C11, the rest of the ail libraries usually only require C99... is this a good enough reason to switch to C11?
+// @Note: The set of matched bytes is a bitmap, in which byte c is bit `(c >> 4) & 7` of `set[(c & 15) | ((c & 128) >> 3)]`
+// Splitting the bytes by their low nibble like this allows testing 16 or 32 bytes at once with byte shuffles (see _ail_pm_el_run)
+// The set already accounts for `inverted`, which is only kept to print the element
 typedef struct AIL_PM_El {
-    AIL_PM_El_Type type;
-    AIL_PM_Count_Type count;
-    b32 inverted;
-    union {
-        char c;
-        AIL_PM_Range r;
-        AIL_SA(char) cs;
-        AIL_SA(AIL_PM_Range) rs;
-    };
+    u8 set[32];
+    u8 type;     // AIL_PM_El_Type
+    u8 count;    // AIL_PM_Count_Type
+    u8 inverted;
+    u8 c;        // Only used by AIL_PM_EL_CHAR
 } AIL_PM_El;
 AIL_DA_INIT(AIL_PM_El);
 AIL_SA_INIT(AIL_PM_El);
@@ -130,10 +202,23 @@ global const char *ail_pm_attr_strs[] = {
     [AIL_PM_ATTR_END]   = "END",
 };
 
+#define AIL_PM_LITERAL_MAX       16
+#define AIL_PM_LITERAL_UNBOUNDED 0xffffffffu
+
+// A literal, that every match of a pattern contains at an offset of [min_off, max_off] bytes from the start of the match
+// If `len` is 0, the pattern doesn't contain any required literals
+typedef struct AIL_PM_Literal {
+    u8  data[AIL_PM_LITERAL_MAX];
+    u32 len;
+    u32 min_off;
+    u32 max_off; // AIL_PM_LITERAL_UNBOUNDED if the offset is unbounded (i.e. because of a '*' before the literal)
+} AIL_PM_Literal;
+
 typedef struct AIL_PM_Pattern {
     AIL_PM_El *els;
     u32 len;
     AIL_PM_Pattern_Attr attrs;
+    AIL_PM_Literal lit;
 } AIL_PM_Pattern;
 
 typedef enum AIL_PM_Err_Type {
@@ -150,6 +235,7 @@ typedef enum AIL_PM_Err_Type {
     AIL_PM_ERR_EMPTY_GROUP,
     AIL_PM_ERR_INCOMPLETE_RANGE,
     AIL_PM_ERR_INVALID_SPECIAL_CHAR,
+    AIL_PM_ERR_TOO_MANY_LEVELS, // Only used by AIL_FS_Glob (see ail_dir.h)
     AIL_PM_ERR_COUNT,
 } AIL_PM_Err_Type;
 global const char *ail_pm_err_type_strs[] = {
@@ -166,6 +252,7 @@ global const char *ail_pm_err_type_strs[] = {
     [AIL_PM_ERR_EMPTY_GROUP]             = "EMPTY_GROUP",
     [AIL_PM_ERR_INCOMPLETE_RANGE]        = "INCOMPLETE_RANGE",
     [AIL_PM_ERR_INVALID_SPECIAL_CHAR]    = "INVALID_SPECIAL_CHAR",
+    [AIL_PM_ERR_TOO_MANY_LEVELS]         = "TOO_MANY_LEVELS",
     [AIL_PM_ERR_COUNT]                   = "COUNT",
 };
 
@@ -200,6 +287,144 @@ typedef struct AIL_PM_Match {
     u32 len;
 } AIL_PM_Match;
 
+// Same as AIL_PM_Match, but for inputs larger than 4GB
+typedef struct AIL_PM_Match64 {
+    u64 idx;
+    u64 len;
+} AIL_PM_Match64;
+AIL_DA_INIT(AIL_PM_Match64);
+
+
+// Maximum amount of states in the cache of each lazily built DFA
+#ifndef AIL_PM_DFA_MAX_STATES
+#define AIL_PM_DFA_MAX_STATES 1024
+#endif
+
+// A DFA over the NFA of one or more patterns, whose states are only computed when they are first reached
+// Each NFA state corresponds to an element of a pattern, that still needs to be matched
+// The elements of each pattern are followed by an extra NFA state, which marks sets of states that were reached by a full match
+typedef struct AIL_PM_Lazy_DFA {
+    u32  nfa_len;
+    u32  words;          // Amount of u64 per set of NFA states
+    u64 *el_sets;        // 256-bit set of the bytes, that each element matches (empty for the accepting states)
+    u64 *on_match;       // Set of NFA states, that are reached after each element matched a byte
+    u64 *start;          // Set of NFA states at the start of the input
+    u64 *restart;        // Set of NFA states, that are added at every byte, so that new matches can start anywhere
+    u64 *accepts;        // Set of the accepting NFA states
+    b32  unanchored;     // Whether `restart` is used
+    u32  classes_count;
+    u8   classes[256];   // Equivalence class of each byte, where bytes in the same class are matched by the same elements
+    u32  states_count;
+    u32  table_cap;
+    u64 *states;         // Set of NFA states of each DFA state
+    u32 *table;          // Hash table of the DFA states, storing their index + 1
+    u32 *trans;          // Transitions stored as `state*classes_count + class` (see _AIL_PM_DFA_ACCEPT_ and _AIL_PM_DFA_DEAD_), 0 if not computed yet
+    u64 *scratch;
+    u32  flushes;
+} AIL_PM_Lazy_DFA;
+
+// Whether DFAs can be compiled to machine code (see ail_pm_dfa_jit)
+#if !defined(AIL_PM_JIT)
+#   if AIL_OS_LINUX && AIL_ARCH_X86 && AIL_64BIT
+#       define AIL_PM_JIT 1
+#   else
+#       define AIL_PM_JIT 0
+#   endif
+#endif
+// Maximum amount of states of a DFA, that is compiled to machine code
+#ifndef AIL_PM_JIT_MAX_STATES
+#define AIL_PM_JIT_MAX_STATES 128
+#endif
+// Maximum amount of byte ranges, that lead from a single state to other states, in a DFA that is compiled to machine code
+#ifndef AIL_PM_JIT_MAX_RANGES
+#define AIL_PM_JIT_MAX_RANGES 16
+#endif
+
+// Signature of a lazy DFA compiled to machine code, which runs it like _ail_pm_lazy_dfa_run_ does
+typedef i64 (*_AIL_PM_Jit_Fn_)(const u8 *s, u64 from, u64 to, AIL_PM_Literal *lit);
+
+typedef struct AIL_PM_DFA {
+    AIL_PM_Pattern_Attr attrs;
+    AIL_PM_Literal  lit;
+    AIL_PM_Lazy_DFA fwd;          // Finds the end of the first match
+    AIL_PM_Lazy_DFA fwd_anchored; // Finds the end of the longest match from a known start
+    AIL_PM_Lazy_DFA rev_anchored; // Finds the leftmost start of a match from a known end
+    _AIL_PM_Jit_Fn_ jit_fwd;      // Compiled code of each of the DFAs above or NULL, if the DFA wasn't compiled with ail_pm_dfa_jit
+    _AIL_PM_Jit_Fn_ jit_fwd_anchored;
+    _AIL_PM_Jit_Fn_ jit_rev_anchored;
+    u8 *jit_code;                 // Executable pages containing the compiled code
+    u64 jit_size;
+    AIL_Allocator   allocator;
+} AIL_PM_DFA;
+
+// A set of patterns, which are all matched together in a single scan over the input by one lazy DFA
+// Each pattern is identified by its index in the array, from which the set was created
+typedef struct AIL_PM_Set {
+    AIL_PM_Lazy_DFA dfa;
+    u32  count;
+    u32 *ids;            // Index of the pattern of every accepting NFA state
+    u64 *end_accepts;    // Accepting NFA states of patterns anchored at the end, which only count at the end of the input
+    u64 *found;
+    AIL_Allocator allocator;
+} AIL_PM_Set;
+
+// Iterator over all non-overlapping matches of a pattern in `s`
+typedef struct AIL_PM_Match_Iter {
+    AIL_PM_DFA *dfa;
+    const char *s;
+    u64 len;
+    u64 pos;             // Position after the previous match, from which the next match is searched
+} AIL_PM_Match_Iter;
+
+// State of a pattern being matched against an input, that is fed to it in chunks
+typedef struct AIL_PM_Stream {
+    AIL_PM_Lazy_DFA dfa;
+    AIL_PM_Pattern_Attr attrs;
+    const u8 *chunk;
+    u64  chunk_len;
+    u64  pos;            // Position of the next byte to scan in the current chunk
+    u64  offset;         // Absolute offset of the start of the current chunk
+    u32  state;
+    b32  accepted;       // Whether a match ended with the last scanned byte
+    b32  dead;           // Whether no more matches are possible (only for patterns anchored at the start)
+    AIL_Allocator allocator;
+} AIL_PM_Stream;
+
+// A cached pattern, whose text and elements are stored in the cache's arena
+typedef struct AIL_PM_Cache_Entry {
+    char *text;
+    u32   text_len;
+    u32   hash;
+    AIL_PM_Exp_Type type;
+    AIL_PM_Comp_Res res;
+    u32   prev;          // Index + 1 of the next more recently used entry, 0 if there is none
+    u32   next;          // Index + 1 of the next less recently used entry, 0 if there is none
+    u32   chain;         // Index + 1 of the next entry in the same bucket, 0 if there is none
+} AIL_PM_Cache_Entry;
+
+// Least-recently-used cache of compiled patterns
+typedef struct AIL_PM_Cache {
+    AIL_PM_Cache_Entry *entries;
+    u32 *buckets;        // Index + 1 of the first entry in each bucket of the hash table
+    u32  cap;
+    u32  count;
+    u32  buckets_count;
+    u32  head;           // Index + 1 of the most recently used entry
+    u32  tail;           // Index + 1 of the least recently used entry
+    AIL_Allocator arenas[2]; // The cached data is stored in arenas[cur] and copied into the other arena when compacting
+    u32  cur;
+    u64  arena_used;     // Bytes allocated in arenas[cur] since it was last cleared
+    u64  arena_live;     // Bytes allocated in arenas[cur] for entries, that weren't evicted yet
+    u64  hits;
+    u64  misses;
+    _AIL_PM_Mutex_ lock;
+    AIL_Allocator  allocator;
+} AIL_PM_Cache;
+
+// Size of the first region of each arena of an AIL_PM_Cache, after which the arena is compacted, if most of it belongs to evicted entries
+#ifndef AIL_PM_CACHE_ARENA_SIZE
+#define AIL_PM_CACHE_ARENA_SIZE AIL_MB(1)
+#endif
 
 global AIL_Allocator ail_pm_tmp_allocator;
 
@@ -229,10 +454,56 @@ internal AIL_PM_Match ail_pm_match_str  (AIL_PM_Pattern pattern, AIL_Str str);
 internal b32          ail_pm_matches_str(AIL_PM_Pattern pattern, AIL_Str str);
 #define ail_pm_compile_str(pattern, type) ail_pm_compile_str_a(pattern, type, ail_default_allocator)
 
+// The pattern is copied into the DFA, so it can be freed afterwards
+internal AIL_PM_DFA   ail_pm_dfa_new_a(AIL_PM_Pattern pattern, AIL_Allocator allocator);
+internal void         ail_pm_dfa_free(AIL_PM_DFA *dfa);
+internal AIL_PM_Match ail_pm_dfa_match(AIL_PM_DFA *dfa, const char *s, u32 len);
+internal b32          ail_pm_dfa_matches(AIL_PM_DFA *dfa, const char *s, u32 len);
+internal b32          ail_pm_dfa_jit(AIL_PM_DFA *dfa);
+#define ail_pm_dfa_new(pattern)             ail_pm_dfa_new_a(pattern, ail_default_allocator)
+#define ail_pm_dfa_match_str(dfaPtr, str)   ail_pm_dfa_match(dfaPtr, (char*)(str).data, (str).len)
+#define ail_pm_dfa_matches_str(dfaPtr, str) ail_pm_dfa_matches(dfaPtr, (char*)(str).data, (str).len)
+
+internal AIL_PM_Set ail_pm_set_new_a(AIL_PM_Pattern *patterns, u32 count, AIL_Allocator allocator);
+internal void       ail_pm_set_free(AIL_PM_Set *set);
+internal i32        ail_pm_set_matches_any(AIL_PM_Set *set, const char *s, u64 len);
+internal u32        ail_pm_set_matches_all(AIL_PM_Set *set, const char *s, u64 len, AIL_Bitset matched);
+#define ail_pm_set_new(patterns, count)        ail_pm_set_new_a(patterns, count, ail_default_allocator)
+#define ail_pm_set_matches_any_str(setPtr, str)         ail_pm_set_matches_any(setPtr, (char*)(str).data, (str).len)
+#define ail_pm_set_matches_all_str(setPtr, str, matched) ail_pm_set_matches_all(setPtr, (char*)(str).data, (str).len, matched)
+
+internal AIL_PM_Match_Iter      ail_pm_match_iter(AIL_PM_DFA *dfa, const char *s, u64 len);
+internal b32                    ail_pm_match_iter_next(AIL_PM_Match_Iter *it, AIL_PM_Match64 *match);
+internal AIL_DA(AIL_PM_Match64) ail_pm_find_all_a(AIL_PM_Pattern pattern, const char *s, u64 len, u32 threads, AIL_Allocator allocator);
+#define ail_pm_match_iter_str(dfaPtr, str)             ail_pm_match_iter(dfaPtr, (char*)(str).data, (str).len)
+#define ail_pm_find_all(pattern, s, len, threads)      ail_pm_find_all_a(pattern, s, len, threads, ail_default_allocator)
+#define ail_pm_find_all_str(pattern, str, threads)     ail_pm_find_all_a(pattern, (char*)(str).data, (str).len, threads, ail_default_allocator)
+
+internal AIL_PM_Cache    ail_pm_cache_new_a(u32 cap, AIL_Allocator allocator);
+internal void            ail_pm_cache_free(AIL_PM_Cache *cache);
+internal AIL_PM_Comp_Res ail_pm_cache_compile_a(AIL_PM_Cache *cache, const char *p, u32 plen, AIL_PM_Exp_Type type, AIL_Allocator allocator);
+#define ail_pm_cache_new(cap)                          ail_pm_cache_new_a(cap, ail_default_allocator)
+#define ail_pm_cache_compile(cachePtr, p, plen, type)  ail_pm_cache_compile_a(cachePtr, p, plen, type, ail_default_allocator)
+#define ail_pm_cache_compile_str(cachePtr, str, type)  ail_pm_cache_compile_a(cachePtr, (char*)(str).data, (str).len, type, ail_default_allocator)
+
+internal AIL_PM_Stream ail_pm_stream_new_a(AIL_PM_Pattern pattern, AIL_Allocator allocator);
+internal void          ail_pm_stream_free(AIL_PM_Stream *st);
+internal void          ail_pm_stream_feed(AIL_PM_Stream *st, const char *chunk, u64 len);
+internal b32           ail_pm_stream_next(AIL_PM_Stream *st, u64 *end);
+internal b32           ail_pm_stream_finish(AIL_PM_Stream *st, u64 *end);
+#define ail_pm_stream_new(pattern)              ail_pm_stream_new_a(pattern, ail_default_allocator)
+#define ail_pm_stream_feed_str(streamPtr, str)  ail_pm_stream_feed(streamPtr, (char*)(str).data, (str).len)
+
 internal AIL_PM_Comp_Char_Res _ail_pm_comp_range_char(const char *p, u32 plen, u32 *idx);
-internal AIL_PM_Comp_El_Res   _ail_pm_comp_range(const char *p, u32 plen, u32 *idx, AIL_Allocator allocator);
-internal b32 _ail_pm_match_el(AIL_PM_El el, char c);
+internal AIL_PM_Comp_El_Res   _ail_pm_comp_range(const char *p, u32 plen, u32 *idx);
+internal AIL_PM_El _ail_pm_el_char(u8 c);
+internal AIL_PM_El _ail_pm_el_class(AIL_PM_El_Type type, b32 inverted);
+inline_func b32 _ail_pm_match_el(const AIL_PM_El *el, u8 c);
+internal u32 _ail_pm_el_run(const AIL_PM_El *el, const u8 *s, u32 len);
+internal void _ail_pm_el_set(AIL_PM_El el, u64 set[4]);
 internal u32 _ail_pm_match_immediate_greedy(AIL_PM_El *els, u32 ellen, const char *s, u32 slen);
+internal AIL_PM_Literal _ail_pm_find_literal(AIL_PM_El *els, u32 len);
+internal u64 _ail_pm_skip_to_literal(AIL_PM_Literal *lit, const u8 *s, u64 len, u64 from, i64 *lit_pos);
 
 #endif // _AIL_PM_H_
 
@@ -282,29 +553,19 @@ u32 ail_pm_el_to_str(AIL_PM_El el, char *buf, u32 buflen)
             n += snprintf(buf + n, buflen - n, " %c", el.c);
             break;
         case AIL_PM_EL_RANGE:
-            n += snprintf(buf + n, buflen - n, " %c-%c", el.r.start, el.r.end);
-            break;
         case AIL_PM_EL_ONE_OF_CHAR:
-            ail_assert(el.cs.len > 0);
-            n += snprintf(buf + n, buflen - n, " %c", el.cs.data[0]);
-            for (u32 i = 1; i < el.cs.len; i++) {
-                n += snprintf(buf + n, buflen - n, " %c", el.cs.data[i]);
-            }
-            break;
-        case AIL_PM_EL_GROUP:
-            if (el.cs.len) {
-                n += snprintf(buf + n, buflen - n, " %c", el.cs.data[0]);
-                for (u32 i = 1; i < el.cs.len; i++) {
-                    n += snprintf(buf + n, buflen - n, "%c", el.cs.data[i]);
-                }
-            }
-            break;
         case AIL_PM_EL_ONE_OF_RANGE:
-            n += snprintf(buf + n, buflen - n, " %c-%c", el.rs.data[0].start, el.rs.data[0].end);
-            for (u32 i = 1; i < el.cs.len; i++) {
-                n += snprintf(buf + n, buflen - n, " %c-%c", el.rs.data[i].start, el.rs.data[i].end);
+            // Print the runs of characters in the (non-inverted) set
+            for (u32 c = 0; c < 256; c++) {
+                if (_ail_pm_match_el(&el, (u8)c) == (b32)el.inverted) continue;
+                u32 end = c;
+                while (end < 255 && _ail_pm_match_el(&el, (u8)(end + 1)) != (b32)el.inverted) end++;
+                if (end == c) n += snprintf(buf + n, buflen - n, " %c", c);
+                else          n += snprintf(buf + n, buflen - n, " %c-%c", c, end);
+                c = end;
             }
             break;
+        case AIL_PM_EL_GROUP:
         case AIL_PM_EL_ANY:
         case AIL_PM_EL_DIGIT:
         case AIL_PM_EL_ALPHA:
@@ -333,12 +594,41 @@ u32 ail_pm_pattern_to_str(AIL_PM_Pattern pattern, char *buf, u32 buflen)
     return n;
 }
 
+#define _AIL_PM_SET_IDX_(c) (((c) & 15) | (((c) & 128) >> 3))
+#define _AIL_PM_SET_BIT_(c) (1u << (((c) >> 4) & 7))
+
+AIL_PM_El _ail_pm_el_char(u8 c)
+{
+    AIL_PM_El el = { .type = AIL_PM_EL_CHAR, .c = c };
+    el.set[_AIL_PM_SET_IDX_(c)] = _AIL_PM_SET_BIT_(c);
+    return el;
+}
+
+AIL_PM_El _ail_pm_el_class(AIL_PM_El_Type type, b32 inverted)
+{
+    AIL_PM_El el = { .type = type, .inverted = inverted };
+    for (u32 c = 0; c < 256; c++) {
+        b32 in;
+        switch (type) {
+            case AIL_PM_EL_ANY:        in = c != '\n' && c != '\r'; break;
+            case AIL_PM_EL_DIGIT:      in = ail_str_is_digit(c); break;
+            case AIL_PM_EL_ALPHA:      in = ail_str_is_alpha(c); break;
+            case AIL_PM_EL_ALPHANUM:   in = ail_str_is_alpha(c) || ail_str_is_digit(c) || c == '_'; break;
+            case AIL_PM_EL_WHITESPACE: in = ail_str_is_space(c) || c == '\v' || c == '\f'; break;
+            default:                   AIL_UNREACHABLE(); in = false;
+        }
+        if (in != inverted) el.set[_AIL_PM_SET_IDX_(c)] |= _AIL_PM_SET_BIT_(c);
+    }
+    return el;
+}
+
 AIL_PM_Comp_Char_Res _ail_pm_comp_range_char(const char *p, u32 plen, u32 *idx)
 {
     AIL_PM_Comp_Char_Res res = {0};
     u32 i = *idx;
     if (p[i] == '\\') {
         if (++i >= plen) res.e = AIL_PM_ERR_INCOMPLETE_ESCAPE;
+        else             res.c = p[i];
     } else if (p[i] == '^' || p[i] == '-' || p[i] == '[') {
          res.e = AIL_PM_ERR_INVALID_SPECIAL_CHAR;
     } else {
@@ -348,165 +638,133 @@ AIL_PM_Comp_Char_Res _ail_pm_comp_range_char(const char *p, u32 plen, u32 *idx)
     return res;
 }
 
-AIL_PM_Comp_El_Res _ail_pm_comp_range(const char *p, u32 plen, u32 *idx, AIL_Allocator allocator)
+// Single characters and ranges can be mixed freely in a class, since they are all added to the element's set
+// `idx` is left at the closing bracket
+AIL_PM_Comp_El_Res _ail_pm_comp_range(const char *p, u32 plen, u32 *idx)
 {
-    u32 i = *idx;
+    u32 i = *idx + 1;
     AIL_PM_El el = {0};
-    if (++i >= plen || i+1 >= plen) goto missing_bracket;
-    if (p[i] == '^') {
+    if (i < plen && p[i] == '^') {
         el.inverted = 1;
         i++;
     }
+    // A closing bracket right at the start of the class is taken literally, if the class is closed later on
+    if (i >= plen || (p[i] == ']' && !memchr(p + i + 1, ']', plen - i - 1))) {
+        return (AIL_PM_Comp_El_Res){.failed=1, .err={.type=AIL_PM_ERR_INCOMPLETE_RANGE, .idx=i}};
+    }
 
-    if (p[i+1] == '-') {
-        AIL_DA(AIL_PM_Range) ranges = ail_da_new_with_alloc(AIL_PM_Range, 4, allocator);
-        for (; i < plen && p[i] != ']'; i += 3) {
-            AIL_PM_Err_Type err_type = AIL_PM_ERR_NONE;
-            AIL_PM_Range r;
-            AIL_PM_Comp_Char_Res x = _ail_pm_comp_range_char(p, plen, &i);
-            if (x.e) { err_type = x.e; goto report_err; }
-            r.start = x.c;
-
-            if (i+2 >= plen)   { err_type = AIL_PM_ERR_INCOMPLETE_RANGE;     goto report_err; }
-            if (p[++i] != '-') { err_type = AIL_PM_ERR_INVALID_RANGE_SYNTAX; goto report_err; }
-            ++i;
-
+    u32 chars = 0, ranges = 0;
+    for (u32 first = i; i < plen && (p[i] != ']' || i == first); i++) {
+        AIL_PM_Comp_Char_Res x = _ail_pm_comp_range_char(p, plen, &i);
+        if (x.e) return (AIL_PM_Comp_El_Res){.failed=1, .err={.type=x.e, .idx=i}};
+        u8 start = (u8)x.c, end = (u8)x.c;
+        if (i + 2 < plen && p[i+1] == '-' && p[i+2] != ']') {
+            i += 2;
             x = _ail_pm_comp_range_char(p, plen, &i);
-            if (x.e) { err_type = x.e; goto report_err; }
-            r.end = x.c;
-            if (r.end >= r.start) err_type = AIL_PM_ERR_INVALID_RANGE;
-
-report_err:
-            if (err_type) return (AIL_PM_Comp_El_Res){.failed=1, .err={.type=err_type, .idx=i}};
-            ail_da_push(&ranges, r);
-        }
-
-        if (ranges.len == 0) {
-            return (AIL_PM_Comp_El_Res){.failed=1, .err={.type=AIL_PM_ERR_EMPTY_GROUP, .idx=i-1}};
-        } else if (ranges.len == 1) {
-            el.type = AIL_PM_EL_RANGE;
-            el.r    = ranges.data[i];
-            ail_da_free(&ranges);
+            if (x.e)              return (AIL_PM_Comp_El_Res){.failed=1, .err={.type=x.e, .idx=i}};
+            if ((u8)x.c < start)  return (AIL_PM_Comp_El_Res){.failed=1, .err={.type=AIL_PM_ERR_INVALID_RANGE, .idx=i}};
+            end = (u8)x.c;
+            ranges++;
         } else {
-            el.type = AIL_PM_EL_ONE_OF_RANGE;
-            el.rs   = ail_sa_from_struct_t(AIL_PM_Range, ranges);
+            el.c = start;
+            chars++;
         }
+        for (u32 c = start; c <= end; c++) el.set[_AIL_PM_SET_IDX_(c)] |= _AIL_PM_SET_BIT_(c);
     }
-    else {
-        AIL_DA(char) chars = ail_da_new_with_alloc(char, 16, allocator);
-        for (; i < plen && p[i] != ']'; i++) {
-            AIL_PM_Comp_Char_Res x = _ail_pm_comp_range_char(p, plen, &i);
-            if (x.e) return (AIL_PM_Comp_El_Res) {.failed=1, .err={.type=x.e, .idx=i}};
-            ail_da_push(&chars, x.c);
-        }
+    if (i >= plen) return (AIL_PM_Comp_El_Res){.failed=1, .err={.type=AIL_PM_ERR_MISSING_BRACKET, .idx=i}};
 
-        if (chars.len == 0) {
-            return (AIL_PM_Comp_El_Res){.failed=1, .err={.type=AIL_PM_ERR_EMPTY_GROUP, .idx=i-1}};
-        } else if (chars.len == 1) {
-            el.type = AIL_PM_EL_CHAR;
-            el.c    = chars.data[i];
-            ail_da_free(&chars);
-        } else {
-            el.type = AIL_PM_EL_ONE_OF_CHAR;
-            el.cs   = ail_sa_from_struct_t(char, chars);
-        }
+    if (chars + ranges == 1) el.type = ranges ? AIL_PM_EL_RANGE : AIL_PM_EL_CHAR;
+    else                     el.type = ranges ? AIL_PM_EL_ONE_OF_RANGE : AIL_PM_EL_ONE_OF_CHAR;
+    if (el.inverted) {
+        for (u32 k = 0; k < sizeof(el.set); k++) el.set[k] = ~el.set[k];
     }
-
     *idx = i;
-    if (i < plen) { // No missing brackets
-        ail_assert(p[*idx++] == ']');
-        return (AIL_PM_Comp_El_Res){ .el = el };
-    }
-missing_bracket:
-    return (AIL_PM_Comp_El_Res){.failed=1, .err={.type=AIL_PM_ERR_MISSING_BRACKET, .idx=i}};
-
+    return (AIL_PM_Comp_El_Res){ .el = el };
 }
 
 AIL_PM_Comp_Res ail_pm_compile_a(const char *p, u32 plen, AIL_PM_Exp_Type exp_type, AIL_Allocator allocator)
 {
+    if (exp_type >= AIL_PM_EXP_COUNT) return (AIL_PM_Comp_Res){.failed=1, .err={.type=AIL_PM_ERR_UNKNOWN_EXP_TYPE}};
     AIL_DA(AIL_PM_El)   els   = ail_da_new_with_alloc(AIL_PM_El, 32, allocator);
     AIL_PM_Pattern_Attr attrs = 0;
-    if (exp_type >= AIL_PM_EXP_COUNT) return (AIL_PM_Comp_Res){.failed=1, .err={.type=AIL_PM_ERR_UNKNOWN_EXP_TYPE}};
+    AIL_PM_Err          err;
     for (u32 i = 0; i < plen; i++) {
         char c = p[i];
         switch (exp_type) {
             case AIL_PM_EXP_REGEX: switch (c) {
                 case '.':
-                    ail_da_push(&els, (AIL_PM_El){.type=AIL_PM_EL_ANY});
+                    ail_da_push(&els, _ail_pm_el_class(AIL_PM_EL_ANY, false));
                     break;
                 case '^':
-                    if (i > 0) return (AIL_PM_Comp_Res){.failed=1, .err={.type=AIL_PM_ERR_LATE_START_MARKER, .idx=i}};
+                    if (i > 0) { err = (AIL_PM_Err){.type=AIL_PM_ERR_LATE_START_MARKER, .idx=i}; goto failed; }
                     attrs |= AIL_PM_ATTR_START;
                     break;
                 case '$':
-                    if (i+1 < plen) return (AIL_PM_Comp_Res){.failed=1, .err={.type=AIL_PM_ERR_EARLY_END_MARKER, .idx=i}};
+                    if (i+1 < plen) { err = (AIL_PM_Err){.type=AIL_PM_ERR_EARLY_END_MARKER, .idx=i}; goto failed; }
                     attrs |= AIL_PM_ATTR_END;
                     break;
                 case '*':
-                    if (els.len == 0 || els.data[els.len-1].count) return (AIL_PM_Comp_Res){.failed=1, .err={.type=AIL_PM_ERR_INVALID_COUNT_QUALIFIER, .idx=i}};
+                    if (els.len == 0 || els.data[els.len-1].count) { err = (AIL_PM_Err){.type=AIL_PM_ERR_INVALID_COUNT_QUALIFIER, .idx=i}; goto failed; }
                     els.data[els.len-1].count = AIL_PM_COUNT_ZERO_PLUS;
                     break;
                 case '+':
-                    if (els.len == 0 || els.data[els.len-1].count) return (AIL_PM_Comp_Res){.failed=1, .err={.type=AIL_PM_ERR_INVALID_COUNT_QUALIFIER, .idx=i}};
+                    if (els.len == 0 || els.data[els.len-1].count) { err = (AIL_PM_Err){.type=AIL_PM_ERR_INVALID_COUNT_QUALIFIER, .idx=i}; goto failed; }
                     els.data[els.len-1].count = AIL_PM_COUNT_ONE_PLUS;
                     break;
                 case '?':
-                    if (els.len == 0 || els.data[els.len-1].count) return (AIL_PM_Comp_Res){.failed=1, .err={.type=AIL_PM_ERR_INVALID_COUNT_QUALIFIER, .idx=i}};
+                    if (els.len == 0 || els.data[els.len-1].count) { err = (AIL_PM_Err){.type=AIL_PM_ERR_INVALID_COUNT_QUALIFIER, .idx=i}; goto failed; }
                     els.data[els.len-1].count = AIL_PM_COUNT_ONE_OR_NONE;
                     break;
                 // case ']':
                 //     return (AIL_PM_Comp_Res){.failed=1, .err={.type=AIL_PM_ERR_INVALID_BRACKET, .idx=1}};
                 case '[': {
-                    AIL_PM_Comp_El_Res x = _ail_pm_comp_range(p, plen, &i, allocator);
-                    if (x.failed) return (AIL_PM_Comp_Res){.failed=1, .err=x.err};
+                    AIL_PM_Comp_El_Res x = _ail_pm_comp_range(p, plen, &i);
+                    if (x.failed) { err = x.err; goto failed; }
                     else ail_da_push(&els, x.el);
                 } break;
                 case '\\':
-                    if (i+1 == plen) return (AIL_PM_Comp_Res){.failed=1, .err={.type=AIL_PM_ERR_INCOMPLETE_ESCAPE, .idx=i}};
-                    AIL_PM_El el = {0};
+                    if (i+1 == plen) { err = (AIL_PM_Err){.type=AIL_PM_ERR_INCOMPLETE_ESCAPE, .idx=i}; goto failed; }
+                    AIL_PM_El el;
                     switch (p[++i]) {
-                        case 's': el.type=AIL_PM_EL_WHITESPACE; el.inverted=0; break;
-                        case 'S': el.type=AIL_PM_EL_WHITESPACE; el.inverted=1; break;
-                        case 'w': el.type=AIL_PM_EL_ALPHANUM;   el.inverted=0; break;
-                        case 'W': el.type=AIL_PM_EL_ALPHANUM;   el.inverted=1; break;
-                        case 'd': el.type=AIL_PM_EL_DIGIT;      el.inverted=0; break;
-                        case 'D': el.type=AIL_PM_EL_DIGIT;      el.inverted=1; break;
-                        default:  el.c = p[i];                             break;
+                        case 's': el = _ail_pm_el_class(AIL_PM_EL_WHITESPACE, 0); break;
+                        case 'S': el = _ail_pm_el_class(AIL_PM_EL_WHITESPACE, 1); break;
+                        case 'w': el = _ail_pm_el_class(AIL_PM_EL_ALPHANUM,   0); break;
+                        case 'W': el = _ail_pm_el_class(AIL_PM_EL_ALPHANUM,   1); break;
+                        case 'd': el = _ail_pm_el_class(AIL_PM_EL_DIGIT,      0); break;
+                        case 'D': el = _ail_pm_el_class(AIL_PM_EL_DIGIT,      1); break;
+                        default:  el = _ail_pm_el_char(p[i]);                     break;
                     }
                     ail_da_push(&els, el);
                     break;
                 default:
-                    ail_da_push(&els, (AIL_PM_El){.c=c});
+                    ail_da_push(&els, _ail_pm_el_char(c));
                     break;
             } break;
             case AIL_PM_EXP_GLOB: switch (c) {
                 case '*': {
-                    AIL_PM_El el = {
-                        .type  = AIL_PM_EL_ANY,
-                        .count = AIL_PM_COUNT_ZERO_PLUS
-                    };
+                    AIL_PM_El el = _ail_pm_el_class(AIL_PM_EL_ANY, false);
+                    el.count = AIL_PM_COUNT_ZERO_PLUS;
                     ail_da_push(&els, el);
                 } break;
                 case '?': {
-                    AIL_PM_El el = {
-                        .type  = AIL_PM_EL_ANY,
-                        .count = AIL_PM_COUNT_ONE_OR_NONE
-                    };
+                    AIL_PM_El el = _ail_pm_el_class(AIL_PM_EL_ANY, false);
+                    el.count = AIL_PM_COUNT_ONE_OR_NONE;
                     ail_da_push(&els, el);
                 } break;
                 case ']':
-                    return (AIL_PM_Comp_Res){.failed=1, .err={.type=AIL_PM_ERR_INVALID_BRACKET, .idx=1}};
+                    err = (AIL_PM_Err){.type=AIL_PM_ERR_INVALID_BRACKET, .idx=1};
+                    goto failed;
                 case '[': {
-                    AIL_PM_Comp_El_Res x = _ail_pm_comp_range(p, plen, &i, allocator);
-                    if (x.failed) return (AIL_PM_Comp_Res){.failed=1, .err=x.err};
+                    AIL_PM_Comp_El_Res x = _ail_pm_comp_range(p, plen, &i);
+                    if (x.failed) { err = x.err; goto failed; }
                     else ail_da_push(&els, x.el);
                 } break;
                 case '\\':
-                    if (i+1 == plen) return (AIL_PM_Comp_Res){.failed=1, .err={.type=AIL_PM_ERR_INCOMPLETE_ESCAPE, .idx=i}};
-                    ail_da_push(&els, (AIL_PM_El){.c=p[++i]});
+                    if (i+1 == plen) { err = (AIL_PM_Err){.type=AIL_PM_ERR_INCOMPLETE_ESCAPE, .idx=i}; goto failed; }
+                    ail_da_push(&els, _ail_pm_el_char(p[++i]));
                     break;
                 default:
-                    ail_da_push(&els, (AIL_PM_El){.c=c});
+                    ail_da_push(&els, _ail_pm_el_char(c));
                     break;
             } break;
             case AIL_PM_EXP_COUNT: AIL_UNREACHABLE();
@@ -517,7 +775,84 @@ AIL_PM_Comp_Res ail_pm_compile_a(const char *p, u32 plen, AIL_PM_Exp_Type exp_ty
         .els    = els.data,
         .len    = els.len,
         .attrs  = attrs,
+        .lit    = _ail_pm_find_literal(els.data, els.len),
     }};
+
+failed:
+    ail_da_free(&els);
+    return (AIL_PM_Comp_Res){.failed=1, .err=err};
+}
+
+// Rough frequency of bytes in typical text, which is used to prefer searching for rare bytes
+internal u32 _ail_pm_byte_freq(u8 c)
+{
+    static const char *letters = "etaoinshrdlcumwfgypbvkjxqz";
+    if (c == ' ')                    return 255;
+    if ('a' <= c && c <= 'z')        return 250 - 8*(u32)(strchr(letters, c) - letters);
+    if ('A' <= c && c <= 'Z')        return (250 - 8*(u32)(strchr(letters, c + 32) - letters))/2;
+    if ('0' <= c && c <= '9')        return 60;
+    if (c == '\n' || c == '.' || c == ',') return 80;
+    if (c >= 0x20 && c < 0x7f)       return 20;
+    return 0;
+}
+
+internal b32 _ail_pm_literal_better(AIL_PM_Literal a, AIL_PM_Literal b)
+{
+    if (a.len != b.len) return a.len > b.len;
+    b32 a_bounded = a.max_off != AIL_PM_LITERAL_UNBOUNDED;
+    b32 b_bounded = b.max_off != AIL_PM_LITERAL_UNBOUNDED;
+    if (a_bounded != b_bounded) return a_bounded;
+    u32 a_freq = 0, b_freq = 0;
+    for (u32 i = 0; i < a.len; i++) {
+        a_freq += _ail_pm_byte_freq(a.data[i]);
+        b_freq += _ail_pm_byte_freq(b.data[i]);
+    }
+    return a_freq < b_freq;
+}
+
+// Runs of single characters can be combined into a literal, if all but the first one are matched exactly once
+// The first character may be repeated with '+', in which case the literal starts at its last repetition
+// A repeated character with '+' can also end the run, since its first repetition follows the rest of the run
+AIL_PM_Literal _ail_pm_find_literal(AIL_PM_El *els, u32 len)
+{
+    AIL_PM_Literal best = {0};
+    u32 min_off = 0, max_off = 0;
+    b32 bounded = true;
+    for (u32 i = 0; i < len; i++) {
+        #define _AIL_PM_IS_LIT_(el) ((el).type == AIL_PM_EL_CHAR && !(el).inverted)
+        u8 count = els[i].count;
+        if (_AIL_PM_IS_LIT_(els[i]) && (count == AIL_PM_COUNT_ONCE || count == AIL_PM_COUNT_ONE_PLUS)) {
+            AIL_PM_Literal lit = { .min_off = min_off, .max_off = (bounded && count == AIL_PM_COUNT_ONCE) ? max_off : AIL_PM_LITERAL_UNBOUNDED };
+            lit.data[lit.len++] = (u8)els[i].c;
+            for (u32 j = i + 1; j < len && lit.len < AIL_PM_LITERAL_MAX && _AIL_PM_IS_LIT_(els[j]); j++) {
+                if (els[j].count != AIL_PM_COUNT_ONCE && els[j].count != AIL_PM_COUNT_ONE_PLUS) break;
+                lit.data[lit.len++] = (u8)els[j].c;
+                if (els[j].count == AIL_PM_COUNT_ONE_PLUS) break;
+            }
+            if (_ail_pm_literal_better(lit, best)) best = lit;
+        }
+        #undef _AIL_PM_IS_LIT_
+        min_off += count == AIL_PM_COUNT_ONCE || count == AIL_PM_COUNT_ONE_PLUS;
+        max_off += 1;
+        bounded &= count == AIL_PM_COUNT_ONCE || count == AIL_PM_COUNT_ONE_OR_NONE;
+    }
+    return best;
+}
+
+// Get the smallest position >= `from`, at which a match could start according to the pattern's literal, or `len` if there is none
+// `lit_pos` caches the last found position of the literal between calls and needs to be initialized to -1
+u64 _ail_pm_skip_to_literal(AIL_PM_Literal *lit, const u8 *s, u64 len, u64 from, i64 *lit_pos)
+{
+    if (!lit->len) return from;
+    u64 min_pos = from + lit->min_off;
+    if (*lit_pos < (i64)min_pos) {
+        i64 q = -1;
+        if (min_pos < len) q = ail_str_find(ail_str_from_parts((u8 *)s + min_pos, len - min_pos), ail_str_from_parts(lit->data, lit->len));
+        *lit_pos = q < 0 ? INT64_MAX : (i64)(min_pos + q);
+    }
+    if (*lit_pos == INT64_MAX)                     return len;
+    if (lit->max_off == AIL_PM_LITERAL_UNBOUNDED)  return from;
+    return ail_max(from, (u64)*lit_pos - ail_min((u64)*lit_pos, lit->max_off));
 }
 
 AIL_PM_Comp_Res ail_pm_compile_str_a(AIL_Str pattern, AIL_PM_Exp_Type type, AIL_Allocator allocator)
@@ -530,28 +865,78 @@ void ail_pm_free_a(AIL_PM_Pattern pattern, AIL_Allocator allocator)
     ail_call_free(allocator, pattern.els);
 }
 
-b32 _ail_pm_match_el(AIL_PM_El el, char c)
+b32 _ail_pm_match_el(const AIL_PM_El *el, u8 c)
 {
-    u8 u = *(u8*)&c;
-    switch (el.type) {
-        case AIL_PM_EL_CHAR:         return el.c == u;
-        case AIL_PM_EL_RANGE:        return el.r.start <= u && u <= el.r.end;
-        case AIL_PM_EL_ONE_OF_CHAR:  return ail_str_find_char(ail_str_from_parts((u8*)el.cs.data, el.cs.len), u) >= 0;
-        case AIL_PM_EL_ONE_OF_RANGE:
-            for (u32 i = 0; i < el.rs.len; i++) {
-                AIL_PM_Range r = el.rs.data[i];
-                if (r.start <= u && u <= r.end) return true;
-            }
-            return false;
-        case AIL_PM_EL_ANY:          return c != '\n' && c != '\r';
-        case AIL_PM_EL_DIGIT:        return ail_str_is_digit(c);
-        case AIL_PM_EL_ALPHA:        return ail_str_is_alpha(c);
-        case AIL_PM_EL_ALPHANUM:     return ail_str_is_alpha(c) || ail_str_is_digit(c);
-        case AIL_PM_EL_WHITESPACE:   return ail_str_is_space(c);
-        case AIL_PM_EL_GROUP:        AIL_TODO(); break;
-        case AIL_PM_EL_COUNT:        AIL_UNREACHABLE();
+    return (el->set[_AIL_PM_SET_IDX_(c)] & _AIL_PM_SET_BIT_(c)) != 0;
+}
+
+// The set is looked up with two byte shuffles: The low nibble selects a byte of the set, while the high bit of each input byte
+// zeroes the lookup in the half of the set that doesn't contain it (shuffles return 0 for indices with the high bit set)
+#if AIL_SIMD_AVX2
+#   define _AIL_PM_VEC_SIZE_ 32
+    typedef __m256i _ail_pm_vec_;
+#   define _ail_pm_vec_load_(p)         _mm256_loadu_si256((__m256i *)(p))
+#   define _ail_pm_vec_splat_(c)        _mm256_set1_epi8((char)(c))
+#   define _ail_pm_vec_table_(t)        _mm256_broadcastsi128_si256(_mm_loadu_si128((__m128i *)(t)))
+#   define _ail_pm_vec_lookup_(t, idx)  _mm256_shuffle_epi8(t, idx)
+#   define _ail_pm_vec_shr4_(v)         _mm256_and_si256(_mm256_srli_epi16(v, 4), _mm256_set1_epi8(0x0f))
+#   define _ail_pm_vec_and_(a, b)       _mm256_and_si256(a, b)
+#   define _ail_pm_vec_or_(a, b)        _mm256_or_si256(a, b)
+#   define _ail_pm_vec_xor_(a, b)       _mm256_xor_si256(a, b)
+#   define _ail_pm_vec_all_zero_(v)     _mm256_testz_si256(v, v)
+#elif AIL_SIMD_SSSE3
+#   define _AIL_PM_VEC_SIZE_ 16
+    typedef __m128i _ail_pm_vec_;
+#   define _ail_pm_vec_load_(p)         _mm_loadu_si128((__m128i *)(p))
+#   define _ail_pm_vec_splat_(c)        _mm_set1_epi8((char)(c))
+#   define _ail_pm_vec_table_(t)        _mm_loadu_si128((__m128i *)(t))
+#   define _ail_pm_vec_lookup_(t, idx)  _mm_shuffle_epi8(t, idx)
+#   define _ail_pm_vec_shr4_(v)         _mm_and_si128(_mm_srli_epi16(v, 4), _mm_set1_epi8(0x0f))
+#   define _ail_pm_vec_and_(a, b)       _mm_and_si128(a, b)
+#   define _ail_pm_vec_or_(a, b)        _mm_or_si128(a, b)
+#   define _ail_pm_vec_xor_(a, b)       _mm_xor_si128(a, b)
+#   define _ail_pm_vec_all_zero_(v)     (_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_setzero_si128())) == 0xffff)
+#elif AIL_SIMD_NEON
+#   define _AIL_PM_VEC_SIZE_ 16
+    typedef uint8x16_t _ail_pm_vec_;
+#   define _ail_pm_vec_load_(p)         vld1q_u8(p)
+#   define _ail_pm_vec_splat_(c)        vdupq_n_u8((u8)(c))
+#   define _ail_pm_vec_table_(t)        vld1q_u8(t)
+#   define _ail_pm_vec_lookup_(t, idx)  vqtbl1q_u8(t, idx)
+#   define _ail_pm_vec_shr4_(v)         vshrq_n_u8(v, 4)
+#   define _ail_pm_vec_and_(a, b)       vandq_u8(a, b)
+#   define _ail_pm_vec_or_(a, b)        vorrq_u8(a, b)
+#   define _ail_pm_vec_xor_(a, b)       veorq_u8(a, b)
+#   define _ail_pm_vec_all_zero_(v)     (vmaxvq_u8(v) == 0)
+#else
+#   define _AIL_PM_VEC_SIZE_ 0
+#endif
+
+// Get the amount of bytes at the start of `s`, that are all contained in the element's set
+u32 _ail_pm_el_run(const AIL_PM_El *el, const u8 *s, u32 len)
+{
+    u32 n = 0;
+#if _AIL_PM_VEC_SIZE_
+    if (len >= _AIL_PM_VEC_SIZE_) {
+        static const u8 bits[16] = { 1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128 };
+        _ail_pm_vec_ lo_set = _ail_pm_vec_table_(el->set);
+        _ail_pm_vec_ hi_set = _ail_pm_vec_table_(el->set + 16);
+        _ail_pm_vec_ bit_tbl = _ail_pm_vec_table_(bits);
+        _ail_pm_vec_ lo_mask = _ail_pm_vec_splat_(0x8f);
+        _ail_pm_vec_ hi_flip = _ail_pm_vec_splat_(0x80);
+        for (; n + _AIL_PM_VEC_SIZE_ <= len; n += _AIL_PM_VEC_SIZE_) {
+            _ail_pm_vec_ v    = _ail_pm_vec_load_(s + n);
+            _ail_pm_vec_ row  = _ail_pm_vec_or_(_ail_pm_vec_lookup_(lo_set, _ail_pm_vec_and_(v, lo_mask)),
+                                                _ail_pm_vec_lookup_(hi_set, _ail_pm_vec_and_(_ail_pm_vec_xor_(v, hi_flip), lo_mask)));
+            _ail_pm_vec_ bit  = _ail_pm_vec_lookup_(bit_tbl, _ail_pm_vec_shr4_(v));
+            // Non-zero exactly for the bytes, which aren't in the set
+            _ail_pm_vec_ miss = _ail_pm_vec_and_(_ail_pm_vec_xor_(row, _ail_pm_vec_splat_(0xff)), bit);
+            if (!_ail_pm_vec_all_zero_(miss)) break;
+        }
     }
-    return false;
+#endif
+    while (n < len && _ail_pm_match_el(el, s[n])) n++;
+    return n;
 }
 
 u32 _ail_pm_match_immediate_greedy(AIL_PM_El *els, u32 ellen, const char *s, u32 slen)
@@ -561,21 +946,20 @@ u32 _ail_pm_match_immediate_greedy(AIL_PM_El *els, u32 ellen, const char *s, u32
     u32 el_idx = 0;
 match:
     while (el_idx < ellen) {
-        if (n >= slen) goto backtrack;
-        AIL_PM_El el = els[el_idx];
-        switch (el.count) {
+        const AIL_PM_El *el = &els[el_idx];
+        switch (el->count) {
             case AIL_PM_COUNT_ONCE:
-                if (!_ail_pm_match_el(el, s[n++])) goto backtrack;
+                if (n >= slen || !_ail_pm_match_el(el, (u8)s[n++])) goto backtrack;
                 break;
             case AIL_PM_COUNT_ZERO_PLUS:
-                while (n < slen && _ail_pm_match_el(el, s[n])) n++;
+                n += _ail_pm_el_run(el, (const u8 *)s + n, slen - n);
                 break;
             case AIL_PM_COUNT_ONE_PLUS:
-                if (!_ail_pm_match_el(el, s[n++])) goto backtrack;
-                while (n < slen && _ail_pm_match_el(el, s[n])) n++;
+                if (n >= slen || !_ail_pm_match_el(el, (u8)s[n++])) goto backtrack;
+                n += _ail_pm_el_run(el, (const u8 *)s + n, slen - n);
                 break;
             case AIL_PM_COUNT_ONE_OR_NONE:
-                if (_ail_pm_match_el(el, s[n])) n++;
+                if (n < slen && _ail_pm_match_el(el, (u8)s[n])) n++;
                 break;
             case AIL_PM_COUNT_COUNT: AIL_UNREACHABLE();
         }
@@ -586,10 +970,10 @@ done:
     ail_call_free(ail_pm_tmp_allocator, stack);
     return n;
 backtrack:
-    for (i32 i = el_idx; i >= 0; i--) {
-        if (els[i].count == AIL_PM_COUNT_ONCE) continue;
-        if (i == 0 && !stack[i])               continue;
-        if (i > 0  && stack[i] == stack[i-1])  continue;
+    // Only the elements before the failed one have an entry on the stack
+    for (i32 i = (i32)el_idx - 1; i >= 0; i--) {
+        u32 min = (i > 0 ? stack[i-1] : 0) + (els[i].count == AIL_PM_COUNT_ONE_PLUS);
+        if (els[i].count == AIL_PM_COUNT_ONCE || stack[i] <= min) continue;
         n = --stack[i];
         el_idx = i + 1;
         goto match;
@@ -621,7 +1005,10 @@ AIL_PM_Match ail_pm_match_greedy(AIL_PM_Pattern pattern, const char *s, u32 len)
             };
         }
     } else {
+        i64 lit_pos = -1;
         for (u32 i = 0; i < len; i++) {
+            i = (u32)_ail_pm_skip_to_literal(&pattern.lit, (const u8 *)s, len, i, &lit_pos);
+            if (i >= len) break;
             u32 n = _ail_pm_match_immediate_greedy(pattern.els, pattern.len, s + i, len - i);
             if (n) return (AIL_PM_Match) {
                 .idx = i,
@@ -678,6 +1065,951 @@ b32 ail_pm_match_eq(AIL_PM_Match a, AIL_PM_Match b)
     return a.len == b.len && (!a.len || a.idx == b.idx);
 }
 
+// Converts the element's set into a plain bitmap, in which byte c is bit `c%64` of `set[c/64]`
+void _ail_pm_el_set(AIL_PM_El el, u64 set[4])
+{
+    memset(set, 0, 4*sizeof(u64));
+    for (u32 c = 0; c < 256; c++) {
+        if (_ail_pm_match_el(&el, (u8)c)) set[c/64] |= 1ULL << (c%64);
+    }
+}
+
+//////////////
+// Lazy DFA //
+//////////////
+
+#define _AIL_PM_DFA_ACCEPT_    0x80000000u // Set in a transition, if its target state was reached by a full match
+#define _AIL_PM_DFA_DEAD_      0x40000000u // Set in a transition, if its target state can never reach a match
+#define _AIL_PM_DFA_IDX_MASK_  0x3fffffffu
+
+internal u32 _ail_pm_lazy_dfa_hash_(u64 *set, u32 words)
+{
+    u64 h = 0;
+    for (u32 i = 0; i < words; i++) h = (((h << 5) | (h >> 59)) ^ set[i])*0x517CC1B727220A95ULL;
+    return (u32)(h ^ (h >> 32));
+}
+
+// The elements of each pattern are read backwards if `reverse` is true, which is used to find the start of a match from its end
+// If `unanchored` is true, matches of all patterns, that aren't anchored at the start, may start at every byte
+internal AIL_PM_Lazy_DFA _ail_pm_lazy_dfa_new_(AIL_PM_Pattern *patterns, u32 count, b32 reverse, b32 unanchored, AIL_Allocator allocator)
+{
+    u32 len = 0;
+    for (u32 k = 0; k < count; k++) len += patterns[k].len + 1;
+    AIL_PM_Lazy_DFA d = {0};
+    d.nfa_len    = len;
+    d.words      = (len + 63)/64;
+    d.unanchored = unanchored;
+    d.el_sets    = ail_call_calloc(allocator, len*4, sizeof(u64));
+    d.on_match   = ail_call_calloc(allocator, len*d.words, sizeof(u64));
+    d.start      = ail_call_calloc(allocator, d.words, sizeof(u64));
+    d.restart    = ail_call_calloc(allocator, d.words, sizeof(u64));
+    d.accepts    = ail_call_calloc(allocator, d.words, sizeof(u64));
+    d.scratch    = ail_call_alloc(allocator, 2*d.words*sizeof(u64));
+
+    // The closure of each state contains all states, that can be reached by skipping optional elements
+    u64 *closure = ail_call_calloc(allocator, len*d.words, sizeof(u64));
+    for (u32 k = 0, off = 0; k < count; off += patterns[k++].len + 1) {
+        AIL_PM_El *els = patterns[k].els;
+        u32 n   = patterns[k].len;
+        u32 acc = off + n;
+        closure[acc*d.words + acc/64] |= 1ULL << (acc%64);
+        d.accepts[acc/64] |= 1ULL << (acc%64);
+        for (u32 i = n; i-- > 0;) {
+            AIL_PM_El el = els[reverse ? n - 1 - i : i];
+            u32  st   = off + i;
+            u64 *c    = closure + st*d.words;
+            u64 *next = closure + (st + 1)*d.words;
+            c[st/64] |= 1ULL << (st%64);
+            if (el.count == AIL_PM_COUNT_ZERO_PLUS || el.count == AIL_PM_COUNT_ONE_OR_NONE) {
+                for (u32 w = 0; w < d.words; w++) c[w] |= next[w];
+            }
+            u64 *m = d.on_match + st*d.words;
+            for (u32 w = 0; w < d.words; w++) m[w] = next[w];
+            if (el.count == AIL_PM_COUNT_ZERO_PLUS || el.count == AIL_PM_COUNT_ONE_PLUS) m[st/64] |= 1ULL << (st%64);
+            _ail_pm_el_set(el, d.el_sets + 4*st);
+        }
+        // Empty matches are never reported, so the start cannot be accepting on its own
+        u64 *first = closure + off*d.words;
+        for (u32 w = 0; w < d.words; w++) d.start[w] |= first[w];
+        if (!(patterns[k].attrs & AIL_PM_ATTR_START)) {
+            for (u32 w = 0; w < d.words; w++) d.restart[w] |= first[w];
+        }
+    }
+    for (u32 w = 0; w < d.words; w++) {
+        d.start[w]   &= ~d.accepts[w];
+        d.restart[w] &= ~d.accepts[w];
+    }
+    ail_call_free(allocator, closure);
+
+    // Bytes are split into classes by every element they are (not) matched by
+    u16 map[256*2];
+    u32 classes_count = 1;
+    for (u32 i = 0; i < len; i++) {
+        u32 new_count = 0;
+        memset(map, 0xff, sizeof(map));
+        for (u32 c = 0; c < 256; c++) {
+            u32 key = 2*d.classes[c] + ((d.el_sets[4*i + c/64] >> (c%64)) & 1);
+            if (map[key] == 0xffff) map[key] = (u16)new_count++;
+            d.classes[c] = (u8)map[key];
+        }
+        classes_count = new_count;
+        if (classes_count == 256) break;
+    }
+    d.classes_count = classes_count;
+
+    d.table_cap = 2*AIL_PM_DFA_MAX_STATES;
+    d.states    = ail_call_alloc(allocator, AIL_PM_DFA_MAX_STATES*d.words*sizeof(u64));
+    d.table     = ail_call_calloc(allocator, d.table_cap, sizeof(u32));
+    d.trans     = ail_call_calloc(allocator, AIL_PM_DFA_MAX_STATES*d.classes_count, sizeof(u32));
+    return d;
+}
+
+internal void _ail_pm_lazy_dfa_free_(AIL_PM_Lazy_DFA *d, AIL_Allocator allocator)
+{
+    ail_call_free(allocator, d->el_sets);
+    ail_call_free(allocator, d->on_match);
+    ail_call_free(allocator, d->start);
+    ail_call_free(allocator, d->restart);
+    ail_call_free(allocator, d->accepts);
+    ail_call_free(allocator, d->scratch);
+    ail_call_free(allocator, d->states);
+    ail_call_free(allocator, d->table);
+    ail_call_free(allocator, d->trans);
+    *d = (AIL_PM_Lazy_DFA){0};
+}
+
+// Get the index of the DFA state for the set of NFA states `set`, which is added if it doesn't exist yet
+// @Important: The cache needs to have space for another state
+internal u32 _ail_pm_lazy_dfa_state_(AIL_PM_Lazy_DFA *d, u64 *set)
+{
+    u32 mask = d->table_cap - 1;
+    for (u32 i = _ail_pm_lazy_dfa_hash_(set, d->words) & mask;; i = (i + 1) & mask) {
+        u32 idx = d->table[i];
+        if (!idx) {
+            ail_assert(d->states_count < AIL_PM_DFA_MAX_STATES);
+            idx = d->states_count++;
+            memcpy(d->states + idx*d->words, set, d->words*sizeof(u64));
+            d->table[i] = idx + 1;
+            return idx;
+        }
+        if (memcmp(d->states + (idx - 1)*d->words, set, d->words*sizeof(u64)) == 0) return idx - 1;
+    }
+}
+
+// Removes all states from the cache except for the initial state (which always has index 0)
+internal void _ail_pm_lazy_dfa_flush_(AIL_PM_Lazy_DFA *d)
+{
+    memset(d->trans, 0, d->states_count*d->classes_count*sizeof(u32));
+    memset(d->table, 0, d->table_cap*sizeof(u32));
+    d->states_count = 0;
+    d->flushes++;
+    _ail_pm_lazy_dfa_state_(d, d->start);
+}
+
+internal u32 _ail_pm_lazy_dfa_initial_(AIL_PM_Lazy_DFA *d)
+{
+    if (!d->states_count) _ail_pm_lazy_dfa_state_(d, d->start);
+    return 0;
+}
+
+// Computes the transition from the state `*state` with the byte `c`
+// If the cache is full, it is flushed first and `*state` is updated to the state's new index
+internal u32 _ail_pm_lazy_dfa_step_(AIL_PM_Lazy_DFA *d, u32 *state, u8 c)
+{
+    u32  words = d->words;
+    u64 *cur   = d->scratch;
+    u64 *next  = d->scratch + words;
+    memcpy(cur, d->states + (*state)*words, words*sizeof(u64));
+    if (d->unanchored) memcpy(next, d->restart, words*sizeof(u64));
+    else               memset(next, 0, words*sizeof(u64));
+    for (u32 w = 0; w < words; w++) {
+        for (u64 bits = cur[w]; bits; bits &= bits - 1) {
+            u32 i = w*64 + ail_ctz_u64(bits);
+            if (!((d->el_sets[4*i + c/64] >> (c%64)) & 1)) continue;
+            u64 *m = d->on_match + i*words;
+            for (u32 k = 0; k < words; k++) next[k] |= m[k];
+        }
+    }
+
+    if (d->states_count + 2 > AIL_PM_DFA_MAX_STATES) {
+        _ail_pm_lazy_dfa_flush_(d);
+        *state = _ail_pm_lazy_dfa_state_(d, cur);
+    }
+    b32 accept = false;
+    b32 dead   = true;
+    for (u32 w = 0; w < words; w++) {
+        accept |= (next[w] & d->accepts[w]) != 0;
+        dead   &= !next[w];
+    }
+    u32 t = (_ail_pm_lazy_dfa_state_(d, next) + 1) | (accept ? _AIL_PM_DFA_ACCEPT_ : 0) | (dead ? _AIL_PM_DFA_DEAD_ : 0);
+    d->trans[(*state)*d->classes_count + d->classes[c]] = t;
+    return t;
+}
+
+// Runs the DFA over s[from..to) or, if `backwards` is true, over s[to..from) from right to left
+// Returns the position after the byte, at which the first (if `stop_first` is true) or last match was accepted or -1
+// If `lit` isn't NULL, the forward scan skips ahead to the next position, at which a match could start, whenever no match is in progress
+internal i64 _ail_pm_lazy_dfa_run_(AIL_PM_Lazy_DFA *d, const u8 *s, u64 from, u64 to, b32 backwards, b32 stop_first, AIL_PM_Literal *lit)
+{
+    i64 last    = -1;
+    i64 lit_pos = -1;
+    u32 state   = _ail_pm_lazy_dfa_initial_(d);
+    u32 cc      = d->classes_count;
+    for (u64 i = from; i != to;) {
+        if (lit && state == 0) {
+            i = _ail_pm_skip_to_literal(lit, s, to, i, &lit_pos);
+            if (i >= to) break;
+        }
+        u8 c = backwards ? s[--i] : s[i++];
+        u32 t = d->trans[state*cc + d->classes[c]];
+        if (AIL_UNLIKELY(!t)) t = _ail_pm_lazy_dfa_step_(d, &state, c);
+        if (t & _AIL_PM_DFA_DEAD_) break;
+        state = (t & _AIL_PM_DFA_IDX_MASK_) - 1;
+        if (t & _AIL_PM_DFA_ACCEPT_) {
+            last = (i64)i;
+            if (stop_first) break;
+        }
+    }
+    return last;
+}
+
+/////////
+// JIT //
+/////////
+
+#if AIL_PM_JIT
+#include <sys/mman.h> // For mmap, mprotect, munmap
+#ifndef MAP_ANONYMOUS
+#   define MAP_ANONYMOUS MAP_ANON
+#endif
+
+// Code of the function being compiled, where jumps are emitted with placeholders, that are patched once all labels are known
+typedef struct _AIL_PM_Jit_Buf_ {
+    u8  *code;
+    u32  len;
+    u32 *labels;         // Offset of each label in `code`
+    u32 *fix_pos;        // Offset of the rel32 placeholder of each jump
+    u32 *fix_label;      // Label that each jump goes to
+    u32  fix_count;
+} _AIL_PM_Jit_Buf_;
+
+#define _ail_pm_jit_emit_(b, ...) do {                    \
+        const u8 bytes_[] = { __VA_ARGS__ };              \
+        memcpy((b)->code + (b)->len, bytes_, sizeof(bytes_)); \
+        (b)->len += sizeof(bytes_);                       \
+    } while(0)
+
+internal void _ail_pm_jit_u32_(_AIL_PM_Jit_Buf_ *b, u32 x)
+{
+    memcpy(b->code + b->len, &x, sizeof(x));
+    b->len += sizeof(x);
+}
+
+internal void _ail_pm_jit_u64_(_AIL_PM_Jit_Buf_ *b, u64 x)
+{
+    memcpy(b->code + b->len, &x, sizeof(x));
+    b->len += sizeof(x);
+}
+
+// Emits a placeholder for the rel32 operand of the jump, whose opcode was just emitted
+internal void _ail_pm_jit_target_(_AIL_PM_Jit_Buf_ *b, u32 label)
+{
+    b->fix_pos[b->fix_count]     = b->len;
+    b->fix_label[b->fix_count++] = label;
+    _ail_pm_jit_u32_(b, 0);
+}
+#endif
+
+// Computes all states and transitions of the lazy DFA, returns false if it has more than `max_states` states
+// @Note: `max_states` must not exceed AIL_PM_DFA_MAX_STATES, so that the cache is never flushed while doing so
+internal b32 _ail_pm_lazy_dfa_explore_(AIL_PM_Lazy_DFA *d, u32 max_states)
+{
+    u8  reps[256];
+    u32 cc = d->classes_count;
+    for (u32 c = 256; c-- > 0;) reps[d->classes[c]] = (u8)c;
+    _ail_pm_lazy_dfa_initial_(d);
+    for (u32 state = 0; state < d->states_count; state++) {
+        for (u32 k = 0; k < cc; k++) {
+            if (d->trans[state*cc + k]) continue;
+            if (d->states_count + 2 > max_states) return false;
+            u32 cur = state;
+            _ail_pm_lazy_dfa_step_(d, &cur, reps[k]);
+        }
+    }
+    return true;
+}
+
+#if AIL_PM_JIT
+// Compiles the fully explored DFA `d` into a function, that behaves like `_ail_pm_lazy_dfa_run_(d, s, from, to, backwards, stop_first, lit)`
+// The registers are used as follows: rbx = s, r12 = i, r13 = to, r14 = lit, r15 = last and [rsp] = lit_pos
+// Returns false if any state has too many byte ranges
+internal b32 _ail_pm_jit_lazy_dfa_(_AIL_PM_Jit_Buf_ *b, AIL_PM_Lazy_DFA *d, b32 backwards, b32 stop_first, b32 use_lit)
+{
+    u32 n    = d->states_count;
+    u32 cc   = d->classes_count;
+    u32 exit = n;
+    b->fix_count = 0;
+
+    // push rbx; push r12; push r13; push r14; push r15; sub rsp, 16
+    _ail_pm_jit_emit_(b, 0x53, 0x41, 0x54, 0x41, 0x55, 0x41, 0x56, 0x41, 0x57, 0x48, 0x83, 0xEC, 0x10);
+    // mov rbx, rdi; mov r12, rsi; mov r13, rdx; mov r14, rcx
+    _ail_pm_jit_emit_(b, 0x48, 0x89, 0xFB, 0x49, 0x89, 0xF4, 0x49, 0x89, 0xD5, 0x49, 0x89, 0xCE);
+    // mov r15, -1; mov qword [rsp], -1
+    _ail_pm_jit_emit_(b, 0x49, 0xC7, 0xC7, 0xFF, 0xFF, 0xFF, 0xFF, 0x48, 0xC7, 0x04, 0x24, 0xFF, 0xFF, 0xFF, 0xFF);
+
+    for (u32 state = 0; state < n; state++) {
+        b->labels[state] = b->len;
+        u64 *set   = d->states + state*d->words;
+        b32 accept = false;
+        for (u32 w = 0; w < d->words; w++) accept |= (set[w] & d->accepts[w]) != 0;
+        if (accept) {
+            _ail_pm_jit_emit_(b, 0x4D, 0x89, 0xE7);                                       // mov r15, r12
+            if (stop_first) { _ail_pm_jit_emit_(b, 0xE9); _ail_pm_jit_target_(b, exit); }  // jmp exit
+        }
+        if (state == 0 && use_lit) {
+            // r12 = _ail_pm_skip_to_literal(r14, rbx, r13, r12, rsp)
+            _ail_pm_jit_emit_(b, 0x4C, 0x89, 0xF7, 0x48, 0x89, 0xDE, 0x4C, 0x89, 0xEA, 0x4C, 0x89, 0xE1, 0x49, 0x89, 0xE0);
+            _ail_pm_jit_emit_(b, 0x48, 0xB8);
+            _ail_pm_jit_u64_(b, (u64)(uintptr_t)&_ail_pm_skip_to_literal);
+            _ail_pm_jit_emit_(b, 0xFF, 0xD0, 0x49, 0x89, 0xC4);                            // call rax; mov r12, rax
+            _ail_pm_jit_emit_(b, 0x4D, 0x39, 0xEC, 0x0F, 0x83); _ail_pm_jit_target_(b, exit); // cmp r12, r13; jae exit
+        } else {
+            _ail_pm_jit_emit_(b, 0x4D, 0x39, 0xEC, 0x0F, 0x84); _ail_pm_jit_target_(b, exit); // cmp r12, r13; je exit
+        }
+        if (backwards) _ail_pm_jit_emit_(b, 0x49, 0xFF, 0xCC, 0x42, 0x0F, 0xB6, 0x04, 0x23); // dec r12; movzx eax, byte [rbx + r12]
+        else           _ail_pm_jit_emit_(b, 0x42, 0x0F, 0xB6, 0x04, 0x23, 0x49, 0xFF, 0xC4); // movzx eax, byte [rbx + r12]; inc r12
+
+        // The bytes are split into runs with the same next state, where the state with the most bytes is jumped to by default
+        u32 run_start[256], run_label[256], runs = 0;
+        u32 bytes_per_label[AIL_PM_JIT_MAX_STATES + 1] = {0};
+        for (u32 c = 0; c < 256; c++) {
+            u32 t     = d->trans[state*cc + d->classes[c]];
+            u32 label = (t & _AIL_PM_DFA_DEAD_) ? exit : (t & _AIL_PM_DFA_IDX_MASK_) - 1;
+            ail_assert(t && label <= n);
+            if (!runs || run_label[runs - 1] != label) {
+                run_start[runs]   = c;
+                run_label[runs++] = label;
+            }
+            bytes_per_label[label]++;
+        }
+        u32 fallback = run_label[0];
+        for (u32 r = 1; r < runs; r++) {
+            if (bytes_per_label[run_label[r]] > bytes_per_label[fallback]) fallback = run_label[r];
+        }
+        u32 ranges = 0;
+        for (u32 r = 0; r < runs; r++) {
+            if (run_label[r] == fallback) continue;
+            if (++ranges > AIL_PM_JIT_MAX_RANGES) return false;
+            u32 lo = run_start[r];
+            u32 hi = r + 1 < runs ? run_start[r + 1] - 1 : 255;
+            if (lo == hi) {
+                _ail_pm_jit_emit_(b, 0x3D); _ail_pm_jit_u32_(b, lo);                     // cmp eax, lo
+                _ail_pm_jit_emit_(b, 0x0F, 0x84);                                        // je
+            } else {
+                _ail_pm_jit_emit_(b, 0x8D, 0x88); _ail_pm_jit_u32_(b, (u32)-(i32)lo);    // lea ecx, [rax - lo]
+                _ail_pm_jit_emit_(b, 0x81, 0xF9); _ail_pm_jit_u32_(b, hi - lo);          // cmp ecx, hi - lo
+                _ail_pm_jit_emit_(b, 0x0F, 0x86);                                        // jbe
+            }
+            _ail_pm_jit_target_(b, run_label[r]);
+        }
+        _ail_pm_jit_emit_(b, 0xE9); _ail_pm_jit_target_(b, fallback);                    // jmp fallback
+    }
+
+    // exit: mov rax, r15; add rsp, 16; pop r15; pop r14; pop r13; pop r12; pop rbx; ret
+    b->labels[exit] = b->len;
+    _ail_pm_jit_emit_(b, 0x4C, 0x89, 0xF8, 0x48, 0x83, 0xC4, 0x10, 0x41, 0x5F, 0x41, 0x5E, 0x41, 0x5D, 0x41, 0x5C, 0x5B, 0xC3);
+
+    for (u32 i = 0; i < b->fix_count; i++) {
+        i32 rel = (i32)b->labels[b->fix_label[i]] - (i32)(b->fix_pos[i] + 4);
+        memcpy(b->code + b->fix_pos[i], &rel, sizeof(rel));
+    }
+    return true;
+}
+#endif
+
+// Compiles the DFA to machine code, which is used instead of interpreting the DFA from then on
+// Returns false if the DFA can't be compiled, because the platform isn't supported or because the DFA is too complex
+// @Note: The DFA may not be copied afterwards, since the copies would share the same code
+b32 ail_pm_dfa_jit(AIL_PM_DFA *dfa)
+{
+#if AIL_PM_JIT
+    if (dfa->jit_code) return true;
+    u32 max_states = ail_min(AIL_PM_JIT_MAX_STATES, AIL_PM_DFA_MAX_STATES);
+    AIL_PM_Lazy_DFA *ds[3] = { &dfa->fwd, &dfa->fwd_anchored, &dfa->rev_anchored };
+    for (u32 i = 0; i < 3; i++) {
+        if (!_ail_pm_lazy_dfa_explore_(ds[i], max_states)) return false;
+    }
+
+    // Every state takes at most 80 bytes of code plus 18 bytes per range
+    u32 cap   = 3*(128 + max_states*(80 + 18*AIL_PM_JIT_MAX_RANGES));
+    u32 fixes = max_states*(AIL_PM_JIT_MAX_RANGES + 3);
+    _AIL_PM_Jit_Buf_ b = {0};
+    b.code      = ail_call_alloc(dfa->allocator, cap);
+    b.labels    = ail_call_alloc(dfa->allocator, (max_states + 1)*sizeof(u32));
+    b.fix_pos   = ail_call_alloc(dfa->allocator, fixes*sizeof(u32));
+    b.fix_label = ail_call_alloc(dfa->allocator, fixes*sizeof(u32));
+    u32 entries[3];
+    b32 ok = true;
+    for (u32 i = 0; i < 3 && ok; i++) {
+        entries[i] = b.len;
+        b32 backwards  = ds[i] == &dfa->rev_anchored;
+        b32 stop_first = ds[i] == &dfa->fwd && !(dfa->attrs & AIL_PM_ATTR_END);
+        b32 use_lit    = ds[i] == &dfa->fwd && dfa->lit.len;
+        ok = _ail_pm_jit_lazy_dfa_(&b, ds[i], backwards, stop_first, use_lit);
+    }
+
+    u8 *code = NULL;
+    if (ok) {
+        code = mmap(NULL, b.len, PROT_READ|PROT_WRITE, MAP_PRIVATE|MAP_ANONYMOUS, -1, 0);
+        if (code == MAP_FAILED) code = NULL;
+    }
+    if (code) {
+        memcpy(code, b.code, b.len);
+        if (mprotect(code, b.len, PROT_READ|PROT_EXEC)) {
+            munmap(code, b.len);
+            code = NULL;
+        }
+    }
+    if (code) {
+        _AIL_PM_Jit_Fn_ *fns[3] = { &dfa->jit_fwd, &dfa->jit_fwd_anchored, &dfa->jit_rev_anchored };
+        for (u32 i = 0; i < 3; i++) {
+            // Object pointers can't be cast to function pointers directly in ISO C
+            u8 *entry = code + entries[i];
+            memcpy(fns[i], &entry, sizeof(entry));
+        }
+        dfa->jit_code = code;
+        dfa->jit_size = b.len;
+    }
+    ail_call_free(dfa->allocator, b.code);
+    ail_call_free(dfa->allocator, b.labels);
+    ail_call_free(dfa->allocator, b.fix_pos);
+    ail_call_free(dfa->allocator, b.fix_label);
+    return code != NULL;
+#else
+    AIL_UNUSED(dfa);
+    return false;
+#endif
+}
+
+// Runs the compiled code of a DFA if it exists and interprets the lazy DFA otherwise
+// @Note: `backwards` and `stop_first` must be the same, with which the DFA was compiled
+internal i64 _ail_pm_dfa_run_(AIL_PM_Lazy_DFA *d, _AIL_PM_Jit_Fn_ jit, const u8 *s, u64 from, u64 to, b32 backwards, b32 stop_first, AIL_PM_Literal *lit)
+{
+    if (jit) return jit(s, from, to, lit);
+    return _ail_pm_lazy_dfa_run_(d, s, from, to, backwards, stop_first, lit);
+}
+
+AIL_PM_DFA ail_pm_dfa_new_a(AIL_PM_Pattern pattern, AIL_Allocator allocator)
+{
+    AIL_PM_DFA dfa = { .attrs = pattern.attrs, .lit = pattern.lit, .allocator = allocator };
+    dfa.fwd          = _ail_pm_lazy_dfa_new_(&pattern, 1, false, true,  allocator);
+    dfa.fwd_anchored = _ail_pm_lazy_dfa_new_(&pattern, 1, false, false, allocator);
+    dfa.rev_anchored = _ail_pm_lazy_dfa_new_(&pattern, 1, true,  false, allocator);
+    return dfa;
+}
+
+void ail_pm_dfa_free(AIL_PM_DFA *dfa)
+{
+    _ail_pm_lazy_dfa_free_(&dfa->fwd,          dfa->allocator);
+    _ail_pm_lazy_dfa_free_(&dfa->fwd_anchored, dfa->allocator);
+    _ail_pm_lazy_dfa_free_(&dfa->rev_anchored, dfa->allocator);
+#if AIL_PM_JIT
+    if (dfa->jit_code) munmap(dfa->jit_code, dfa->jit_size);
+#endif
+    dfa->jit_code = NULL;
+}
+
+// Finds the leftmost-longest match in s[from..len), where `from` counts as the start of the input for patterns anchored at the start
+// The end of the first match is found with a forward scan, after which a backward scan from that end finds the leftmost start
+// Then a forward scan from that start finds the longest match
+internal b32 _ail_pm_dfa_match_from_(AIL_PM_DFA *dfa, const u8 *p, u64 from, u64 len, AIL_PM_Match64 *match)
+{
+    i64 start, end;
+    if (dfa->attrs & AIL_PM_ATTR_START) {
+        start = (i64)from;
+        end   = _ail_pm_dfa_run_(&dfa->fwd_anchored, dfa->jit_fwd_anchored, p, from, len, false, false, NULL);
+        if (end < 0) return false;
+        if ((dfa->attrs & AIL_PM_ATTR_END) && (u64)end != len) return false;
+    } else if (dfa->attrs & AIL_PM_ATTR_END) {
+        end = _ail_pm_dfa_run_(&dfa->fwd, dfa->jit_fwd, p, from, len, false, false, &dfa->lit);
+        if (end < 0 || (u64)end != len) return false;
+        start = _ail_pm_dfa_run_(&dfa->rev_anchored, dfa->jit_rev_anchored, p, len, from, true, false, NULL);
+    } else {
+        end = _ail_pm_dfa_run_(&dfa->fwd, dfa->jit_fwd, p, from, len, false, true, &dfa->lit);
+        if (end < 0) return false;
+        start = _ail_pm_dfa_run_(&dfa->rev_anchored, dfa->jit_rev_anchored, p, (u64)end, from, true, false, NULL);
+        end   = _ail_pm_dfa_run_(&dfa->fwd_anchored, dfa->jit_fwd_anchored, p, (u64)start, len, false, false, NULL);
+    }
+    ail_assert(start >= (i64)from && end > start);
+    *match = (AIL_PM_Match64){ .idx = (u64)start, .len = (u64)(end - start) };
+    return true;
+}
+
+AIL_PM_Match ail_pm_dfa_match(AIL_PM_DFA *dfa, const char *s, u32 len)
+{
+    AIL_PM_Match64 m;
+    if (!_ail_pm_dfa_match_from_(dfa, (const u8 *)s, 0, len, &m)) return (AIL_PM_Match){0};
+    return (AIL_PM_Match){ .idx = (u32)m.idx, .len = (u32)m.len };
+}
+
+b32 ail_pm_dfa_matches(AIL_PM_DFA *dfa, const char *s, u32 len)
+{
+    if ((dfa->attrs & AIL_PM_ATTR_START) || (dfa->attrs & AIL_PM_ATTR_END)) return ail_pm_dfa_match(dfa, s, len).len > 0;
+    return _ail_pm_dfa_run_(&dfa->fwd, dfa->jit_fwd, (const u8 *)s, 0, len, false, true, &dfa->lit) >= 0;
+}
+
+///////////////
+// Find All //
+///////////////
+
+AIL_PM_Match_Iter ail_pm_match_iter(AIL_PM_DFA *dfa, const char *s, u64 len)
+{
+    return (AIL_PM_Match_Iter){ .dfa = dfa, .s = s, .len = len };
+}
+
+// Get the next match after the previous one, returns false if there are no more matches
+b32 ail_pm_match_iter_next(AIL_PM_Match_Iter *it, AIL_PM_Match64 *match)
+{
+    // Patterns anchored at the start can only match once
+    if (it->pos >= it->len || (it->pos && (it->dfa->attrs & AIL_PM_ATTR_START))) return false;
+    if (!_ail_pm_dfa_match_from_(it->dfa, (const u8 *)it->s, it->pos, it->len, match)) {
+        it->pos = it->len;
+        return false;
+    }
+    it->pos = match->idx + match->len;
+    return true;
+}
+
+#ifndef AIL_PM_FIND_ALL_MIN_CHUNK
+#define AIL_PM_FIND_ALL_MIN_CHUNK AIL_MB(1)
+#endif
+#ifndef AIL_PM_FIND_ALL_MAX_THREADS
+#define AIL_PM_FIND_ALL_MAX_THREADS 64
+#endif
+
+typedef struct _AIL_PM_Find_Job_ {
+    AIL_PM_DFA  dfa;
+    const char *s;
+    u64 start;
+    u64 end;
+    AIL_DA(AIL_PM_Match64) matches;
+} _AIL_PM_Find_Job_;
+
+internal void _ail_pm_find_job_run_(_AIL_PM_Find_Job_ *job)
+{
+    AIL_PM_Match_Iter it = ail_pm_match_iter(&job->dfa, job->s + job->start, job->end - job->start);
+    AIL_PM_Match64 m;
+    while (ail_pm_match_iter_next(&it, &m)) {
+        m.idx += job->start;
+        ail_da_push(&job->matches, m);
+    }
+}
+
+#if AIL_OS_WIN
+internal DWORD WINAPI _ail_pm_find_job_thread_(LPVOID arg) { _ail_pm_find_job_run_(arg); return 0; }
+#elif _AIL_PM_THREADS_
+internal void *_ail_pm_find_job_thread_(void *arg) { _ail_pm_find_job_run_(arg); return NULL; }
+#endif
+
+internal u32 _ail_pm_cpu_count_(void)
+{
+#if AIL_OS_WIN
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors;
+#elif _AIL_PM_THREADS_
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (u32)n : 1;
+#else
+    return 1;
+#endif
+}
+
+// Collects all non-overlapping matches in `s` like `ail_pm_match_iter_next` does
+// The buffer is split into one chunk per thread, each ending after a line break, which are matched in parallel
+// If `threads` is 0, one thread per CPU core is used
+// @Important: Since every thread stores its matches in its own array, `allocator` needs to be thread-safe
+AIL_DA(AIL_PM_Match64) ail_pm_find_all_a(AIL_PM_Pattern pattern, const char *s, u64 len, u32 threads, AIL_Allocator allocator)
+{
+    if (!threads) threads = _ail_pm_cpu_count_();
+    threads = ail_min(threads, AIL_PM_FIND_ALL_MAX_THREADS);
+    threads = (u32)ail_min((u64)threads, len/AIL_PM_FIND_ALL_MIN_CHUNK + 1);
+    // Matches can only be found independently per chunk, if they can't contain the line breaks between chunks
+    for (u32 i = 0; i < pattern.len && threads > 1; i++) {
+        if (_ail_pm_match_el(&pattern.els[i], '\n')) threads = 1;
+    }
+    if (!_AIL_PM_THREADS_) threads = 1;
+
+    _AIL_PM_Find_Job_ jobs[AIL_PM_FIND_ALL_MAX_THREADS];
+    u64 start = 0;
+    for (u32 t = 0; t < threads; t++) {
+        u64 end = len;
+        if (t + 1 < threads) {
+            end = ail_max(start, (t + 1)*(len/threads));
+            i64 nl = ail_str_find_char(ail_str_from_parts((u8 *)s + end, len - end), '\n');
+            end = nl < 0 ? len : end + (u64)nl + 1;
+        }
+        jobs[t] = (_AIL_PM_Find_Job_){ .s = s, .start = start, .end = end };
+        jobs[t].matches = ail_da_new_with_alloc_t(AIL_PM_Match64, 16, allocator);
+        start = end;
+    }
+    // Matches of patterns anchored at the start or end can only be in the first or last chunk respectively
+    u32 first = 0, last = threads - 1;
+    if (pattern.attrs & AIL_PM_ATTR_START) last  = first;
+    if (pattern.attrs & AIL_PM_ATTR_END)   first = last;
+    for (u32 t = first; t <= last; t++) jobs[t].dfa = ail_pm_dfa_new_a(pattern, allocator);
+
+#if AIL_OS_WIN
+    HANDLE handles[AIL_PM_FIND_ALL_MAX_THREADS];
+    for (u32 t = first + 1; t <= last; t++) handles[t] = CreateThread(NULL, 0, _ail_pm_find_job_thread_, &jobs[t], 0, NULL);
+    _ail_pm_find_job_run_(&jobs[first]);
+    for (u32 t = first + 1; t <= last; t++) {
+        WaitForSingleObject(handles[t], INFINITE);
+        CloseHandle(handles[t]);
+    }
+#elif _AIL_PM_THREADS_
+    pthread_t handles[AIL_PM_FIND_ALL_MAX_THREADS];
+    b32 started[AIL_PM_FIND_ALL_MAX_THREADS] = {0};
+    for (u32 t = first + 1; t <= last; t++) started[t] = pthread_create(&handles[t], NULL, _ail_pm_find_job_thread_, &jobs[t]) == 0;
+    _ail_pm_find_job_run_(&jobs[first]);
+    for (u32 t = first + 1; t <= last; t++) {
+        // Chunks, for which no thread could be started, are matched by this thread instead
+        if (started[t]) pthread_join(handles[t], NULL);
+        else            _ail_pm_find_job_run_(&jobs[t]);
+    }
+#else
+    for (u32 t = first; t <= last; t++) _ail_pm_find_job_run_(&jobs[t]);
+#endif
+
+    AIL_DA(AIL_PM_Match64) res = jobs[first].matches;
+    for (u32 t = 0; t < threads; t++) {
+        if (t != first) {
+            ail_da_pushn(&res, jobs[t].matches.data, jobs[t].matches.len);
+            ail_da_free(&jobs[t].matches);
+        }
+        if (first <= t && t <= last) ail_pm_dfa_free(&jobs[t].dfa);
+    }
+    return res;
+}
+
+///////////
+// Cache //
+///////////
+
+AIL_PM_Cache ail_pm_cache_new_a(u32 cap, AIL_Allocator allocator)
+{
+    ail_assert(cap > 0);
+    AIL_PM_Cache cache = { .cap = cap, .allocator = allocator, .lock = _AIL_PM_MUTEX_INIT_ };
+    cache.buckets_count = 1;
+    while (cache.buckets_count < cap) cache.buckets_count *= 2;
+    cache.entries   = ail_call_alloc(allocator, cap*sizeof(AIL_PM_Cache_Entry));
+    cache.buckets   = ail_call_calloc(allocator, cache.buckets_count, sizeof(u32));
+    cache.arenas[0] = ail_alloc_arena_new(AIL_PM_CACHE_ARENA_SIZE, &ail_alloc_pager);
+    cache.arenas[1] = ail_alloc_arena_new(AIL_PM_CACHE_ARENA_SIZE, &ail_alloc_pager);
+    return cache;
+}
+
+void ail_pm_cache_free(AIL_PM_Cache *cache)
+{
+    for (u32 i = 0; i < 2; i++) {
+        ail_call_free_all(cache->arenas[i]);
+        ail_call_free(ail_alloc_pager, cache->arenas[i].data);
+    }
+    ail_call_free(cache->allocator, cache->entries);
+    ail_call_free(cache->allocator, cache->buckets);
+    _ail_pm_mutex_deinit_(&cache->lock);
+    *cache = (AIL_PM_Cache){0};
+}
+
+internal u32 _ail_pm_cache_hash_(const char *p, u32 plen, AIL_PM_Exp_Type type)
+{
+    return ail_str_hash(ail_str_from_parts((u8 *)p, plen)) ^ ((u32)type*0x9E3779B9u);
+}
+
+// Copies the text and elements of the entry into `arena`, returns the amount of bytes allocated for it
+internal u64 _ail_pm_cache_store_(AIL_PM_Cache_Entry *e, const char *text, AIL_PM_Comp_Res res, AIL_Allocator arena)
+{
+    u64 size = e->text_len;
+    e->text  = ail_call_alloc(arena, ail_max(e->text_len, 1));
+    if (e->text_len) memcpy(e->text, text, e->text_len);
+    e->res = res;
+    if (!res.failed) {
+        size += res.pattern.len*sizeof(AIL_PM_El);
+        e->res.pattern.els = ail_call_alloc(arena, ail_max(res.pattern.len, 1)*sizeof(AIL_PM_El));
+        memcpy(e->res.pattern.els, res.pattern.els, res.pattern.len*sizeof(AIL_PM_El));
+    }
+    return size;
+}
+
+internal void _ail_pm_cache_unlink_(AIL_PM_Cache *cache, u32 idx)
+{
+    AIL_PM_Cache_Entry *e = &cache->entries[idx];
+    if (e->prev) cache->entries[e->prev - 1].next = e->next;
+    else         cache->head = e->next;
+    if (e->next) cache->entries[e->next - 1].prev = e->prev;
+    else         cache->tail = e->prev;
+}
+
+internal void _ail_pm_cache_push_front_(AIL_PM_Cache *cache, u32 idx)
+{
+    AIL_PM_Cache_Entry *e = &cache->entries[idx];
+    e->prev = 0;
+    e->next = cache->head;
+    if (cache->head) cache->entries[cache->head - 1].prev = idx + 1;
+    cache->head = idx + 1;
+    if (!cache->tail) cache->tail = idx + 1;
+}
+
+// Copies all entries into the other arena and clears the current one, so that the memory of evicted entries can be reused
+// @Note: Only the entries in the LRU list are copied, so an entry, that is being replaced, needs to be unlinked first
+internal void _ail_pm_cache_compact_(AIL_PM_Cache *cache)
+{
+    AIL_Allocator to = cache->arenas[cache->cur ^ 1];
+    u64 live = 0;
+    for (u32 idx = cache->head; idx; idx = cache->entries[idx - 1].next) {
+        AIL_PM_Cache_Entry *e = &cache->entries[idx - 1];
+        live += _ail_pm_cache_store_(e, e->text, e->res, to);
+    }
+    ail_call_clear_all(cache->arenas[cache->cur]);
+    cache->cur       ^= 1;
+    cache->arena_used = live;
+    cache->arena_live = live;
+}
+
+internal i64 _ail_pm_cache_find_(AIL_PM_Cache *cache, const char *p, u32 plen, AIL_PM_Exp_Type type, u32 hash)
+{
+    for (u32 idx = cache->buckets[hash & (cache->buckets_count - 1)]; idx; idx = cache->entries[idx - 1].chain) {
+        AIL_PM_Cache_Entry *e = &cache->entries[idx - 1];
+        if (e->hash == hash && e->type == type && e->text_len == plen && memcmp(e->text, p, plen) == 0) return idx - 1;
+    }
+    return -1;
+}
+
+// Returns a copy of the result of the entry, whose pattern is allocated with `allocator`
+internal AIL_PM_Comp_Res _ail_pm_cache_copy_res_(AIL_PM_Cache_Entry *e, AIL_Allocator allocator)
+{
+    AIL_PM_Comp_Res res = e->res;
+    if (!res.failed) {
+        res.pattern.els = ail_call_alloc(allocator, ail_max(res.pattern.len, 1)*sizeof(AIL_PM_El));
+        memcpy(res.pattern.els, e->res.pattern.els, res.pattern.len*sizeof(AIL_PM_El));
+    }
+    return res;
+}
+
+// Same as ail_pm_compile_a, except that the pattern is only compiled if it isn't in the cache yet
+// Compilation errors are cached as well
+// @Note: Patterns are compiled outside of the cache's lock, so different threads can compile different patterns at the same time
+AIL_PM_Comp_Res ail_pm_cache_compile_a(AIL_PM_Cache *cache, const char *p, u32 plen, AIL_PM_Exp_Type type, AIL_Allocator allocator)
+{
+    u32 hash = _ail_pm_cache_hash_(p, plen, type);
+    _ail_pm_mutex_lock_(&cache->lock);
+    i64 idx = _ail_pm_cache_find_(cache, p, plen, type, hash);
+    if (idx >= 0) {
+        cache->hits++;
+        _ail_pm_cache_unlink_(cache, (u32)idx);
+        _ail_pm_cache_push_front_(cache, (u32)idx);
+        AIL_PM_Comp_Res res = _ail_pm_cache_copy_res_(&cache->entries[idx], allocator);
+        _ail_pm_mutex_unlock_(&cache->lock);
+        return res;
+    }
+    cache->misses++;
+    _ail_pm_mutex_unlock_(&cache->lock);
+
+    AIL_PM_Comp_Res res = ail_pm_compile_a(p, plen, type, allocator);
+
+    _ail_pm_mutex_lock_(&cache->lock);
+    // Another thread might have added the same pattern in the meantime
+    if (_ail_pm_cache_find_(cache, p, plen, type, hash) < 0) {
+        u32 i;
+        if (cache->count < cache->cap) {
+            i = cache->count++;
+        } else {
+            // The least recently used entry is evicted and replaced
+            i = cache->tail - 1;
+            AIL_PM_Cache_Entry *old = &cache->entries[i];
+            u32 *link = &cache->buckets[old->hash & (cache->buckets_count - 1)];
+            while (*link != i + 1) link = &cache->entries[*link - 1].chain;
+            *link = old->chain;
+            _ail_pm_cache_unlink_(cache, i);
+            cache->arena_live -= old->text_len + (old->res.failed ? 0 : old->res.pattern.len*sizeof(AIL_PM_El));
+        }
+        if (cache->arena_used > AIL_PM_CACHE_ARENA_SIZE && 2*cache->arena_live < cache->arena_used) {
+            _ail_pm_cache_compact_(cache);
+        }
+        AIL_PM_Cache_Entry *e = &cache->entries[i];
+        e->text_len = plen;
+        e->hash     = hash;
+        e->type     = type;
+        u64 size = _ail_pm_cache_store_(e, p, res, cache->arenas[cache->cur]);
+        cache->arena_used += size;
+        cache->arena_live += size;
+        u32 *bucket = &cache->buckets[hash & (cache->buckets_count - 1)];
+        e->chain = *bucket;
+        *bucket  = i + 1;
+        _ail_pm_cache_push_front_(cache, i);
+    }
+    _ail_pm_mutex_unlock_(&cache->lock);
+    return res;
+}
+
+/////////////////
+// Pattern Set //
+/////////////////
+
+AIL_PM_Set ail_pm_set_new_a(AIL_PM_Pattern *patterns, u32 count, AIL_Allocator allocator)
+{
+    AIL_PM_Set set = { .count = count, .allocator = allocator };
+    set.dfa         = _ail_pm_lazy_dfa_new_(patterns, count, false, true, allocator);
+    set.ids         = ail_call_alloc(allocator, (set.dfa.nfa_len ? set.dfa.nfa_len : 1)*sizeof(u32));
+    set.end_accepts = ail_call_calloc(allocator, set.dfa.words ? set.dfa.words : 1, sizeof(u64));
+    set.found       = ail_call_alloc(allocator, (set.dfa.words ? set.dfa.words : 1)*sizeof(u64));
+    for (u32 k = 0, off = 0; k < count; off += patterns[k++].len + 1) {
+        u32 acc = off + patterns[k].len;
+        set.ids[acc] = k;
+        if (patterns[k].attrs & AIL_PM_ATTR_END) set.end_accepts[acc/64] |= 1ULL << (acc%64);
+    }
+    return set;
+}
+
+void ail_pm_set_free(AIL_PM_Set *set)
+{
+    _ail_pm_lazy_dfa_free_(&set->dfa, set->allocator);
+    ail_call_free(set->allocator, set->ids);
+    ail_call_free(set->allocator, set->end_accepts);
+    ail_call_free(set->allocator, set->found);
+    *set = (AIL_PM_Set){0};
+}
+
+// Collects the accepting NFA states of all patterns with a match into `set->found`
+// If `stop_first` is true, the scan stops as soon as any pattern matched
+// Returns the amount of found patterns
+internal u32 _ail_pm_set_run_(AIL_PM_Set *set, const u8 *s, u64 len, b32 stop_first)
+{
+    AIL_PM_Lazy_DFA *d = &set->dfa;
+    u32 words = d->words;
+    u32 found = 0;
+    memset(set->found, 0, words*sizeof(u64));
+    if (!set->count) return 0;
+
+    u32 state = _ail_pm_lazy_dfa_initial_(d);
+    u32 cc    = d->classes_count;
+    u64 i     = 0;
+    while (i < len) {
+        u8  c = s[i++];
+        u32 t = d->trans[state*cc + d->classes[c]];
+        if (AIL_UNLIKELY(!t)) t = _ail_pm_lazy_dfa_step_(d, &state, c);
+        if (t & _AIL_PM_DFA_DEAD_) return found;
+        state = (t & _AIL_PM_DFA_IDX_MASK_) - 1;
+        if (t & _AIL_PM_DFA_ACCEPT_) {
+            u64 *st = d->states + state*words;
+            for (u32 w = 0; w < words; w++) {
+                u64 new_bits = st[w] & d->accepts[w] & ~set->end_accepts[w] & ~set->found[w];
+                set->found[w] |= new_bits;
+                found += ail_popcount_u64(new_bits);
+            }
+            if (found == set->count || (found && stop_first)) return found;
+        }
+    }
+    // Patterns anchored at the end only match, if they accept after the last byte
+    u64 *st = d->states + state*words;
+    for (u32 w = 0; w < words; w++) {
+        u64 new_bits = st[w] & set->end_accepts[w] & ~set->found[w];
+        set->found[w] |= new_bits;
+        found += ail_popcount_u64(new_bits);
+    }
+    return found;
+}
+
+// Get the index of any pattern in the set, that matches `s`, or -1 if none do
+i32 ail_pm_set_matches_any(AIL_PM_Set *set, const char *s, u64 len)
+{
+    if (!_ail_pm_set_run_(set, (const u8 *)s, len, true)) return -1;
+    for (u32 w = 0; w < set->dfa.words; w++) {
+        if (set->found[w]) return (i32)set->ids[w*64 + ail_ctz_u64(set->found[w])];
+    }
+    AIL_UNREACHABLE();
+    return -1;
+}
+
+// Sets the bit of every pattern in `matched`, that matches `s`, and returns the amount of matching patterns
+// @Important: `matched` needs to have space for at least `set->count` bits
+u32 ail_pm_set_matches_all(AIL_PM_Set *set, const char *s, u64 len, AIL_Bitset matched)
+{
+    ail_assert(matched.len >= set->count);
+    ail_bitset_clear_all(matched);
+    u32 found = _ail_pm_set_run_(set, (const u8 *)s, len, false);
+    for (u32 w = 0; w < set->dfa.words; w++) {
+        for (u64 bits = set->found[w]; bits; bits &= bits - 1) ail_bitset_set(matched, set->ids[w*64 + ail_ctz_u64(bits)]);
+    }
+    return found;
+}
+
+///////////////
+// Streaming //
+///////////////
+
+// @Note: The stream uses its own DFA, since the indices of DFA states, which it keeps between chunks, would become invalid,
+// if the cache of a shared DFA was flushed while matching anything else with it
+AIL_PM_Stream ail_pm_stream_new_a(AIL_PM_Pattern pattern, AIL_Allocator allocator)
+{
+    AIL_PM_Stream st = { .attrs = pattern.attrs, .allocator = allocator };
+    st.dfa   = _ail_pm_lazy_dfa_new_(&pattern, 1, false, true, allocator);
+    st.state = _ail_pm_lazy_dfa_initial_(&st.dfa);
+    return st;
+}
+
+void ail_pm_stream_free(AIL_PM_Stream *st)
+{
+    _ail_pm_lazy_dfa_free_(&st->dfa, st->allocator);
+    *st = (AIL_PM_Stream){0};
+}
+
+// @Important: The previous chunk needs to be fully scanned (i.e. `ail_pm_stream_next` returned false) before feeding the next one
+void ail_pm_stream_feed(AIL_PM_Stream *st, const char *chunk, u64 len)
+{
+    ail_assert(st->dead || st->pos == st->chunk_len);
+    st->offset   += st->chunk_len;
+    st->chunk     = (const u8 *)chunk;
+    st->chunk_len = len;
+    st->pos       = 0;
+}
+
+// Scans the current chunk until the next match ends, whose absolute end offset is then written to `end`
+// Returns false once the whole chunk was scanned without finding another match
+b32 ail_pm_stream_next(AIL_PM_Stream *st, u64 *end)
+{
+    AIL_PM_Lazy_DFA *d = &st->dfa;
+    u32 cc = d->classes_count;
+    if (st->dead) return false;
+    while (st->pos < st->chunk_len) {
+        u8  c = st->chunk[st->pos++];
+        u32 t = d->trans[st->state*cc + d->classes[c]];
+        if (AIL_UNLIKELY(!t)) t = _ail_pm_lazy_dfa_step_(d, &st->state, c);
+        if (t & _AIL_PM_DFA_DEAD_) {
+            st->dead     = true;
+            st->accepted = false;
+            return false;
+        }
+        st->state    = (t & _AIL_PM_DFA_IDX_MASK_) - 1;
+        st->accepted = (t & _AIL_PM_DFA_ACCEPT_) != 0;
+        if (st->accepted && !(st->attrs & AIL_PM_ATTR_END)) {
+            *end = st->offset + st->pos;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Ends the input and reports the match of a pattern anchored at the end, if the input ended with one
+// Matches of other patterns were all reported by `ail_pm_stream_next` already
+b32 ail_pm_stream_finish(AIL_PM_Stream *st, u64 *end)
+{
+    ail_assert(st->dead || st->pos == st->chunk_len);
+    if (!(st->attrs & AIL_PM_ATTR_END) || !st->accepted) return false;
+    *end = st->offset + st->chunk_len;
+    return true;
+}
+
 AIL_WARN_POP
 #endif // _AIL_PM_IMPL_GUARD_
 #endif // AIL_NO_PM_IMPL
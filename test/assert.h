@@ -1,6 +1,7 @@
 #ifndef TEST_ASSERT_H_
 #define TEST_ASSERT_H_
 
+#include "../src/base/ail_base.h" // Included first, so that its feature-test macros apply to all system headers
 #include <stdio.h>
 
 #define COMMON_ASSERT(expr, msg) do { if (!(expr)) {                                        \
@@ -13,6 +13,9 @@ typedef struct Vec2 {
 } Vec2;
 AIL_DA_INIT(Vec2);
 
+#define PARTICLE_FIELDS(X) X(Vec2, pos) X(u8, alive) X(f64, mass)
+AIL_SOA_INIT(Particle, PARTICLE_FIELDS);
+
 bool intTest(void)
 {
     i32 buf[LEN] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
@@ -49,6 +52,29 @@ bool structTest(void)
     return sum.x == expected.x && sum.y == expected.y;
 }
 
+bool soaTest(void)
+{
+    AIL_SOA(Particle) soa = ail_soa_empty(Particle);
+    for (u32 i = 0; i < LEN; i++) ail_soa_push(&soa, ((AIL_SOA_EL(Particle)){ .pos = {i, 2*i}, .alive = i%2, .mass = i }));
+    if (soa.len != LEN || soa.cap < LEN) return false;
+    if (ail_int_from_ptr(soa.pos) % AIL_SOA_ALIGNMENT || ail_int_from_ptr(soa.alive) % AIL_SOA_ALIGNMENT || ail_int_from_ptr(soa.mass) % AIL_SOA_ALIGNMENT) return false;
+
+    ail_soa_rm(&soa, 0);      // [1, 2, ..., 9]
+    ail_soa_rm_swap(&soa, 0); // [9, 2, ..., 8]
+    AIL_SOA_EL(Particle) el;
+    ail_soa_get(&soa, 0, &el);
+    if (el.pos.x != 9 || el.pos.y != 18 || el.alive != 1 || el.mass != 9) return false;
+
+    f64 *mass  = ail_soa_field(&soa, mass);
+    f64 total  = 0;
+    u32 alive  = 0;
+    for (u32 i = 0; i < soa.len; i++) total += mass[i];
+    for (u32 i = 0; i < soa.len; i++) alive += soa.alive[i];
+    bool res = soa.len == LEN - 2 && total == 44 && alive == 4 && soa.pos[soa.len - 1].y == 16;
+    ail_soa_free(&soa);
+    return res && soa.len == 0 && soa.mem == NULL;
+}
+
 int main(void)
 {
     ail_default_allocator = ail_alloc_std;
@@ -56,5 +82,7 @@ int main(void)
     else              printf("\033[31mTest with ints failed     :(\033[0m\n");
     if (structTest()) printf("\033[32mTest with vec2 succesfull :)\033[0m\n");
     else              printf("\033[31mTest with vec2 failed     ;(\033[0m\n");
+    if (soaTest())    printf("\033[32mTest with soa succesfull  :)\033[0m\n");
+    else              printf("\033[31mTest with soa failed      :(\033[0m\n");
     return 0;
 }
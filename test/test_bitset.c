@@ -0,0 +1,107 @@
+#include "../src/base/ail_alloc.h"
+#include "../src/base/ail_bitset.h"
+#include "../src/math/ail_rand.h"
+#include "assert.h"
+#include <stdio.h>
+#include <stdbool.h>
+
+#define N 1000
+
+bool basicTest(void)
+{
+    AIL_Bitset bs = ail_bitset_new(N, ail_default_allocator);
+    ASSERT(ail_bitset_popcount(bs) == 0);
+    ail_bitset_set(bs, 0);
+    ail_bitset_set(bs, 63);
+    ail_bitset_set(bs, 64);
+    ail_bitset_set(bs, N - 1);
+    ail_bitset_toggle(bs, 500);
+    ail_bitset_assign(bs, 501, true);
+    ail_bitset_assign(bs, 501, false);
+    ASSERT(ail_bitset_test(bs, 0) && ail_bitset_test(bs, 63) && ail_bitset_test(bs, 64) && ail_bitset_test(bs, N - 1));
+    ASSERT(ail_bitset_test(bs, 500) && !ail_bitset_test(bs, 501) && !ail_bitset_test(bs, 1));
+    ASSERT(ail_bitset_popcount(bs) == 5);
+    ail_bitset_clear(bs, 63);
+    ASSERT(ail_bitset_popcount(bs) == 4);
+
+    u64 expected[] = { 0, 64, 500, N - 1 };
+    u32 count = 0;
+    ail_bitset_for_each_set(bs, i) {
+        ASSERT(count < ail_arrlen(expected) && i == expected[count]);
+        count++;
+    }
+    ASSERT(count == ail_arrlen(expected));
+    ASSERT(ail_bitset_find_next_clear(bs, 0) == 1);
+    ASSERT(ail_bitset_find_next_clear(bs, 64) == 65);
+
+    ail_bitset_set_all(bs);
+    ASSERT(ail_bitset_popcount(bs) == N);
+    ASSERT(ail_bitset_find_next_clear(bs, 0) == N);
+    ail_bitset_clear_all(bs);
+    ASSERT(ail_bitset_find_next_set(bs, 0) == N);
+    ail_bitset_free(&bs, ail_default_allocator);
+    return true;
+}
+
+bool bulkTest(void)
+{
+    AIL_Bitset a = ail_bitset_new(N, ail_default_allocator);
+    AIL_Bitset b = ail_bitset_new(N, ail_default_allocator);
+    AIL_Bitset c = ail_bitset_new(N, ail_default_allocator);
+    for (u32 i = 0; i < N; i += 2) ail_bitset_set(a, i);
+    for (u32 i = 0; i < N; i += 3) ail_bitset_set(b, i);
+    u64 n_a = (N + 1)/2, n_b = (N + 2)/3, n_ab = (N + 5)/6;
+
+    ail_bitset_and(c, a, b);
+    ASSERT(ail_bitset_popcount(c) == n_ab);
+    ail_bitset_or(c, a, b);
+    ASSERT(ail_bitset_popcount(c) == n_a + n_b - n_ab);
+    ail_bitset_xor(c, a, b);
+    ASSERT(ail_bitset_popcount(c) == n_a + n_b - 2*n_ab);
+    ail_bitset_andnot(c, a, b);
+    ASSERT(ail_bitset_popcount(c) == n_a - n_ab);
+    ASSERT(ail_bitset_test(c, 2) && !ail_bitset_test(c, 6));
+    ail_bitset_not(c, a);
+    ASSERT(ail_bitset_popcount(c) == N - n_a);
+    ASSERT(ail_bitset_find_next_set(c, 0) == 1);
+
+    ail_bitset_free(&a, ail_default_allocator);
+    ail_bitset_free(&b, ail_default_allocator);
+    ail_bitset_free(&c, ail_default_allocator);
+    return true;
+}
+
+bool rankSelectTest(void)
+{
+    u64 len = 10*N + 17;
+    AIL_Bitset bs = ail_bitset_new(len, ail_default_allocator);
+    for (u32 i = 0; i < N; i++) ail_bitset_set(bs, ail_rand_u64() % len);
+    AIL_Bitset_Rank rank = ail_bitset_rank_new(bs, ail_default_allocator);
+    ASSERT(rank.ones == ail_bitset_popcount(bs));
+
+    u64 ones = 0;
+    for (u64 i = 0; i < len; i++) {
+        ASSERT(ail_bitset_rank(bs, rank, i) == ones);
+        if (ail_bitset_test(bs, i)) {
+            ASSERT(ail_bitset_select(bs, rank, ones) == i);
+            ones++;
+        }
+    }
+    ASSERT(ail_bitset_rank(bs, rank, len) == ones);
+    ASSERT(ail_bitset_select(bs, rank, ones) == len);
+    ail_bitset_rank_free(&rank, ail_default_allocator);
+    ail_bitset_free(&bs, ail_default_allocator);
+    return true;
+}
+
+int main(void)
+{
+    ail_default_allocator = ail_alloc_std;
+    if (basicTest())      printf("\033[32mBasic Test succesful       :)\033[0m\n");
+    else                  printf("\033[31mBasic Test failed          :(\033[0m\n");
+    if (bulkTest())       printf("\033[32mBulk Test succesful        :)\033[0m\n");
+    else                  printf("\033[31mBulk Test failed           :(\033[0m\n");
+    if (rankSelectTest()) printf("\033[32mRank/Select Test succesful :)\033[0m\n");
+    else                  printf("\033[31mRank/Select Test failed    :(\033[0m\n");
+    return 0;
+}
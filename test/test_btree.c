@@ -0,0 +1,139 @@
+#include "../src/base/ail_alloc.h"
+#include "../src/base/ail_btree.h"
+#include "../src/math/ail_rand.h"
+#include "assert.h"
+#include <stdio.h>
+#include <stdbool.h>
+
+#define N 20000
+
+typedef struct Sample {
+    u64 timestamp;
+    f32 value;
+} Sample;
+
+// Reference for which keys are expected to be in the tree
+static bool present[N];
+
+bool checkTree(AIL_BTree *bt)
+{
+    u64 count = 0, prev = 0;
+    ail_btree_for_each(bt, it) {
+        ASSERT(it.key < N && present[it.key]);
+        ASSERT(count == 0 || it.key > prev);
+        ASSERT(((Sample *)it.val)->timestamp == it.key);
+        prev = it.key;
+        count++;
+    }
+    ASSERT(count == bt->len);
+    return true;
+}
+
+bool insertRemoveTest(void)
+{
+    AIL_Allocator pool = ail_alloc_pool_new(256, AIL_BTREE_NODE_SIZE, &ail_alloc_std);
+    AIL_BTree bt = ail_btree_new(sizeof(Sample), pool);
+    for (u32 i = 0; i < N; i++) {
+        u64 key = ail_rand_u64() % N;
+        Sample s = { .timestamp = key, .value = (f32)i };
+        ail_btree_put(&bt, key, &s);
+        present[key] = true;
+    }
+    if (!checkTree(&bt)) return false;
+    for (u64 key = 0; key < N; key++) {
+        Sample *s = ail_btree_get(&bt, key);
+        ASSERT(present[key] ? (s && s->timestamp == key) : !s);
+    }
+
+    for (u32 i = 0; i < N; i++) {
+        u64 key = ail_rand_u64() % N;
+        ASSERT(ail_btree_rm(&bt, key) == present[key]);
+        present[key] = false;
+    }
+    if (!checkTree(&bt)) return false;
+
+    // Remove everything
+    for (u64 key = 0; key < N; key++) {
+        ail_btree_rm(&bt, key);
+        present[key] = false;
+    }
+    ASSERT(bt.len == 0);
+    ASSERT(!ail_btree_iter_valid(ail_btree_first(&bt)));
+    Sample s = { .timestamp = 7 };
+    ail_btree_put(&bt, 7, &s);
+    ASSERT(ail_btree_first(&bt).key == 7);
+    ail_btree_free(&bt);
+    ail_call_free_all(pool);
+    ail_call_free(ail_alloc_std, pool.data);
+    return true;
+}
+
+bool bulkLoadTest(void)
+{
+    u64    keys[N];
+    Sample vals[N];
+    for (u32 i = 0; i < N; i++) {
+        keys[i] = 3*i;
+        vals[i] = (Sample){ .timestamp = 3*i, .value = (f32)i };
+    }
+    AIL_BTree bt = ail_btree_new_from_sorted(sizeof(Sample), keys, vals, N, ail_default_allocator);
+    ASSERT(bt.len == N);
+    for (u32 i = 0; i < N; i++) {
+        Sample *s = ail_btree_get(&bt, 3*i);
+        ASSERT(s && s->value == (f32)i);
+        ASSERT(!ail_btree_get(&bt, 3*i + 1));
+    }
+
+    // Range query over [100, 200)
+    u64 count = 0;
+    ail_btree_for_range(&bt, it, 100, 200) {
+        ASSERT(it.key >= 100 && it.key < 200 && ail_btree_get(&bt, it.key));
+        count++;
+    }
+    ASSERT(count == 33);
+    ASSERT(ail_btree_lower_bound(&bt, 100).key == 102);
+    ASSERT(ail_btree_upper_bound(&bt, 102).key == 105);
+    ASSERT(!ail_btree_iter_valid(ail_btree_lower_bound(&bt, 3*N)));
+
+    // Reverse iteration
+    AIL_BTree_Iter it = ail_btree_last(&bt);
+    for (u32 i = N; i > 0; i--) {
+        ASSERT(ail_btree_iter_valid(it) && it.key == 3*(i - 1));
+        ail_btree_iter_prev(&it);
+    }
+    ASSERT(!ail_btree_iter_valid(it));
+
+    // Inserting into a bulk-loaded tree
+    Sample s = { .timestamp = 1 };
+    ail_btree_put(&bt, 1, &s);
+    ASSERT(ail_btree_upper_bound(&bt, 0).key == 1);
+    ail_btree_free(&bt);
+    return true;
+}
+
+bool keyConversionTest(void)
+{
+    i64 ints[]   = { -5000000000LL, -3, -1, 0, 1, 42, 5000000000LL };
+    f64 floats[] = { -1e300, -2.5, -0.0, 0.0, 1e-300, 3.25, 1e300 };
+    for (u32 i = 0; i < ail_arrlen(ints); i++) {
+        ASSERT(ail_btree_key_to_i64(ail_btree_key_from_i64(ints[i])) == ints[i]);
+        ASSERT(ail_btree_key_to_f64(ail_btree_key_from_f64(floats[i])) == floats[i]);
+        if (i) {
+            ASSERT(ail_btree_key_from_i64(ints[i - 1])   < ail_btree_key_from_i64(ints[i]));
+            ASSERT(ail_btree_key_from_f64(floats[i - 1]) < ail_btree_key_from_f64(floats[i]));
+        }
+    }
+    return true;
+}
+
+int main(void)
+{
+    ail_default_allocator = ail_alloc_std;
+    if (insertRemoveTest())  printf("\033[32mInsert/Remove Test succesful  :)\033[0m\n");
+    else                     printf("\033[31mInsert/Remove Test failed     :(\033[0m\n");
+    if (bulkLoadTest())      printf("\033[32mBulk-Load Test succesful      :)\033[0m\n");
+    else                     printf("\033[31mBulk-Load Test failed         :(\033[0m\n");
+    if (keyConversionTest()) printf("\033[32mKey-Conversion Test succesful :)\033[0m\n");
+    else                     printf("\033[31mKey-Conversion Test failed    :(\033[0m\n");
+    return 0;
+}
@@ -0,0 +1,170 @@
+#include "../src/base/ail_alloc.h"
+#include "../src/base/ail_csb.h"
+#include "../src/math/ail_rand.h"
+#include "assert.h"
+#include <stdio.h>
+#include <stdbool.h>
+#include <string.h>
+#include <unistd.h>
+
+// Checks that the chunks of the builder contain exactly the text in `sb`
+bool checkEq(AIL_CSB csb, AIL_SB sb)
+{
+    ASSERT(csb.len == sb.len);
+    u64 pos = 0, count = 0;
+    for (AIL_CSB_Chunk *c = csb.head; c; c = c->next, count++) {
+        ASSERT(pos + c->len <= sb.len);
+        ASSERT(memcmp(c->data, sb.data + pos, c->len) == 0);
+        pos += c->len;
+    }
+    ASSERT(pos == sb.len && count == csb.chunk_count);
+    return true;
+}
+
+bool basicTest(void)
+{
+    AIL_CSB csb = ail_csb_new();
+    ASSERT(csb.len == 0 && csb.head == NULL);
+    ASSERT(ail_csb_collapse(&csb).len == 0);
+
+    ail_csb_push_cstr(&csb, "Hello");
+    ail_csb_push_char(&csb, ' ');
+    ail_csb_push_str(&csb, ail_str_from_cstr("World "));
+    ail_csb_push_unsigned(&csb, 18446744073709551615ULL);
+    ail_csb_push_char(&csb, ' ');
+    ail_csb_push_signed(&csb, -42);
+    ail_csb_push_char(&csb, ' ');
+    ail_csb_push_float(&csb, 2.5);
+    ASSERT(csb.chunk_count == 1);
+
+    AIL_Str s = ail_csb_to_str(csb);
+    ASSERT(ail_str_eq(s, ail_str_from_cstr("Hello World 18446744073709551615 -42 2.5")));
+    ASSERT(s.data[s.len] == 0);
+    ail_str_free(s);
+
+    // Large strings are referenced instead of copied
+    static char big[1000];
+    memset(big, 'x', sizeof(big));
+    AIL_Str ref = ail_str_from_parts((u8 *)big, sizeof(big));
+    ail_csb_push_ref(&csb, ref);
+    ail_csb_push_cstr(&csb, "!");
+    ASSERT(csb.chunk_count == 3 && csb.head->next->data == (u8 *)big);
+    ASSERT(csb.len == 40 + sizeof(big) + 1);
+
+    // Small strings are copied
+    ail_csb_push_ref(&csb, ail_str_from_cstr("small"));
+    ASSERT(csb.chunk_count == 3);
+
+    AIL_Str c = ail_csb_collapse(&csb);
+    ASSERT(csb.chunk_count == 1 && c.len == csb.len);
+    ASSERT(memcmp(c.data, "Hello World", 11) == 0 && c.data[40] == 'x' && memcmp(c.data + c.len - 6, "!small", 6) == 0);
+    // Collapsing contiguous text doesn't copy anything
+    AIL_Str c2 = ail_csb_collapse(&csb);
+    ASSERT(c2.data == c.data);
+
+    // The builder can still be pushed to after collapsing it
+    ail_csb_push_cstr(&csb, "?");
+    ASSERT(csb.chunk_count == 2 && csb.tail->data[0] == '?');
+
+    ail_csb_clear(&csb);
+    ASSERT(csb.len == 0 && csb.head == NULL && csb.blocks && !csb.blocks->next);
+    ail_csb_push_cstr(&csb, "abc");
+    ASSERT(csb.len == 3 && memcmp(csb.head->data, "abc", 3) == 0);
+    ail_csb_free(&csb);
+    ASSERT(csb.blocks == NULL);
+    return true;
+}
+
+bool randomTest(void)
+{
+    static u8 refs[AIL_KB(64)];
+    for (u64 i = 0; i < sizeof(refs); i++) refs[i] = 'A' + ail_rand_u64() % 26;
+
+    AIL_CSB csb = ail_csb_new();
+    AIL_SB  sb  = ail_da_new(u8);
+    u8 buf[AIL_KB(32)];
+    for (u32 round = 0; round < 3; round++) {
+        for (u32 i = 0; i < 5000; i++) {
+            switch (ail_rand_u64() % 6) {
+                case 0: {
+                    u64 n = ail_rand_u64() % 64;
+                    for (u64 j = 0; j < n; j++) buf[j] = 'a' + ail_rand_u64() % 26;
+                    ail_csb_push_bytes(&csb, buf, n);
+                    ail_da_pushn(&sb, buf, n);
+                } break;
+                case 1: {
+                    // Larger than any block
+                    u64 n = ail_rand_u64() % sizeof(buf);
+                    for (u64 j = 0; j < n; j++) buf[j] = '0' + ail_rand_u64() % 10;
+                    ail_csb_push_bytes(&csb, buf, n);
+                    ail_da_pushn(&sb, buf, n);
+                } break;
+                case 2: {
+                    u64 start = ail_rand_u64() % sizeof(refs);
+                    u64 n     = ail_rand_u64() % (sizeof(refs) - start);
+                    ail_csb_push_ref(&csb, ail_str_from_parts(refs + start, n));
+                    ail_da_pushn(&sb, refs + start, n);
+                } break;
+                case 3: {
+                    u64 num = ail_rand_u64() >> (ail_rand_u64() % 64);
+                    ail_csb_push_unsigned(&csb, num);
+                    ail_sb_push_unsigned(&sb, num);
+                } break;
+                case 4: {
+                    u64 n = ail_rand_u64() % 100;
+                    u8 *p = ail_csb_push_space(&csb, n);
+                    memset(p, '#', n);
+                    for (u64 j = 0; j < n; j++) ail_da_push(&sb, '#');
+                } break;
+                default:
+                    ail_csb_push_char(&csb, '\n');
+                    ail_da_push(&sb, '\n');
+                    break;
+            }
+        }
+        ASSERT(checkEq(csb, sb));
+
+        AIL_Str s = ail_csb_to_str(csb);
+        ASSERT(s.len == sb.len && memcmp(s.data, sb.data, sb.len) == 0);
+        ail_str_free(s);
+
+        // Write everything through a pipe and read it back
+        if (round == 0) {
+            int fds[2];
+            ASSERT(pipe(fds) == 0);
+            ASSERT(sb.len < AIL_MB(64));
+            u8 *out = ail_call_alloc(ail_default_allocator, sb.len);
+            if (fork() == 0) {
+                close(fds[0]);
+                _exit(ail_csb_write_fd(csb, fds[1]) ? 0 : 1);
+            }
+            close(fds[1]);
+            u64 got = 0;
+            for (ssize_t n; (n = read(fds[0], out + got, sb.len - got)) > 0;) got += (u64)n;
+            close(fds[0]);
+            ASSERT(got == sb.len && memcmp(out, sb.data, sb.len) == 0);
+            ail_call_free(ail_default_allocator, out);
+        }
+
+        if (round == 1) {
+            AIL_Str c = ail_csb_collapse(&csb);
+            ASSERT(c.len == sb.len && memcmp(c.data, sb.data, sb.len) == 0);
+        } else {
+            ail_csb_clear(&csb);
+            sb.len = 0;
+        }
+    }
+    ail_csb_free(&csb);
+    ail_da_free(&sb);
+    return true;
+}
+
+int main(void)
+{
+    ail_default_allocator = ail_alloc_std;
+    if (basicTest())  printf("\033[32mBasic Test succesful :)\033[0m\n");
+    else              printf("\033[31mBasic Test failed :(\033[0m\n");
+    if (randomTest()) printf("\033[32mRandom Test succesful :)\033[0m\n");
+    else              printf("\033[31mRandom Test failed :(\033[0m\n");
+    return 0;
+}
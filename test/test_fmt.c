@@ -0,0 +1,165 @@
+#include "../src/base/ail_alloc.h"
+#include "../src/base/ail_fmt.h"
+#include "../src/math/ail_rand.h"
+#include "assert.h"
+#include <stdio.h>
+#include <stdbool.h>
+#include <string.h>
+#include <math.h>
+
+static AIL_SB sb;
+static char   expected[4096];
+
+// Compares the output of ail_sb_print with the output of libc's snprintf
+#define CHECK(...) do {                                                                             \
+        sb.len = 0;                                                                                 \
+        ail_sb_print(&sb, __VA_ARGS__);                                                             \
+        int n_ = snprintf(expected, sizeof(expected), __VA_ARGS__);                                 \
+        if (sb.len != (u64)n_ || memcmp(sb.data, expected, sb.len)) {                               \
+            printf("Expected '%s', but got '%.*s'\n", expected, (int)sb.len, (char *)sb.data);      \
+            ASSERT(false);                                                                          \
+        }                                                                                           \
+    } while(0)
+
+// Writes a random specifier for the conversion `conv` (prefixed by the length modifier `len`) into `fmt`
+static void random_spec(char *fmt, const char *len, char conv, b32 allow_alt)
+{
+    u64 r = ail_rand_u64();
+    char *p = fmt;
+    *p++ = '%';
+    if (r & 1)               *p++ = '-';
+    if (r & 2)               *p++ = '+';
+    if (r & 4)               *p++ = ' ';
+    if (r & 8 && allow_alt)  *p++ = '#';
+    if (r & 16)              *p++ = '0';
+    if (r & 32)              p += sprintf(p, "%d", (int)((r >> 8) % 30));
+    if (r & 64)              p += sprintf(p, ".%d", (int)((r >> 16) % 25));
+    p += sprintf(p, "%s%c", len, conv);
+}
+
+static f64 random_float(void)
+{
+    u64 r = ail_rand_u64();
+    f64 x;
+    switch (r % 6) {
+        case 0:  memcpy(&x, &r, sizeof(x)); break;                                   // Any exponent
+        case 1:  x = (f64)(ail_rand_u64() % 2000000) / 1000; break;                  // Typical decimals
+        case 2:  x = (f64)(ail_rand_u64() % 1000) + 0.5; break;                      // Ties when rounding to integers
+        case 3:  x = (f64)(ail_rand_u64() % 100000) / 1024; break;                   // Exact binary fractions with ties
+        case 4:  x = (f64)(ail_rand_u64() >> 11) * 4.9406564584124654e-324; break;   // Subnormals
+        default: x = ldexp((f64)(ail_rand_u64() >> 11), (int)(ail_rand_u64() % 200) - 100); break;
+    }
+    return (r >> 63) ? -x : x;
+}
+
+bool intTest(void)
+{
+    CHECK("%d %i %u %x %X %o", 42, -42, 42u, 0xBEEFu, 0xBEEFu, 8u);
+    CHECK("[%5d] [%-5d] [%05d] [%+d] [% d] [%.3d] [%.0d] [%5.0d]", 42, 42, -42, 42, 42, 7, 0, 0);
+    CHECK("[%#x] [%#X] [%#o] [%#o] [%#.0o] [%#x]", 255u, 255u, 8u, 0u, 0u, 0u);
+    CHECK("%hhd %hhu %hd %hu", 300, 300u, 70000, 70000u);
+    CHECK("%ld %lu %lld %llu", -1234567890123L, 1234567890123UL, (long long)INT64_MIN, (unsigned long long)UINT64_MAX);
+    CHECK("%jd %zu %td %zx", (intmax_t)-5, (size_t)12345, (ptrdiff_t)-77, (size_t)0xABC);
+    CHECK("[%*d] [%-*d] [%.*d] [%*.*d]", 6, 1, 6, 2, 4, 3, -8, 3, 4);
+    CHECK("%p %p", (void *)0x1234, NULL);
+
+    char fmt[64];
+    for (u32 i = 0; i < 50000; i++) {
+        const char convs[] = "diuxXo";
+        char conv = convs[i % 6];
+        random_spec(fmt, "ll", conv, i % 6 >= 3);
+        u64 v = ail_rand_u64() >> (ail_rand_u64() % 64);
+        CHECK(fmt, (long long)v);
+    }
+    return true;
+}
+
+bool floatTest(void)
+{
+    CHECK("%f %e %g %a", 1.5, 1.5, 1.5, 1.5);
+    CHECK("%f %f %f %f", 0.5, 1.5, 2.5, -0.0);
+    CHECK("%.0f %.0f %.0f %.1f %.2f", 0.5, 1.5, 2.5, 0.25, 1.005);
+    CHECK("%.20f %.17e %.30g", 0.1, 0.1, 0.1);
+    CHECK("%f %.3e %g", 1e300, 1e-300, 1e-5);
+    CHECK("%g %g %g %g %g %#g", 100000.0, 1000000.0, 0.0001, 0.00001, 123456789.0, 1.0);
+    CHECK("%e %g %a", 4.9406564584124654e-324, 4.9406564584124654e-324, 4.9406564584124654e-324);
+    CHECK("%.3a %.0a %.0a %#.0a %A", 1.0/3, 1.5, 2.5, 1.0, 0.0);
+    CHECK("[%10.3f] [%-10.3f] [%010.3f] [%+.2e] [% .2e] [%010a]", 3.14159, 3.14159, -3.14159, 2.0, 2.0, 1.0);
+    CHECK("%f %F %e %E %g %G", HUGE_VAL, -HUGE_VAL, NAN, NAN, HUGE_VAL, -HUGE_VAL);
+    CHECK("[%08f] [%-8f]", HUGE_VAL, NAN);
+    CHECK("%.500f", 5e-324);
+    CHECK("%Lf", (long double)2.75);
+
+    char fmt[64];
+    for (u32 i = 0; i < 100000; i++) {
+        const char convs[] = "feEgGaA";
+        random_spec(fmt, "", convs[i % 7], true);
+        f64 x = random_float();
+        CHECK(fmt, x);
+    }
+    return true;
+}
+
+bool strTest(void)
+{
+    AIL_Str name = ail_str_from_cstr("World, and more");
+    sb.len = 0;
+    ail_sb_print(&sb, "Hello " AIL_STR_FMT "!", AIL_STR_ARG(ail_str_from_parts(name.data, 5)));
+    ASSERT(ail_str_eq(ail_str_from_parts(sb.data, sb.len), ail_str_from_cstr("Hello World!")));
+    CHECK("[%s] [%10s] [%-10s] [%.3s] [%*.*s]", "abc", "abc", "abc", "abcdef", 6, 2, "abcdef");
+    CHECK("[%c] [%3c] [%-3c] [%%]", 'x', 'y', 'z');
+    CHECK("%s", "");
+    CHECK("Literal text only");
+
+    int n1 = 0, n2 = 0;
+    sb.len = 0;
+    ail_sb_print(&sb, "ab%ncde%n", &n1, &n2);
+    ASSERT(n1 == 2 && n2 == 5);
+
+    // Invalid specifiers are written as they are
+    const char *invalid = "%d%% %y %";
+    AIL_Str s = ail_str_new_fmt(invalid, 5);
+    ASSERT(s.len == 7 && memcmp(s.data, "5\x25 \x25y \x25", 7) == 0 && s.data[s.len] == 0);
+    ail_str_free(s);
+    return true;
+}
+
+bool compiledTest(void)
+{
+    AIL_Fmt fmt = ail_fmt_compile("[%s] %5.2f | %-6d | %x %y%%\n");
+    ASSERT(fmt.compiled && fmt.count == 6);
+    for (u32 i = 0; i < 1000; i++) {
+        f64 x = random_float();
+        i32 d = (i32)ail_rand_u64();
+        sb.len = 0;
+        ail_sb_print_fmt(&sb, &fmt, "INFO", x, d, (u32)d);
+        int n = snprintf(expected, sizeof(expected), "[%s] %5.2f | %-6d | %x ", "INFO", x, d, (u32)d);
+        n += snprintf(expected + n, sizeof(expected) - (u64)n, "%%y%%\n");
+        ASSERT(sb.len == (u64)n && memcmp(sb.data, expected, sb.len) == 0);
+    }
+
+    // Formats with too many specifiers are parsed every time instead
+    const char *many = "%d%d%d%d%d%d%d%d%d%d%d%d%d%d%d%d%d%d%d%d%d%d%d%d%d%d%d%d%d%d%d%d%d %s";
+    fmt = ail_fmt_compile(many);
+    ASSERT(!fmt.compiled);
+    sb.len = 0;
+    ail_sb_print_fmt(&sb, &fmt, 1,2,3,4,5,6,7,8,9,0,1,2,3,4,5,6,7,8,9,0,1,2,3,4,5,6,7,8,9,0,1,2,3, "end");
+    ASSERT(ail_str_eq(ail_str_from_parts(sb.data, sb.len), ail_str_from_cstr("123456789012345678901234567890123 end")));
+    return true;
+}
+
+int main(void)
+{
+    ail_default_allocator = ail_alloc_std;
+    sb = ail_da_new_t(u8);
+    if (intTest())      printf("\033[32mInteger Test succesful  :)\033[0m\n");
+    else                printf("\033[31mInteger Test failed     :(\033[0m\n");
+    if (floatTest())    printf("\033[32mFloat Test succesful    :)\033[0m\n");
+    else                printf("\033[31mFloat Test failed       :(\033[0m\n");
+    if (strTest())      printf("\033[32mString Test succesful   :)\033[0m\n");
+    else                printf("\033[31mString Test failed      :(\033[0m\n");
+    if (compiledTest()) printf("\033[32mCompiled Test succesful :)\033[0m\n");
+    else                printf("\033[31mCompiled Test failed    :(\033[0m\n");
+    ail_da_free(&sb);
+    return 0;
+}
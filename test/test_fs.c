@@ -1,24 +1,180 @@
 // Test ail_fs.h
-
+#define AIL_FS_GLOB_MAX_RESULTS 16 // Small enough, that the walker has to wait for ail_fs_glob_next
 #include "assert.h"
 #include "../src/fs/ail_file.h"
+#include "../src/fs/ail_dir.h"
 #include <stdio.h>
+#include <stdlib.h> // For qsort
 
-int main(void)
+#define DIR_MODE (S_IRWXU | S_IRWXG | S_IROTH | S_IXOTH)
+
+bool test_read_write(void)
 {
-    ail_default_allocator = ail_alloc_std;
     static const char *buf = "Hello World\n";
-    mkdir("./tmp", S_IRWXU | S_IRWXG | S_IROTH | S_IXOTH);
+    mkdir("./tmp", DIR_MODE);
     bool succ = ail_fs_write_file("./tmp/test.txt", buf, strlen(buf));
     ASSERT(succ);
     u64 size;
     u8 *out = ail_fs_read_entire_file("./tmp/test.txt", &size, ail_default_allocator);
     ASSERT(size == strlen(buf));
     ASSERT(memcmp(out, buf, size) == 0);
+    ail_call_free(ail_default_allocator, out);
 
     ASSERT(!remove("./tmp/test.txt"));
     rmdir("./tmp");
     ASSERT(!ail_fs_dir_exists("./tmp"));
-    printf("\033[32mTest successful :)\033[0m\n");
+    return true;
+}
+
+static const char *tree_dirs[]  = { "tmp", "tmp/logs", "tmp/logs/a", "tmp/logs/a/b", "tmp/other" };
+static const char *tree_files[] = { "tmp/logs/z.gz", "tmp/logs/n.txt", "tmp/logs/a/x.gz", "tmp/logs/a/b/y.gz", "tmp/logs/a/b/y.txt", "tmp/other/w.gz", "tmp/top.gz" };
+
+static int cmp_pchar(const void *a, const void *b)
+{
+    return strcmp(*(const char **)a, *(const char **)b);
+}
+
+// Collects all paths matching `pattern` in sorted order and compares them to `expected`
+static bool glob_eq(const char *pattern, u32 threads, const char **expected, u32 expected_count)
+{
+    AIL_FS_Glob *g = ail_fs_glob_new(pattern, threads);
+    ASSERT(!g->failed);
+    AIL_DA(pchar) res = ail_da_new_with_cap(pchar, 16);
+    for (AIL_Str path; ail_fs_glob_next(g, &path);) {
+        ASSERT(path.data[path.len] == 0);
+        char *copy = ail_call_alloc(ail_default_allocator, path.len + 1);
+        memcpy(copy, path.data, path.len + 1);
+        ail_da_push(&res, copy);
+    }
+    ail_fs_glob_free(g);
+    qsort(res.data, res.len, sizeof(char *), cmp_pchar);
+    bool eq = res.len == expected_count;
+    for (u32 i = 0; eq && i < expected_count; i++) eq = strcmp(res.data[i], expected[i]) == 0;
+    if (!eq) {
+        printf("\033[31mGlob '%s' with %u threads matched:\033[0m\n", pattern, threads);
+        for (u32 i = 0; i < res.len; i++) printf("  %s\n", res.data[i]);
+    }
+    for (u32 i = 0; i < res.len; i++) ail_call_free(ail_default_allocator, res.data[i]);
+    ail_da_free(&res);
+    return eq;
+}
+
+static u32 glob_count(const char *pattern, u32 threads)
+{
+    AIL_FS_Glob *g = ail_fs_glob_new(pattern, threads);
+    u32 count = 0;
+    for (AIL_Str path; ail_fs_glob_next(g, &path);) count++;
+    ail_fs_glob_free(g);
+    return count;
+}
+
+// Creates (or removes) the directory `dir` with `depth` levels of subdirectories below it and returns the amount of directories
+static u32 count_tree(const char *dir, u32 depth, bool create)
+{
+    char path[256];
+    u32 count = 1;
+    for (u32 i = 0; depth && i < 6; i++) {
+        snprintf(path, sizeof(path), "%s/d%u", dir, i);
+        if (create) mkdir(path, DIR_MODE);
+        count += count_tree(path, depth - 1, create);
+    }
+    const char *files[] = { "f.gz", "f.txt" };
+    for (u32 i = 0; i < ail_arrlen(files); i++) {
+        snprintf(path, sizeof(path), "%s/%s", dir, files[i]);
+        if (create) ail_fs_write_file(path, "", 0);
+        else        remove(path);
+    }
+    if (!create) rmdir(dir);
+    return count;
+}
+
+#define GLOB_EQ(pattern, threads, ...) do {                                            \
+        const char *expected[] = { __VA_ARGS__ };                                      \
+        ASSERT(glob_eq(pattern, threads, expected, ail_arrlen(expected)));             \
+    } while(0)
+
+bool test_glob(void)
+{
+    for (u32 i = 0; i < ail_arrlen(tree_dirs); i++) mkdir(tree_dirs[i], DIR_MODE);
+    for (u32 i = 0; i < ail_arrlen(tree_files); i++) ASSERT(ail_fs_write_file(tree_files[i], "", 0));
+
+    for (u32 threads = 1; threads <= 4; threads += 3) {
+        GLOB_EQ("tmp/logs/**/*.gz", threads, "tmp/logs/a/b/y.gz", "tmp/logs/a/x.gz", "tmp/logs/z.gz");
+        GLOB_EQ("tmp/**/**/*.gz",   threads, "tmp/logs/a/b/y.gz", "tmp/logs/a/x.gz", "tmp/logs/z.gz", "tmp/other/w.gz", "tmp/top.gz");
+        GLOB_EQ("tmp/*/*.gz",       threads, "tmp/logs/z.gz", "tmp/other/w.gz");
+        GLOB_EQ("tmp/logs/?.txt",   threads, "tmp/logs/n.txt");
+        GLOB_EQ("tmp/**/b",         threads, "tmp/logs/a/b");
+        GLOB_EQ("tmp/logs/a/b/y.*", threads, "tmp/logs/a/b/y.gz", "tmp/logs/a/b/y.txt");
+        GLOB_EQ("tmp//other/w.gz",  threads, "tmp/other/w.gz");
+        GLOB_EQ("tmp/[lo]*/**/[xy].gz", threads, "tmp/logs/a/b/y.gz", "tmp/logs/a/x.gz");
+        ASSERT(glob_eq("tmp/missing/*", threads, NULL, 0));
+        ASSERT(glob_eq("tmp/top.gz/*",  threads, NULL, 0));
+        // "." and ".." are matched by literal components only
+        GLOB_EQ("./tmp/logs/*.gz",       threads, "./tmp/logs/z.gz");
+        GLOB_EQ("tmp/logs/../logs/*.gz", threads, "tmp/logs/../logs/z.gz");
+        GLOB_EQ("tmp/./top.gz",          threads, "tmp/./top.gz");
+        GLOB_EQ("tmp/*/../top.gz",       threads, "tmp/logs/../top.gz", "tmp/other/../top.gz");
+        GLOB_EQ("tmp/logs/a/*",          threads, "tmp/logs/a/b", "tmp/logs/a/x.gz");
+        ASSERT(glob_eq("tmp/other/.*",   threads, NULL, 0));
+    }
+
+    char cwd[256];
+    ASSERT(getcwd(cwd, sizeof(cwd)));
+    char up[512];
+    snprintf(up, sizeof(up), "../%s/tmp/logs/*.gz", strrchr(cwd, '/') + 1);
+    ASSERT(glob_count(up, 2) == 1);
+
+    AIL_FS_Glob *g = ail_fs_glob_new("tmp/*/[a-", 1);
+    ASSERT(g->failed);
+    ASSERT(g->err.idx >= 6);
+    ail_fs_glob_free(g);
+
+    // One directory level more than the walker supports
+    char deep[2*(AIL_FS_GLOB_MAX_COMPONENTS + 1)];
+    for (u32 i = 0; i <= AIL_FS_GLOB_MAX_COMPONENTS; i++) { deep[2*i] = 'a'; deep[2*i + 1] = '/'; }
+    deep[sizeof(deep) - 1] = 0;
+    g = ail_fs_glob_new(deep, 1);
+    ASSERT(g->failed);
+    ASSERT(g->err.type == AIL_PM_ERR_TOO_MANY_LEVELS);
+    ASSERT(g->err.idx == 2*AIL_FS_GLOB_MAX_COMPONENTS);
+    ail_fs_glob_free(g);
+
+    // Stopping a walk early
+    g = ail_fs_glob_new("tmp/**", 2);
+    AIL_Str path;
+    ASSERT(ail_fs_glob_next(g, &path));
+    ail_fs_glob_free(g);
+
+    // A bigger tree with 6 subdirectories per directory and a file of each kind in every one of them
+    ASSERT(!mkdir("tmp/gen", DIR_MODE));
+    ASSERT(count_tree("tmp/gen", 4, true) == 1 + 6 + 36 + 216 + 1296);
+    for (u32 threads = 1; threads <= 8; threads *= 2) {
+        ASSERT(glob_count("tmp/gen/**/*.gz",  threads) == 1 + 6 + 36 + 216 + 1296);
+        ASSERT(glob_count("tmp/gen/*/*/f.gz", threads) == 36);
+        ASSERT(glob_count("tmp/gen/d[0-2]/**/d5/*.txt", threads) == 3*(1 + 6 + 36));
+        ASSERT(glob_count("tmp/gen/**/d1/d1", threads) == 1 + 6 + 36);
+    }
+    ASSERT(count_tree("tmp/gen", 4, false) == 1 + 6 + 36 + 216 + 1296);
+
+    AIL_DA(pchar) files = ail_fs_get_files_in_dir("tmp/logs");
+    qsort(files.data, files.len, sizeof(char *), cmp_pchar);
+    ASSERT(files.len == 2);
+    ASSERT(!strcmp(files.data[0], "n.txt"));
+    ASSERT(!strcmp(files.data[1], "z.gz"));
+    for (u32 i = 0; i < files.len; i++) ail_call_free(ail_default_allocator, files.data[i]);
+    ail_da_free(&files);
+
+    for (u32 i = 0; i < ail_arrlen(tree_files); i++) ASSERT(!remove(tree_files[i]));
+    for (u32 i = ail_arrlen(tree_dirs); i > 0; i--) ASSERT(!rmdir(tree_dirs[i - 1]));
+    return true;
+}
+
+int main(void)
+{
+    ail_default_allocator = ail_alloc_std;
+    if (test_read_write()) printf("\033[32mReading and writing files works as expected :)\033[0m\n");
+    else                   printf("\033[31mReading and writing files failed :(\033[0m\n");
+    if (test_glob()) printf("\033[32mGlobs are expanded as expected :)\033[0m\n");
+    else             printf("\033[31mExpanding globs failed :(\033[0m\n");
     return 0;
 }
@@ -0,0 +1,81 @@
+#include "../src/base/ail_alloc.h"
+#include "../src/base/ail_gapbuf.h"
+#include "../src/math/ail_rand.h"
+#include "assert.h"
+#include <stdio.h>
+#include <stdbool.h>
+
+#define N 2000
+
+bool basicTest(void)
+{
+    AIL_GapBuf gb = ail_gapbuf_new_cap(4);
+    ail_gapbuf_push(&gb, ail_str_from_cstr("Hello World"));
+    ail_gapbuf_insert(&gb, 5, ail_str_from_cstr(","));
+    ail_gapbuf_insert_char(&gb, ail_gapbuf_len(gb), '!');
+    ASSERT(ail_gapbuf_len(gb) == 13);
+    ASSERT(ail_str_eq(ail_gapbuf_before(gb), ail_str_from_cstr("Hello, World!")));
+    ASSERT(ail_gapbuf_get(gb, 5) == ',');
+
+    ail_gapbuf_move_gap(&gb, 5);
+    ASSERT(ail_str_eq(ail_gapbuf_before(gb), ail_str_from_cstr("Hello")));
+    ASSERT(ail_str_eq(ail_gapbuf_after(gb),  ail_str_from_cstr(", World!")));
+    ASSERT(ail_str_eq(ail_gapbuf_view(&gb, 7, 5), ail_str_from_cstr("World")));
+    ASSERT(ail_str_eq(ail_gapbuf_view(&gb, 3, 4), ail_str_from_cstr("lo, ")));
+
+    ail_gapbuf_rm(&gb, 5, 1);
+    ail_gapbuf_rm(&gb, 11, 100);
+    ASSERT(ail_str_eq(ail_gapbuf_to_str(&gb), ail_str_from_cstr("Hello World")));
+    ail_gapbuf_clear(&gb);
+    ASSERT(ail_gapbuf_len(gb) == 0);
+    ail_gapbuf_free(&gb);
+    return true;
+}
+
+bool randomEditTest(void)
+{
+    // Compare against the same edits on a plain array
+    static u8 ref[N*8];
+    u64 ref_len = 0;
+    u8 tmp[N*8];
+    AIL_GapBuf gb = ail_gapbuf_new_from_str(ail_str_from_cstr("start"));
+    ail_mem_copy(ref, "start", 5);
+    ref_len = 5;
+    for (u32 i = 0; i < N; i++) {
+        u64 pos = ail_rand_u64() % (ref_len + 1);
+        if (ail_rand_u64() & 3) {
+            u8 text[5];
+            u64 n = 1 + ail_rand_u64() % sizeof(text);
+            for (u64 j = 0; j < n; j++) text[j] = 'a' + ail_rand_u64() % 26;
+            ail_gapbuf_insert(&gb, pos, ail_str_from_parts(text, n));
+            ail_mem_copy(ref + pos + n, ref + pos, ref_len - pos);
+            ail_mem_copy(ref + pos, text, n);
+            ref_len += n;
+        } else {
+            u64 n = ail_rand_u64() % 8;
+            n = ail_min(n, ref_len - pos);
+            ail_gapbuf_rm(&gb, pos, n);
+            ail_mem_copy(ref + pos, ref + pos + n, ref_len - pos - n);
+            ref_len -= n;
+        }
+        ASSERT(ail_gapbuf_len(gb) == ref_len);
+    }
+    u64 start = ref_len/3, len = ref_len/3;
+    ail_gapbuf_copy_to(gb, start, len, tmp);
+    ASSERT(ail_str_full_eq((char *)tmp, len, (char *)ref + start, len));
+    AIL_Str view = ail_gapbuf_view(&gb, start, len);
+    ASSERT(ail_str_full_eq((char *)view.data, view.len, (char *)ref + start, len));
+    ASSERT(ail_str_full_eq((char *)ail_gapbuf_to_str(&gb).data, ref_len, (char *)ref, ref_len));
+    ail_gapbuf_free(&gb);
+    return true;
+}
+
+int main(void)
+{
+    ail_default_allocator = ail_alloc_std;
+    if (basicTest())      printf("\033[32mBasic Test succesful       :)\033[0m\n");
+    else                  printf("\033[31mBasic Test failed          :(\033[0m\n");
+    if (randomEditTest()) printf("\033[32mRandom Edit Test succesful :)\033[0m\n");
+    else                  printf("\033[31mRandom Edit Test failed    :(\033[0m\n");
+    return 0;
+}
@@ -0,0 +1,105 @@
+#include "../src/base/ail_alloc.h"
+#include "../src/base/ail_heap.h"
+#include "../src/math/ail_rand.h"
+#include "assert.h"
+#include <stdio.h>
+#include <stdbool.h>
+
+#define N 1000
+
+typedef struct Timer {
+    u64 deadline;
+    u32 id;
+} Timer;
+AIL_DA_INIT(Timer);
+AIL_IHEAP_INIT(u64);
+
+#define timer_less(a, b) ((a).deadline < (b).deadline)
+
+bool binaryTest(void)
+{
+    AIL_DA(u32) heap = ail_da_new_with_cap(u32, 4);
+    for (u32 i = 0; i < N; i++) ail_heap_push(&heap, (u32)(ail_rand_u64() % 5000), ail_heap_lt);
+    ASSERT(heap.len == N);
+    u32 prev = 0;
+    for (u32 i = 0; i < N; i++) {
+        u32 x;
+        ail_heap_pop(&heap, x, ail_heap_lt);
+        ASSERT(x >= prev);
+        prev = x;
+    }
+    ASSERT(heap.len == 0);
+    ail_da_free(&heap);
+    return true;
+}
+
+bool quaternaryTest(void)
+{
+    AIL_DA(Timer) heap = ail_da_empty(Timer);
+    for (u32 i = 0; i < N; i++) ail_heap4_push(&heap, ((Timer){ .deadline = ail_rand_u64() % 5000, .id = i }), timer_less);
+    // Move the last timer to the front of the queue
+    ail_heap4_decrease_key(&heap, heap.len - 1, ((Timer){ .deadline = 0, .id = N }), timer_less);
+    ASSERT(ail_heap4_peek(&heap).id == N);
+    u64 prev = 0;
+    for (u32 i = 0; i < N; i++) {
+        Timer t;
+        ail_heap4_pop(&heap, t, timer_less);
+        ASSERT(t.deadline >= prev);
+        prev = t.deadline;
+    }
+    ail_da_free(&heap);
+    return true;
+}
+
+bool heapifyTest(void)
+{
+    AIL_DA(i32) heap = ail_da_new_with_cap(i32, N);
+    for (u32 i = 0; i < N; i++) heap.data[heap.len++] = (i32)(ail_rand_u64() % 5000) - 2500;
+    ail_heap_heapify(&heap, ail_heap_gt);
+    i32 prev = 2500;
+    for (u32 i = 0; i < N; i++) {
+        i32 x;
+        ail_heap_pop(&heap, x, ail_heap_gt);
+        ASSERT(x <= prev);
+        prev = x;
+    }
+    ail_da_free(&heap);
+    return true;
+}
+
+bool indexedTest(void)
+{
+    AIL_IHEAP(u64) heap = ail_iheap_new(u64, N);
+    for (u32 i = 0; i < N; i++) ail_iheap_push(&heap, i, 1000 + ail_rand_u64() % 5000, ail_heap_lt);
+    for (u32 i = 0; i < N; i += 2) ail_iheap_decrease_key(&heap, i, ail_iheap_key(&heap, i) - 1000, ail_heap_lt);
+    ail_iheap_update(&heap, 1, 0, ail_heap_lt);
+    ail_iheap_update(&heap, 3, 100000, ail_heap_lt);
+    ASSERT(ail_iheap_peek(&heap) == 1);
+    u64 prev = 0;
+    u32 id   = 0;
+    for (u32 i = 0; i < N; i++) {
+        ASSERT(heap.pos[heap.ids[0]] == 0);
+        u64 key = ail_iheap_peek_key(&heap);
+        ail_iheap_pop(&heap, id, ail_heap_lt);
+        ASSERT(key >= prev);
+        ASSERT(!ail_iheap_contains(&heap, id));
+        prev = key;
+    }
+    ASSERT(id == 3);
+    ail_iheap_free(&heap);
+    return true;
+}
+
+int main(void)
+{
+    ail_default_allocator = ail_alloc_std;
+    if (binaryTest())     printf("\033[32mTest with binary heap succesful  :)\033[0m\n");
+    else                  printf("\033[31mTest with binary heap failed     :(\033[0m\n");
+    if (quaternaryTest()) printf("\033[32mTest with 4-ary heap succesful   :)\033[0m\n");
+    else                  printf("\033[31mTest with 4-ary heap failed      :(\033[0m\n");
+    if (heapifyTest())    printf("\033[32mTest with heapify succesful      :)\033[0m\n");
+    else                  printf("\033[31mTest with heapify failed         :(\033[0m\n");
+    if (indexedTest())    printf("\033[32mTest with indexed heap succesful :)\033[0m\n");
+    else                  printf("\033[31mTest with indexed heap failed    :(\033[0m\n");
+    return 0;
+}
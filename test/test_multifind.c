@@ -0,0 +1,144 @@
+#include "../src/base/ail_alloc.h"
+#include "../src/base/ail_multifind.h"
+#include "../src/math/ail_rand.h"
+#include "assert.h"
+#include <stdio.h>
+#include <stdbool.h>
+#include <string.h>
+
+static b32 matches_at(AIL_Str str, u64 pos, AIL_Str needle)
+{
+    return pos + needle.len <= str.len && ail_str_full_eq((char *)str.data + pos, needle.len, (char *)needle.data, needle.len);
+}
+
+bool basicTest(void)
+{
+    AIL_Str needles[] = {
+        ail_str_from_cstr("he"),
+        ail_str_from_cstr("she"),
+        ail_str_from_cstr("his"),
+        ail_str_from_cstr("hers"),
+        ail_str_from_cstr("she"),
+    };
+    AIL_MultiFind mf = ail_multifind_new(needles, ail_arrlen(needles));
+    AIL_Str str = ail_str_from_cstr("ushers");
+    AIL_Str_Find_Of_Res first = ail_multifind_first(&mf, str);
+    ASSERT(first.str_idx == 1 && first.needle_idx == 1);
+    AIL_DA(AIL_Str_Find_Of_Res) all = ail_multifind_all(&mf, str);
+    ASSERT(all.len == 4);
+    ASSERT(all.data[0].str_idx == 1 && all.data[0].needle_idx == 1);
+    ASSERT(all.data[1].str_idx == 1 && all.data[1].needle_idx == 4);
+    ASSERT(all.data[2].str_idx == 2 && all.data[2].needle_idx == 0);
+    ASSERT(all.data[3].str_idx == 2 && all.data[3].needle_idx == 3);
+    ail_da_free(&all);
+    ASSERT(ail_multifind_first(&mf, ail_str_from_cstr("xyz")).str_idx == -1);
+    ail_multifind_free(&mf);
+
+    first = ail_str_find_of(str, needles, ail_arrlen(needles));
+    ASSERT(first.str_idx == 1 && first.needle_idx == 1);
+    first = ail_str_find_last_of(str, needles, ail_arrlen(needles));
+    ASSERT(first.str_idx == 2 && first.needle_idx == 0);
+    return true;
+}
+
+bool randomTest(void)
+{
+    static u8 hay[2000], bytes[400*8];
+    AIL_Str needles[400];
+    u32 counts[] = { 1, 3, 8, 9, 50, 400 };
+    for (u32 iter = 0; iter < 300; iter++) {
+        u32 count    = counts[iter % ail_arrlen(counts)];
+        u32 alphabet = 2 + iter % 4;
+        u64 n        = ail_rand_u64() % sizeof(hay);
+        for (u64 i = 0; i < n; i++) hay[i] = 'a' + ail_rand_u64() % alphabet;
+        for (u32 j = 0; j < count; j++) {
+            u64 len = 1 + ail_rand_u64() % 8;
+            for (u64 i = 0; i < len; i++) bytes[8*j + i] = 'a' + ail_rand_u64() % alphabet;
+            needles[j] = ail_str_from_parts(bytes + 8*j, len);
+        }
+        AIL_Str str = ail_str_from_parts(hay, n);
+        AIL_MultiFind mf = ail_multifind_new(needles, count);
+        AIL_DA(AIL_Str_Find_Of_Res) all = ail_multifind_all(&mf, str);
+        AIL_Str_Find_Of_Res first = ail_multifind_first(&mf, str);
+        AIL_Str_Find_Of_Res last  = { -1, -1 };
+
+        // All matches should be found in the same order by checking every position for every needle
+        u64 k = 0;
+        for (u64 p = 0; p < n; p++) {
+            for (u32 j = 0; j < count; j++) {
+                if (!matches_at(str, p, needles[j])) continue;
+                ASSERT(k < all.len && all.data[k].str_idx == (i64)p && all.data[k].needle_idx == (i32)j);
+                if (last.str_idx != (i64)p) last = (AIL_Str_Find_Of_Res){ (i64)p, (i32)j };
+                k++;
+            }
+        }
+        ASSERT(k == all.len);
+        AIL_Str_Find_Of_Res expected = all.len ? all.data[0] : (AIL_Str_Find_Of_Res){ -1, -1 };
+        ASSERT(first.str_idx == expected.str_idx && first.needle_idx == expected.needle_idx);
+        AIL_Str_Find_Of_Res res = ail_str_find_of(str, needles, count);
+        ASSERT(res.str_idx == expected.str_idx && res.needle_idx == expected.needle_idx);
+        res = ail_str_find_last_of(str, needles, count);
+        ASSERT(res.str_idx == last.str_idx && res.needle_idx == last.needle_idx);
+        ail_da_free(&all);
+        ail_multifind_free(&mf);
+    }
+    return true;
+}
+
+bool replaceTest(void)
+{
+    AIL_Str from[] = { ail_str_from_cstr("{{name}}"), ail_str_from_cstr("{{n}}"), ail_str_from_cstr("{{"), ail_str_from_cstr("") };
+    AIL_Str to[]   = { ail_str_from_cstr("World"),    ail_str_from_cstr("42"),    ail_str_from_cstr("<"),  ail_str_from_cstr("?") };
+    AIL_Str res = ail_str_replace_many(ail_str_from_cstr("Hello {{name}}, {{n}} {{x}}"), from, to, ail_arrlen(from));
+    ASSERT(ail_str_eq(res, ail_str_from_cstr("Hello World, 42 <x}}")) && res.data[res.len] == 0);
+    ail_str_free(res);
+
+    // Compare against replacing at every position by hand, with enough matches to exceed the buffer of remembered matches
+    static u8 hay[20000], bytes[50*8], out[20000*8];
+    AIL_Str needles[50], replacements[50];
+    u32 counts[] = { 1, 3, 8, 50 };
+    for (u32 iter = 0; iter < 100; iter++) {
+        u32 count    = counts[iter % ail_arrlen(counts)];
+        u32 alphabet = 2 + iter % 4;
+        u64 n        = ail_rand_u64() % sizeof(hay);
+        for (u64 i = 0; i < n; i++) hay[i] = 'a' + ail_rand_u64() % alphabet;
+        for (u32 j = 0; j < count; j++) {
+            u64 len = 1 + ail_rand_u64() % 8;
+            for (u64 i = 0; i < len; i++) bytes[8*j + i] = 'a' + ail_rand_u64() % alphabet;
+            needles[j]      = ail_str_from_parts(bytes + 8*j, len);
+            replacements[j] = ail_str_from_parts((u8 *)"0123456789", ail_rand_u64() % 11);
+        }
+        AIL_Str str = ail_str_from_parts(hay, n);
+        AIL_MultiFind mf = ail_multifind_new(needles, count);
+        res = ail_multifind_replace(&mf, str, replacements);
+
+        u64 len = 0;
+        for (u64 p = 0; p < n;) {
+            u32 j = 0;
+            while (j < count && !matches_at(str, p, needles[j])) j++;
+            if (j < count) {
+                memcpy(out + len, replacements[j].data, replacements[j].len);
+                len += replacements[j].len;
+                p   += needles[j].len;
+            } else {
+                out[len++] = hay[p++];
+            }
+        }
+        ASSERT(res.len == len && memcmp(res.data, out, len) == 0 && res.data[len] == 0);
+        ail_str_free(res);
+        ail_multifind_free(&mf);
+    }
+    return true;
+}
+
+int main(void)
+{
+    ail_default_allocator = ail_alloc_std;
+    if (basicTest())  printf("\033[32mBasic Test succesful  :)\033[0m\n");
+    else              printf("\033[31mBasic Test failed     :(\033[0m\n");
+    if (randomTest()) printf("\033[32mRandom Test succesful :)\033[0m\n");
+    else              printf("\033[31mRandom Test failed    :(\033[0m\n");
+    if (replaceTest()) printf("\033[32mReplace Test succesful :)\033[0m\n");
+    else               printf("\033[31mReplace Test failed    :(\033[0m\n");
+    return 0;
+}
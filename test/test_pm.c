@@ -89,7 +89,9 @@
 
 #include "../src/base/ail_str.h"
 #include "../src/pm/ail_pm.h"
+#include "../src/math/ail_rand.h"
 #include "./assert.h"
+#include <pthread.h>
 
 typedef struct SuccTest {
     AIL_Str pattern;
@@ -756,6 +758,567 @@ b32 succ_tests(SuccTest tests[], u32 count, AIL_PM_Exp_Type type)
     return true;
 }
 
+// Whether s[i..j) is matched exactly by els[k..]
+static b32 ref_match_exact(AIL_PM_El *els, u32 k, u32 ellen, const char *s, u32 i, u32 j)
+{
+    if (k == ellen) return i == j;
+    u64 set[4];
+    _ail_pm_el_set(els[k], set);
+    #define IN_SET(c) ((set[(u8)(c)/64] >> ((u8)(c)%64)) & 1)
+    switch (els[k].count) {
+        case AIL_PM_COUNT_ONCE:        return i < j && IN_SET(s[i]) && ref_match_exact(els, k + 1, ellen, s, i + 1, j);
+        case AIL_PM_COUNT_ONE_OR_NONE: return ref_match_exact(els, k + 1, ellen, s, i, j) || (i < j && IN_SET(s[i]) && ref_match_exact(els, k + 1, ellen, s, i + 1, j));
+        case AIL_PM_COUNT_ONE_PLUS:
+        case AIL_PM_COUNT_ZERO_PLUS: {
+            u32 n = i;
+            if (els[k].count == AIL_PM_COUNT_ONE_PLUS) {
+                if (i >= j || !IN_SET(s[i])) return false;
+                n++;
+            }
+            for (;; n++) {
+                if (ref_match_exact(els, k + 1, ellen, s, n, j)) return true;
+                if (n >= j || !IN_SET(s[n])) return false;
+            }
+        }
+        case AIL_PM_COUNT_COUNT: break;
+    }
+    #undef IN_SET
+    return false;
+}
+
+// Leftmost-longest non-empty match found by trying every start and end
+static AIL_PM_Match ref_match(AIL_PM_Pattern p, const char *s, u32 len)
+{
+    for (u32 i = 0; i < len; i++) {
+        if ((p.attrs & AIL_PM_ATTR_START) && i > 0) break;
+        for (u32 j = len; j > i; j--) {
+            if ((p.attrs & AIL_PM_ATTR_END) && j < len) break;
+            if (ref_match_exact(p.els, 0, p.len, s, i, j)) return (AIL_PM_Match){ .idx = i, .len = j - i };
+        }
+    }
+    return (AIL_PM_Match){0};
+}
+
+b32 dfa_tests(void)
+{
+    const char *atoms[] = { "a", "b", ".", "[ab]", "[^ab]", "\\d", "\\s", "\\w" };
+    const char *counts[] = { "", "", "*", "+", "?" };
+    const char *alphabet = "aab1 \n";
+    char pattern[64], str[16];
+    for (u32 iter = 0; iter < 20000; iter++) {
+        u32 n = 0;
+        if (ail_rand_u64() % 4 == 0) pattern[n++] = '^';
+        u32 els = 1 + ail_rand_u64() % 5;
+        for (u32 i = 0; i < els; i++) {
+            n += sprintf(pattern + n, "%s%s", atoms[ail_rand_u64() % ail_arrlen(atoms)], counts[ail_rand_u64() % ail_arrlen(counts)]);
+        }
+        if (ail_rand_u64() % 4 == 0) pattern[n++] = '$';
+        pattern[n] = 0;
+        u32 len = ail_rand_u64() % sizeof(str);
+        for (u32 i = 0; i < len; i++) str[i] = alphabet[ail_rand_u64() % 6];
+
+        AIL_PM_Comp_Res cr = ail_pm_compile(pattern, n, AIL_PM_EXP_REGEX);
+        ASSERT(!cr.failed);
+        AIL_PM_DFA dfa = ail_pm_dfa_new(cr.pattern);
+        AIL_PM_Match expected = ref_match(cr.pattern, str, len);
+        AIL_PM_Match got      = ail_pm_dfa_match(&dfa, str, len);
+        if (!ail_pm_match_eq(got, expected)) {
+            printf("\033[31mPattern '%s' on '%.*s': Expected (%u, %u) - Received (%u, %u)\033[0m\n", pattern, len, str, expected.idx, expected.len, got.idx, got.len);
+            return false;
+        }
+        ASSERT(ail_pm_dfa_matches(&dfa, str, len) == (expected.len > 0));
+        ail_pm_dfa_free(&dfa);
+        ail_pm_free(cr.pattern);
+    }
+
+    // Patterns, which make backtracking take super-quadratic time, and a pattern with more DFA states than fit into the cache
+    static char long_str[100000];
+    memset(long_str, 'a', sizeof(long_str));
+    AIL_PM_Comp_Res cr = ail_pm_compile_str(ail_str_from_cstr("a*a*a*a*a*a*b"), AIL_PM_EXP_REGEX);
+    AIL_PM_DFA dfa = ail_pm_dfa_new(cr.pattern);
+    ASSERT(ail_pm_dfa_match(&dfa, long_str, sizeof(long_str)).len == 0);
+    long_str[sizeof(long_str) - 1] = 'b';
+    ASSERT(ail_pm_match_eq(ail_pm_dfa_match(&dfa, long_str, sizeof(long_str)), (AIL_PM_Match){ 0, sizeof(long_str) }));
+    ail_pm_dfa_free(&dfa);
+    ail_pm_free(cr.pattern);
+
+    for (u32 i = 0; i < sizeof(long_str); i++) long_str[i] = "ab"[ail_rand_u64() & 1];
+    cr = ail_pm_compile_str(ail_str_from_cstr("a.........................b"), AIL_PM_EXP_REGEX);
+    dfa = ail_pm_dfa_new(cr.pattern);
+    AIL_PM_Match m = ail_pm_dfa_match(&dfa, long_str, sizeof(long_str));
+    ASSERT(ail_pm_match_eq(m, ref_match(cr.pattern, long_str, 200)));
+    for (u32 i = 0; i + 27 <= sizeof(long_str); i += 27) ail_pm_dfa_matches(&dfa, long_str + i, sizeof(long_str) - i);
+    ASSERT(dfa.fwd.flushes > 0);
+    ail_pm_dfa_free(&dfa);
+    ail_pm_free(cr.pattern);
+    return true;
+}
+
+b32 class_tests(void)
+{
+    struct { const char *p; const char *members; } tests[] = {
+        { "[abc]",     "abc" },
+        { "[a-cx]",    "abcx" },
+        { "[]a]",      "]a" },
+        { "[\\]\\-]", "]-" },
+        { "[0-9A-F]",  "0123456789ABCDEF" },
+        { "\\d",       "0123456789" },
+        { "\\s",       " \t\n\v\f\r" },
+    };
+    for (u32 i = 0; i < ail_arrlen(tests); i++) {
+        AIL_PM_Comp_Res cr = ail_pm_compile_str(ail_str_from_cstr((char *)tests[i].p), AIL_PM_EXP_REGEX);
+        ASSERT(!cr.failed && cr.pattern.len == 1);
+        for (u32 c = 1; c < 256; c++) {
+            ASSERT(_ail_pm_match_el(cr.pattern.els, (u8)c) == (strchr(tests[i].members, (int)c) != NULL));
+        }
+        ail_pm_free(cr.pattern);
+    }
+
+    // Inverted classes and \w
+    AIL_PM_Comp_Res cr = ail_pm_compile_str(ail_str_from_cstr("[^a-z]\\w\\W"), AIL_PM_EXP_REGEX);
+    ASSERT(!cr.failed && cr.pattern.len == 3);
+    for (u32 c = 0; c < 256; c++) {
+        b32 word = ail_str_is_alpha((char)c) || ail_str_is_digit((char)c) || c == '_';
+        ASSERT(_ail_pm_match_el(&cr.pattern.els[0], (u8)c) == !('a' <= c && c <= 'z'));
+        ASSERT(_ail_pm_match_el(&cr.pattern.els[1], (u8)c) == word);
+        ASSERT(_ail_pm_match_el(&cr.pattern.els[2], (u8)c) == !word);
+    }
+
+    // Runs of class members are counted like byte by byte
+    static u8 buf[1000];
+    for (u32 iter = 0; iter < 2000; iter++) {
+        const AIL_PM_El *el = &cr.pattern.els[ail_rand_u64() % 3];
+        for (u32 i = 0; i < sizeof(buf); i++) buf[i] = (u8)ail_rand_u64();
+        u32 len = ail_rand_u64() % sizeof(buf);
+        u32 stop = ail_rand_u64() % (len + 1);
+        for (u32 i = 0; i < stop; i++) {
+            while (!_ail_pm_match_el(el, buf[i])) buf[i] = (u8)ail_rand_u64();
+        }
+        u32 expected = 0;
+        while (expected < len && _ail_pm_match_el(el, buf[expected])) expected++;
+        ASSERT(_ail_pm_el_run(el, buf, len) == expected);
+    }
+    ail_pm_free(cr.pattern);
+    return true;
+}
+
+// Writes a random pattern built from `atoms` into `pattern`
+static u32 random_pattern(char *pattern, const char **atoms, u32 atoms_count, b32 anchors)
+{
+    const char *counts[] = { "", "", "*", "+", "?" };
+    u32 n = 0;
+    if (anchors && ail_rand_u64() % 4 == 0) pattern[n++] = '^';
+    u32 els = 1 + ail_rand_u64() % 5;
+    for (u32 i = 0; i < els; i++) {
+        n += sprintf(pattern + n, "%s%s", atoms[ail_rand_u64() % atoms_count], counts[ail_rand_u64() % ail_arrlen(counts)]);
+    }
+    if (anchors && ail_rand_u64() % 4 == 0) pattern[n++] = '$';
+    pattern[n] = 0;
+    return n;
+}
+
+b32 set_tests(void)
+{
+    const char *atoms[] = { "a", "b", "c", ".", "[ab]", "[^ab]", "\\d", "\\s" };
+    const char *alphabet = "aabc1 \n";
+    static AIL_PM_Pattern patterns[300];
+    static AIL_PM_DFA     dfas[300];
+    char pattern[64], str[32];
+    AIL_Bitset matched = ail_bitset_new(ail_arrlen(patterns), ail_default_allocator);
+    for (u32 iter = 0; iter < 300; iter++) {
+        u32 count = iter < 290 ? 1 + ail_rand_u64() % 40 : ail_arrlen(patterns);
+        for (u32 k = 0; k < count; k++) {
+            u32 n = random_pattern(pattern, atoms, ail_arrlen(atoms), true);
+            AIL_PM_Exp_Type type = pattern[0] == '^' || ail_rand_u64() % 8 ? AIL_PM_EXP_REGEX : AIL_PM_EXP_GLOB;
+            if (type == AIL_PM_EXP_GLOB) n = sprintf(pattern, "%s*%s", atoms[ail_rand_u64() % 3], atoms[ail_rand_u64() % 3]);
+            AIL_PM_Comp_Res cr = ail_pm_compile(pattern, n, type);
+            ASSERT(!cr.failed);
+            patterns[k] = cr.pattern;
+            dfas[k]     = ail_pm_dfa_new(cr.pattern);
+        }
+        AIL_PM_Set set = ail_pm_set_new(patterns, count);
+        for (u32 j = 0; j < 20; j++) {
+            u32 len = ail_rand_u64() % sizeof(str);
+            for (u32 i = 0; i < len; i++) str[i] = alphabet[ail_rand_u64() % 7];
+            u32 expected = 0;
+            for (u32 k = 0; k < count; k++) expected += ail_pm_dfa_matches(&dfas[k], str, len);
+            ASSERT(ail_pm_set_matches_all(&set, str, len, matched) == expected);
+            for (u32 k = 0; k < count; k++) ASSERT(ail_bitset_test(matched, k) == ail_pm_dfa_matches(&dfas[k], str, len));
+            i32 any = ail_pm_set_matches_any(&set, str, len);
+            ASSERT(expected ? (any >= 0 && ail_bitset_test(matched, (u64)any)) : any == -1);
+        }
+        ail_pm_set_free(&set);
+        for (u32 k = 0; k < count; k++) {
+            ail_pm_dfa_free(&dfas[k]);
+            ail_pm_free(patterns[k]);
+        }
+    }
+
+    // A set without any patterns never matches
+    AIL_PM_Set empty = ail_pm_set_new(patterns, 0);
+    ASSERT(ail_pm_set_matches_any(&empty, "abc", 3) == -1);
+    ASSERT(ail_pm_set_matches_all(&empty, "abc", 3, matched) == 0);
+    ail_pm_set_free(&empty);
+    ail_bitset_free(&matched, ail_default_allocator);
+    return true;
+}
+
+b32 stream_tests(void)
+{
+    const char *atoms[] = { "a", "b", ".", "[ab]", "[^ab]", "\\d", "\\s" };
+    const char *alphabet = "aab1 \n";
+    char pattern[64], str[64];
+    for (u32 iter = 0; iter < 5000; iter++) {
+        u32 n = random_pattern(pattern, atoms, ail_arrlen(atoms), true);
+        u32 len = ail_rand_u64() % sizeof(str);
+        for (u32 i = 0; i < len; i++) str[i] = alphabet[ail_rand_u64() % 6];
+        AIL_PM_Comp_Res cr = ail_pm_compile(pattern, n, AIL_PM_EXP_REGEX);
+        ASSERT(!cr.failed);
+        AIL_PM_Pattern p = cr.pattern;
+
+        // A match ends after the e-th byte, if any non-empty match ends there
+        b32 expected[sizeof(str) + 1] = {0};
+        for (u32 e = 1; e <= len; e++) {
+            if ((p.attrs & AIL_PM_ATTR_END) && e != len) continue;
+            for (u32 start = 0; start < e && !expected[e]; start++) {
+                if ((p.attrs & AIL_PM_ATTR_START) && start) break;
+                expected[e] = ref_match_exact(p.els, 0, p.len, str, start, e);
+            }
+        }
+
+        AIL_PM_Stream st = ail_pm_stream_new(p);
+        b32 got[sizeof(str) + 1] = {0};
+        u64 end;
+        for (u32 i = 0; i < len;) {
+            u32 chunk = (u32)(ail_rand_u64() % 6);
+            chunk = ail_min(len - i, chunk);
+            ail_pm_stream_feed(&st, str + i, chunk);
+            while (ail_pm_stream_next(&st, &end)) {
+                ASSERT(end > i && end <= i + chunk && !got[end]);
+                got[end] = true;
+            }
+            i += chunk;
+        }
+        if (ail_pm_stream_finish(&st, &end)) {
+            ASSERT(end == len && !got[end]);
+            got[end] = true;
+        }
+        for (u32 e = 0; e <= len; e++) {
+            if (got[e] != expected[e]) {
+                printf("\033[31mPattern '%s' on '%.*s': Expected a match ending at %u to %s\033[0m\n", pattern, len, str, e, expected[e] ? "be found" : "not be found");
+                return false;
+            }
+        }
+        ail_pm_stream_free(&st);
+        ail_pm_free(p);
+    }
+
+    // Offsets keep counting across many chunks
+    AIL_PM_Comp_Res cr = ail_pm_compile_str(ail_str_from_cstr("ab"), AIL_PM_EXP_REGEX);
+    AIL_PM_Stream st = ail_pm_stream_new(cr.pattern);
+    u64 end, count = 0, last = 0;
+    for (u32 i = 0; i < 100000; i++) {
+        ail_pm_stream_feed(&st, i % 2 ? "bxa" : "xxa", 3);
+        while (ail_pm_stream_next(&st, &end)) {
+            count++;
+            last = end;
+        }
+    }
+    ASSERT(count == 50000 && last == 3*99999 + 1);
+    ASSERT(!ail_pm_stream_finish(&st, &end));
+    ail_pm_stream_free(&st);
+    ail_pm_free(cr.pattern);
+    return true;
+}
+
+b32 find_all_tests(void)
+{
+    const char *atoms[] = { "a", "b", ".", "[ab]", "[^ab]", "\\d", "\\s" };
+    const char *alphabet = "aab1 \n";
+    char pattern[64], str[256];
+    for (u32 iter = 0; iter < 3000; iter++) {
+        u32 n = random_pattern(pattern, atoms, ail_arrlen(atoms), true);
+        u32 len = ail_rand_u64() % sizeof(str);
+        for (u32 i = 0; i < len; i++) str[i] = alphabet[ail_rand_u64() % 6];
+        AIL_PM_Comp_Res cr = ail_pm_compile(pattern, n, AIL_PM_EXP_REGEX);
+        ASSERT(!cr.failed);
+        AIL_PM_Pattern p = cr.pattern;
+        AIL_PM_DFA dfa = ail_pm_dfa_new(p);
+
+        // Every match is the leftmost-longest match in the input after the previous match
+        AIL_DA(AIL_PM_Match64) matches = ail_da_new(AIL_PM_Match64);
+        AIL_PM_Match_Iter it = ail_pm_match_iter(&dfa, str, len);
+        AIL_PM_Match64 m;
+        u64 pos = 0;
+        while (ail_pm_match_iter_next(&it, &m)) {
+            ASSERT(m.idx >= pos && m.len > 0 && m.idx + m.len <= len);
+            AIL_PM_Match ref = ail_pm_dfa_match(&dfa, str + pos, len - (u32)pos);
+            if (pos && (p.attrs & AIL_PM_ATTR_START)) ref.len = 0;
+            ASSERT(ref.len == m.len && ref.idx + pos == m.idx);
+            ail_da_push(&matches, m);
+            pos = m.idx + m.len;
+        }
+        ASSERT(!ail_pm_dfa_match(&dfa, str + pos, len - (u32)pos).len || (pos && (p.attrs & AIL_PM_ATTR_START)));
+
+        // Splitting the input into chunks doesn't change the matches
+        u32 threads = 1 + ail_rand_u64() % 8;
+        AIL_DA(AIL_PM_Match64) all = ail_pm_find_all(p, str, len, threads);
+        if (all.len != matches.len || memcmp(all.data, matches.data, all.len*sizeof(AIL_PM_Match64))) {
+            printf("\033[31mPattern '%s' on '%.*s': Expected %llu matches from ail_pm_find_all, but got %llu\033[0m\n", pattern, len, str, (unsigned long long)matches.len, (unsigned long long)all.len);
+            return false;
+        }
+        ail_da_free(&all);
+        ail_da_free(&matches);
+        ail_pm_dfa_free(&dfa);
+        ail_pm_free(p);
+    }
+
+    // Large inputs are split into one chunk per thread
+    u64 len = 8*AIL_PM_FIND_ALL_MIN_CHUNK + 123;
+    char *big = ail_call_alloc(ail_default_allocator, len);
+    for (u64 i = 0; i < len; i++) big[i] = alphabet[ail_rand_u64() % 6];
+    const char *patterns[] = { "ab+1", "^a", "a\\s*1", "b$", "[^\\n]+", "1\\sa" };
+    for (u32 i = 0; i < ail_arrlen(patterns); i++) {
+        AIL_PM_Comp_Res cr = ail_pm_compile_str(ail_str_from_cstr((char *)patterns[i]), AIL_PM_EXP_REGEX);
+        ASSERT(!cr.failed);
+        AIL_PM_DFA dfa = ail_pm_dfa_new(cr.pattern);
+        for (u32 threads = 0; threads <= 8; threads += 3) {
+            AIL_PM_Match_Iter it = ail_pm_match_iter(&dfa, big, len);
+            AIL_DA(AIL_PM_Match64) all = ail_pm_find_all(cr.pattern, big, len, threads);
+            AIL_PM_Match64 m;
+            u64 count = 0;
+            while (ail_pm_match_iter_next(&it, &m)) {
+                ASSERT(count < all.len && all.data[count].idx == m.idx && all.data[count].len == m.len);
+                count++;
+            }
+            ASSERT(count == all.len);
+            ail_da_free(&all);
+        }
+        ail_pm_dfa_free(&dfa);
+        ail_pm_free(cr.pattern);
+    }
+    ail_call_free(ail_default_allocator, big);
+    return true;
+}
+
+b32 jit_tests(void)
+{
+    const char *atoms[] = { "a", "b", "ab", "ba1", ".", "[ab]", "[^ab]", "\\d", "\\s", "[a-c1-3]" };
+    const char *alphabet = "aab1 \nc3";
+    char pattern[64], str[128];
+    u32 compiled = 0;
+    for (u32 iter = 0; iter < 3000; iter++) {
+        u32 n = random_pattern(pattern, atoms, ail_arrlen(atoms), true);
+        AIL_PM_Comp_Res cr = ail_pm_compile(pattern, n, AIL_PM_EXP_REGEX);
+        ASSERT(!cr.failed);
+        AIL_PM_DFA dfa = ail_pm_dfa_new(cr.pattern);
+        AIL_PM_DFA jit = ail_pm_dfa_new(cr.pattern);
+        b32 ok = ail_pm_dfa_jit(&jit);
+        ASSERT(ok == (jit.jit_code != NULL));
+        compiled += ok;
+        for (u32 k = 0; k < 20; k++) {
+            u32 len = ail_rand_u64() % sizeof(str);
+            for (u32 i = 0; i < len; i++) str[i] = alphabet[ail_rand_u64() % 8];
+            AIL_PM_Match expected = ail_pm_dfa_match(&dfa, str, len);
+            AIL_PM_Match got      = ail_pm_dfa_match(&jit, str, len);
+            if (!ail_pm_match_eq(expected, got) || ail_pm_dfa_matches(&jit, str, len) != (expected.len > 0)) {
+                printf("\033[31mPattern '%s' on '%.*s': Expected (%u, %u), but the compiled DFA found (%u, %u)\033[0m\n", pattern, len, str, expected.idx, expected.len, got.idx, got.len);
+                return false;
+            }
+        }
+        ail_pm_dfa_free(&jit);
+        ail_pm_dfa_free(&dfa);
+        ail_pm_free(cr.pattern);
+    }
+    ASSERT(AIL_PM_JIT ? compiled > 2900 : !compiled);
+
+    // Patterns with too many states are interpreted instead
+    AIL_PM_Comp_Res cr = ail_pm_compile_str(ail_str_from_cstr("a.........b"), AIL_PM_EXP_REGEX);
+    AIL_PM_DFA dfa = ail_pm_dfa_new(cr.pattern);
+    ASSERT(!ail_pm_dfa_jit(&dfa) && !dfa.jit_code);
+    ASSERT(ail_pm_match_eq(ail_pm_dfa_match(&dfa, "xxa123456789bx", 14), (AIL_PM_Match){ 2, 11 }));
+    ail_pm_dfa_free(&dfa);
+    ail_pm_free(cr.pattern);
+    return true;
+}
+
+static b32 pattern_eq(AIL_PM_Comp_Res a, AIL_PM_Comp_Res b)
+{
+    if (a.failed != b.failed) return false;
+    if (a.failed) return pm_err_eq(a.err, b.err);
+    return a.pattern.len == b.pattern.len && a.pattern.attrs == b.pattern.attrs &&
+           memcmp(a.pattern.els, b.pattern.els, a.pattern.len*sizeof(AIL_PM_El)) == 0;
+}
+
+// Writes one of `count` different patterns into `pattern`, some of which are long and some of which are invalid
+static u32 cache_pattern(char *pattern, u32 count)
+{
+    u32 id = ail_rand_u64() % count;
+    u32 n  = sprintf(pattern, "%s%u", id % 7 ? "a[bc]+" : "*x", id);
+    for (u32 i = 0; i < id % 200; i++) pattern[n++] = 'a' + (id + i) % 26;
+    pattern[n] = 0;
+    return n;
+}
+
+static AIL_PM_Cache shared_cache;
+
+static void *cache_thread(void *arg)
+{
+    char pattern[256];
+    for (u32 i = 0; i < 2000; i++) {
+        // Each thread uses its own random state, so that the threads don't share any state except for the cache
+        u64 *rs = arg;
+        *rs ^= *rs << 13; *rs ^= *rs >> 7; *rs ^= *rs << 17;
+        u32 id = *rs % 300;
+        u32 n  = sprintf(pattern, "%s%u", id % 7 ? "a[bc]+" : "*x", id);
+        for (u32 j = 0; j < id % 200; j++) pattern[n++] = 'a' + (id + j) % 26;
+        AIL_PM_Comp_Res expected = ail_pm_compile(pattern, n, AIL_PM_EXP_REGEX);
+        AIL_PM_Comp_Res got      = ail_pm_cache_compile(&shared_cache, pattern, n, AIL_PM_EXP_REGEX);
+        if (!pattern_eq(expected, got)) return (void *)1;
+        if (!expected.failed) ail_pm_free(expected.pattern);
+        if (!got.failed)      ail_pm_free(got.pattern);
+    }
+    return NULL;
+}
+
+b32 cache_tests(void)
+{
+    AIL_PM_Cache cache = ail_pm_cache_new(2);
+    AIL_PM_Comp_Res a = ail_pm_cache_compile(&cache, "a+b", 3, AIL_PM_EXP_REGEX);
+    AIL_PM_Comp_Res b = ail_pm_cache_compile(&cache, "a+b", 3, AIL_PM_EXP_GLOB);
+    AIL_PM_Comp_Res c = ail_pm_cache_compile(&cache, "a+b", 3, AIL_PM_EXP_REGEX);
+    ASSERT(cache.hits == 1 && cache.misses == 2 && cache.count == 2);
+    ASSERT(pattern_eq(a, c) && !pattern_eq(a, b) && a.pattern.els != c.pattern.els);
+    ail_pm_free(a.pattern);
+    ail_pm_free(b.pattern);
+    ail_pm_free(c.pattern);
+    // The glob pattern was used least recently, so it is evicted first
+    AIL_PM_Comp_Res err = ail_pm_cache_compile(&cache, "a**", 3, AIL_PM_EXP_REGEX);
+    ASSERT(err.failed && err.err.type == AIL_PM_ERR_INVALID_COUNT_QUALIFIER && cache.misses == 3);
+    err = ail_pm_cache_compile(&cache, "a**", 3, AIL_PM_EXP_REGEX);
+    ASSERT(err.failed && cache.hits == 2);
+    a = ail_pm_cache_compile(&cache, "a+b", 3, AIL_PM_EXP_REGEX);
+    ASSERT(cache.hits == 3);
+    ail_pm_free(a.pattern);
+    b = ail_pm_cache_compile(&cache, "a+b", 3, AIL_PM_EXP_GLOB);
+    ASSERT(cache.misses == 4 && cache.count == 2);
+    ail_pm_free(b.pattern);
+    ail_pm_cache_free(&cache);
+
+    // Many long patterns, so that the arena is compacted several times
+    char pattern[256];
+    cache = ail_pm_cache_new(64);
+    for (u32 i = 0; i < 20000; i++) {
+        u32 n = cache_pattern(pattern, 300);
+        AIL_PM_Comp_Res expected = ail_pm_compile(pattern, n, AIL_PM_EXP_REGEX);
+        AIL_PM_Comp_Res got      = ail_pm_cache_compile(&cache, pattern, n, AIL_PM_EXP_REGEX);
+        ASSERT(pattern_eq(expected, got));
+        if (!expected.failed) ail_pm_free(expected.pattern);
+        if (!got.failed)      ail_pm_free(got.pattern);
+    }
+    ASSERT(cache.count == 64 && cache.hits + cache.misses == 20000 && cache.hits > 0);
+    ASSERT(cache.arena_used <= 2*cache.arena_live || cache.arena_used <= AIL_PM_CACHE_ARENA_SIZE);
+    ail_pm_cache_free(&cache);
+
+    // Several threads use the same cache
+    shared_cache = ail_pm_cache_new(100);
+    pthread_t threads[4];
+    u64 states[4];
+    for (u32 i = 0; i < 4; i++) {
+        states[i] = ail_rand_u64() | 1;
+        ASSERT(pthread_create(&threads[i], NULL, cache_thread, &states[i]) == 0);
+    }
+    b32 ok = true;
+    for (u32 i = 0; i < 4; i++) {
+        void *res;
+        pthread_join(threads[i], &res);
+        ok &= res == NULL;
+    }
+    ASSERT(ok && shared_cache.hits + shared_cache.misses == 4*2000);
+    ail_pm_cache_free(&shared_cache);
+    return true;
+}
+
+static b32 literal_eq(AIL_PM_Literal lit, const char *data, u32 min_off, u32 max_off)
+{
+    return lit.len == strlen(data) && memcmp(lit.data, data, lit.len) == 0 && lit.min_off == min_off && lit.max_off == max_off;
+}
+
+b32 literal_tests(void)
+{
+    struct { const char *p; const char *lit; u32 min_off, max_off; } tests[] = {
+        { "abc",         "abc", 0, 0 },
+        { "x?\\d+hello.*", "hello", 1, AIL_PM_LITERAL_UNBOUNDED },
+        { "\\d?.ab",     "ab",   1, 2 },
+        { "a+bc",        "abc",  0, AIL_PM_LITERAL_UNBOUNDED },
+        { "ab+c",        "ab",   0, 0 },
+        { "a*b*",        "",     0, 0 },
+        { ".a.q.",       "q",    3, 3 },
+    };
+    for (u32 i = 0; i < ail_arrlen(tests); i++) {
+        AIL_PM_Comp_Res cr = ail_pm_compile_str(ail_str_from_cstr((char *)tests[i].p), AIL_PM_EXP_REGEX);
+        ASSERT(!cr.failed);
+        if (!literal_eq(cr.pattern.lit, tests[i].lit, tests[i].min_off, tests[i].max_off)) {
+            printf("\033[31mPattern '%s': Expected literal '%s' at [%u, %u] - Received '%.*s' at [%u, %u]\033[0m\n", tests[i].p, tests[i].lit, tests[i].min_off, tests[i].max_off,
+                   cr.pattern.lit.len, cr.pattern.lit.data, cr.pattern.lit.min_off, cr.pattern.lit.max_off);
+            return false;
+        }
+        ail_pm_free(cr.pattern);
+    }
+
+    // Skipping to the literal doesn't change the result of the backtracking matcher, where it matches like the reference implementation
+    const char *atoms[] = { "a", "b", "c", ".", "[ab]", "\\d" };
+    const char *counts[] = { "", "", "", "*", "+", "?" };
+    const char *alphabet = "aabc1 ";
+    char pattern[64], str[32];
+    for (u32 iter = 0; iter < 20000; iter++) {
+        u32 n = 0;
+        u32 els = 1 + ail_rand_u64() % 6;
+        for (u32 i = 0; i < els; i++) {
+            n += sprintf(pattern + n, "%s%s", atoms[ail_rand_u64() % ail_arrlen(atoms)], counts[ail_rand_u64() % ail_arrlen(counts)]);
+        }
+        if (ail_rand_u64() % 4 == 0) pattern[n++] = '$';
+        pattern[n] = 0;
+        u32 len = ail_rand_u64() % sizeof(str);
+        for (u32 i = 0; i < len; i++) str[i] = alphabet[ail_rand_u64() % 6];
+
+        AIL_PM_Comp_Res cr = ail_pm_compile(pattern, n, AIL_PM_EXP_REGEX);
+        ASSERT(!cr.failed);
+        AIL_PM_Pattern unfiltered = cr.pattern;
+        unfiltered.lit.len = 0;
+        AIL_PM_Match expected = ail_pm_match_greedy(unfiltered, str, len);
+        AIL_PM_Match got      = ail_pm_match_greedy(cr.pattern, str, len);
+        if (ail_pm_match_eq(expected, ref_match(cr.pattern, str, len)) && !ail_pm_match_eq(got, expected)) {
+            printf("\033[31mPattern '%s' on '%.*s': Expected (%u, %u) - Received (%u, %u)\033[0m\n", pattern, len, str, expected.idx, expected.len, got.idx, got.len);
+            return false;
+        }
+        ail_pm_free(cr.pattern);
+    }
+
+    // Long inputs, in which the literal is rare
+    static char long_str[100000];
+    for (u32 i = 0; i < sizeof(long_str); i++) long_str[i] = "abc "[ail_rand_u64() & 3];
+    memcpy(long_str + 77775, " xERROR: 42", 11);
+    AIL_PM_Comp_Res cr = ail_pm_compile_str(ail_str_from_cstr("\\w+ERROR: \\d+"), AIL_PM_EXP_REGEX);
+    ASSERT(literal_eq(cr.pattern.lit, "ERROR: ", 1, AIL_PM_LITERAL_UNBOUNDED));
+    AIL_PM_DFA dfa = ail_pm_dfa_new(cr.pattern);
+    AIL_PM_Match m = ail_pm_dfa_match(&dfa, long_str, sizeof(long_str));
+    ASSERT(m.idx == 77776 && m.len == 10);
+    long_str[77777] = 'e';
+    ASSERT(ail_pm_dfa_match(&dfa, long_str, sizeof(long_str)).len == 0);
+    ail_pm_dfa_free(&dfa);
+    ail_pm_free(cr.pattern);
+
+    cr = ail_pm_compile_str(ail_str_from_cstr("a.q"), AIL_PM_EXP_REGEX);
+    memcpy(long_str + sizeof(long_str) - 3, "abq", 3);
+    dfa = ail_pm_dfa_new(cr.pattern);
+    ASSERT(ail_pm_match_eq(ail_pm_dfa_match(&dfa, long_str, sizeof(long_str)), (AIL_PM_Match){ sizeof(long_str) - 3, 3 }));
+    ASSERT(ail_pm_match_eq(ail_pm_match_greedy(cr.pattern, long_str, sizeof(long_str)), (AIL_PM_Match){ sizeof(long_str) - 3, 3 }));
+    ail_pm_dfa_free(&dfa);
+    ail_pm_free(cr.pattern);
+    return true;
+}
+
 int main(void)
 {
     ail_default_allocator = ail_alloc_std;
@@ -787,6 +1350,23 @@ int main(void)
     if (fail_tests(glob_fail_tests, ail_arrlen(glob_fail_tests), AIL_PM_EXP_GLOB, false)) printf("\033[32mInvalid Globs fail as expected :)\033[0m\n");
     else printf("\033[31mNot all invalid globs failed to compile as expected :(\033[0m\n");
 
+    if (dfa_tests()) printf("\033[32mLazy DFA matches like the reference implementation :)\033[0m\n");
+    else printf("\033[31mLazy DFA doesn't match like the reference implementation :(\033[0m\n");
+    if (class_tests()) printf("\033[32mCharacter classes match as expected :)\033[0m\n");
+    else printf("\033[31mCharacter classes don't match as expected :(\033[0m\n");
+    if (set_tests()) printf("\033[32mPattern sets match like their patterns :)\033[0m\n");
+    else printf("\033[31mPattern sets don't match like their patterns :(\033[0m\n");
+    if (stream_tests()) printf("\033[32mStreams find all matches across chunks :)\033[0m\n");
+    else printf("\033[31mStreams don't find all matches across chunks :(\033[0m\n");
+    if (find_all_tests()) printf("\033[32mAll matches are found in large buffers :)\033[0m\n");
+    else printf("\033[31mNot all matches are found in large buffers :(\033[0m\n");
+    if (jit_tests()) printf("\033[32mCompiled DFAs match like interpreted DFAs :)\033[0m\n");
+    else printf("\033[31mCompiled DFAs don't match like interpreted DFAs :(\033[0m\n");
+    if (cache_tests()) printf("\033[32mCached patterns are the same as compiled patterns :)\033[0m\n");
+    else printf("\033[31mCached patterns aren't the same as compiled patterns :(\033[0m\n");
+    if (literal_tests()) printf("\033[32mSearching for required literals works as expected :)\033[0m\n");
+    else printf("\033[31mSearching for required literals doesn't work as expected :(\033[0m\n");
+
     ail_pm_deinit();
     return 0;
 }
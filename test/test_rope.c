@@ -0,0 +1,109 @@
+#include "../src/base/ail_alloc.h"
+#include "../src/base/ail_rope.h"
+#include "../src/math/ail_rand.h"
+#include "assert.h"
+#include <stdio.h>
+#include <stdbool.h>
+
+#define N 5000
+
+bool checkBalanced(AIL_Rope_Node *n)
+{
+    if (!n || !n->left) return true;
+    i64 balance = (i64)n->left->height - (i64)n->right->height;
+    ASSERT(balance >= -1 && balance <= 1);
+    ASSERT(n->len == n->left->len + n->right->len);
+    return checkBalanced(n->left) && checkBalanced(n->right);
+}
+
+bool basicTest(void)
+{
+    char *text = "Hello World";
+    AIL_Rope rope = ail_rope_new_from_str(ail_str_from_cstr(text));
+    ail_rope_insert(&rope, 5, ail_str_from_cstr(","));
+    ail_rope_push(&rope, ail_str_from_cstr("!"));
+    ail_rope_push(&rope, ail_str_from_cstr("!"));
+    ASSERT(ail_rope_len(rope) == 14);
+    ASSERT(ail_rope_get(rope, 5) == ',' && ail_rope_get(rope, 13) == '!');
+
+    // Text, that the rope was created from, is not copied
+    AIL_Str view;
+    ASSERT(ail_rope_view(rope, 7, 5, &view));
+    ASSERT(view.data == (u8 *)text + 6);
+    ASSERT(ail_rope_view(rope, 12, 2, &view)); // Consecutive inserts are coalesced
+    ASSERT(!ail_rope_view(rope, 4, 2, &view));
+
+    AIL_Str s = ail_rope_to_str(rope);
+    ASSERT(ail_str_eq(s, ail_str_from_cstr("Hello, World!!")));
+    ASSERT(s.data[s.len] == 0);
+    ail_str_free(s);
+
+    ail_rope_rm(&rope, 5, 1);
+    ail_rope_rm(&rope, 11, 100);
+    s = ail_rope_to_str(rope);
+    ASSERT(ail_str_eq(s, ail_str_from_cstr("Hello World")));
+    ail_str_free(s);
+    ail_rope_rm(&rope, 0, ail_rope_len(rope));
+    ASSERT(ail_rope_len(rope) == 0 && rope.root == NULL);
+    ail_rope_free(&rope);
+    return true;
+}
+
+bool randomEditTest(void)
+{
+    // Compare against the same edits on a plain array
+    static u8 ref[N*8];
+    u64 ref_len = 0;
+    static u8 tmp[N*8];
+    AIL_Rope rope = ail_rope_new();
+    for (u32 i = 0; i < N; i++) {
+        u64 pos = ail_rand_u64() % (ref_len + 1);
+        if (ail_rand_u64() & 3) {
+            u8 text[5];
+            u64 n = 1 + ail_rand_u64() % sizeof(text);
+            for (u64 j = 0; j < n; j++) text[j] = 'a' + ail_rand_u64() % 26;
+            ail_rope_insert(&rope, pos, ail_str_from_parts(text, n));
+            ail_mem_copy(ref + pos + n, ref + pos, ref_len - pos);
+            ail_mem_copy(ref + pos, text, n);
+            ref_len += n;
+        } else {
+            u64 n = ail_rand_u64() % 8;
+            n = ail_min(n, ref_len - pos);
+            ail_rope_rm(&rope, pos, n);
+            ail_mem_copy(ref + pos, ref + pos + n, ref_len - pos - n);
+            ref_len -= n;
+        }
+        ASSERT(ail_rope_len(rope) == ref_len);
+    }
+    if (!checkBalanced(rope.root)) return false;
+
+    ail_rope_copy_to(rope, 0, ref_len, tmp);
+    ASSERT(ail_str_full_eq((char *)tmp, ref_len, (char *)ref, ref_len));
+    for (u32 i = 0; i < 100; i++) {
+        u64 start = ail_rand_u64() % ref_len;
+        u64 len   = ail_rand_u64() % (ref_len - start);
+        ail_rope_copy_to(rope, start, len, tmp);
+        ASSERT(ail_str_full_eq((char *)tmp, len, (char *)ref + start, len));
+        ASSERT(ail_rope_get(rope, start) == ref[start]);
+    }
+
+    u64 pos = 0;
+    AIL_Rope_Iter it = ail_rope_iter_new(rope, 0);
+    for (AIL_Str chunk = ail_rope_iter_next(&it); chunk.len; chunk = ail_rope_iter_next(&it)) {
+        ASSERT(ail_str_full_eq((char *)chunk.data, chunk.len, (char *)ref + pos, chunk.len));
+        pos += chunk.len;
+    }
+    ASSERT(pos == ref_len);
+    ail_rope_free(&rope);
+    return true;
+}
+
+int main(void)
+{
+    ail_default_allocator = ail_alloc_std;
+    if (basicTest())      printf("\033[32mBasic Test succesful       :)\033[0m\n");
+    else                  printf("\033[31mBasic Test failed          :(\033[0m\n");
+    if (randomEditTest()) printf("\033[32mRandom Edit Test succesful :)\033[0m\n");
+    else                  printf("\033[31mRandom Edit Test failed    :(\033[0m\n");
+    return 0;
+}
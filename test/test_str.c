@@ -3,6 +3,9 @@
 #include "../src/base/ail_str.h"
 #include <stdbool.h>
 #include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
 
 bool test_ail_str_inits(void)
 {
@@ -24,7 +27,6 @@ bool test_ail_str_inits(void)
 
 bool test_ail_str_num_conversions(void)
 {
-    // @TODO: Test from/to float conversion too
     AIL_Str nonum1  = ail_str_from_cstr("not a number");
     AIL_Str nonum2  = ail_str_from_cstr("+not a number");
     AIL_Str nonum3  = ail_str_from_cstr("-not a number");
@@ -78,6 +80,138 @@ bool test_ail_str_num_conversions(void)
     ASSERT(ail_str_parse_unsigned(sub).len == 0);
     ASSERT(ail_str_parse_signed(sub).val == -13);
     ASSERT(ail_str_parse_signed(sub).len == 3);
+
+    // Overflow is detected and reported as an error
+    AIL_Str u64_max = ail_str_from_cstr("18446744073709551615");
+    AIL_Str i64_min = ail_str_from_cstr("-9223372036854775808");
+    AIL_Str zeros   = ail_str_from_cstr("+000000000000000000000000000042x");
+    ASSERT(ail_str_parse_unsigned(u64_max).val == UINT64_MAX && ail_str_parse_unsigned(u64_max).len == 20);
+    ASSERT(ail_str_parse_signed(i64_min).val == INT64_MIN && ail_str_parse_signed(i64_min).len == 20);
+    ASSERT(ail_str_parse_signed(ail_str_from_cstr("9223372036854775807")).val == INT64_MAX);
+    ASSERT(ail_str_parse_unsigned(zeros).val == 42 && ail_str_parse_unsigned(zeros).len == 31);
+    ASSERT(ail_str_parse_unsigned(ail_str_from_cstr("18446744073709551616")).len == 0);
+    ASSERT(ail_str_parse_unsigned(ail_str_from_cstr("99999999999999999999")).len == 0);
+    ASSERT(ail_str_parse_signed(ail_str_from_cstr("9223372036854775808")).len == 0);
+    ASSERT(ail_str_parse_signed(ail_str_from_cstr("-9223372036854775809")).len == 0);
+
+    // Random numbers of any length match libc
+    u64 seed = 0x2545F4914F6CDD1D;
+    char buf[64];
+    u8   out[AIL_STR_INT_MAX_LEN];
+    for (u32 iter = 0; iter < 100000; iter++) {
+        seed ^= seed << 13; seed ^= seed >> 7; seed ^= seed << 17;
+        u64 x = seed >> (seed % 64);
+        i64 y = (i64)((seed & 1) ? 0 - x : x);
+        u32 n = (u32)snprintf(buf, sizeof(buf), "%llu,", (unsigned long long)x);
+        ASSERT(ail_str_unsigned_to_buf(x, out) == n - 1 && ail_str_full_eq((char *)out, n - 1, buf, n - 1));
+        AIL_Str_Parse_U_Res ures = ail_str_parse_unsigned(ail_str_from_parts((u8 *)buf, n));
+        ASSERT(ures.val == x && ures.len == n - 1);
+        n = (u32)snprintf(buf, sizeof(buf), "%lld", (long long)y);
+        ASSERT(ail_str_signed_to_buf(y, out) == n && ail_str_full_eq((char *)out, n, buf, n));
+        AIL_Str_Parse_I_Res ires = ail_str_parse_signed(ail_str_from_parts((u8 *)buf, n));
+        ASSERT(ires.val == y && ires.len == n);
+    }
+
+    AIL_SB sb = ail_da_new(u8);
+    ail_sb_push_signed(&sb, INT64_MIN);
+    ail_sb_push_str(&sb, ail_str_from_cstr(" "));
+    ail_sb_push_unsigned(&sb, 0);
+    ail_sb_push_str(&sb, ail_str_from_cstr(" "));
+    ail_sb_push_float(&sb, 0.5);
+    ASSERT(ail_str_eq(ail_str_from_parts(sb.data, sb.len), ail_str_from_cstr("-9223372036854775808 0 0.5")));
+    ail_da_free(&sb);
+    return true;
+}
+
+static u64 f64_bits(f64 x)
+{
+    u64 u;
+    memcpy(&u, &x, sizeof(u));
+    return u;
+}
+
+static bool parses_to(const char *s, f64 expected, u32 len)
+{
+    AIL_Str_Parse_F_Res res = ail_str_parse_float(ail_str_from_cstr((char *)s));
+    return res.len == len && f64_bits(res.val) == f64_bits(expected);
+}
+
+static bool prints_as(f64 x, const char *expected)
+{
+    u8  buf[AIL_STR_FLOAT_MAX_LEN];
+    u32 len = ail_str_float_to_buf(x, buf);
+    return ail_str_full_eq((char *)buf, len, (char *)expected, strlen(expected));
+}
+
+bool test_ail_str_float_conversions(void)
+{
+    ASSERT(parses_to("1.5", 1.5, 3));
+    ASSERT(parses_to("-0", -0.0, 2));
+    ASSERT(parses_to("+.5e1x", 5.0, 5));
+    ASSERT(parses_to("5.", 5.0, 2));
+    ASSERT(parses_to("12e", 12.0, 2));
+    ASSERT(parses_to("1e+x", 1.0, 1));
+    ASSERT(parses_to("-Infinity", -HUGE_VAL, 9));
+    ASSERT(parses_to("inf", HUGE_VAL, 3));
+    ASSERT(parses_to("1e400", HUGE_VAL, 5));
+    ASSERT(parses_to("1e-400", 0.0, 6));
+    ASSERT(parses_to("4.9406564584124654e-324", 4.9406564584124654e-324, 23));
+    ASSERT(parses_to("2.2250738585072011e-308", 2.2250738585072011e-308, 23));
+    ASSERT(parses_to("9007199254740993", 9007199254740992.0, 16)); // Exactly halfway, rounds to even
+    ASSERT(parses_to("9007199254740993.0000000000000000000001", 9007199254740994.0, 39));
+    ASSERT(parses_to("179769313486231580793728971405301e276", 1.7976931348623157e308, 37));
+    ASSERT(ail_str_parse_float(ail_str_from_cstr("NaN")).val != ail_str_parse_float(ail_str_from_cstr("NaN")).val);
+    ASSERT(ail_str_parse_float(ail_str_from_cstr(".")).len == 0);
+    ASSERT(ail_str_parse_float(ail_str_from_cstr("-e5")).len == 0);
+    ASSERT(ail_str_parse_float(ail_str_from_cstr("in")).len == 0);
+
+    ASSERT(prints_as(0.0, "0") && prints_as(-0.0, "-0"));
+    ASSERT(prints_as(1.0, "1") && prints_as(-123.25, "-123.25"));
+    ASSERT(prints_as(0.1, "0.1") && prints_as(0.3, "0.3") && prints_as(0.1 + 0.2, "0.30000000000000004"));
+    ASSERT(prints_as(1e21, "1e+21") && prints_as(1e20, "100000000000000000000"));
+    ASSERT(prints_as(1e-6, "0.000001") && prints_as(1.5e-7, "1.5e-7"));
+    ASSERT(prints_as(5e-324, "5e-324") && prints_as(1.7976931348623157e308, "1.7976931348623157e+308"));
+    ASSERT(prints_as(HUGE_VAL, "inf") && prints_as(-HUGE_VAL, "-inf") && prints_as(NAN, "nan"));
+    AIL_Str s = ail_str_new_float(2.5e-3);
+    ASSERT(ail_str_eq(s, ail_str_from_cstr("0.0025")) && s.data[s.len] == 0);
+    ail_str_free(s);
+
+    u64 seed = 0x2545F4914F6CDD1D;
+    char buf[128];
+    for (u32 iter = 0; iter < 200000; iter++) {
+        seed ^= seed << 13; seed ^= seed >> 7; seed ^= seed << 17;
+        f64 x;
+        memcpy(&x, &seed, sizeof(x));
+        if (isnan(x) || isinf(x)) continue;
+
+        // Printing and parsing round-trips and is as short as the shortest precision that round-trips with libc
+        u8  out[AIL_STR_FLOAT_MAX_LEN];
+        u32 len = ail_str_float_to_buf(x, out);
+        AIL_Str_Parse_F_Res res = ail_str_parse_float(ail_str_from_parts(out, len));
+        ASSERT(res.len == len && f64_bits(res.val) == f64_bits(x));
+        if (iter % 16 == 0) {
+            u32 digits = 0;
+            for (u32 i = 0; i < len && out[i] != 'e'; i++) digits += out[i] >= '0' && out[i] <= '9';
+            // Leading and trailing zeros of the fixed notation are not significant
+            u32 i = 0;
+            while (i < len && (out[i] == '-' || out[i] == '0' || out[i] == '.')) digits -= out[i++] == '0';
+            if (memchr(out, '.', len) == NULL && memchr(out, 'e', len) == NULL) for (i = len; i > 0 && out[i - 1] == '0'; i--) digits--;
+            u32 precision = 1;
+            while (snprintf(buf, sizeof(buf), "%.*g", precision, x), strtod(buf, NULL) != x) precision++;
+            ASSERT(digits == precision);
+        }
+
+        // Parsing random decimals matches strtod, including long ones that need the slow path
+        u32 nd = 1 + (u32)(seed >> 8) % (iter % 8 ? 20 : 120);
+        u32 n  = 0;
+        for (u32 i = 0; i < nd; i++) {
+            seed ^= seed << 13; seed ^= seed >> 7; seed ^= seed << 17;
+            if (i == nd/2 && seed & 1) buf[n++] = '.';
+            buf[n++] = '0' + (char)(seed % 10);
+        }
+        n += snprintf(buf + n, sizeof(buf) - n, "e%d", (i32)(seed >> 16) % 700 - 350);
+        ASSERT(parses_to(buf, strtod(buf, NULL), n));
+    }
     return true;
 }
 
@@ -107,12 +241,262 @@ bool test_ail_str_cmps(void)
     return true;
 }
 
+static u8 naive_lower(u8 c)
+{
+    return ('A' <= c && c <= 'Z') ? c + 32 : c;
+}
+
+bool test_ail_str_case(void)
+{
+    AIL_Str hello = ail_str_new_lower(ail_str_from_cstr("Hello, WORLD! [@`{] \xC3\x84"));
+    ASSERT(ail_str_eq(hello, ail_str_from_cstr("hello, world! [@`{] \xC3\x84")) && hello.data[hello.len] == 0);
+    ail_str_to_upper(hello, hello.data);
+    ASSERT(ail_str_eq(hello, ail_str_from_cstr("HELLO, WORLD! [@`{] \xC3\x84")));
+    ail_str_free(hello);
+
+    ASSERT(ail_str_eq_nocase(ail_str_from_cstr("Content-Length"), ail_str_from_cstr("content-length")));
+    ASSERT(!ail_str_eq_nocase(ail_str_from_cstr("Content-Length"), ail_str_from_cstr("content_length")));
+    ASSERT(!ail_str_eq_nocase(ail_str_from_cstr("@"), ail_str_from_cstr("`")));
+    ASSERT(ail_str_starts_with_nocase(ail_str_from_cstr("GET /index.html HTTP/1.1"), ail_str_from_cstr("get ")));
+    ASSERT(ail_str_ends_with_nocase(ail_str_from_cstr("GET /index.html HTTP/1.1"), ail_str_from_cstr("http/1.1")));
+    ASSERT(!ail_str_ends_with_nocase(ail_str_from_cstr("1.1"), ail_str_from_cstr("http/1.1")));
+    ASSERT(ail_str_cmp_nocase(ail_str_from_cstr("ABC"), ail_str_from_cstr("abd")) < 0);
+    ASSERT(ail_str_cmp_nocase(ail_str_from_cstr("abc"), ail_str_from_cstr("AB")) > 0);
+    ASSERT(ail_str_find_nocase(ail_str_from_cstr("Accept: */*\r\nHOST: example.com"), ail_str_from_cstr("host:")) == 13);
+    ASSERT(ail_str_hash_nocase(ail_str_from_cstr("X-Forwarded-For")) == ail_str_hash(ail_str_from_cstr("x-forwarded-for")));
+    ASSERT(ail_str_hash(ail_str_from_cstr("X-Forwarded-For")) != ail_str_hash(ail_str_from_cstr("x-forwarded-for")));
+
+    // Random strings of letters, which differ in their case or in a single byte, are compared with naive implementations
+    u8 a[100], b[100], lower[100];
+    u64 seed = 0x2545F4914F6CDD1D;
+    for (u32 iter = 0; iter < 20000; iter++) {
+        seed ^= seed << 13; seed ^= seed >> 7; seed ^= seed << 17;
+        u64 len = seed % sizeof(a);
+        for (u64 i = 0; i < len; i++) {
+            seed ^= seed << 13; seed ^= seed >> 7; seed ^= seed << 17;
+            a[i] = (seed & 1) ? (u8)(seed >> 8) : (u8)"aAzZ@[`{ -"[(seed >> 8) % 10];
+            b[i] = (seed >> 16 & 1) ? a[i] ^ ((naive_lower(a[i]) != (a[i] | 0x20)) ? 0 : 0x20) : a[i];
+            lower[i] = naive_lower(a[i]);
+        }
+        if (len && (iter & 1)) b[seed % len] ^= (u8)(seed >> 24) | 1;
+        AIL_Str sa = ail_str_from_parts(a, len), sb = ail_str_from_parts(b, len);
+        b32 eq = true;
+        for (u64 i = 0; i < len; i++) eq &= naive_lower(a[i]) == naive_lower(b[i]);
+        ASSERT(ail_str_eq_nocase(sa, sb) == eq);
+        ASSERT(ail_str_eq(sa, sb) == (memcmp(a, b, len) == 0));
+        ASSERT((ail_str_cmp_nocase(sa, sb) == 0) == eq);
+        ASSERT(!eq || ail_str_hash_nocase(sa) == ail_str_hash_nocase(sb));
+        if (len) ASSERT(ail_str_starts_with_nocase(sa, ail_str_from_parts(b, len - 1)) == (eq || ail_str_eq_nocase(ail_str_from_parts(a, len - 1), ail_str_from_parts(b, len - 1))));
+
+        u8 buf[100];
+        ASSERT(memcmp(ail_str_to_lower(sa, buf).data, lower, len) == 0);
+        for (u64 i = 0; i < len; i++) ASSERT(ail_str_to_upper(sa, buf).data[i] == (('a' <= a[i] && a[i] <= 'z') ? a[i] - 32 : a[i]));
+
+        u64 start = len ? seed % len : 0;
+        u64 n     = len - start ? (seed >> 32) % (len - start) + 1 : 0;
+        AIL_Str needle = ail_str_from_parts(b + start, n);
+        i64 expected = -1;
+        for (u64 i = 0; expected < 0 && i + n <= len; i++) {
+            u64 j = 0;
+            while (j < n && naive_lower(a[i + j]) == naive_lower(b[start + j])) j++;
+            if (j == n) expected = (i64)i;
+        }
+        ASSERT(ail_str_find_nocase(sa, needle) == expected);
+    }
+
+    // Whitespace around strings, which are longer than the SIMD blocks
+    u8 spaced[200];
+    for (u32 iter = 0; iter < 2000; iter++) {
+        seed ^= seed << 13; seed ^= seed >> 7; seed ^= seed << 17;
+        u64 len = seed % sizeof(spaced), l = 0, r = 0;
+        for (u64 i = 0; i < len; i++) spaced[i] = " \t\n\r"[(seed >> (i & 31)) & 3];
+        if (len && (seed & 3)) {
+            l = (seed >> 8) % len;
+            r = l + (seed >> 24) % (len - l);
+            spaced[l] = 'x';
+            spaced[r] = 'y';
+        }
+        AIL_Str t = ail_str_trim(ail_str_from_parts(spaced, len));
+        if (len && (seed & 3)) ASSERT(t.data == spaced + l && t.len == r - l + 1);
+        else                   ASSERT(t.len == 0);
+        ASSERT(ail_str_ltrim(ail_str_from_parts(spaced, len)).data == spaced + ((len && (seed & 3)) ? l : len));
+        ASSERT(ail_str_rtrim(ail_str_from_parts(spaced, len)).len == ((len && (seed & 3)) ? r + 1 : 0));
+    }
+    return true;
+}
+
+static i64 naive_find(AIL_Str str, AIL_Str needle, b32 last)
+{
+    i64 res = -1;
+    for (u64 i = 0; i + needle.len <= str.len; i++) {
+        if (memcmp(str.data + i, needle.data, needle.len) == 0) {
+            res = (i64)i;
+            if (!last) break;
+        }
+    }
+    return res;
+}
+
+bool test_ail_str_find(void)
+{
+    AIL_Str a = ail_str_from_cstr("Hello World, Hello!");
+    ASSERT(ail_str_find(a, ail_str_from_cstr("Hello")) == 0);
+    ASSERT(ail_str_find_last(a, ail_str_from_cstr("Hello")) == 13);
+    ASSERT(ail_str_find(a, ail_str_from_cstr("World!")) == -1);
+    ASSERT(ail_str_find(a, ail_str_from_cstr("Hello World, Hello!!")) == -1);
+    ASSERT(ail_str_find(a, ail_str_from_cstr("")) == 0);
+    ASSERT(ail_str_find_last(a, ail_str_from_cstr("")) == (i64)a.len);
+    ASSERT(ail_str_find_char(a, '!') == 18);
+    ASSERT(ail_str_find_last_char(a, 'o') == 17);
+    ASSERT(ail_str_find_char(a, 'x') == -1);
+    ASSERT(ail_str_contains(a, ail_str_from_cstr("lo!")));
+    ASSERT(!ail_str_contains(a, ail_str_from_cstr("lo?")));
+    ASSERT(ail_str_contains_char(a, ','));
+
+    // Unlike with ail_str_find, empty needles are only found at the indices of the string
+    AIL_Str needles[] = { ail_str_from_cstr("x"), ail_str_from_cstr(""), ail_str_from_cstr("!") };
+    AIL_Str_Find_Of_Res res = ail_str_find_of(a, needles, ail_arrlen(needles));
+    ASSERT(res.str_idx == 0 && res.needle_idx == 1);
+    res = ail_str_find_last_of(a, needles, ail_arrlen(needles));
+    ASSERT(res.str_idx == (i64)a.len - 1 && res.needle_idx == 1);
+    ASSERT(ail_str_find_of(ail_str_from_cstr(""), needles, ail_arrlen(needles)).str_idx == -1);
+    ASSERT(ail_str_find_last_of(ail_str_from_cstr(""), needles, ail_arrlen(needles)).str_idx == -1);
+
+    // Random haystacks over a small alphabet produce lots of partial matches
+    static u8 hay[4096], needle[300];
+    u32 seed = 42;
+    for (u32 iter = 0; iter < 2000; iter++) {
+        u32 alphabet = 2 + iter%3;
+        u64 n = 1 + iter*2 % sizeof(hay);
+        u64 m = 1 + (iter*7) % (iter % 4 ? 8 : sizeof(needle));
+        for (u64 i = 0; i < n; i++) hay[i]    = 'a' + (seed = seed*1103515245 + 12345) / 65536 % alphabet;
+        for (u64 i = 0; i < m; i++) needle[i] = 'a' + (seed = seed*1103515245 + 12345) / 65536 % alphabet;
+        // Make sure that the needle is contained in about half of the cases
+        if (iter % 2 && m <= n) memcpy(needle, hay + (iter*13) % (n - m + 1), m);
+        AIL_Str h = ail_str_from_parts(hay, n), s = ail_str_from_parts(needle, m);
+        ASSERT(ail_str_find(h, s)      == naive_find(h, s, false));
+        ASSERT(ail_str_find_last(h, s) == naive_find(h, s, true));
+    }
+
+    // Worst case for the SIMD filter: every position matches the needle's first and last byte
+    memset(hay, 'a', sizeof(hay));
+    memset(needle, 'a', sizeof(needle));
+    needle[sizeof(needle)/2] = 'b';
+    AIL_Str h = ail_str_from_parts(hay, sizeof(hay)), s = ail_str_from_parts(needle, sizeof(needle));
+    ASSERT(ail_str_find(h, s) == -1 && ail_str_find_last(h, s) == -1);
+    hay[1000 + sizeof(needle)/2] = 'b';
+    hay[3000 + sizeof(needle)/2] = 'b';
+    ASSERT(ail_str_find(h, s) == 1000 && ail_str_find_last(h, s) == 3000);
+    return true;
+}
+
+// Reference validator, that decodes each character and checks its value
+static bool naive_valid_utf8(u8 *p, u64 n)
+{
+    for (u64 i = 0; i < n;) {
+        u32 len = p[i] < 0x80 ? 1 : p[i] < 0xC0 ? 0 : p[i] < 0xE0 ? 2 : p[i] < 0xF0 ? 3 : p[i] < 0xF8 ? 4 : 0;
+        if (!len || i + len > n) return false;
+        u32 cp = len == 1 ? p[i] : p[i] & (0x7F >> len);
+        for (u32 j = 1; j < len; j++) {
+            if ((p[i+j] & 0xC0) != 0x80) return false;
+            cp = (cp << 6) | (p[i+j] & 0x3F);
+        }
+        u32 min[] = { 0, 0, 0x80, 0x800, 0x10000 };
+        if (cp < min[len] || cp > 0x10FFFF || (cp >= 0xD800 && cp < 0xE000)) return false;
+        i += len;
+    }
+    return true;
+}
+
+bool test_ail_str_unicode(void)
+{
+    // Invalid sequences: stray continuation, overlong, surrogate, too large, truncated, 5-byte lead
+    char *invalid[] = { "a\x80", "\xC0\xAF", "\xE0\x80\xAF", "\xF0\x8F\xBF\xBF", "\xED\xA0\x80", "\xF4\x90\x80\x80", "\xE2\x82", "\xF8\x88\x80\x80\x80", "abc\xE2" };
+    for (u32 i = 0; i < ail_arrlen(invalid); i++) {
+        ASSERT(!ail_str8_is_valid_utf8(ail_str_from_cstr(invalid[i])));
+        ASSERT(ail_str16_new_str8(ail_str_from_cstr(invalid[i])).data == NULL);
+    }
+    u16 lone_surrogates[] = { 'a', 0xD800, 'b', 0xDC00, 0xD800 };
+    ASSERT(!ail_str16_is_valid_utf16((AIL_Str16){ lone_surrogates + 1, 2 }));
+    ASSERT(!ail_str16_is_valid_utf16((AIL_Str16){ lone_surrogates + 3, 1 }));
+    ASSERT(!ail_str16_is_valid_utf16((AIL_Str16){ lone_surrogates + 4, 1 }));
+    u32 invalid32[] = { 0xD800, 0x110000 };
+    ASSERT(!ail_str32_is_valid_utf32((AIL_Str32){ invalid32, 1 }));
+    ASSERT(!ail_str32_is_valid_utf32((AIL_Str32){ invalid32 + 1, 1 }));
+
+    AIL_Str8 s8 = ail_str_from_cstr("Grüße, 世界! \xF0\x9F\x98\x80");
+    ASSERT(ail_str8_is_valid_utf8(s8));
+    ASSERT(ail_str32_len_from_str8(s8) == 12 && ail_str16_len_from_str8(s8) == 13);
+    AIL_Str16 s16 = ail_str16_new_str8(s8);
+    AIL_Str32 s32 = ail_str32_new_str16(s16);
+    ASSERT(s16.len == 13 && s16.data[11] == 0xD83D && s16.data[12] == 0xDE00 && s16.data[13] == 0);
+    ASSERT(s32.len == 12 && s32.data[2] == 0xFC && s32.data[7] == 0x4E16 && s32.data[11] == 0x1F600);
+    AIL_Str8 back = ail_str8_new_str32(s32);
+    ASSERT(ail_str_eq(back, s8) && back.data[back.len] == 0);
+    ail_str_free(s16); ail_str_free(s32); ail_str_free(back);
+
+    // Random round trips with varying amounts of non-ASCII characters
+    static u32 cps[2048], buf32[2048];
+    static u16 buf16[4096];
+    static u8  buf8[8192], buf8_2[8192];
+    u32 seed = 1337;
+    for (u32 iter = 0; iter < 500; iter++) {
+        u64 n = (iter*37) % ail_arrlen(cps);
+        for (u64 i = 0; i < n; i++) {
+            u32 r = (seed = seed*1103515245 + 12345) / 65536;
+            switch ((iter % 8 ? r % (iter % 8 * 8) : r) % 16) {
+                case 0:  cps[i] = 0x80 + r % 0x780; break;
+                case 1:  cps[i] = 0x800 + r % 0xD000; break;
+                case 2:  cps[i] = 0x10000 + r*31 % 0x100000; break;
+                default: cps[i] = r % 0x80;
+            }
+            if (cps[i] >= 0xD800 && cps[i] < 0xE000) cps[i] -= 0x1000;
+        }
+        AIL_Str32 a32 = { cps, n };
+        ASSERT(ail_str32_is_valid_utf32(a32));
+        AIL_Str8  a8  = ail_str8_from_str32(a32, buf8);
+        ASSERT(a8.len == ail_str8_len_from_str32(a32) && ail_str8_is_valid_utf8(a8));
+        AIL_Str16 a16 = ail_str16_from_str8(a8, buf16);
+        ASSERT(a16.len == ail_str16_len_from_str8(a8) && a16.len == ail_str16_len_from_str32(a32) && ail_str16_is_valid_utf16(a16));
+        AIL_Str32 b32 = ail_str32_from_str16(a16, buf32);
+        ASSERT(b32.len == n && b32.len == ail_str32_len_from_str16(a16) && memcmp(b32.data, cps, n*4) == 0);
+        b32 = ail_str32_from_str8(a8, buf32);
+        ASSERT(b32.len == n && b32.len == ail_str32_len_from_str8(a8) && memcmp(b32.data, cps, n*4) == 0);
+        AIL_Str8 b8 = ail_str8_from_str16(a16, buf8_2);
+        ASSERT(b8.len == ail_str8_len_from_str16(a16) && ail_str_eq(a8, b8));
+        a16 = ail_str16_from_str32(a32, buf16);
+        ASSERT(ail_str8_from_str16(a16, buf8_2).len == a8.len && memcmp(buf8_2, buf8, a8.len) == 0);
+
+        // The allocated strings have no room to spare after their end, unlike the buffers above
+        AIL_Str16 n16 = ail_str16_new_str32(a32);
+        AIL_Str8  n8  = ail_str8_new_str16(n16);
+        AIL_Str32 n32 = ail_str32_new_str8(n8);
+        AIL_Str16 m16 = ail_str16_new_str8(a8);
+        AIL_Str8  m8  = ail_str8_new_str32(a32);
+        AIL_Str32 m32 = ail_str32_new_str16(m16);
+        ASSERT(ail_str_eq(n8, a8) && ail_str_eq(m8, a8) && n16.len == m16.len && memcmp(n16.data, m16.data, 2*n16.len) == 0);
+        ASSERT(n32.len == n && m32.len == n && memcmp(n32.data, cps, n*4) == 0 && memcmp(m32.data, cps, n*4) == 0);
+        ail_str_free(n16); ail_str_free(n8); ail_str_free(n32);
+        ail_str_free(m16); ail_str_free(m8); ail_str_free(m32);
+
+        // Corrupt a few bytes and compare against the reference validator
+        if (a8.len) {
+            for (u32 k = 0; k < 1 + iter % 3; k++) {
+                u32 r = (seed = seed*1103515245 + 12345) / 65536;
+                buf8[r % a8.len] = (u8)(r >> 8);
+            }
+            ASSERT(ail_str8_is_valid_utf8(a8) == naive_valid_utf8(a8.data, a8.len));
+            for (u64 cut = a8.len - ail_min(a8.len, 70); cut < a8.len; cut++) {
+                ASSERT(ail_str8_is_valid_utf8(ail_str_from_parts(a8.data, cut)) == naive_valid_utf8(a8.data, cut));
+            }
+        }
+    }
+    return true;
+}
+
 bool test_ail_str_split(void)
 {
-    // @TODO: Also test the following
-    // - ail_str_split_next_char
-    // - ail_str_split_next
-    // - ail_str_split_char
+    // @TODO: Also test ail_str_split_char
     AIL_Str a = ail_str_from_cstr("_:__:_abc_:_def_:_\nghi_:_jkl_:_");
     AIL_DA(AIL_Str) lines = ail_str_split_lines(a, true);
     ASSERT(lines.len == 2);
@@ -131,6 +515,87 @@ bool test_ail_str_split(void)
     ASSERT(joined_words.len + 2 == joined_splitted.len);
     ASSERT(ail_str_eq(joined_words, ail_str_trim(joined_splitted)));
     ASSERT(ail_str_eq(joined_words, ail_str_offset(joined_splitted, 2)));
+
+    AIL_Str csv   = ail_str_from_cstr(",,Hello,World,");
+    AIL_Str first = ail_str_split_next_char(&csv, ',', true);
+    ASSERT(ail_str_eq(csv, ail_str_from_cstr("World,")));
+    AIL_Str second = ail_str_split_next_char(&csv, ',', true);
+    ASSERT(ail_str_eq(first, ail_str_from_cstr("Hello")) && ail_str_eq(second, ail_str_from_cstr("World")));
+    AIL_Str text = ail_str_from_cstr("ab--cd----ef");
+    AIL_Str dash = ail_str_from_cstr("--");
+    char *expected_dashes[] = { "ab", "cd", "", "ef" };
+    b32   ignore_dashes[]   = { false, true, false, false };
+    for (u32 i = 0; i < 4; i++) {
+        AIL_Str token = ail_str_split_next(&text, dash, ignore_dashes[i]);
+        ASSERT(ail_str_eq(token, ail_str_from_cstr(expected_dashes[i])));
+    }
+    ASSERT(!text.len);
+    AIL_Str crlf = ail_str_from_cstr("a\r\n\r\nb");
+    AIL_Str line_a = ail_str_split_next_line(&crlf, true);
+    AIL_Str line_b = ail_str_split_next_line(&crlf, true);
+    ASSERT(ail_str_eq(line_a, ail_str_from_cstr("a")) && ail_str_eq(line_b, ail_str_from_cstr("b")));
+
+    // Iterators and lazy splitting agree with a naive reference on random text, that spans several 64-byte blocks
+    static u8 buf[1000];
+    u64 seed = 0x2545F4914F6CDD1D;
+    for (u32 iter = 0; iter < 200; iter++) {
+        u64 n = iter*5;
+        for (u64 i = 0; i < n; i++) {
+            seed ^= seed << 13; seed ^= seed >> 7; seed ^= seed << 17;
+            buf[i] = " \t\r\n,xyz"[seed % (iter % 2 ? 8 : 64) % 8];
+        }
+        AIL_Str str = ail_str_from_parts(buf, n);
+        for (u32 kind = 0; kind < 4; kind++) {
+            b32 ignore_empty = kind != iter % 4;
+            AIL_Str_Split_Iter it;
+            switch (kind) {
+                case 0:  it = ail_str_split_iter_char(str, ',', ignore_empty); break;
+                case 1:  it = ail_str_split_iter(str, ail_str_from_cstr(", "), ignore_empty); break;
+                case 2:  it = ail_str_split_iter_lines(str, ignore_empty); break;
+                default: it = ail_str_split_iter_whitespace(str, ignore_empty); break;
+            }
+            AIL_Str lazy = str;
+            u64 start = 0, count = 0;
+            for (u64 i = 0; i <= n; i++) {
+                u64 dlen = 0;
+                if (i < n) {
+                    switch (kind) {
+                        case 0:  dlen = buf[i] == ','; break;
+                        case 1:  dlen = i + 1 < n && buf[i] == ',' && buf[i + 1] == ' ' ? 2 : 0; break;
+                        case 2:  dlen = buf[i] == '\n'; break;
+                        default: dlen = ail_str_is_space(buf[i]); break;
+                    }
+                }
+                if (!dlen && i < n) continue;
+                AIL_Str expected = ail_str_from_parts(buf + start, i - start);
+                if (kind == 2 && expected.len && expected.data[expected.len - 1] == '\r') expected.len--;
+                if (!(i == n && start == n) && !(ignore_empty && !expected.len)) {
+                    AIL_Str token;
+                    ASSERT(ail_str_split_iter_next(&it, &token));
+                    ASSERT(token.data == expected.data && token.len == expected.len);
+                    AIL_Str lazy_token;
+                    switch (kind) {
+                        case 0:  lazy_token = ail_str_split_next_char(&lazy, ',', ignore_empty); break;
+                        case 1:  lazy_token = ail_str_split_next(&lazy, ail_str_from_cstr(", "), ignore_empty); break;
+                        case 2:  lazy_token = ail_str_split_next_line(&lazy, ignore_empty); break;
+                        default: lazy_token = ail_str_split_next_whitespace(&lazy, ignore_empty); break;
+                    }
+                    ASSERT(ail_str_eq(lazy_token, expected));
+                    count++;
+                }
+                start = i + dlen;
+                if (dlen) i += dlen - 1;
+            }
+            AIL_Str token;
+            ASSERT(!ail_str_split_iter_next(&it, &token));
+            ASSERT(!ail_str_split_iter_next(&it, &token));
+            if (kind == 3) {
+                AIL_DA(AIL_Str) words = ail_str_split_whitespace(str, ignore_empty);
+                ASSERT(words.len == count);
+                ail_da_free(&words);
+            }
+        }
+    }
     return true;
 }
 
@@ -170,8 +635,16 @@ bool test_ail_str_others(void)
     ASSERT(ail_str_eq(ail_str_from_cstr("Hi World, Hi!"), b));
     ail_call_free(ail_default_allocator, b.data);
 
-    AIL_Str s = ail_str_replace(empty, a, b);
-    ASSERT(ail_str_eq(s, empty));
+    AIL_Str s = ail_str_replace(empty, a, hi);
+    ASSERT(ail_str_eq(s, empty) && s.data[s.len] == 0);
+    ail_str_free(s);
+    // Empty substrings are never replaced, but the result is still a zero-terminated copy
+    s = ail_str_replace(a, empty, hi);
+    ASSERT(ail_str_eq(s, a) && s.data != a.data && s.data[s.len] == 0);
+    ail_str_free(s);
+    s = ail_str_replace(a, hello, empty);
+    ASSERT(ail_str_eq(s, ail_str_from_cstr(" World, !")) && s.data[s.len] == 0);
+    ail_str_free(s);
 
     AIL_Str  xhi  = ail_str_from_cstr("hi");
     AIL_Str  xhey = ail_str_from_cstr("hey");
@@ -180,6 +653,29 @@ bool test_ail_str_others(void)
     ASSERT(ail_str_eq(xin, xout));
     ASSERT(xin.data != xout.data);
     ail_call_free(ail_default_allocator, xout.data);
+
+    // Matches don't overlap and more matches than fit into the buffer of remembered positions are replaced as well
+    static u8 many[3000];
+    for (u32 i = 0; i < sizeof(many); i++) many[i] = i % 3 == 2 ? ',' : 'a';
+    AIL_Str many_str = ail_str_from_parts(many, sizeof(many));
+    AIL_Str replaced = ail_str_replace(many_str, ail_str_from_cstr("aa"), ail_str_from_cstr("xyz"));
+    ASSERT(replaced.len == 4000 && replaced.data[replaced.len] == 0);
+    for (u32 i = 0; i < replaced.len; i++) ASSERT(replaced.data[i] == "xyz,"[i & 3]);
+    ail_str_free(replaced);
+    replaced = ail_str_replace(ail_str_from_cstr("aaaaa"), ail_str_from_cstr("aa"), ail_str_from_cstr(""));
+    ASSERT(ail_str_eq(replaced, ail_str_from_cstr("a")));
+    ail_str_free(replaced);
+
+    AIL_Str parts[] = { ail_str_from_cstr("a"), ail_str_from_cstr("bc"), ail_str_from_cstr("d") };
+    AIL_Str joined  = ail_str_join(parts, 3, ail_str_from_cstr(", "));
+    ASSERT(ail_str_eq(joined, ail_str_from_cstr("a, bc, d")) && joined.data[joined.len] == 0);
+    ail_str_free(joined);
+    joined = ail_str_rev_join(parts, 3, ail_str_from_cstr(", "));
+    ASSERT(ail_str_eq(joined, ail_str_from_cstr("d, bc, a")) && joined.data[joined.len] == 0);
+    ail_str_free(joined);
+    joined = ail_str_concat(parts[0], parts[1], parts[2]);
+    ASSERT(ail_str_eq(joined, ail_str_from_cstr("abcd")));
+    ail_str_free(joined);
     return true;
 }
 
@@ -190,8 +686,16 @@ int main(void)
     else                      printf("\033[031mAIL_Str initialization fails :(\033[0m\n");
     if (test_ail_str_cmps()) printf("\033[032mAIL_Str comparisons work :)\033[0m\n");
     else                     printf("\033[031mAIL_Str comparisons fail :(\033[0m\n");
+    if (test_ail_str_case()) printf("\033[032mAIL_Str case conversions work :)\033[0m\n");
+    else                     printf("\033[031mAIL_Str case conversions fail :(\033[0m\n");
     if (test_ail_str_num_conversions()) printf("\033[032mAIL_Str number conversions work :)\033[0m\n");
     else                                printf("\033[031mAIL_Str number conversions fail :(\033[0m\n");
+    if (test_ail_str_float_conversions()) printf("\033[032mAIL_Str float conversions work :)\033[0m\n");
+    else                                  printf("\033[031mAIL_Str float conversions fail :(\033[0m\n");
+    if (test_ail_str_find()) printf("\033[032mAIL_Str find funcs work :)\033[0m\n");
+    else                     printf("\033[031mAIL_Str find funcs fail :(\033[0m\n");
+    if (test_ail_str_unicode()) printf("\033[032mAIL_Str unicode funcs work :)\033[0m\n");
+    else                        printf("\033[031mAIL_Str unicode funcs fail :(\033[0m\n");
     if (test_ail_str_split()) printf("\033[032mAIL_Str split funcs work :)\033[0m\n");
     else                      printf("\033[031mAIL_Str split funcs fail :(\033[0m\n");
     if (test_ail_str_others()) printf("\033[032mAIL_Str other funcs work :)\033[0m\n");